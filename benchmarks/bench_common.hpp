@@ -0,0 +1,64 @@
+#pragma once
+/**
+ * @file bench_common.hpp
+ * @brief Helpers shared by the axidev-io benchmarks.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <axidev-io/keyboard/common.hpp>
+
+namespace axidev::io::bench {
+
+/// Key injected by the Sender benchmarks. F20 is rarely bound to anything.
+inline constexpr keyboard::Key kProbeKey = keyboard::Key::F20;
+
+/**
+ * @brief Whether benchmarks may inject real key events into the session.
+ *
+ * Off unless AXIDEV_IO_BENCH_INJECT=1, so that running the whole suite does
+ * not type into whatever window has focus.
+ */
+inline bool injectEnabled() {
+  const char *value = std::getenv("AXIDEV_IO_BENCH_INJECT");
+  return value && std::strcmp(value, "1") == 0;
+}
+
+/// Skip @p state unless injection is enabled; returns true when skipped.
+inline bool skipUnlessInjecting(benchmark::State &state) {
+  if (injectEnabled())
+    return false;
+  state.SkipWithError("set AXIDEV_IO_BENCH_INJECT=1 to inject key events");
+  return true;
+}
+
+/**
+ * @brief Report the p50/p99/max of @p samplesNs as counters in microseconds.
+ *
+ * Reorders @p samplesNs.
+ */
+inline void reportLatency(benchmark::State &state,
+                          std::vector<uint64_t> &samplesNs) {
+  if (samplesNs.empty())
+    return;
+  auto percentile = [&samplesNs](double p) {
+    const auto index = static_cast<size_t>(p * (samplesNs.size() - 1));
+    std::nth_element(samplesNs.begin(), samplesNs.begin() + index,
+                     samplesNs.end());
+    return static_cast<double>(samplesNs[index]) / 1000.0;
+  };
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["max_us"] =
+      static_cast<double>(
+          *std::max_element(samplesNs.begin(), samplesNs.end())) /
+      1000.0;
+}
+
+} // namespace axidev::io::bench
@@ -0,0 +1,150 @@
+/**
+ * @file bench_key_utils.cpp
+ * @brief Microbenchmarks for key name conversion, KeyMap lookups and UTF-8
+ * decoding.
+ */
+
+#include "bench_common.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <axidev-io/keyboard/common.hpp>
+
+#include "keyboard/common/keymap.hpp"
+#include "keyboard/common/utf8.hpp"
+
+using namespace axidev::io::keyboard;
+
+namespace {
+
+// Every key with a canonical name, in enum order.
+const std::vector<Key> &namedKeys() {
+  static const std::vector<Key> keys = [] {
+    std::vector<Key> out;
+    for (uint16_t i = 1; i < 512; ++i) {
+      if (keyToStringView(static_cast<Key>(i)) != "Unknown")
+        out.push_back(static_cast<Key>(i));
+    }
+    return out;
+  }();
+  return keys;
+}
+
+const std::vector<std::string> &keyNames() {
+  static const std::vector<std::string> names = [] {
+    std::vector<std::string> out;
+    for (Key key : namedKeys())
+      out.push_back(keyToString(key));
+    return out;
+  }();
+  return names;
+}
+
+// Mixed ASCII / Latin-1 / CJK / emoji text.
+constexpr std::string_view kMixedText =
+    "The quick brown fox jumps over the lazy dog. "
+    "Fran\xC3\xA7ozs \xC3\xA9t\xC3\xA9 na\xC3\xAFve "
+    "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E "
+    "\xF0\x9F\x98\x80\xF0\x9F\x8E\x89 done.";
+
+void BM_KeyToString(benchmark::State &state) {
+  const auto &keys = namedKeys();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(keyToString(keys[i]));
+    i = (i + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KeyToString);
+
+void BM_KeyToStringView(benchmark::State &state) {
+  const auto &keys = namedKeys();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(keyToStringView(keys[i]));
+    i = (i + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KeyToStringView);
+
+void BM_StringToKey(benchmark::State &state) {
+  const auto &names = keyNames();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stringToKey(names[i]));
+    i = (i + 1) % names.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringToKey);
+
+void BM_StringToKeyAlias(benchmark::State &state) {
+  static constexpr std::string_view kAliases[] = {"esc", "kp1", "CTRL",
+                                                  "return", "del"};
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stringToKey(kAliases[i]));
+    i = (i + 1) % std::size(kAliases);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringToKeyAlias);
+
+void BM_StringToKeyWithModifier(benchmark::State &state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(stringToKeyWithModifier("Ctrl+Shift+S"));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringToKeyWithModifier);
+
+void BM_KeyMapKeyForCharacter(benchmark::State &state) {
+  const KeyMap &map = KeyMap::instance();
+  char32_t cp = U'!';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.keyForCharacter(cp));
+    cp = cp == U'~' ? U'!' : cp + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KeyMapKeyForCharacter);
+
+void BM_KeyMapCodeForKey(benchmark::State &state) {
+  const KeyMap &map = KeyMap::instance();
+  const auto &keys = namedKeys();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.codeForKey(keys[i]));
+    i = (i + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KeyMapCodeForKey);
+
+void BM_Utf8ForEachCodepoint(benchmark::State &state) {
+  for (auto _ : state) {
+    char32_t sum = 0;
+    detail::forEachCodepoint(kMixedText, [&sum](char32_t cp) { sum += cp; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(kMixedText.size()));
+}
+BENCHMARK(BM_Utf8ForEachCodepoint);
+
+void BM_Utf8ToUtf32(benchmark::State &state) {
+  std::u32string out;
+  for (auto _ : state) {
+    out.clear();
+    detail::appendUtf8AsUtf32(kMixedText, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(kMixedText.size()));
+}
+BENCHMARK(BM_Utf8ToUtf32);
+
+} // namespace
@@ -0,0 +1,100 @@
+/**
+ * @file bench_listener.cpp
+ * @brief Microbenchmarks for the per-event work on the listener thread:
+ * filtering, dispatch bookkeeping, queueing and hotkey matching.
+ */
+
+#include "bench_common.hpp"
+
+#include <axidev-io/keyboard/hotkey.hpp>
+#include <axidev-io/keyboard/listener.hpp>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/common/published_callback.hpp"
+#include "keyboard/common/spsc_ring.hpp"
+#include "keyboard/listener/listener_filter.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+
+using namespace axidev::io::keyboard;
+
+namespace {
+
+// A synthetic layout: codes 8..135 map to the first 128 keys.
+constexpr int32_t kFirstCode = 8;
+constexpr int32_t kCodeCount = 128;
+
+void BM_KeyFilterAdmitsCode(benchmark::State &state) {
+  detail::CodeKeyTable base;
+  detail::CodeModsKeyTable withMods{Modifier::Shift};
+  for (int32_t i = 0; i < kCodeCount; ++i)
+    base.insert(kFirstCode + i, static_cast<Key>(i + 1));
+  Listener::Filter spec;
+  spec.addKeyRange(Key::F1, Key::F12);
+  const detail::KeyFilter filter(spec, base, withMods);
+
+  uint32_t code = kFirstCode;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(filter.admitsCode(code, true));
+    code = code == kFirstCode + kCodeCount - 1 ? kFirstCode : code + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KeyFilterAdmitsCode);
+
+void BM_StatsDispatch(benchmark::State &state) {
+  detail::PublishedCallback<Listener::EventCallback> callback;
+  uint64_t delivered = 0;
+  callback.publish([&delivered](const Listener::Event &) { ++delivered; });
+  detail::ListenerStats stats;
+  Listener::Event ev;
+  ev.keyMod = KeyWithModifier(Key::A, Modifier::None);
+  for (auto _ : state)
+    stats.dispatch(callback, ev);
+  benchmark::DoNotOptimize(delivered);
+  callback.retire();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatsDispatch);
+
+void BM_QueuePushPop(benchmark::State &state) {
+  detail::SpscRing<Listener::Event> ring(1024);
+  Listener::Event ev;
+  Listener::Event out;
+  for (auto _ : state) {
+    ring.tryPush(ev);
+    ring.tryPop(out);
+  }
+  benchmark::DoNotOptimize(out);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueuePushPop);
+
+void BM_HotkeyMatcherFeed(benchmark::State &state) {
+  // range(0)^2 two-stroke bindings Alt+Fa Alt+Fb.
+  const int width = static_cast<int>(state.range(0));
+  HotkeyMatcher matcher;
+  for (int a = 0; a < width; ++a) {
+    for (int b = 0; b < width; ++b) {
+      const KeyWithModifier seq[] = {
+          {static_cast<Key>(static_cast<int>(Key::A) + a), Modifier::Alt},
+          {static_cast<Key>(static_cast<int>(Key::A) + b), Modifier::Alt}};
+      matcher.add(seq, {});
+    }
+  }
+  matcher.compile();
+
+  int next = 0;
+  uint64_t matched = 0;
+  for (auto _ : state) {
+    matched += matcher.feed(
+        {static_cast<Key>(static_cast<int>(Key::A) + next), Modifier::Alt},
+        true);
+    next = (next + 7) % width;
+  }
+  benchmark::DoNotOptimize(matched);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bindings"] = static_cast<double>(matcher.size());
+}
+BENCHMARK(BM_HotkeyMatcherFeed)->Arg(4)->Arg(26);
+
+} // namespace
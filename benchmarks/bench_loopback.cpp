@@ -0,0 +1,162 @@
+/**
+ * @file bench_loopback.cpp
+ * @brief End-to-end benchmarks: a Sender injecting into a Listener on the
+ * same machine.
+ *
+ * Latency is measured from just before the Sender call to the
+ * `Listener::Event::timestampNs` of the matching press, i.e. the moment the
+ * Listener hands the event to its callback. These inject real events; see
+ * `injectEnabled()`.
+ */
+
+#include "bench_common.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <axidev-io/keyboard/listener.hpp>
+#include <axidev-io/keyboard/sender.hpp>
+
+using namespace axidev::io::keyboard;
+using axidev::io::bench::kProbeKey;
+
+namespace {
+
+uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/**
+ * @brief A Listener filtered down to presses of the probe key, and a Sender.
+ */
+class Loopback {
+public:
+  bool start() {
+    Listener::Filter filter;
+    filter.addKey(kProbeKey);
+    filter.pressOnly = true;
+    filter.needCodepoint = false;
+    listener_.setFilter(std::move(filter));
+    if (!listener_.startWithEvents(
+            [this](const Listener::Event &ev) { onEvent(ev); }))
+      return false;
+    if (!sender_.waitUntilReady(2000))
+      return false;
+    // The listener may only pick up a new virtual device after it is
+    // created; wait until one probe makes the round trip.
+    for (int attempt = 0; attempt < 20; ++attempt) {
+      const uint64_t before = seen();
+      sender_.tap(KeyWithModifier(kProbeKey));
+      if (waitForCount(before + 1, std::chrono::milliseconds(100)))
+        return true;
+    }
+    return false;
+  }
+
+  Sender &sender() { return sender_; }
+
+  uint64_t seen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seen_;
+  }
+
+  /// Wait until @p count presses have been seen; false on timeout.
+  bool waitForCount(uint64_t count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&] { return seen_ >= count; });
+  }
+
+  /// Dispatch time of the last press seen.
+  uint64_t lastTimestampNs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastNs_;
+  }
+
+private:
+  void onEvent(const Listener::Event &ev) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++seen_;
+      lastNs_ = ev.timestampNs;
+    }
+    cv_.notify_one();
+  }
+
+  Listener listener_;
+  Sender sender_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  uint64_t seen_{0};
+  uint64_t lastNs_{0};
+};
+
+// Started once and shared by both benchmarks.
+Loopback *loopback(benchmark::State &state) {
+  if (axidev::io::bench::skipUnlessInjecting(state))
+    return nullptr;
+  static std::unique_ptr<Loopback> shared = [] {
+    auto lb = std::make_unique<Loopback>();
+    return lb->start() ? std::move(lb) : nullptr;
+  }();
+  if (!shared)
+    state.SkipWithError("Sender and Listener could not be looped back "
+                        "(missing permissions or backend support)");
+  return shared.get();
+}
+
+// One tap at a time: inject-to-callback latency.
+void BM_LoopbackLatency(benchmark::State &state) {
+  Loopback *lb = loopback(state);
+  if (!lb)
+    return;
+  std::vector<uint64_t> samples;
+  samples.reserve(static_cast<size_t>(state.max_iterations));
+  for (auto _ : state) {
+    const uint64_t target = lb->seen() + 1;
+    const uint64_t sentNs = nowNs();
+    lb->sender().tap(KeyWithModifier(kProbeKey));
+    if (!lb->waitForCount(target, std::chrono::seconds(1))) {
+      state.SkipWithError("listener did not observe the injected key");
+      break;
+    }
+    samples.push_back(lb->lastTimestampNs() - sentNs);
+  }
+  state.counters["events_per_s"] =
+      benchmark::Counter(static_cast<double>(samples.size()),
+                         benchmark::Counter::kIsRate);
+  axidev::io::bench::reportLatency(state, samples);
+}
+BENCHMARK(BM_LoopbackLatency)->UseRealTime()->Iterations(2000);
+
+// Bursts of range(0) taps in one sendSequence(): sustained throughput.
+void BM_LoopbackThroughput(benchmark::State &state) {
+  Loopback *lb = loopback(state);
+  if (!lb)
+    return;
+  std::vector<Sender::KeyEvent> burst;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    burst.push_back({kProbeKey, true, 0});
+    burst.push_back({kProbeKey, false, 0});
+  }
+  uint64_t delivered = 0;
+  for (auto _ : state) {
+    const uint64_t target = lb->seen() + static_cast<uint64_t>(state.range(0));
+    lb->sender().sendSequence(burst);
+    if (!lb->waitForCount(target, std::chrono::seconds(2))) {
+      state.SkipWithError("listener dropped injected keys");
+      break;
+    }
+    delivered += static_cast<uint64_t>(state.range(0));
+  }
+  state.counters["events_per_s"] = benchmark::Counter(
+      static_cast<double>(delivered), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_LoopbackThroughput)->Arg(64)->UseRealTime();
+
+} // namespace
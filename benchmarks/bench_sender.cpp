@@ -0,0 +1,92 @@
+/**
+ * @file bench_sender.cpp
+ * @brief Benchmarks for the Sender emit path (uinput on Linux).
+ *
+ * These inject real events; see `injectEnabled()`.
+ */
+
+#include "bench_common.hpp"
+
+#include <vector>
+
+#include <axidev-io/keyboard/sender.hpp>
+
+using namespace axidev::io::keyboard;
+using axidev::io::bench::kProbeKey;
+
+namespace {
+
+// Returns a ready Sender, or nullptr after marking @p state skipped.
+Sender *readySender(benchmark::State &state) {
+  if (axidev::io::bench::skipUnlessInjecting(state))
+    return nullptr;
+  static Sender sender;
+  if (!sender.waitUntilReady(2000)) {
+    state.SkipWithError("Sender backend is not ready");
+    return nullptr;
+  }
+  return &sender;
+}
+
+void BM_SenderTap(benchmark::State &state) {
+  Sender *sender = readySender(state);
+  if (!sender)
+    return;
+  for (auto _ : state) {
+    if (!sender->tap(KeyWithModifier(kProbeKey))) {
+      state.SkipWithError("tap() failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SenderTap)->UseRealTime();
+
+// One sendSequence() of range(0) taps.
+void BM_SenderSequence(benchmark::State &state) {
+  Sender *sender = readySender(state);
+  if (!sender)
+    return;
+  std::vector<Sender::KeyEvent> events;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    events.push_back({kProbeKey, true, 0});
+    events.push_back({kProbeKey, false, 0});
+  }
+  for (auto _ : state) {
+    if (!sender->sendSequence(events)) {
+      state.SkipWithError("sendSequence() failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_SenderSequence)->Arg(16)->Arg(256)->UseRealTime();
+
+// The same taps precompiled and replayed.
+void BM_SenderReplay(benchmark::State &state) {
+  Sender *sender = readySender(state);
+  if (!sender)
+    return;
+  std::vector<Sender::KeyEvent> events;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    events.push_back({kProbeKey, true, 0});
+    events.push_back({kProbeKey, false, 0});
+  }
+  const CompiledSequence compiled = sender->compile(events);
+  if (!compiled.valid()) {
+    state.SkipWithError("compile() failed");
+    return;
+  }
+  for (auto _ : state) {
+    if (!sender->replay(compiled)) {
+      state.SkipWithError("replay() failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_SenderReplay)->Arg(16)->Arg(256)->UseRealTime();
+
+} // namespace
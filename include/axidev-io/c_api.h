@@ -99,9 +99,18 @@ extern "C" {
  * keyboard::Sender)
  * - `axidev_io_keyboard_listener_t`: Global keyboard event monitoring (wraps
  * keyboard::Listener)
+ * - `axidev_io_keyboard_compiled_t`: Pre-resolved, replayable event sequence
+ * (wraps keyboard::CompiledSequence)
+ * - `axidev_io_keyboard_trace_recorder_t`: Writes listener events to a trace
+ * file (wraps keyboard::TraceRecorder)
+ * - `axidev_io_keyboard_trace_player_t`: Replays a trace file through a sender
+ * (wraps keyboard::TracePlayer)
  */
 typedef void *axidev_io_keyboard_sender_t;
 typedef void *axidev_io_keyboard_listener_t;
+typedef void *axidev_io_keyboard_compiled_t;
+typedef void *axidev_io_keyboard_trace_recorder_t;
+typedef void *axidev_io_keyboard_trace_player_t;
 
 /**
  * @brief Primitive types used for keys and modifiers in the C API.
@@ -189,6 +198,184 @@ typedef void (*axidev_io_keyboard_listener_cb)(
     uint32_t codepoint, axidev_io_keyboard_key_with_modifier_t key_mod,
     bool pressed, void *user_data);
 
+/**
+ * @struct axidev_io_keyboard_event_t
+ * @brief A key event drained from a listener started in queued mode
+ * (mirrors axidev::io::keyboard::Listener::Event).
+ *
+ * @var axidev_io_keyboard_event_t::codepoint Unicode codepoint produced by
+ * the event (0 if none).
+ * @var axidev_io_keyboard_event_t::key_mod Logical key and modifier state.
+ * @var axidev_io_keyboard_event_t::pressed True for key press, false for
+ * release.
+ * @var axidev_io_keyboard_event_t::timestamp_ns Monotonic time at which the
+ * event was handed to the callback or queue, in nanoseconds.
+ * @var axidev_io_keyboard_event_t::os_timestamp_ns Time the OS stamped the
+ * event, on the same clock as `timestamp_ns`; 0 if unknown.
+ * @var axidev_io_keyboard_event_t::device_id Keyboard that produced the
+ * event, numbered from 1 per listening session on Linux; 0 on backends that
+ * cannot tell keyboards apart.
+ */
+typedef struct axidev_io_keyboard_event_t {
+  uint32_t codepoint;
+  axidev_io_keyboard_key_with_modifier_t key_mod;
+  bool pressed;
+  uint64_t timestamp_ns;
+  uint64_t os_timestamp_ns;
+  uint32_t device_id;
+} axidev_io_keyboard_event_t;
+
+/**
+ * @typedef axidev_io_keyboard_listener_event_cb
+ * @brief Keyboard listener callback receiving the whole event, timestamps
+ * included (see `axidev_io_keyboard_listener_start_with_events`).
+ *
+ * @param event The event; only valid for the duration of the call.
+ * @param user_data Opaque pointer provided by the caller.
+ */
+typedef void (*axidev_io_keyboard_listener_event_cb)(
+    const axidev_io_keyboard_event_t *event, void *user_data);
+
+/**
+ * @typedef axidev_io_keyboard_listener_batch_cb
+ * @brief Keyboard listener callback receiving an array of events (see
+ * `axidev_io_keyboard_listener_start_batched`).
+ *
+ * @param events Events in arrival order; only valid for the duration of the
+ * call.
+ * @param count Number of entries in @p events (at least 1).
+ * @param user_data Opaque pointer provided by the caller.
+ */
+typedef void (*axidev_io_keyboard_listener_batch_cb)(
+    const axidev_io_keyboard_event_t *events, size_t count, void *user_data);
+
+/**
+ * @brief Number of buckets in
+ * `axidev_io_keyboard_listener_stats_t::callback_time_histogram`.
+ */
+#define AXIDEV_IO_LISTENER_HISTOGRAM_BUCKETS 16
+
+/**
+ * @struct axidev_io_keyboard_listener_stats_t
+ * @brief Listener event counters (mirrors
+ * axidev::io::keyboard::Listener::Stats).
+ *
+ * @var axidev_io_keyboard_listener_stats_t::events_seen Key events received
+ * from the OS.
+ * @var axidev_io_keyboard_listener_stats_t::events_dropped Events not
+ * delivered (no callback, or the queue was full).
+ * @var axidev_io_keyboard_listener_stats_t::events_filtered Events skipped
+ * by the listener filter (see `axidev_io_keyboard_listener_set_filter`).
+ * @var axidev_io_keyboard_listener_stats_t::callback_time_max_ns Longest
+ * single callback, in nanoseconds.
+ * @var axidev_io_keyboard_listener_stats_t::callback_time_histogram Callback
+ * durations: bucket 0 counts calls under 1 us, bucket i those in
+ * [2^(i-1), 2^i) us, and the last bucket everything longer.
+ */
+typedef struct axidev_io_keyboard_listener_stats_t {
+  uint64_t events_seen;
+  uint64_t events_dropped;
+  uint64_t events_filtered;
+  uint64_t callback_time_max_ns;
+  uint64_t callback_time_histogram[AXIDEV_IO_LISTENER_HISTOGRAM_BUCKETS];
+} axidev_io_keyboard_listener_stats_t;
+
+/**
+ * @struct axidev_io_keyboard_listener_filter_t
+ * @brief Keys a listener reports (mirrors
+ * axidev::io::keyboard::Listener::Filter).
+ *
+ * With no keys and no chords every key is reported.
+ *
+ * @var axidev_io_keyboard_listener_filter_t::keys Keys reported whatever
+ * modifiers are held (may be NULL when `key_count` is 0).
+ * @var axidev_io_keyboard_listener_filter_t::chords Keys reported only with
+ * exactly these Shift/Ctrl/Alt/Super modifiers held (may be NULL when
+ * `chord_count` is 0).
+ * @var axidev_io_keyboard_listener_filter_t::press_only Skip key releases.
+ * @var axidev_io_keyboard_listener_filter_t::need_codepoint When false, the
+ * codepoint is not computed and events carry 0.
+ */
+typedef struct axidev_io_keyboard_listener_filter_t {
+  const axidev_io_keyboard_key_t *keys;
+  size_t key_count;
+  const axidev_io_keyboard_key_with_modifier_t *chords;
+  size_t chord_count;
+  bool press_only;
+  bool need_codepoint;
+} axidev_io_keyboard_listener_filter_t;
+
+/**
+ * @struct axidev_io_keyboard_listener_sources_t
+ * @brief Seats and devices a listener reads (mirrors
+ * axidev::io::keyboard::Listener::Sources); Linux only.
+ *
+ * With no seats and no device paths the listener reads "seat0".
+ *
+ * @var axidev_io_keyboard_listener_sources_t::seats udev seat names (may be
+ * NULL when `seat_count` is 0).
+ * @var axidev_io_keyboard_listener_sources_t::device_paths Device nodes such
+ * as "/dev/input/event3" (may be NULL when `device_path_count` is 0).
+ */
+typedef struct axidev_io_keyboard_listener_sources_t {
+  const char *const *seats;
+  size_t seat_count;
+  const char *const *device_paths;
+  size_t device_path_count;
+} axidev_io_keyboard_listener_sources_t;
+
+/**
+ * @struct axidev_io_keyboard_round_trip_t
+ * @brief Result of `axidev_io_keyboard_measure_round_trip` (mirrors
+ * axidev::io::keyboard::RoundTripHistogram).
+ *
+ * Latencies are in nanoseconds, from just before a marker is sent to its
+ * delivery by the listener, and are 0 when no probe arrived.
+ *
+ * @var axidev_io_keyboard_round_trip_t::sent Probes sent.
+ * @var axidev_io_keyboard_round_trip_t::received Probes that arrived.
+ * @var axidev_io_keyboard_round_trip_t::lost Probes that timed out.
+ * @var axidev_io_keyboard_round_trip_t::histogram Arrived probes per bucket,
+ * with the layout of
+ * `axidev_io_keyboard_listener_stats_t::callback_time_histogram`.
+ */
+typedef struct axidev_io_keyboard_round_trip_t {
+  uint64_t sent;
+  uint64_t received;
+  uint64_t lost;
+  uint64_t min_ns;
+  uint64_t mean_ns;
+  uint64_t p50_ns;
+  uint64_t p90_ns;
+  uint64_t p99_ns;
+  uint64_t max_ns;
+  uint64_t histogram[AXIDEV_IO_LISTENER_HISTOGRAM_BUCKETS];
+} axidev_io_keyboard_round_trip_t;
+
+/**
+ * @struct axidev_io_keyboard_key_event_t
+ * @brief A raw key event submitted through
+ * `axidev_io_keyboard_sender_send_sequence` (mirrors
+ * axidev::io::keyboard::Sender::KeyEvent).
+ *
+ * @var axidev_io_keyboard_key_event_t::key Logical key to press or release.
+ * @var axidev_io_keyboard_key_event_t::down True for key press, false for
+ * release.
+ * @var axidev_io_keyboard_key_event_t::delay_us Pause after this event, in
+ * microseconds.
+ */
+typedef struct axidev_io_keyboard_key_event_t {
+  axidev_io_keyboard_key_t key;
+  bool down;
+  uint32_t delay_us;
+} axidev_io_keyboard_key_event_t;
+
+/**
+ * @brief Timeout value for `axidev_io_keyboard_listener_wait` and
+ * `axidev_io_keyboard_sender_wait` meaning "wait indefinitely".
+ */
+#define AXIDEV_IO_WAIT_INFINITE UINT32_MAX
+
 /** @name Keyboard Sender (keyboard input injection)
  * @brief Functions to create and operate a keyboard Sender for injecting
  * keyboard input.
@@ -220,6 +407,21 @@ axidev_io_keyboard_sender_destroy(axidev_io_keyboard_sender_t sender);
 AXIDEV_IO_API bool
 axidev_io_keyboard_sender_is_ready(axidev_io_keyboard_sender_t sender);
 
+/**
+ * @brief Wait until injected events will be seen by the rest of the system.
+ *
+ * Creating a sender does not block; on Linux/uinput the first injection
+ * waits (briefly) for udev to announce the virtual device. Call this to take
+ * that wait up front.
+ *
+ * @param sender Sender handle.
+ * @param timeout_ms Longest time to wait, in milliseconds.
+ * @return true if the backend is ready; false on timeout or error.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait_until_ready(axidev_io_keyboard_sender_t sender,
+                                           uint32_t timeout_ms);
+
 /**
  * @brief Get the active backend type used by the sender.
  * @param sender Sender handle.
@@ -291,6 +493,108 @@ AXIDEV_IO_API bool
 axidev_io_keyboard_sender_tap(axidev_io_keyboard_sender_t sender,
                               axidev_io_keyboard_key_with_modifier_t key_mod);
 
+/**
+ * @brief Send a sequence of raw key events in one submission.
+ *
+ * Every key is resolved before anything is sent, so an unmapped key fails
+ * the call without injecting a partial sequence. The key delay does not
+ * apply; only the per-event `delay_us` pauses split the submission.
+ *
+ * @param sender Sender handle.
+ * @param events Events to send, in order (must not be NULL if count > 0).
+ * @param count Number of entries in @p events.
+ * @return true when every event was submitted; false on failure.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_sender_send_sequence(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_event_t *events, size_t count);
+
+/**
+ * @brief Tap several keys, each with its modifiers, in one call.
+ *
+ * Equivalent to calling `axidev_io_keyboard_sender_tap` for each entry, but
+ * crosses the C boundary once. Stops at the first key that fails.
+ *
+ * @param sender Sender handle.
+ * @param keys Keys to tap, in order (must not be NULL if count > 0).
+ * @param count Number of entries in @p keys.
+ * @return Number of keys tapped; less than @p count on failure (see last
+ * error).
+ */
+AXIDEV_IO_API size_t axidev_io_keyboard_sender_tap_keys(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_with_modifier_t *keys, size_t count);
+
+/**
+ * @brief Compile a sequence of raw key events for repeated replay.
+ *
+ * Keys are resolved against the current layout once, up front. The returned
+ * handle must be released with `axidev_io_keyboard_compiled_destroy`.
+ *
+ * @param sender Sender handle.
+ * @param events Events to compile, in order (must not be NULL if count > 0).
+ * @param count Number of entries in @p events.
+ * @return Compiled sequence handle, or NULL on failure (see last error).
+ */
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_sequence(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_event_t *events, size_t count);
+
+/**
+ * @brief Compile Unicode text for repeated replay.
+ *
+ * @param sender Sender handle.
+ * @param codepoints UTF-32 code points (must not be NULL if count > 0).
+ * @param count Number of entries in @p codepoints.
+ * @return Compiled sequence handle, or NULL on failure (see last error).
+ */
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_text_utf32(axidev_io_keyboard_sender_t sender,
+                                             const uint32_t *codepoints,
+                                             size_t count);
+
+/**
+ * @brief Compile UTF-8 text for repeated replay.
+ *
+ * @param sender Sender handle.
+ * @param utf8_text Null-terminated UTF-8 string to compile.
+ * @return Compiled sequence handle, or NULL on failure, including ill-formed
+ * UTF-8 (see last error).
+ */
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_text_utf8(axidev_io_keyboard_sender_t sender,
+                                            const char *utf8_text);
+
+/**
+ * @brief Replay a compiled sequence.
+ *
+ * Fails if the keyboard layout changed since the sequence was compiled;
+ * compile it again in that case.
+ *
+ * @param sender Sender handle.
+ * @param compiled Compiled sequence handle.
+ * @return true when every event was submitted; false on failure.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_replay(axidev_io_keyboard_sender_t sender,
+                                 axidev_io_keyboard_compiled_t compiled);
+
+/**
+ * @brief Check whether a compiled sequence is still replayable.
+ * @param compiled Compiled sequence handle.
+ * @return true if replay can succeed; false if NULL or stale.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_compiled_is_valid(axidev_io_keyboard_compiled_t compiled);
+
+/**
+ * @brief Destroy a compiled sequence.
+ * @param compiled Compiled sequence handle (safe to call with NULL).
+ */
+AXIDEV_IO_API void
+axidev_io_keyboard_compiled_destroy(axidev_io_keyboard_compiled_t compiled);
+
 /**
  * @brief Get the currently active modifiers.
  * @param sender Sender handle.
@@ -332,12 +636,31 @@ axidev_io_keyboard_sender_release_all_modifiers(axidev_io_keyboard_sender_t send
  * backends).
  * @param sender Sender handle.
  * @param utf8_text Null-terminated UTF-8 string to inject.
- * @return true on success; false if not supported or on failure.
+ * @return true on success; false if not supported, if the text is not
+ * well-formed UTF-8 (nothing is typed), or on failure.
  */
 AXIDEV_IO_API bool
 axidev_io_keyboard_sender_type_text_utf8(axidev_io_keyboard_sender_t sender,
                                        const char *utf8_text);
 
+/**
+ * @brief Inject @p length bytes of UTF-8 text.
+ *
+ * Same as `axidev_io_keyboard_sender_type_text_utf8`, for callers that hold
+ * a length-delimited buffer: no terminator is needed and embedded NUL bytes
+ * are typed like any other character.
+ *
+ * @param sender Sender handle.
+ * @param utf8_text UTF-8 bytes (may be NULL when @p length is 0).
+ * @param length Number of bytes in @p utf8_text.
+ * @return true on success; false if not supported, if the text is not
+ * well-formed UTF-8 (nothing is typed), or on failure.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_type_text_utf8_n(axidev_io_keyboard_sender_t sender,
+                                         const char *utf8_text,
+                                         size_t length);
+
 /**
  * @brief Inject a single Unicode codepoint.
  * @param sender Sender handle.
@@ -364,6 +687,157 @@ axidev_io_keyboard_sender_flush(axidev_io_keyboard_sender_t sender);
 AXIDEV_IO_API void
 axidev_io_keyboard_sender_set_key_delay(axidev_io_keyboard_sender_t sender,
                                       uint32_t delay_us);
+
+/**
+ * @brief Spin the last @p spin_us of each key delay instead of sleeping,
+ * for accuracy on coarse timers (0, the default, always sleeps). The spin is
+ * capped to an eighth of each delay.
+ * @param sender Sender handle.
+ * @param spin_us Spin in microseconds.
+ */
+AXIDEV_IO_API void axidev_io_keyboard_sender_set_key_delay_spin(
+    axidev_io_keyboard_sender_t sender, uint32_t spin_us);
+
+/**
+ * @brief Set how many characters text injection submits per batch.
+ *
+ * Only the Windows backend batches text (one `SendInput` call per batch);
+ * the other backends ignore the setting.
+ *
+ * @param sender Sender handle.
+ * @param characters Characters per batch (0 restores the default).
+ */
+AXIDEV_IO_API void axidev_io_keyboard_sender_set_text_batch_size(
+    axidev_io_keyboard_sender_t sender, size_t characters);
+
+/**
+ * @brief Number of characters the last text injection actually delivered.
+ *
+ * After a failed `axidev_io_keyboard_sender_type_text_utf8` this tells how
+ * far typing got.
+ *
+ * @param sender Sender handle.
+ * @return Characters (code points) injected, or 0 on error.
+ */
+AXIDEV_IO_API size_t
+axidev_io_keyboard_sender_last_typed_count(axidev_io_keyboard_sender_t sender);
+
+/**
+ * @brief Start a background injection thread for the sender.
+ *
+ * While running, the `..._async` functions copy the command into a
+ * fixed-capacity lock-free queue and return a ticket immediately; the
+ * injection thread executes queued commands in order, paced by the key delay.
+ * The `..._async` functions and `axidev_io_keyboard_sender_cancel_pending`
+ * must be called from one thread at a time, and the synchronous injection
+ * functions must not be used until `axidev_io_keyboard_sender_stop_async`
+ * returns.
+ *
+ * @param sender Sender handle.
+ * @param capacity Queue capacity in commands (rounded up to a power of two);
+ * pass 0 for the library default.
+ * @return true on success; false if already running or on failure.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_start_async(axidev_io_keyboard_sender_t sender,
+                                      size_t capacity);
+
+/**
+ * @brief Execute every queued command, then stop the injection thread.
+ * @param sender Sender handle.
+ */
+AXIDEV_IO_API void
+axidev_io_keyboard_sender_stop_async(axidev_io_keyboard_sender_t sender);
+
+/**
+ * @brief Queue a tap.
+ * @param sender Sender handle.
+ * @param key_mod Key and modifiers to tap.
+ * @return Ticket identifying the command, or 0 if it was not queued (async
+ * mode off or queue full).
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_tap_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod);
+
+/**
+ * @brief Queue a key press.
+ * @param sender Sender handle.
+ * @param key_mod Key and modifiers to press.
+ * @return Ticket identifying the command, or 0 if it was not queued.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_key_down_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod);
+
+/**
+ * @brief Queue a key release.
+ * @param sender Sender handle.
+ * @param key_mod Key and modifiers to release.
+ * @return Ticket identifying the command, or 0 if it was not queued.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_key_up_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod);
+
+/**
+ * @brief Queue UTF-8 text for injection. The text is copied.
+ * @param sender Sender handle.
+ * @param utf8_text Null-terminated UTF-8 string to inject.
+ * @return Ticket identifying the command, or 0 if it was not queued.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_type_text_utf8_async(
+    axidev_io_keyboard_sender_t sender, const char *utf8_text);
+
+/**
+ * @brief Queue @p length bytes of UTF-8 text for injection. The text is
+ * copied.
+ * @param sender Sender handle.
+ * @param utf8_text UTF-8 bytes (may be NULL when @p length is 0).
+ * @param length Number of bytes in @p utf8_text.
+ * @return Ticket identifying the command, or 0 if it was not queued.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_type_text_utf8_n_async(
+    axidev_io_keyboard_sender_t sender, const char *utf8_text, size_t length);
+
+/**
+ * @brief Block until a queued command has finished.
+ *
+ * Cancelled commands count as finished. May be called from any thread.
+ *
+ * @param sender Sender handle.
+ * @param ticket Ticket returned by an `..._async` function.
+ * @param timeout_ms Timeout in milliseconds, or `AXIDEV_IO_WAIT_INFINITE`.
+ * @return true when the command has finished; false on timeout or error.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait(axidev_io_keyboard_sender_t sender,
+                               uint64_t ticket, uint32_t timeout_ms);
+
+/**
+ * @brief Block until every command queued so far has finished.
+ * @param sender Sender handle.
+ * @param timeout_ms Timeout in milliseconds, or `AXIDEV_IO_WAIT_INFINITE`.
+ * @return true once idle; false on timeout or error.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait_idle(axidev_io_keyboard_sender_t sender,
+                                    uint32_t timeout_ms);
+
+/**
+ * @brief Discard every queued command that has not started yet.
+ * @param sender Sender handle.
+ */
+AXIDEV_IO_API void
+axidev_io_keyboard_sender_cancel_pending(axidev_io_keyboard_sender_t sender);
+
+/**
+ * @brief Number of queued commands that reported failure.
+ * @param sender Sender handle.
+ * @return Failure count since the injection thread was started.
+ */
+AXIDEV_IO_API uint64_t
+axidev_io_keyboard_sender_async_failures(axidev_io_keyboard_sender_t sender);
 /** @} */ /* end of Keyboard Sender group */
 
 /** @name Keyboard Listener (global keyboard event monitoring)
@@ -383,6 +857,11 @@ AXIDEV_IO_API axidev_io_keyboard_listener_t axidev_io_keyboard_listener_create(v
 
 /**
  * @brief Destroy a Listener instance.
+ *
+ * Must not be called from the callback of
+ * `axidev_io_keyboard_listener_start_batched`; such a call sets a last error
+ * and does nothing.
+ *
  * @param listener Listener handle to destroy (safe to call with NULL).
  */
 AXIDEV_IO_API void
@@ -402,6 +881,18 @@ axidev_io_keyboard_listener_start(axidev_io_keyboard_listener_t listener,
                                 axidev_io_keyboard_listener_cb cb,
                                 void *user_data);
 
+/**
+ * @brief Start the listener with a callback that receives the whole event,
+ * including its OS and dispatch timestamps.
+ * @param listener Listener handle.
+ * @param cb Callback invoked for each observed event.
+ * @param user_data Opaque pointer forwarded to the callback.
+ * @return true on success; false if the listener could not be started.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_listener_start_with_events(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_event_cb cb, void *user_data);
+
 /**
  * @brief Stop the listener. Safe to call from any thread; a no-op if not
  * running.
@@ -417,8 +908,284 @@ axidev_io_keyboard_listener_stop(axidev_io_keyboard_listener_t listener);
  */
 AXIDEV_IO_API bool
 axidev_io_keyboard_listener_is_listening(axidev_io_keyboard_listener_t listener);
+
+/**
+ * @brief Start the listener in queued mode.
+ *
+ * No callback runs on the listener's internal thread: events are pushed into
+ * a fixed-capacity lock-free queue and drained with
+ * `axidev_io_keyboard_listener_poll`. When the queue is full new events are
+ * dropped and counted (see `axidev_io_keyboard_listener_dropped_events`).
+ *
+ * @param listener Listener handle.
+ * @param capacity Queue capacity in events (rounded up to a power of two);
+ * pass 0 for the library default.
+ * @return true on success; false if the listener could not be started.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_start_queued(axidev_io_keyboard_listener_t listener,
+                                         size_t capacity);
+
+/**
+ * @brief Start the listener and deliver events in arrays.
+ *
+ * Runs the listener in queued mode and starts a dispatcher thread that
+ * drains the queue and calls @p cb with everything pending, up to
+ * @p max_batch events per call. Bindings for managed runtimes pay one
+ * callback crossing per burst instead of one per key. The callback runs on
+ * the dispatcher thread, never on the OS hook thread.
+ *
+ * `axidev_io_keyboard_listener_stop` delivers the events queued so far,
+ * then joins the dispatcher; it may take up to 100 ms. When called from
+ * @p cb it returns at once and the dispatcher exits after the callback.
+ * `axidev_io_keyboard_listener_destroy` is not allowed from @p cb: it fails
+ * with a last error and leaves the listener intact. Do not use
+ * `axidev_io_keyboard_listener_poll` or `_wait` in this mode.
+ *
+ * @param listener Listener handle.
+ * @param cb Callback receiving the events (must not be NULL).
+ * @param user_data Opaque pointer passed back to @p cb.
+ * @param capacity Queue capacity in events; pass 0 for the library default.
+ * @param max_batch Maximum events per callback; pass 0 for the default (64).
+ * @return true on success; false if the listener is already listening or
+ * could not be started.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_listener_start_batched(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_batch_cb cb, void *user_data,
+    size_t capacity, size_t max_batch);
+
+/**
+ * @brief Drain queued events without blocking.
+ *
+ * Must only be called from one thread at a time.
+ *
+ * @param listener Listener handle.
+ * @param out_events Destination array (must not be NULL if max_events > 0).
+ * @param max_events Capacity of @p out_events.
+ * @return Number of events written to @p out_events.
+ */
+AXIDEV_IO_API size_t
+axidev_io_keyboard_listener_poll(axidev_io_keyboard_listener_t listener,
+                                 axidev_io_keyboard_event_t *out_events,
+                                 size_t max_events);
+
+/**
+ * @brief Block until queued events are pending or the timeout expires.
+ *
+ * Call `axidev_io_keyboard_listener_poll` after a successful wait.
+ *
+ * @param listener Listener handle.
+ * @param timeout_ms Timeout in milliseconds, or `AXIDEV_IO_WAIT_INFINITE`.
+ * @return true when events are pending; false on timeout or error.
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_wait(axidev_io_keyboard_listener_t listener,
+                                 uint32_t timeout_ms);
+
+/**
+ * @brief Native handle signaled while queued events are pending.
+ *
+ * A file descriptor on Linux/macOS (poll for readability) or a `HANDLE` on
+ * Windows (wait for the signaled state). Owned by the listener; do not close.
+ *
+ * @param listener Listener handle.
+ * @return The handle, or -1 when the listener is not in queued mode.
+ */
+AXIDEV_IO_API intptr_t
+axidev_io_keyboard_listener_wait_handle(axidev_io_keyboard_listener_t listener);
+
+/**
+ * @brief Number of events dropped because the queue was full.
+ * @param listener Listener handle.
+ * @return Overflow count since the last queued start.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_listener_dropped_events(
+    axidev_io_keyboard_listener_t listener);
+
+/**
+ * @brief Read the listener's event and callback timing counters.
+ * @param listener Listener handle.
+ * @param out_stats Destination (must not be NULL).
+ * @return true on success; false on invalid arguments.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_listener_get_stats(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_stats_t *out_stats);
+
+/**
+ * @brief Zero the counters reported by `axidev_io_keyboard_listener_get_stats`.
+ * @param listener Listener handle.
+ */
+AXIDEV_IO_API void
+axidev_io_keyboard_listener_reset_stats(axidev_io_keyboard_listener_t listener);
+
+/**
+ * @brief Restrict the events reported by the next start.
+ *
+ * Skipped keys are handed back to the OS before any translation and are
+ * counted in `axidev_io_keyboard_listener_stats_t::events_filtered`.
+ *
+ * @param listener Listener handle.
+ * @param filter Filter to apply, copied; NULL reports every key again.
+ * @return true on success; false on invalid arguments or while listening.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_listener_set_filter(
+    axidev_io_keyboard_listener_t listener,
+    const axidev_io_keyboard_listener_filter_t *filter);
+
+/**
+ * @brief Choose the seats and devices read by the next start.
+ *
+ * Each keyboard keeps its own modifier state and is reported in
+ * `axidev_io_keyboard_event_t::device_id`.
+ *
+ * @param listener Listener handle.
+ * @param sources Sources to read, copied; NULL reads "seat0" again.
+ * @return true on success; false on invalid arguments, while listening, or
+ *         for seats or devices on backends other than Linux.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_listener_set_sources(
+    axidev_io_keyboard_listener_t listener,
+    const axidev_io_keyboard_listener_sources_t *sources);
+
+/**
+ * @brief Measure the sender-to-listener input latency on this machine.
+ *
+ * Taps @p count marker keys (F17 to F20) with @p sender and times their
+ * arrival in @p listener, which must not be listening; it is started for
+ * the probe and stopped again. The markers are really typed into the
+ * session.
+ *
+ * @param sender Sender handle.
+ * @param listener Idle listener handle.
+ * @param count Number of timed probes.
+ * @param timeout_ms Wait per probe before it counts as lost.
+ * @param out_result Destination (must not be NULL).
+ * @return true when the probe ran; false on invalid arguments, or when the
+ *         sender is not ready or the listener is busy or cannot start.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_measure_round_trip(
+    axidev_io_keyboard_sender_t sender, axidev_io_keyboard_listener_t listener,
+    uint32_t count, uint32_t timeout_ms,
+    axidev_io_keyboard_round_trip_t *out_result);
 /** @} */ /* end of Listener group */
 
+/** @name Keystroke traces (record and replay typing sessions)
+ *
+ * Record listener events to a compact binary trace file and replay it through
+ * a sender. See `axidev-io/keyboard/trace.hpp` for the format and behavior.
+ * @{
+ */
+
+/**
+ * @brief Start a new trace at @p path, replacing any existing file.
+ *
+ * The time of this call is the start of the recording. The returned handle
+ * must be released with `axidev_io_keyboard_trace_recorder_destroy`.
+ *
+ * @param path File to create (must not be NULL).
+ * @return Recorder handle, or NULL on failure (see last error).
+ */
+AXIDEV_IO_API axidev_io_keyboard_trace_recorder_t
+axidev_io_keyboard_trace_recorder_create(const char *path);
+
+/**
+ * @brief Append one listener event to the trace.
+ *
+ * Does not allocate; can be called from the listener event callback. An
+ * event with `timestamp_ns` 0 is stamped now.
+ *
+ * @param recorder Recorder handle.
+ * @param event Event to record (must not be NULL).
+ * @return true on success; false on invalid arguments or a write error.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_trace_recorder_record(
+    axidev_io_keyboard_trace_recorder_t recorder,
+    const axidev_io_keyboard_event_t *event);
+
+/**
+ * @brief Write the buffered events to the file.
+ * @param recorder Recorder handle.
+ * @return true on success.
+ */
+AXIDEV_IO_API bool axidev_io_keyboard_trace_recorder_flush(
+    axidev_io_keyboard_trace_recorder_t recorder);
+
+/**
+ * @brief Number of events recorded so far.
+ * @param recorder Recorder handle.
+ * @return Event count, or 0 if @p recorder is NULL.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_recorder_recorded_count(
+    axidev_io_keyboard_trace_recorder_t recorder);
+
+/**
+ * @brief Flush and close the trace, then destroy the recorder.
+ * @param recorder Recorder handle (safe to call with NULL).
+ */
+AXIDEV_IO_API void axidev_io_keyboard_trace_recorder_destroy(
+    axidev_io_keyboard_trace_recorder_t recorder);
+
+/**
+ * @brief Map the trace at @p path for playback.
+ *
+ * The returned handle must be released with
+ * `axidev_io_keyboard_trace_player_destroy`.
+ *
+ * @param path Trace file (must not be NULL).
+ * @return Player handle, or NULL when the file cannot be mapped or is not a
+ *         trace (see last error).
+ */
+AXIDEV_IO_API axidev_io_keyboard_trace_player_t
+axidev_io_keyboard_trace_player_open(const char *path);
+
+/**
+ * @brief Replay the whole trace with @p sender; blocks until done.
+ *
+ * Unknown keys and keys @p sender cannot map on the current layout are
+ * skipped.
+ *
+ * @param player Player handle.
+ * @param sender Sender handle.
+ * @param speed Playback rate: 1 for the recorded pace, 2 for twice as fast,
+ *        0 or less for as fast as possible.
+ * @param max_pause_us Upper bound on any single pause after scaling, in
+ *        microseconds; 0 keeps the pauses as recorded.
+ * @return true when the trace was played; false on invalid arguments, when
+ *         the sender is not ready, or when sending a batch failed (playback
+ *         stops there).
+ */
+AXIDEV_IO_API bool
+axidev_io_keyboard_trace_player_play(axidev_io_keyboard_trace_player_t player,
+                                     axidev_io_keyboard_sender_t sender,
+                                     double speed, uint32_t max_pause_us);
+
+/**
+ * @brief Number of events sent by the last play.
+ * @param player Player handle.
+ * @return Event count, or 0 if @p player is NULL.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_player_played_count(
+    axidev_io_keyboard_trace_player_t player);
+
+/**
+ * @brief Number of events the last play skipped.
+ * @param player Player handle.
+ * @return Event count, or 0 if @p player is NULL.
+ */
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_player_skipped_count(
+    axidev_io_keyboard_trace_player_t player);
+
+/**
+ * @brief Unmap the trace and destroy the player.
+ * @param player Player handle (safe to call with NULL).
+ */
+AXIDEV_IO_API void
+axidev_io_keyboard_trace_player_destroy(axidev_io_keyboard_trace_player_t player);
+
+/** @} */ /* end of Keystroke traces group */
+
 /* ---------------- Utilities / Conversions ---------------- */
 
 /**
@@ -429,6 +1196,42 @@ axidev_io_keyboard_listener_is_listening(axidev_io_keyboard_listener_t listener)
  */
 AXIDEV_IO_API char *axidev_io_keyboard_key_to_string(axidev_io_keyboard_key_t key);
 
+/**
+ * @brief Write the canonical name of a Key into a caller-provided buffer.
+ *
+ * Allocation-free alternative to `axidev_io_keyboard_key_to_string` with
+ * `snprintf` semantics: at most `buf_size - 1` characters are written and the
+ * result is always null-terminated when `buf_size > 0`.
+ *
+ * @param key Key to convert.
+ * @param buf Destination buffer (may be NULL when `buf_size` is 0).
+ * @param buf_size Size of `buf` in bytes.
+ * @return size_t Length of the full name excluding the terminator; a value
+ * `>= buf_size` means the output was truncated. Returns 0 if `buf` is NULL
+ * and `buf_size > 0`.
+ */
+AXIDEV_IO_API size_t axidev_io_keyboard_key_to_string_buf(
+    axidev_io_keyboard_key_t key, char *buf, size_t buf_size);
+
+/**
+ * @brief Write the names of several keys into one caller-provided buffer.
+ *
+ * The names are joined with @p separator; pass `'\0'` to get
+ * NUL-separated names. Same `snprintf` semantics as
+ * `axidev_io_keyboard_key_to_string_buf`.
+ *
+ * @param keys Keys to convert (must not be NULL if count > 0).
+ * @param count Number of entries in @p keys.
+ * @param separator Byte written between two names.
+ * @param buf Destination buffer (may be NULL when `buf_size` is 0).
+ * @param buf_size Size of `buf` in bytes.
+ * @return size_t Length of the full output excluding the terminator; a value
+ * `>= buf_size` means the output was truncated.
+ */
+AXIDEV_IO_API size_t axidev_io_keyboard_keys_to_string_buf(
+    const axidev_io_keyboard_key_t *keys, size_t count, char separator,
+    char *buf, size_t buf_size);
+
 /**
  * @brief Parse a textual key name to a `axidev_io_keyboard_key_t` value.
  * @param name Null-terminated string (case-insensitive; accepts common aliases
@@ -451,6 +1254,23 @@ AXIDEV_IO_API axidev_io_keyboard_key_t axidev_io_keyboard_string_to_key(const ch
 AXIDEV_IO_API char *axidev_io_keyboard_key_to_string_with_modifier(
     axidev_io_keyboard_key_with_modifier_t key_mod);
 
+/**
+ * @brief Write a KeyWithModifier string (e.g., "Shift+A") into a
+ * caller-provided buffer.
+ *
+ * Allocation-free alternative to
+ * `axidev_io_keyboard_key_to_string_with_modifier`, with the same truncation
+ * rules and return value as `axidev_io_keyboard_key_to_string_buf`.
+ *
+ * @param key_mod Key and modifier state to convert.
+ * @param buf Destination buffer (may be NULL when `buf_size` is 0).
+ * @param buf_size Size of `buf` in bytes.
+ * @return size_t Length of the full string excluding the terminator.
+ */
+AXIDEV_IO_API size_t axidev_io_keyboard_key_to_string_with_modifier_buf(
+    axidev_io_keyboard_key_with_modifier_t key_mod, char *buf,
+    size_t buf_size);
+
 /**
  * @brief Parse a key combo string (e.g., "Shift+A", "Ctrl+Shift+C") into
  * a KeyWithModifier.
@@ -496,8 +1316,9 @@ AXIDEV_IO_API void axidev_io_free_string(char *s);
 /** @name Logging
  * @brief Functions to control and use the internal logging system.
  *
- * The library includes a lightweight header-only logging utility. These
- * functions allow C API users to control logging behavior at runtime.
+ * The library includes a lightweight logging utility. These functions allow
+ * C API users to control logging behavior at runtime, route records to their
+ * own sink and move output to a background writer thread.
  * @{
  */
 
@@ -561,6 +1382,60 @@ AXIDEV_IO_API void axidev_io_log_message(axidev_io_log_level_t level,
                                      const char *file, int line,
                                      const char *fmt, ...);
 
+/**
+ * @brief A log record delivered to a sink. Pointers are only valid for the
+ * duration of the sink call.
+ */
+typedef struct {
+  axidev_io_log_level_t level; /**< One of AXIDEV_IO_LOG_LEVEL_* */
+  const char *file;            /**< Trimmed source path */
+  int line;                    /**< Source line */
+  int64_t timestamp_us; /**< Wall-clock time of the log call, Unix epoch */
+  const char *message;  /**< Formatted message without trailing newline */
+} axidev_io_log_record_t;
+
+/**
+ * @brief Sink callback type.
+ *
+ * Never called concurrently. Must not log through axidev-io or change the
+ * sink / async mode.
+ */
+typedef void (*axidev_io_log_sink_cb)(const axidev_io_log_record_t *record,
+                                      void *user_data);
+
+/**
+ * @brief Route log records to a custom sink.
+ *
+ * After this returns the previous sink is no longer called.
+ *
+ * @param sink Callback, or NULL to restore the default stderr output.
+ * @param user_data Opaque pointer passed back to @p sink.
+ */
+AXIDEV_IO_API void axidev_io_log_set_sink(axidev_io_log_sink_cb sink,
+                                          void *user_data);
+
+/**
+ * @brief Deliver log records from a background writer thread.
+ *
+ * The logging thread only formats the message into a bounded lock-free
+ * queue; when the queue is full the record is dropped and counted.
+ *
+ * @param capacity Queue capacity in records; 0 selects the default (1024).
+ * @return true if async mode is active.
+ */
+AXIDEV_IO_API bool axidev_io_log_start_async(size_t capacity);
+
+/**
+ * @brief Flush pending records and return to synchronous logging.
+ */
+AXIDEV_IO_API void axidev_io_log_stop_async(void);
+
+/**
+ * @brief Number of records dropped because the async queue was full.
+ * @return uint64_t Count since process start.
+ */
+AXIDEV_IO_API uint64_t axidev_io_log_dropped_messages(void);
+
 /** @} */ /* end of Logging group */
 
 #ifdef __cplusplus
@@ -26,6 +26,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace axidev {
 namespace io {
@@ -515,12 +516,23 @@ enum class BackendType : uint8_t {
  * @return std::string Canonical name for the key (e.g., "A", "Enter").
  */
 AXIDEV_IO_API std::string keyToString(Key key);
+/**
+ * @brief Allocation-free variant of `keyToString`.
+ * @param key Logical key to convert.
+ * @return std::string_view Canonical name with static storage duration. The
+ * viewed characters are always followed by a null terminator, so `data()` may
+ * be passed to C APIs directly.
+ */
+AXIDEV_IO_API std::string_view keyToStringView(Key key) noexcept;
 /**
  * @brief Parse a textual key name into a Key value.
+ *
+ * Does not allocate; `std::string` and C strings convert implicitly.
+ *
  * @param str Input string (case-insensitive; accepts common aliases).
  * @return Key Parsed key value or Key::Unknown for unrecognized strings.
  */
-AXIDEV_IO_API Key stringToKey(const std::string &str);
+AXIDEV_IO_API Key stringToKey(std::string_view str);
 
 /**
  * @brief Convert a Key with its required modifiers to a human-readable string.
@@ -545,7 +557,7 @@ AXIDEV_IO_API std::string keyToStringWithModifier(Key key, Modifier mods);
  * @param str Input string (case-insensitive; accepts modifier prefixes).
  * @return KeyWithModifier Parsed key and required modifiers.
  */
-AXIDEV_IO_API KeyWithModifier stringToKeyWithModifier(const std::string &str);
+AXIDEV_IO_API KeyWithModifier stringToKeyWithModifier(std::string_view str);
 
 } // namespace keyboard
 } // namespace io
@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file keyboard/hotkey.hpp
+ * @brief Chord and multi-stroke shortcut matching on top of the Listener.
+ *
+ * `HotkeyMatcher` turns the raw stream of Listener events into matched
+ * bindings. Bindings are single chords such as Ctrl+Shift+P or sequences of
+ * chords such as Ctrl+K Ctrl+C. The registered bindings are compiled into a
+ * flat transition table, so each event costs one hash probe and no
+ * allocation, which makes it suitable for running directly on the listener
+ * thread.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * #include <axidev-io/keyboard/hotkey.hpp>
+ * #include <axidev-io/keyboard/listener.hpp>
+ *
+ * axidev::io::keyboard::HotkeyMatcher hotkeys;
+ * hotkeys.add("Ctrl+K Ctrl+C", [](auto) { commentSelection(); });
+ * hotkeys.add("Ctrl+Shift+P", [](auto) { openPalette(); });
+ * hotkeys.compile();
+ *
+ * axidev::io::keyboard::Listener listener;
+ * listener.start([&](char32_t, axidev::io::keyboard::KeyWithModifier keyMod,
+ *                    bool pressed) { hotkeys.feed(keyMod, pressed); });
+ * @endcode
+ */
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include <axidev-io/keyboard/common.hpp>
+#include <axidev-io/keyboard/listener.hpp>
+
+namespace axidev {
+namespace io {
+namespace keyboard {
+
+/**
+ * @class HotkeyMatcher
+ * @brief Matches Listener events against registered chords and sequences.
+ *
+ * A binding is a sequence of one or more strokes. A stroke is a
+ * `KeyWithModifier` compared on its key and on the Shift/Ctrl/Alt/Super
+ * bits; CapsLock and NumLock are ignored. Keys are compared as the Listener
+ * reports them, so on layouts where Shift changes the reported key (for
+ * example Shift+1 reported as `Key::Exclamation`) the binding must use that
+ * key.
+ *
+ * Only key presses advance the matcher. Presses of modifier keys themselves
+ * are ignored, so holding Ctrl across Ctrl+K Ctrl+C works as expected. A
+ * press that does not continue a pending sequence abandons it and is then
+ * tried as the first stroke of a new one.
+ *
+ * No binding may be a prefix of another; `add()` rejects such conflicts so
+ * that every match fires as soon as its last stroke is pressed.
+ *
+ * HotkeyMatcher is not internally synchronized. Register bindings and call
+ * `compile()` before feeding events, and feed from one thread at a time
+ * (typically the Listener callback).
+ */
+class AXIDEV_IO_API HotkeyMatcher {
+public:
+  /// Identifies a registered binding; `kInvalidBinding` means none.
+  using BindingId = uint32_t;
+  static constexpr BindingId kInvalidBinding = 0;
+
+  /// Invoked from `feed()` with the id of the matched binding.
+  using Action = std::function<void(BindingId id)>;
+
+  HotkeyMatcher();
+  ~HotkeyMatcher();
+  HotkeyMatcher(HotkeyMatcher &&) noexcept;
+  HotkeyMatcher &operator=(HotkeyMatcher &&) noexcept;
+
+  /**
+   * @brief Register a sequence of strokes.
+   *
+   * @param sequence Strokes in order; none may be `Key::Unknown` or a
+   *                 modifier key.
+   * @param action Invoked when the sequence is completed (may be empty, in
+   *               which case only `feed()` reports the match).
+   * @return The new binding's id, or `kInvalidBinding` when the sequence is
+   *         empty or invalid, or is equal to, a prefix of or an extension of
+   *         an existing binding.
+   */
+  BindingId add(std::span<const KeyWithModifier> sequence, Action action);
+
+  /// Register a single chord; see the sequence overload.
+  BindingId add(KeyWithModifier chord, Action action);
+
+  /**
+   * @brief Register a binding written as text.
+   *
+   * Strokes are separated by spaces and each one is parsed with
+   * `stringToKeyWithModifier()`, e.g. `"Ctrl+K Ctrl+C"`.
+   */
+  BindingId add(std::string_view sequence, Action action);
+
+  /// Remove all bindings and abandon any pending sequence.
+  void clear();
+
+  /// Number of registered bindings.
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief Build the transition table used by `feed()`.
+   *
+   * `feed()` compiles on demand after bindings change; calling this up front
+   * keeps that work off the listener thread. Abandons any pending sequence.
+   */
+  void compile();
+
+  /**
+   * @brief Advance the matcher with one Listener event.
+   *
+   * Invokes the matched binding's action, if any, before returning.
+   *
+   * @param keyMod Key and modifiers as reported by the Listener.
+   * @param pressed True for a press; releases are ignored.
+   * @return The id of the binding completed by this event, or
+   *         `kInvalidBinding`.
+   */
+  BindingId feed(KeyWithModifier keyMod, bool pressed);
+
+  /// Convenience overload for queued events and `EventCallback`s.
+  BindingId feed(const Listener::Event &event) {
+    return feed(event.keyMod, event.pressed);
+  }
+
+  /// True while the strokes seen so far are a prefix of some binding.
+  [[nodiscard]] bool pending() const;
+
+  /// Abandon any pending sequence.
+  void reset();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace keyboard
+} // namespace io
+} // namespace axidev
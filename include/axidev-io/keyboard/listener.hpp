@@ -51,8 +51,14 @@
  * }
  * @endcode
  */
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 #include <axidev-io/keyboard/common.hpp>
 
@@ -68,6 +74,11 @@ namespace keyboard {
  * keyboard events. Use `start()` to begin receiving events and `stop()` to
  * end listening. Callbacks may be invoked on an internal background thread,
  * therefore they must be thread-safe.
+ *
+ * Alternatively, `startQueued()` keeps user code off the OS hook thread
+ * entirely: translated events are pushed into a fixed-capacity lock-free
+ * queue and the consumer drains them with `poll()`, optionally blocking in
+ * `waitForEvents()` or on the native handle from `eventWaitHandle()`.
  */
 class AXIDEV_IO_API Listener {
 public:
@@ -91,6 +102,114 @@ public:
   using Callback = std::function<void(char32_t codepoint,
                                       KeyWithModifier keyMod, bool pressed)>;
 
+  /**
+   * @brief A translated key event as delivered in queued mode or to an
+   * `EventCallback`.
+   *
+   * Carries the same information as the `Callback` arguments plus two times
+   * on the `std::chrono::steady_clock` timeline, so that
+   * `timestampNs - osTimestampNs` is the time the event spent between the OS
+   * and the Listener.
+   */
+  struct Event {
+    char32_t codepoint{0};  ///< Unicode codepoint produced (0 if none).
+    KeyWithModifier keyMod; ///< Logical key and active modifiers.
+    bool pressed{false};    ///< True for key press, false for release.
+    /// Time the event was handed to the callback or queue, in ns.
+    uint64_t timestampNs{0};
+    /// Time the OS stamped the event, in ns; 0 if the backend has none.
+    /// Microsecond precision on Linux, but only the ~10-16 ms tick of
+    /// `GetTickCount()` on Windows.
+    uint64_t osTimestampNs{0};
+    /// Keyboard that produced the event: on Linux an id assigned from 1 as
+    /// devices appear during one listening session, and 0 on backends that
+    /// cannot tell keyboards apart (Windows, macOS).
+    uint32_t deviceId{0};
+  };
+
+  /**
+   * @brief Callback receiving the full `Event`, timestamps included.
+   * @see startWithEvents()
+   */
+  using EventCallback = std::function<void(const Event &ev)>;
+
+  /// Number of buckets in `Stats::callbackTimeHistogram`.
+  static constexpr size_t kCallbackHistogramBuckets = 16;
+
+  /**
+   * @brief Counters maintained by the backend since `start()` (or the last
+   * `resetStats()`).
+   *
+   * `callbackTimeHistogram` counts callback durations in power-of-two
+   * microsecond buckets: bucket 0 holds calls under 1 us, bucket `i` those in
+   * [2^(i-1), 2^i) us, and the last bucket everything longer. In queued mode
+   * the "callback" is the push into the queue.
+   */
+  struct Stats {
+    /// Key events received from the OS, filtered ones included.
+    uint64_t eventsSeen{0};
+    /// Events not delivered: no callback was set or the queue was full.
+    uint64_t eventsDropped{0};
+    /// Events skipped because they did not pass the `Filter`.
+    uint64_t eventsFiltered{0};
+    /// Longest single callback, in ns.
+    uint64_t callbackTimeMaxNs{0};
+    /// Callback durations, see above.
+    std::array<uint64_t, kCallbackHistogramBuckets> callbackTimeHistogram{};
+  };
+
+  /**
+   * @brief Which events the Listener reports (see `setFilter()`).
+   *
+   * A default Filter reports everything. Adding keys or chords restricts the
+   * Listener to them: events for any other key are handed back to the OS
+   * before the backend translates them, and never reach the callback or
+   * queue.
+   */
+  struct AXIDEV_IO_API Filter {
+    /// Keys reported with any modifiers.
+    std::vector<Key> keys;
+    /// Keys reported only with exactly these Shift/Ctrl/Alt/Super modifiers;
+    /// CapsLock and NumLock are ignored on both sides.
+    std::vector<KeyWithModifier> chords;
+    /// Report key presses only.
+    bool pressOnly{false};
+    /// Compute `codepoint`. When false it is always 0 and the backend skips
+    /// character translation entirely.
+    bool needCodepoint{true};
+
+    /// Add @p key to `keys`.
+    Filter &addKey(Key key);
+    /// Add every key from @p first to @p last (inclusive, in enum order).
+    Filter &addKeyRange(Key first, Key last);
+    /// Add @p chord to `chords`.
+    Filter &addChord(KeyWithModifier chord);
+  };
+
+  /**
+   * @brief Where the Listener reads key events from (see `setSources()`).
+   *
+   * Only the Linux backend reads from selectable sources. Default Sources
+   * listen on udev seat "seat0", like a Listener that never set any.
+   */
+  struct AXIDEV_IO_API Sources {
+    /// udev seats to listen on, e.g. "seat0" and "seat1".
+    std::vector<std::string> seats;
+    /// Device nodes to listen on directly, e.g. "/dev/input/event3".
+    std::vector<std::string> devicePaths;
+
+    /// Add @p seat to `seats`.
+    Sources &addSeat(std::string seat);
+    /// Add @p path to `devicePaths`.
+    Sources &addDevicePath(std::string path);
+  };
+
+  /// Default queue capacity used by `startQueued()`.
+  static constexpr size_t kDefaultQueueCapacity = 1024;
+
+  /// Timeout value for `waitForEvents()` meaning "wait indefinitely".
+  static constexpr uint32_t kWaitInfinite = UINT32_MAX;
+
   Listener();
   ~Listener();
 
@@ -110,6 +229,46 @@ public:
    */
   bool start(Callback cb);
 
+  /**
+   * @brief Start listening with a callback that receives the whole `Event`.
+   *
+   * Same as `start()`, except that the callback also gets the OS and
+   * dispatch timestamps of each event.
+   *
+   * @param cb Callback to invoke for each observed event.
+   * @return true on success, false on failure.
+   */
+  bool startWithEvents(EventCallback cb);
+
+  /**
+   * @brief Restrict the events reported by the next `start()`,
+   * `startWithEvents()` or `startQueued()`.
+   *
+   * The filter is compiled against the active layout when listening starts,
+   * into a per-keycode bitset that the OS hook checks before any other work.
+   *
+   * @param filter Events to report; a default Filter reports everything.
+   * @return false (and the filter is unchanged) while listening.
+   */
+  bool setFilter(Filter filter);
+
+  /**
+   * @brief Choose the seats and devices read by the next `start()`,
+   * `startWithEvents()` or `startQueued()`.
+   *
+   * Every keyboard keeps its own modifier and layout state, so a modifier
+   * held on one keyboard never changes how another one's keys translate;
+   * `Event::deviceId` tells them apart. All sources are read by the same
+   * Listener thread and events arrive in one stream. Listening fails to
+   * start when any seat or device cannot be opened.
+   *
+   * @param sources Seats and device nodes to read; default Sources read
+   *                "seat0".
+   * @return false (and the sources are unchanged) while listening, or for
+   *         non-default Sources on backends other than Linux.
+   */
+  bool setSources(Sources sources);
+
   /**
    * @brief Stop listening for global keyboard events.
    *
@@ -124,9 +283,107 @@ public:
    */
   [[nodiscard]] bool isListening() const;
 
+  // --- Queued mode ---
+  /**
+   * @brief Start listening in queued mode.
+   *
+   * Instead of running a user callback on the OS hook thread, each event is
+   * pushed into a lock-free single-producer/single-consumer ring of
+   * @p capacity entries (rounded up to a power of two). When the ring is full
+   * new events are dropped and counted by `droppedEvents()`, so a slow
+   * consumer can never stall the Windows hook or the macOS event tap.
+   *
+   * Any events left from a previous queued session are discarded.
+   *
+   * @param capacity Number of events the queue can hold.
+   * @return true on success, false on failure or if already listening.
+   */
+  bool startQueued(size_t capacity = kDefaultQueueCapacity);
+
+  /**
+   * @brief Drain queued events without blocking.
+   *
+   * Copies up to `out.size()` events in arrival order. Events queued before
+   * `stop()` remain available until the next `startQueued()`. Must only be
+   * called from one consumer thread at a time.
+   *
+   * @param out Destination buffer.
+   * @return Number of events written to @p out (0 when none are pending or
+   *         the listener was not started with `startQueued()`).
+   */
+  size_t poll(std::span<Event> out);
+
+  /**
+   * @brief Block until queued events are pending or the timeout expires.
+   *
+   * Call `poll()` after a successful wait; the readiness signal is only
+   * re-armed by draining. A signal left raised by events that an earlier
+   * `poll()` already took is cleared here and waited through, so a true
+   * return always means `poll()` has events to return.
+   *
+   * @param timeoutMs Timeout in milliseconds, or `kWaitInfinite`.
+   * @return true when events are pending; false on timeout, after
+   *         `wakeWaiter()`, or when the listener is not in queued mode.
+   */
+  bool waitForEvents(uint32_t timeoutMs);
+
+  /**
+   * @brief Make the thread blocked in `waitForEvents()` return now.
+   *
+   * Lets a consumer waiting with `kWaitInfinite` be told to exit without
+   * polling a flag on a timeout. If no thread is waiting, the next
+   * `waitForEvents()` that finds nothing pending returns false at once.
+   * Safe to call from any thread.
+   */
+  void wakeWaiter();
+
+  /**
+   * @brief Native handle that becomes readable/signaled when events are
+   * queued.
+   *
+   * On Linux this is an eventfd and on macOS the read end of a pipe, suitable
+   * for poll/epoll/kqueue; on Windows it is a manual-reset event `HANDLE`
+   * suitable for `WaitForMultipleObjects`. The handle is owned by the
+   * Listener and stays valid until the next `startQueued()` or destruction.
+   * Unlike `waitForEvents()`, the handle can report readiness with nothing
+   * pending (the events were taken by a `poll()` after they raised it); the
+   * next `poll()` then returns 0 and clears it.
+   *
+   * @return The handle cast to intptr_t, or -1 when not in queued mode.
+   */
+  [[nodiscard]] intptr_t eventWaitHandle() const;
+
+  /**
+   * @brief Number of events dropped because the queue was full.
+   * @return Overflow count since the last `startQueued()`.
+   */
+  [[nodiscard]] uint64_t droppedEvents() const;
+
+  // --- Instrumentation ---
+  /**
+   * @brief Snapshot of the event and callback timing counters.
+   *
+   * Safe to call from any thread while listening; the counters are updated
+   * with relaxed atomics, so a snapshot taken mid-event may be off by one.
+   *
+   * @return Stats Counters since `start()` or the last `resetStats()`.
+   */
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * @brief Zero the counters reported by `stats()`.
+   */
+  void resetStats();
+
+  /// @internal Event queue behind `startQueued()`; defined in
+  /// `keyboard/listener/listener_queue.hpp`, not part of the public API.
+  struct Queue;
+
 private:
   struct Impl;
   std::unique_ptr<Impl> m_impl;
+
+  std::unique_ptr<Queue> m_queue;
 };
 
 } // namespace keyboard
@@ -0,0 +1,160 @@
+#pragma once
+
+/**
+ * @file keyboard/round_trip.hpp
+ * @brief Runtime probe of the Sender-to-Listener input pipeline latency.
+ *
+ * `measureRoundTrip()` injects marker keystrokes with a Sender and times
+ * their arrival in a Listener on the same machine. The measured path is the
+ * whole one an application's input takes: the backend Sender, the OS input
+ * stack (compositor, Windows UIPI, the macOS event tap) and the Listener
+ * backend. Results accumulate in a `RoundTripHistogram`, so repeated probes
+ * build up a long-running picture.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * #include <axidev-io/keyboard/round_trip.hpp>
+ *
+ * axidev::io::keyboard::Sender sender;
+ * axidev::io::keyboard::Listener listener;
+ * axidev::io::keyboard::RoundTripHistogram latency;
+ * if (measureRoundTrip(sender, listener, 50, latency))
+ *   report(latency.percentileNs(0.99), latency.lost());
+ * @endcode
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <axidev-io/keyboard/common.hpp>
+#include <axidev-io/keyboard/listener.hpp>
+#include <axidev-io/keyboard/sender.hpp>
+
+namespace axidev {
+namespace io {
+namespace keyboard {
+
+/**
+ * @class RoundTripHistogram
+ * @brief Accumulated round-trip latencies and lost probes.
+ *
+ * Buckets use the same power-of-two microsecond layout as
+ * `Listener::Stats::callbackTimeHistogram`. Percentiles come from a sorted
+ * sample of at most `kMaxSamples` latencies: every latency while fewer have
+ * arrived, so percentiles are exact, then a uniform random subset. Memory
+ * use is bounded however long the histogram accumulates. Counts, minimum,
+ * maximum, mean and buckets always cover every probe.
+ */
+class AXIDEV_IO_API RoundTripHistogram {
+public:
+  static constexpr size_t kBuckets = Listener::kCallbackHistogramBuckets;
+  /// Latencies kept for percentiles at most.
+  static constexpr size_t kMaxSamples = 4096;
+
+  /// Record one probe that arrived after @p ns.
+  void add(uint64_t ns);
+  /// Record one probe that never arrived.
+  void addLost() { ++m_lost; }
+  /// Add every probe of @p other; once the kept samples would exceed
+  /// `kMaxSamples`, both sides contribute in proportion to their probes.
+  void merge(const RoundTripHistogram &other);
+  /// Forget everything recorded so far.
+  void clear();
+
+  /// Probes recorded, arrived or not.
+  [[nodiscard]] uint64_t sent() const { return received() + m_lost; }
+  /// Probes that arrived.
+  [[nodiscard]] uint64_t received() const { return m_received; }
+  /// Probes that did not arrive within the timeout.
+  [[nodiscard]] uint64_t lost() const { return m_lost; }
+
+  /// Smallest, largest and mean latency in ns; 0 without samples.
+  [[nodiscard]] uint64_t minNs() const;
+  [[nodiscard]] uint64_t maxNs() const;
+  [[nodiscard]] uint64_t meanNs() const;
+
+  /**
+   * @brief Latency at quantile @p q (nearest rank among the kept samples).
+   * @param q Quantile in [0, 1], e.g. 0.99 for p99; clamped.
+   * @return The latency in ns, or 0 without samples.
+   */
+  [[nodiscard]] uint64_t percentileNs(double q) const;
+
+  /// Sample counts per bucket.
+  [[nodiscard]] const std::array<uint64_t, kBuckets> &buckets() const {
+    return m_buckets;
+  }
+
+  /// The kept samples in ns (see above), in ascending order.
+  [[nodiscard]] std::span<const uint64_t> samplesNs() const {
+    return m_samples;
+  }
+
+private:
+  /// Index in [0, bound), from the histogram's own generator.
+  size_t randomBelow(uint64_t bound);
+  /// Keep @p count of the samples, chosen at random; the rest are dropped.
+  void keepRandom(size_t count);
+  void insertSorted(uint64_t ns);
+
+  // Always sorted, so the const queries only read.
+  std::vector<uint64_t> m_samples;
+  uint64_t m_received{0};
+  uint64_t m_sum{0};
+  uint64_t m_min{0};
+  uint64_t m_max{0};
+  uint64_t m_lost{0};
+  uint64_t m_rng{0x9e3779b97f4a7c15ULL};
+  std::array<uint64_t, kBuckets> m_buckets{};
+};
+
+/**
+ * @brief Options of `measureRoundTrip()`.
+ */
+struct RoundTripOptions {
+  /**
+   * Marker keys, used in rotation. A late arrival is recognized by its key
+   * and discarded instead of being mistaken for the next probe. Pick keys
+   * nothing on the machine reacts to; the defaults are F17 to F20.
+   */
+  std::vector<Key> markers{Key::F17, Key::F18, Key::F19, Key::F20};
+  /// How long to wait for each probe before counting it as lost.
+  uint32_t timeoutMs{250};
+  /// Pause between probes.
+  uint32_t intervalMs{0};
+};
+
+/**
+ * @brief Measure the Sender-to-Listener round trip @p count times.
+ *
+ * Each probe is a `Sender::tap()` of the next marker key, timed from just
+ * before the tap to the `Listener::Event::timestampNs` of its press. One
+ * untimed probe runs first, so the Listener has picked up the Sender's
+ * device before measuring starts.
+ *
+ * @p listener must not be listening: it is started with its own callback
+ * for the duration of the probe and stopped again before returning. Its
+ * filter, if any, must admit the marker keys.
+ *
+ * The marker keys really are typed into the session, so the focused
+ * application receives them.
+ *
+ * @param sender Sender to inject with.
+ * @param listener Idle Listener to observe with.
+ * @param count Number of timed probes.
+ * @param out Histogram the results are added to.
+ * @param options Marker keys and timing.
+ * @return false, with @p out unchanged, when the probe could not run: the
+ *         Sender is not ready, the Listener is busy or fails to start, the
+ *         marker list is empty, or the warm-up probe never arrives.
+ */
+AXIDEV_IO_API bool measureRoundTrip(Sender &sender, Listener &listener,
+                                    uint32_t count, RoundTripHistogram &out,
+                                    const RoundTripOptions &options = {});
+
+} // namespace keyboard
+} // namespace io
+} // namespace axidev
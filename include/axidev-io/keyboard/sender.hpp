@@ -36,9 +36,12 @@
  * @endcode
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 
 #include <axidev-io/keyboard/common.hpp>
 
@@ -46,6 +49,49 @@ namespace axidev {
 namespace io {
 namespace keyboard {
 
+class Sender;
+
+/**
+ * @class CompiledSequence
+ * @brief Immutable, pre-built event buffer returned by `Sender::compile()`.
+ *
+ * Holds the backend-native events (`INPUT` records on Windows,
+ * `input_event` records on Linux, `CGEventRef`s on macOS) so that
+ * `Sender::replay()` submits them without decoding, keymap lookups or
+ * modifier planning. Copies share the same buffer. A sequence compiled before
+ * the keyboard layout was reinitialized, or before the active layout
+ * switched, is no longer valid and must be compiled again.
+ */
+class AXIDEV_IO_API CompiledSequence {
+public:
+  /// Construct an empty (invalid) sequence.
+  CompiledSequence();
+  ~CompiledSequence();
+
+  CompiledSequence(const CompiledSequence &);
+  CompiledSequence &operator=(const CompiledSequence &);
+  CompiledSequence(CompiledSequence &&) noexcept;
+  CompiledSequence &operator=(CompiledSequence &&) noexcept;
+
+  /**
+   * @brief Check whether the sequence can be replayed.
+   * @return true when compilation succeeded and the layout has neither been
+   * reinitialized nor switched since.
+   */
+  [[nodiscard]] bool valid() const;
+
+private:
+  friend class Sender;
+  struct Data; // backend-specific
+
+  CompiledSequence(std::shared_ptr<const Data> data, uint64_t generation,
+                   uint64_t layoutEpoch);
+
+  std::shared_ptr<const Data> m_data;
+  uint64_t m_generation{0};
+  uint64_t m_layoutEpoch{0};
+};
+
 /**
  * @class Sender
  * @brief Layout-aware input sender (keyboard injection)
@@ -55,6 +101,32 @@ namespace keyboard {
  */
 class AXIDEV_IO_API Sender {
 public:
+  /**
+   * @brief Identifies a command queued by one of the `...Async()` methods.
+   *
+   * Tickets increase monotonically per Sender; 0 means the command was not
+   * queued (async mode off, queue full, or allocation failure).
+   */
+  using AsyncTicket = uint64_t;
+
+  /// Default queue capacity used by `startAsync()`.
+  static constexpr size_t kDefaultAsyncCapacity = 256;
+
+  /// Timeout value for `wait()` / `waitIdle()` meaning "wait indefinitely".
+  static constexpr uint32_t kWaitInfinite = UINT32_MAX;
+
+  /**
+   * @brief A raw key event submitted through `sendSequence()`.
+   *
+   * Modifier keys are ordinary events here: to send Ctrl+C, press
+   * `Key::CtrlLeft`, tap `Key::C`, then release `Key::CtrlLeft`.
+   */
+  struct KeyEvent {
+    Key key{Key::Unknown};
+    bool down{false};     ///< True for key press, false for release.
+    uint32_t delayUs{0};  ///< Pause after this event, in microseconds.
+  };
+
   /**
    * @brief Construct a new Sender instance.
    */
@@ -62,6 +134,8 @@ public:
 
   /**
    * @brief Destroy the Sender instance and release resources.
+   *
+   * On Linux/uinput, keys this Sender still holds down are released.
    */
   ~Sender();
 
@@ -90,6 +164,22 @@ public:
    */
   [[nodiscard]] bool isReady() const;
 
+  /**
+   * @brief Wait until injected input will be seen by the rest of the system.
+   *
+   * Constructing a Sender does not block. On Linux/uinput the virtual device
+   * is only read once udev has announced it, which the first injection waits
+   * for automatically (at most ~100 ms after the first Sender of the process
+   * created it; later Senders share that device). Call this to take that wait
+   * up front or to bound it. Other backends are ready as soon as `isReady()`
+   * is.
+   *
+   * @param timeoutMs Longest time to wait, in milliseconds.
+   * @return true if the backend is ready; false on timeout or if
+   * `isReady()` is false.
+   */
+  bool waitUntilReady(uint32_t timeoutMs);
+
   /**
    * @brief Attempt to request any runtime permissions required by the backend.
    * @return true if the backend is ready after requesting permissions.
@@ -132,6 +222,68 @@ public:
    */
   bool tap(KeyWithModifier keyMod);
 
+  /**
+   * @brief Send a sequence of raw key events in one submission.
+   *
+   * Every key is resolved to a platform keycode before anything is sent, so
+   * an unmapped key fails the call without injecting a partial sequence. The
+   * events are then submitted back to back (one `SendInput` call on Windows,
+   * one batched device write on Linux); `setKeyDelay()` does not apply and
+   * only the per-event `KeyEvent::delayUs` pauses split the submission.
+   * Modifier keys in the sequence update `activeModifiers()`.
+   *
+   * @param events Events to send, in order.
+   * @return true when every event was submitted; false on failure or when a
+   * key has no mapping on the active layout.
+   */
+  bool sendSequence(std::span<const KeyEvent> events);
+
+  // --- Compiled sequences ---
+  /**
+   * @brief Pre-build a raw key sequence for repeated replay.
+   *
+   * Resolves the events exactly as `sendSequence()` would, including the
+   * `KeyEvent::delayUs` pauses. When the keyboard layout has been
+   * reinitialized since the sender last loaded it, the sender reloads its
+   * layout tables first.
+   *
+   * @param events Events to compile, in order.
+   * @return The compiled sequence; invalid when a key has no mapping.
+   */
+  [[nodiscard]] CompiledSequence compile(std::span<const KeyEvent> events);
+
+  /**
+   * @brief Pre-build Unicode text for repeated replay.
+   *
+   * The result types the text like `typeText()` but is submitted back to
+   * back on replay: `setKeyDelay()` does not apply.
+   *
+   * @param text Unicode text (UTF-32) to compile.
+   * @return The compiled sequence; invalid when a character cannot be typed.
+   */
+  [[nodiscard]] CompiledSequence compile(std::u32string_view text);
+
+  /**
+   * @brief Pre-build UTF-8 text for repeated replay.
+   * @param utf8Text UTF-8 encoded text to compile.
+   * @return The compiled sequence; invalid when the text is not well-formed
+   * UTF-8 or a character cannot be typed.
+   */
+  [[nodiscard]] CompiledSequence compile(std::string_view utf8Text);
+
+  /**
+   * @brief Submit a compiled sequence.
+   *
+   * Each run of events between pauses goes out in a single submission.
+   * Modifier keys in the sequence update `activeModifiers()`.
+   *
+   * @param sequence Sequence returned by `compile()`.
+   * @return true on success; false when the sequence is invalid (see
+   * `CompiledSequence::valid()`), was compiled for another layout than the
+   * one this sender uses, or submission failed.
+   */
+  bool replay(const CompiledSequence &sequence);
+
   // --- Modifier helpers ---
   /**
    * @brief Return the currently active modifier mask.
@@ -164,16 +316,22 @@ public:
   /**
    * @brief Inject Unicode text directly (layout-independent).
    * @param text Unicode text (UTF-32) to inject.
-   * @return true on success; false if unsupported or on failure.
+   * @return true on success; false if unsupported, if @p text holds a
+   * surrogate or a value above U+10FFFF, or on failure.
    */
-  bool typeText(const std::u32string &text);
+  bool typeText(std::u32string_view text);
 
   /**
    * @brief Convenience overload that accepts UTF-8 text.
+   *
+   * Ill-formed UTF-8 (overlong forms, encoded surrogates, truncated
+   * sequences) is rejected before anything is typed.
+   *
    * @param utf8Text UTF-8 encoded string to inject.
-   * @return true on success; false if unsupported or on failure.
+   * @return true on success; false if unsupported, on invalid UTF-8, or on
+   * failure.
    */
-  bool typeText(const std::string &utf8Text);
+  bool typeText(std::string_view utf8Text);
 
   /**
    * @brief Inject a single Unicode codepoint.
@@ -182,6 +340,29 @@ public:
    */
   bool typeCharacter(char32_t codepoint);
 
+  /**
+   * @brief Number of characters the last `typeText()` / `typeCharacter()`
+   * call actually injected.
+   *
+   * Equals the length of the text on success; after a failure it tells how
+   * far typing got before it stopped. Not meaningful while async mode is on.
+   *
+   * @return Code points delivered to the system input queue.
+   */
+  [[nodiscard]] size_t lastTypedCount() const;
+
+  /**
+   * @brief Set how many characters `typeText()` submits per batch.
+   *
+   * Long text is injected in batches so that a multi-megabyte paste is never
+   * handed to the system as a single array (one `SendInput` call per batch
+   * on Windows). uinput already writes in bounded chunks and macOS is limited
+   * to 20 UTF-16 units per event, so those backends ignore the setting.
+   *
+   * @param characters Characters per batch (0 restores the default).
+   */
+  void setTextBatchSize(size_t characters);
+
   // --- Misc ---
   /**
    * @brief Flush pending events to ensure timely delivery.
@@ -190,10 +371,105 @@ public:
 
   /**
    * @brief Set the key delay used by tap/combo operations.
-   * @param delayUs Delay in microseconds.
+   *
+   * Events are scheduled against deadlines on the monotonic clock, so
+   * sub-millisecond delays are honoured on every platform and the timing
+   * error does not accumulate over long sequences.
+   *
+   * @param delayUs Delay in microseconds (0 disables pacing).
    */
   void setKeyDelay(uint32_t delayUs);
 
+  /**
+   * @brief Busy-wait the end of each key delay instead of sleeping.
+   *
+   * By default the thread sleeps for the whole delay. A non-zero @p spinUs
+   * stops the sleep that long before each deadline and spins the rest,
+   * trading CPU time for accuracy where the platform timer is coarse. The
+   * spin is capped to an eighth of each delay.
+   *
+   * @param spinUs Spin in microseconds (0, the default, always sleeps).
+   */
+  void setKeyDelaySpin(uint32_t spinUs);
+
+  // --- Asynchronous injection ---
+  /**
+   * @brief Start a background injection thread.
+   *
+   * While async mode is on, the `...Async()` methods copy the command into a
+   * fixed-capacity lock-free queue and return immediately; the injection
+   * thread executes queued commands in order, paced by `setKeyDelay()`. The
+   * `...Async()` methods and `cancelPending()` must be called from one thread
+   * at a time, and the synchronous injection methods must not be used until
+   * `stopAsync()` returns. Moving or destroying the Sender stops async mode
+   * and discards commands that have not started; neither may happen inside
+   * a command running on the injection thread.
+   *
+   * @param capacity Maximum number of queued commands (rounded up to a power
+   * of two).
+   * @return true on success; false if already running or the thread could
+   * not be started.
+   */
+  bool startAsync(size_t capacity = kDefaultAsyncCapacity);
+
+  /**
+   * @brief Execute every queued command, then stop the injection thread.
+   *
+   * Call `cancelPending()` first to discard the queue instead.
+   */
+  void stopAsync();
+
+  /// Whether the background injection thread is running.
+  [[nodiscard]] bool asyncEnabled() const;
+
+  /// Queue a `tap()`; see `startAsync()`.
+  AsyncTicket tapAsync(KeyWithModifier keyMod);
+
+  /// Queue a `keyDown()`; see `startAsync()`.
+  AsyncTicket keyDownAsync(KeyWithModifier keyMod);
+
+  /// Queue a `keyUp()`; see `startAsync()`.
+  AsyncTicket keyUpAsync(KeyWithModifier keyMod);
+
+  /// Queue a `typeText()`; the text is copied.
+  AsyncTicket typeTextAsync(const std::u32string &text);
+
+  /// Queue a `typeText()` of UTF-8 text; decoding happens on the injection
+  /// thread.
+  AsyncTicket typeTextAsync(const std::string &utf8Text);
+
+  /**
+   * @brief Block until the command identified by @p ticket has finished.
+   *
+   * Cancelled commands count as finished. May be called from any thread.
+   *
+   * @param ticket Ticket returned by an `...Async()` method.
+   * @param timeoutMs Timeout in milliseconds, or `kWaitInfinite`.
+   * @return true when the command has finished; false on timeout, for a 0
+   * ticket or when async mode is off.
+   */
+  bool wait(AsyncTicket ticket, uint32_t timeoutMs = kWaitInfinite);
+
+  /**
+   * @brief Block until every command queued so far has finished.
+   * @param timeoutMs Timeout in milliseconds, or `kWaitInfinite`.
+   * @return true once idle; false on timeout or when async mode is off.
+   */
+  bool waitIdle(uint32_t timeoutMs = kWaitInfinite);
+
+  /**
+   * @brief Discard every queued command that has not started yet.
+   *
+   * A command already being injected runs to completion.
+   */
+  void cancelPending();
+
+  /**
+   * @brief Number of queued commands that reported failure.
+   * @return Failure count since the last `startAsync()`.
+   */
+  [[nodiscard]] uint64_t asyncFailures() const;
+
 private:
   /**
    * @brief Internal helper to send a raw key event without modifier handling.
@@ -209,6 +485,15 @@ private:
 
   struct Impl;
   std::unique_ptr<Impl> m_impl;
+
+  // Declared after m_impl so the injection thread is joined before the
+  // backend it drives is destroyed.
+  struct AsyncQueue;
+  std::unique_ptr<AsyncQueue> m_async;
+
+  /// Cancel the commands that have not started and join the injection
+  /// thread, as the moves require before the backend changes hands.
+  void discardAsync() noexcept;
 };
 
 } // namespace keyboard
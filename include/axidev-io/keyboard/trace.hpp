@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * @file keyboard/trace.hpp
+ * @brief Record typing sessions from a Listener and replay them through a
+ * Sender.
+ *
+ * `TraceRecorder` appends Listener events to a compact binary trace file:
+ * the time since the previous event in microseconds (a varint), the `Key`
+ * and the packed modifiers and press flag, typically 5 or 6 bytes per
+ * event. `TracePlayer` maps the file into memory and streams it through
+ * `Sender::sendSequence()` in fixed-size batches, at the recorded pace, a
+ * scaled pace or as fast as possible. Multi-hour traces therefore replay
+ * without being loaded into memory.
+ *
+ * Traces hold keys, not text: replaying presses the recorded keys on the
+ * current layout, including the modifier keys themselves. The modifiers
+ * stored with each event are informational (what was held when it was
+ * recorded); playback does not apply them, since the recorded modifier key
+ * events already reproduce that state.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * #include <axidev-io/keyboard/trace.hpp>
+ *
+ * using namespace axidev::io::keyboard;
+ *
+ * TraceRecorder recorder;
+ * Listener listener;
+ * if (recorder.open("session.axkt"))
+ *   listener.startWithEvents(
+ *       [&recorder](const Listener::Event &ev) { recorder.record(ev); });
+ * // ... later
+ * listener.stop();
+ * recorder.close();
+ *
+ * TracePlayer player;
+ * Sender sender;
+ * TracePlayOptions fast;
+ * fast.speed = 4.0;
+ * if (player.open("session.axkt"))
+ *   player.play(sender, fast);
+ * @endcode
+ */
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <axidev-io/keyboard/common.hpp>
+#include <axidev-io/keyboard/listener.hpp>
+#include <axidev-io/keyboard/sender.hpp>
+
+namespace axidev {
+namespace io {
+namespace keyboard {
+
+/**
+ * @class TraceRecorder
+ * @brief Appends Listener events to a trace file.
+ *
+ * Events are encoded into a fixed buffer and written out when it fills, so
+ * `record()` does not allocate and rarely makes a system call; it can run
+ * directly in the Listener callback. The file only ever grows, so a trace
+ * cut short by a crash keeps every event flushed before it.
+ *
+ * TraceRecorder is not internally synchronized: record from one thread at a
+ * time, and stop the Listener before `close()`.
+ */
+class AXIDEV_IO_API TraceRecorder {
+public:
+  TraceRecorder();
+  ~TraceRecorder();
+  TraceRecorder(TraceRecorder &&) noexcept;
+  TraceRecorder &operator=(TraceRecorder &&) noexcept;
+
+  /**
+   * @brief Start a new trace at @p path, replacing any existing file.
+   *
+   * Closes the current trace first. The time of this call is the start of
+   * the recording.
+   *
+   * @return false when the file cannot be created.
+   */
+  bool open(const std::string &path);
+
+  /**
+   * @brief Append one event.
+   *
+   * The event's `timestampNs` orders it; an event without one is stamped
+   * now.
+   *
+   * @return false when no trace is open or writing failed.
+   */
+  bool record(const Listener::Event &event);
+
+  /// Write the buffered events to the file.
+  bool flush();
+
+  /// Flush and close the trace; a no-op when none is open.
+  void close();
+
+  /// True between a successful `open()` and `close()`.
+  [[nodiscard]] bool isOpen() const;
+
+  /// Events recorded since `open()`.
+  [[nodiscard]] uint64_t recordedCount() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief Options of `TracePlayer::play()`.
+ */
+struct TracePlayOptions {
+  /// Playback rate relative to the recording: 1 replays at the recorded
+  /// pace, 2 twice as fast, and 0 (or less) as fast as possible.
+  double speed{1.0};
+  /// Upper bound on any single pause, after scaling, in microseconds; 0
+  /// keeps the pauses as recorded. Useful to skip idle periods of long
+  /// sessions.
+  uint32_t maxPauseUs{0};
+};
+
+/**
+ * @class TracePlayer
+ * @brief Replays a trace file through a Sender.
+ *
+ * The file is memory-mapped and decoded as it is played, a batch of events
+ * at a time, so memory use does not grow with the length of the trace.
+ */
+class AXIDEV_IO_API TracePlayer {
+public:
+  TracePlayer();
+  ~TracePlayer();
+  TracePlayer(TracePlayer &&) noexcept;
+  TracePlayer &operator=(TracePlayer &&) noexcept;
+
+  /**
+   * @brief Map the trace at @p path.
+   *
+   * Closes the current trace first.
+   *
+   * @return false when the file cannot be mapped or is not a trace of this
+   *         format version.
+   */
+  bool open(const std::string &path);
+
+  /// Unmap the trace; a no-op when none is open.
+  void close();
+
+  /// True between a successful `open()` and `close()`.
+  [[nodiscard]] bool isOpen() const;
+
+  /**
+   * @brief Replay the whole trace with @p sender.
+   *
+   * Blocks until the last event was sent. The first event is sent right
+   * away; the pauses between events follow @p options. Events of
+   * `Key::Unknown` are skipped, and so is any key @p sender cannot map on
+   * the current layout; keys are checked before they are sent. An
+   * incomplete last record (a trace still being written) ends playback.
+   *
+   * @return false when no trace is open, @p sender is not ready, or sending
+   *         failed; playback stops at the failed batch, which is not
+   *         retried, and `playedCount()` covers the batches sent before it.
+   */
+  bool play(Sender &sender, const TracePlayOptions &options = {});
+
+  /// Events sent by the last `play()`.
+  [[nodiscard]] uint64_t playedCount() const;
+
+  /// Events the last `play()` skipped (unknown or unmapped keys).
+  [[nodiscard]] uint64_t skippedCount() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace keyboard
+} // namespace io
+} // namespace axidev
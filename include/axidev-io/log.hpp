@@ -2,7 +2,7 @@
 
 /**
  * @file log.hpp
- * @brief Lightweight, header-only logging utility used by axidev-io backends.
+ * @brief Lightweight logging utility used by axidev-io backends.
  *
  * Usage:
  *   @code{.cpp}
@@ -18,19 +18,36 @@
  *  - AXIDEV_IO_FORCE_COLORS: non-empty -> force ANSI colors on.
  *  - AXIDEV_IO_NO_COLOR: non-empty -> disable ANSI colors.
  *
+ * Compile-time configuration:
+ *  - AXIDEV_IO_MIN_LOG_LEVEL: lowest level (0 = Debug ... 3 = Error, 4 = off)
+ *    the logging macros are compiled for. Macros below it expand to an empty
+ *    statement whose arguments are never evaluated. The library sets this via
+ *    the CMake cache variable of the same name (Warn for Release builds);
+ *    other translation units default to 0 so every level stays available.
+ *
+ * Enabled macros check the runtime level before evaluating their arguments,
+ * so log sites may call non-trivial formatting helpers without paying for
+ * them when the level is filtered out.
+ *
+ * Output goes through a replaceable sink (stderr by default, see `setSink`).
+ * `startAsync()` moves sink calls to a background writer thread fed by a
+ * bounded lock-free queue, so logging threads never block on I/O.
+ *
  * The header is intentionally small and portable and works in plain C++ and
- * Objective-C++ translation units.
+ * Objective-C++ translation units. Record dispatch lives in the library
+ * (`src/log.cpp`).
  */
 
+#include <axidev-io/core.hpp>
+
 #include <algorithm>
 #include <atomic>
-#include <chrono>
 #include <cstdarg>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <ctime>
-#include <mutex>
 #include <string>
 #if defined(_WIN32) || defined(_WIN64)
 #include <io.h>
@@ -38,6 +55,10 @@
 #include <unistd.h>
 #endif
 
+#ifndef AXIDEV_IO_MIN_LOG_LEVEL
+#define AXIDEV_IO_MIN_LOG_LEVEL 0
+#endif
+
 namespace axidev {
 namespace io {
 namespace log {
@@ -74,7 +95,8 @@ inline const char *levelToString(Level l) {
  * @brief Parse runtime configuration to determine the default log level.
  *
  * Prefers the AXIDEV_IO_LOG_LEVEL environment variable; falls back to the
- * legacy AXIDEV_OSK_DEBUG_BACKEND behavior when AXIDEV_IO_LOG_LEVEL is not set.
+ * legacy AXIDEV_OSK_DEBUG_BACKEND behavior when AXIDEV_IO_LOG_LEVEL is not set,
+ * and to Warn when neither is.
  * @return Level The determined default log level.
  */
 inline Level parseLevelFromEnv() {
@@ -97,11 +119,8 @@ inline Level parseLevelFromEnv() {
   }
 
   const char *legacy = std::getenv("AXIDEV_OSK_DEBUG_BACKEND");
-  if (!legacy) {
-    // Default to enabled for the time being while testing (preserve legacy
-    // behaviour).
-    return Level::Debug;
-  }
+  if (!legacy)
+    return Level::Warn;
   if (legacy[0] == '0')
     return Level::Info;
   return Level::Debug;
@@ -131,16 +150,6 @@ inline bool isEnabled(Level level) {
   return static_cast<int>(level) >= static_cast<int>(getLevel());
 }
 
-/**
- * @internal
- * @brief Internal mutex used to serialize access to stderr.
- * @return std::mutex& Reference to the mutex used for output serialization.
- */
-inline std::mutex &outputMutex() {
-  static std::mutex m;
-  return m;
-}
-
 /**
  * @internal
  * @brief Return an ANSI color escape sequence for the given log level.
@@ -224,12 +233,92 @@ inline const char *trimPathToAxidevIo(const char *path) {
   return base;
 }
 
+/**
+ * @brief A single log message as delivered to a sink.
+ *
+ * All pointers are only valid for the duration of the sink call.
+ */
+struct Record {
+  Level level{Level::Info};
+  const char *file{""}; ///< Source path trimmed by `trimPathToAxidevIo`.
+  int line{0};
+  int64_t timestampUs{0}; ///< Wall-clock time of the log call (Unix epoch).
+  const char *message{""}; ///< Formatted body, without a trailing newline.
+};
+
+/**
+ * @brief Destination for formatted log records.
+ *
+ * Sinks are never called concurrently: synchronous logging serializes them
+ * and in async mode only the writer thread calls them. A sink must not log
+ * through axidev-io or call `setSink`, `startAsync` or `stopAsync`.
+ */
+using Sink = void (*)(const Record &record, void *userData);
+
+/**
+ * @brief Built-in sink writing colored, timestamped lines to stderr.
+ *
+ * Installed by default; exposed so custom sinks can forward to it.
+ */
+AXIDEV_IO_API void stderrSink(const Record &record, void *userData);
+
+/**
+ * @brief Replace the active sink.
+ *
+ * Once this returns the previous sink will not be called again.
+ *
+ * @param sink New sink, or nullptr to restore `stderrSink`.
+ * @param userData Opaque pointer passed back to @p sink.
+ */
+AXIDEV_IO_API void setSink(Sink sink, void *userData = nullptr);
+
+/**
+ * @brief Default capacity (in records) of the async log queue.
+ */
+inline constexpr size_t kDefaultAsyncCapacity = 1024;
+
+/**
+ * @brief Longest message body kept by the async queue; longer messages are
+ * truncated. Synchronous logging does not truncate.
+ */
+inline constexpr size_t kAsyncMessageCapacity = 512;
+
+/**
+ * @brief Route records through a background writer thread.
+ *
+ * Logging threads format the message and push it into a bounded lock-free
+ * queue; the writer thread drains it into the sink. When the queue is full
+ * the record is dropped and counted (see `droppedMessages`), so logging never
+ * blocks the caller.
+ *
+ * @param capacity Queue capacity in records (rounded up to a power of two).
+ * @return true if async mode is active (including when it already was).
+ */
+AXIDEV_IO_API bool startAsync(size_t capacity = kDefaultAsyncCapacity);
+
+/**
+ * @brief Flush pending records, stop the writer thread and return to
+ * synchronous logging. Safe to call when async mode is not active.
+ */
+AXIDEV_IO_API void stopAsync();
+
+/**
+ * @brief Whether records are currently routed through the writer thread.
+ */
+AXIDEV_IO_API bool asyncEnabled();
+
+/**
+ * @brief Number of records dropped because the async queue was full since the
+ * process started.
+ */
+AXIDEV_IO_API uint64_t droppedMessages();
+
 /**
  * @internal
- * @brief Emit a formatted log message using a va_list (thread-safe).
+ * @brief Format a log message using a va_list and hand it to the sink.
  *
- * Produces a timestamp (local time, millisecond precision), level name,
- * and source file/line prefix before the formatted message body.
+ * Captures the timestamp, formats the body and either calls the sink directly
+ * (serialized) or enqueues the record for the writer thread.
  *
  * @param level Log level for the message.
  * @param file Source file name (typically `__FILE__`).
@@ -237,65 +326,8 @@ inline const char *trimPathToAxidevIo(const char *path) {
  * @param fmt printf-style format string.
  * @param ap Preinitialized va_list of arguments for `fmt`.
  */
-inline void vlog(Level level, const char *file, int line, const char *fmt,
-                 va_list ap) {
-  if (!isEnabled(level))
-    return;
-
-  // Grab time
-  using namespace std::chrono;
-  auto now = system_clock::now();
-  auto ms =
-      duration_cast<milliseconds>(now.time_since_epoch()) % milliseconds(1000);
-  std::time_t t = system_clock::to_time_t(now);
-
-  // Convert to local time in a portable way
-  std::tm tmbuf;
-#if defined(_MSC_VER) || defined(_WIN32)
-  localtime_s(&tmbuf, &t);
-#else
-  localtime_r(&t, &tmbuf);
-#endif
-
-  char timebuf[64];
-  if (std::strftime(timebuf, sizeof(timebuf), "%Y-%m-%d %H:%M:%S", &tmbuf) ==
-      0) {
-    // Fallback if strftime fails
-    std::snprintf(timebuf, sizeof(timebuf), "%lld", static_cast<long long>(t));
-  }
-
-  // Serialise output to avoid interleaving
-  std::lock_guard<std::mutex> lk(outputMutex());
-
-  const bool use_colors = colorsEnabled();
-  const char *reset = use_colors ? "\x1b[0m" : "";
-  const char *file_color = use_colors ? "\x1b[90m" : "";
-  const char *lvl_color = use_colors ? levelColor(level) : "";
-
-  const char *trimmed = trimPathToAxidevIo(file);
-
-  // Header: timestamp.millis [LEVEL] file:line: (with coloring)
-  std::fprintf(stderr, "[axidev-io] %s.%03d [", timebuf,
-               static_cast<int>(ms.count()));
-  if (use_colors)
-    std::fputs(lvl_color, stderr);
-  std::fprintf(stderr, "%s", levelToString(level));
-  if (use_colors)
-    std::fputs(reset, stderr);
-  std::fprintf(stderr, "] ");
-  if (use_colors)
-    std::fputs(file_color, stderr);
-  std::fprintf(stderr, "%s:%d: ", trimmed, line);
-  if (use_colors)
-    std::fputs(reset, stderr);
-
-  // Body
-  std::vfprintf(stderr, fmt, ap);
-
-  // Newline and flush for immediacy (useful when used from tests / CI)
-  std::fprintf(stderr, "\n");
-  std::fflush(stderr);
-}
+AXIDEV_IO_API void vlog(Level level, const char *file, int line,
+                        const char *fmt, va_list ap);
 
 /**
  * @brief Log a message with varargs.
@@ -332,19 +364,39 @@ inline bool debugEnabled() { return isEnabled(Level::Debug); }
  * @brief Convenience macros that include file and line automatically.
  *
  * These macros wrap `::axidev::io::log::log` and automatically supply
- * `__FILE__` and `__LINE__`.
+ * `__FILE__` and `__LINE__`. Each expands to a single statement.
  * @{
  */
+
+/// True when messages at `level` are compiled into this translation unit.
+#define AXIDEV_IO_LOG_COMPILED(level)                                          \
+  (static_cast<int>(level) >= AXIDEV_IO_MIN_LOG_LEVEL)
+
+/// True when messages at `level` are both compiled in and enabled at runtime.
+#define AXIDEV_IO_LOG_ENABLED(level)                                           \
+  (AXIDEV_IO_LOG_COMPILED(level) && ::axidev::io::log::isEnabled(level))
+
+/**
+ * @internal
+ * @brief Shared body of the level macros. The `if constexpr` discards the
+ * call (arguments included) below the compile-time minimum while keeping it
+ * type-checked; the runtime check runs before any argument is evaluated.
+ */
+#define AXIDEV_IO_LOG_AT_LEVEL_(level, fmt, ...)                               \
+  do {                                                                         \
+    if constexpr (AXIDEV_IO_LOG_COMPILED(level)) {                             \
+      if (::axidev::io::log::isEnabled(level))                                 \
+        ::axidev::io::log::log(level, __FILE__, __LINE__, fmt,                 \
+                               ##__VA_ARGS__);                                 \
+    }                                                                          \
+  } while (0)
+
 #define AXIDEV_IO_LOG_DEBUG(fmt, ...)                                          \
-  ::axidev::io::log::log(::axidev::io::log::Level::Debug, __FILE__, __LINE__,  \
-                         fmt, ##__VA_ARGS__)
+  AXIDEV_IO_LOG_AT_LEVEL_(::axidev::io::log::Level::Debug, fmt, ##__VA_ARGS__)
 #define AXIDEV_IO_LOG_INFO(fmt, ...)                                           \
-  ::axidev::io::log::log(::axidev::io::log::Level::Info, __FILE__, __LINE__,   \
-                         fmt, ##__VA_ARGS__)
+  AXIDEV_IO_LOG_AT_LEVEL_(::axidev::io::log::Level::Info, fmt, ##__VA_ARGS__)
 #define AXIDEV_IO_LOG_WARN(fmt, ...)                                           \
-  ::axidev::io::log::log(::axidev::io::log::Level::Warn, __FILE__, __LINE__,   \
-                         fmt, ##__VA_ARGS__)
+  AXIDEV_IO_LOG_AT_LEVEL_(::axidev::io::log::Level::Warn, fmt, ##__VA_ARGS__)
 #define AXIDEV_IO_LOG_ERROR(fmt, ...)                                          \
-  ::axidev::io::log::log(::axidev::io::log::Level::Error, __FILE__, __LINE__,  \
-                         fmt, ##__VA_ARGS__)
+  AXIDEV_IO_LOG_AT_LEVEL_(::axidev::io::log::Level::Error, fmt, ##__VA_ARGS__)
 /** @} */ /* end of LoggingMacros */
@@ -11,24 +11,34 @@
  * `axidev_io_get_last_error`.
  *
  * @note Listener callbacks may be invoked from background threads; the wrapper
- *       safely bridges those events into C callbacks while protecting callback
- *       state with a mutex.
+ *       bridges those events into C callbacks by capturing the callback and
+ *       user data by value at start time, so no lock is taken per event.
  */
 
 #include <axidev-io/c_api.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstdlib>
 #include <cstring>
-
+#include <iterator>
+#include <memory>
 #include <mutex>
 #include <new>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <axidev-io/core.hpp>
 #include <axidev-io/keyboard/common.hpp>
 #include <axidev-io/keyboard/listener.hpp>
+#include <axidev-io/keyboard/round_trip.hpp>
 #include <axidev-io/keyboard/sender.hpp>
+#include <axidev-io/keyboard/trace.hpp>
 #include <axidev-io/log.hpp>
 
 namespace {
@@ -45,17 +55,48 @@ struct SenderWrapper {
 };
 
 /**
- * @brief Internal wrapper that contains a Listener and its C callback state.
+ * @brief Internal wrapper that owns a axidev::io::keyboard::Listener instance.
+ *
+ * The C callback and its `user_data` are not stored here: they are captured
+ * by value in the bridge passed to `Listener::start()`, which the listener
+ * publishes once and releases on `stop()`.
  *
- * The `cb` and `user_data` fields are protected by `cb_mutex` so that both
- * the C API entry points and the listener's internal event threads can safely
- * access and update them.
+ * `batchThread` is the dispatcher of
+ * `axidev_io_keyboard_listener_start_batched`: it drains the listener's queue
+ * and hands the C callback whole arrays of events. It is joined on stop and
+ * destruction.
  */
 struct ListenerWrapper {
   axidev::io::keyboard::Listener listener;
-  axidev_io_keyboard_listener_cb cb{nullptr};
-  void *user_data{nullptr};
-  std::mutex cb_mutex; // protects cb & user_data
+  std::thread batchThread;
+  std::atomic<bool> batchStop{false};
+};
+
+/**
+ * @brief Internal wrapper that owns a axidev::io::keyboard::CompiledSequence.
+ *
+ * Returned to C callers as `axidev_io_keyboard_compiled_t`.
+ */
+struct CompiledWrapper {
+  axidev::io::keyboard::CompiledSequence sequence;
+};
+
+/**
+ * @brief Internal wrapper that owns a axidev::io::keyboard::TraceRecorder.
+ *
+ * Returned to C callers as `axidev_io_keyboard_trace_recorder_t`.
+ */
+struct TraceRecorderWrapper {
+  axidev::io::keyboard::TraceRecorder recorder;
+};
+
+/**
+ * @brief Internal wrapper that owns a axidev::io::keyboard::TracePlayer.
+ *
+ * Returned to C callers as `axidev_io_keyboard_trace_player_t`.
+ */
+struct TracePlayerWrapper {
+  axidev::io::keyboard::TracePlayer player;
 };
 
 /**
@@ -67,6 +108,9 @@ struct ListenerWrapper {
  */
 static std::mutex g_last_error_mutex;
 static std::string g_last_error;
+/// Whether `g_last_error` holds a message. Lets `clear_last_error()`, which
+/// every entry point calls, skip the mutex in the common no-error case.
+static std::atomic<bool> g_has_last_error{false};
 
 /**
  * @brief Set the process-wide last error message (thread-safe).
@@ -75,18 +119,23 @@ static std::string g_last_error;
 static void set_last_error(const std::string &s) {
   std::lock_guard<std::mutex> lk(g_last_error_mutex);
   g_last_error = s;
+  g_has_last_error.store(true, std::memory_order_relaxed);
 }
 
 /**
  * @brief Clear the process-wide last error message (thread-safe).
  */
 static void clear_last_error() {
+  if (!g_has_last_error.load(std::memory_order_relaxed)) {
+    return;
+  }
   std::lock_guard<std::mutex> lk(g_last_error_mutex);
   g_last_error.clear();
+  g_has_last_error.store(false, std::memory_order_relaxed);
 }
 
 /**
- * @brief Duplicate a std::string into a C-allocated null-terminated buffer.
+ * @brief Duplicate a string into a C-allocated null-terminated buffer.
  *
  * The returned buffer must be freed by the caller (for example via
  * `axidev_io_free_string` or `std::free`). Returns nullptr on allocation
@@ -95,7 +144,7 @@ static void clear_last_error() {
  * @param s Source string to duplicate.
  * @return char* Heap-allocated null-terminated copy or nullptr on OOM.
  */
-static char *duplicate_c_string(const std::string &s) {
+static char *duplicate_c_string(std::string_view s) {
   size_t n = s.size();
   char *p = static_cast<char *>(std::malloc(n + 1));
   if (!p) {
@@ -106,6 +155,176 @@ static char *duplicate_c_string(const std::string &s) {
   return p;
 }
 
+/**
+ * @brief Convert C key events into their C++ counterparts.
+ * @param events Source events (may be NULL when @p count is 0).
+ * @param count Number of entries in @p events.
+ * @return Converted events, in order.
+ */
+static std::vector<axidev::io::keyboard::Sender::KeyEvent>
+to_key_events(const axidev_io_keyboard_key_event_t *events, size_t count) {
+  std::vector<axidev::io::keyboard::Sender::KeyEvent> seq(count);
+  for (size_t i = 0; i < count; ++i) {
+    seq[i].key = static_cast<axidev::io::keyboard::Key>(events[i].key);
+    seq[i].down = events[i].down;
+    seq[i].delayUs = events[i].delay_us;
+  }
+  return seq;
+}
+
+/**
+ * @brief Convert a Listener event into its C counterpart.
+ * @param ev Source event.
+ * @return The same event in the C layout.
+ */
+static axidev_io_keyboard_event_t
+to_c_event(const axidev::io::keyboard::Listener::Event &ev) {
+  axidev_io_keyboard_event_t out;
+  out.codepoint = static_cast<uint32_t>(ev.codepoint);
+  out.key_mod.key = static_cast<axidev_io_keyboard_key_t>(ev.keyMod.key);
+  out.key_mod.mods = static_cast<axidev_io_keyboard_modifier_t>(
+      static_cast<uint8_t>(ev.keyMod.requiredMods));
+  out.pressed = ev.pressed;
+  out.timestamp_ns = ev.timestampNs;
+  out.os_timestamp_ns = ev.osTimestampNs;
+  out.device_id = ev.deviceId;
+  return out;
+}
+
+/**
+ * @brief Convert a C listener event into its C++ counterpart.
+ * @param ev Source event.
+ * @return The same event in the C++ layout.
+ */
+static axidev::io::keyboard::Listener::Event
+from_c_event(const axidev_io_keyboard_event_t &ev) {
+  axidev::io::keyboard::Listener::Event out;
+  out.codepoint = static_cast<char32_t>(ev.codepoint);
+  out.keyMod.key = static_cast<axidev::io::keyboard::Key>(ev.key_mod.key);
+  out.keyMod.requiredMods =
+      static_cast<axidev::io::keyboard::Modifier>(ev.key_mod.mods);
+  out.pressed = ev.pressed;
+  out.timestampNs = ev.timestamp_ns;
+  out.osTimestampNs = ev.os_timestamp_ns;
+  out.deviceId = ev.device_id;
+  return out;
+}
+
+/// Events handed to a batch callback at most, unless the caller says
+/// otherwise.
+constexpr size_t kDefaultListenerBatch = 64;
+
+/**
+ * @brief Body of the batch dispatcher thread.
+ *
+ * Drains everything pending, @p max_batch events per callback, then waits
+ * for more. The stop flag is read before draining: `stop()` stops the
+ * listener before raising it, so the events queued until then are still
+ * delivered. The wait has no timeout; `stop_batch_dispatch()` wakes it.
+ */
+static void run_batch_dispatch(ListenerWrapper *w,
+                               axidev_io_keyboard_listener_batch_cb cb,
+                               void *user_data, size_t max_batch) {
+  std::vector<axidev::io::keyboard::Listener::Event> events(max_batch);
+  std::vector<axidev_io_keyboard_event_t> c_events(max_batch);
+  for (;;) {
+    const bool stopping = w->batchStop.load(std::memory_order_acquire);
+    size_t n;
+    while ((n = w->listener.poll(events)) > 0) {
+      for (size_t i = 0; i < n; ++i)
+        c_events[i] = to_c_event(events[i]);
+      cb(c_events.data(), n, user_data);
+    }
+    if (stopping)
+      return;
+    w->listener.waitForEvents(
+        axidev::io::keyboard::Listener::kWaitInfinite);
+  }
+}
+
+/**
+ * @brief Stop and join the batch dispatcher of @p w, if one runs.
+ *
+ * The listener must already be stopped. From inside the batch callback the
+ * dispatcher is only told to exit; it is joined by the next start or
+ * destroy.
+ */
+static void stop_batch_dispatch(ListenerWrapper *w) {
+  if (!w->batchThread.joinable())
+    return;
+  w->batchStop.store(true, std::memory_order_release);
+  // Also when called from the callback: the dispatcher's next wait then
+  // returns at once instead of blocking for good.
+  w->listener.wakeWaiter();
+  if (w->batchThread.get_id() == std::this_thread::get_id())
+    return;
+  w->batchThread.join();
+}
+
+static_assert(AXIDEV_IO_LISTENER_HISTOGRAM_BUCKETS ==
+                  axidev::io::keyboard::Listener::kCallbackHistogramBuckets,
+              "C and C++ histogram sizes must match");
+
+/**
+ * @brief Accumulate string pieces into a caller-provided buffer with
+ * `snprintf`-style truncation.
+ *
+ * At most `size - 1` bytes are copied and the result is always
+ * null-terminated when `size > 0`; `finish()` reports the untruncated length.
+ */
+class BufferWriter {
+public:
+  BufferWriter(char *buf, size_t size) : buf_(buf), size_(size) {}
+
+  void append(std::string_view piece) {
+    if (size_ > 0 && written_ < size_ - 1) {
+      size_t n = std::min(piece.size(), size_ - 1 - written_);
+      std::memcpy(buf_ + written_, piece.data(), n);
+      written_ += n;
+    }
+    total_ += piece.size();
+  }
+
+  size_t finish() {
+    if (size_ > 0) {
+      buf_[written_] = '\0';
+    }
+    return total_;
+  }
+
+private:
+  char *buf_;
+  size_t size_;
+  size_t written_{0};
+  size_t total_{0};
+};
+
+/**
+ * @brief C sink registered through `axidev_io_log_set_sink`.
+ *
+ * Each registration allocates a new slot so the previous one can be freed
+ * once `setSink` guarantees it is no longer in use.
+ */
+struct CLogSink {
+  axidev_io_log_sink_cb cb;
+  void *user_data;
+};
+
+std::mutex g_log_sink_mutex;
+std::unique_ptr<CLogSink> g_log_sink;
+
+void c_log_sink_trampoline(const axidev::io::log::Record &record,
+                           void *user_data) {
+  const auto *slot = static_cast<const CLogSink *>(user_data);
+  axidev_io_log_record_t rec;
+  rec.level = static_cast<axidev_io_log_level_t>(record.level);
+  rec.file = record.file;
+  rec.line = record.line;
+  rec.timestamp_us = record.timestampUs;
+  rec.message = record.message;
+  slot->cb(&rec, slot->user_data);
+}
+
 } // namespace
 
 #ifdef __cplusplus
@@ -167,6 +386,27 @@ axidev_io_keyboard_sender_is_ready(axidev_io_keyboard_sender_t sender) {
   }
 }
 
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait_until_ready(axidev_io_keyboard_sender_t sender,
+                                           uint32_t timeout_ms) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.waitUntilReady(timeout_ms);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_wait_until_ready");
+    return false;
+  }
+}
+
 AXIDEV_IO_API uint8_t
 axidev_io_keyboard_sender_type(axidev_io_keyboard_sender_t sender) {
   if (!sender) {
@@ -309,6 +549,226 @@ axidev_io_keyboard_sender_tap(axidev_io_keyboard_sender_t sender,
   }
 }
 
+AXIDEV_IO_API size_t axidev_io_keyboard_sender_tap_keys(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_with_modifier_t *keys, size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  if (!keys && count > 0) {
+    set_last_error("keys is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    for (size_t i = 0; i < count; ++i) {
+      axidev::io::keyboard::KeyWithModifier kwm{
+          static_cast<axidev::io::keyboard::Key>(keys[i].key),
+          static_cast<axidev::io::keyboard::Modifier>(keys[i].mods)};
+      if (!w->sender.tap(kwm)) {
+        set_last_error("tap failed at index " + std::to_string(i));
+        return i;
+      }
+    }
+    return count;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_tap_keys");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_keyboard_sender_send_sequence(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_event_t *events, size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!events && count > 0) {
+    set_last_error("events is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.sendSequence(to_key_events(events, count));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_send_sequence");
+    return false;
+  }
+}
+
+/**
+ * @brief Heap-allocate a wrapper for @p sequence, or record why it failed.
+ * @param sequence Freshly compiled sequence.
+ * @return Opaque handle, or nullptr if @p sequence is invalid or on OOM.
+ */
+static axidev_io_keyboard_compiled_t
+wrap_compiled(axidev::io::keyboard::CompiledSequence sequence) {
+  if (!sequence.valid()) {
+    set_last_error("Failed to compile sequence");
+    return nullptr;
+  }
+  CompiledWrapper *c = new (std::nothrow) CompiledWrapper();
+  if (!c) {
+    set_last_error("Out of memory (compiled sequence)");
+    return nullptr;
+  }
+  c->sequence = std::move(sequence);
+  return reinterpret_cast<axidev_io_keyboard_compiled_t>(c);
+}
+
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_sequence(
+    axidev_io_keyboard_sender_t sender,
+    const axidev_io_keyboard_key_event_t *events, size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return nullptr;
+  }
+  if (!events && count > 0) {
+    set_last_error("events is NULL");
+    return nullptr;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return wrap_compiled(w->sender.compile(to_key_events(events, count)));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_compile_sequence");
+    return nullptr;
+  }
+}
+
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_text_utf32(axidev_io_keyboard_sender_t sender,
+                                             const uint32_t *codepoints,
+                                             size_t count) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return nullptr;
+  }
+  if (!codepoints && count > 0) {
+    set_last_error("codepoints is NULL");
+    return nullptr;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    std::u32string text(count, U'\0');
+    for (size_t i = 0; i < count; ++i) {
+      text[i] = static_cast<char32_t>(codepoints[i]);
+    }
+    return wrap_compiled(w->sender.compile(std::u32string_view(text)));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_compile_text_utf32");
+    return nullptr;
+  }
+}
+
+AXIDEV_IO_API axidev_io_keyboard_compiled_t
+axidev_io_keyboard_sender_compile_text_utf8(axidev_io_keyboard_sender_t sender,
+                                            const char *utf8_text) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return nullptr;
+  }
+  if (!utf8_text) {
+    set_last_error("utf8_text is NULL");
+    return nullptr;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return wrap_compiled(w->sender.compile(std::string_view(utf8_text)));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_compile_text_utf8");
+    return nullptr;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_replay(axidev_io_keyboard_sender_t sender,
+                                 axidev_io_keyboard_compiled_t compiled) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!compiled) {
+    set_last_error("compiled is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    CompiledWrapper *c = reinterpret_cast<CompiledWrapper *>(compiled);
+    return w->sender.replay(c->sequence);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_replay");
+    return false;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_compiled_is_valid(axidev_io_keyboard_compiled_t compiled) {
+  if (!compiled) {
+    set_last_error("compiled is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    CompiledWrapper *c = reinterpret_cast<CompiledWrapper *>(compiled);
+    return c->sequence.valid();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_compiled_is_valid");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_compiled_destroy(axidev_io_keyboard_compiled_t compiled) {
+  if (!compiled) {
+    return;
+  }
+  try {
+    clear_last_error();
+    CompiledWrapper *c = reinterpret_cast<CompiledWrapper *>(compiled);
+    delete c;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_compiled_destroy");
+  }
+}
+
 AXIDEV_IO_API axidev_io_keyboard_modifier_t
 axidev_io_keyboard_sender_active_modifiers(axidev_io_keyboard_sender_t sender) {
   if (!sender) {
@@ -408,7 +868,7 @@ axidev_io_keyboard_sender_type_text_utf8(axidev_io_keyboard_sender_t sender,
   try {
     clear_last_error();
     SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
-    return w->sender.typeText(std::string(utf8_text));
+    return w->sender.typeText(std::string_view(utf8_text));
   } catch (const std::exception &e) {
     set_last_error(e.what());
     return false;
@@ -419,6 +879,32 @@ axidev_io_keyboard_sender_type_text_utf8(axidev_io_keyboard_sender_t sender,
   }
 }
 
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_type_text_utf8_n(axidev_io_keyboard_sender_t sender,
+                                         const char *utf8_text,
+                                         size_t length) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  if (!utf8_text && length > 0) {
+    set_last_error("utf8_text is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeText(std::string_view(utf8_text, length));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_type_text_utf8_n");
+    return false;
+  }
+}
+
 AXIDEV_IO_API bool
 axidev_io_keyboard_sender_type_character(axidev_io_keyboard_sender_t sender,
                                        uint32_t codepoint) {
@@ -476,9 +962,302 @@ axidev_io_keyboard_sender_set_key_delay(axidev_io_keyboard_sender_t sender,
   }
 }
 
-/* ---------------- Listener implementation ---------------- */
-
-AXIDEV_IO_API axidev_io_keyboard_listener_t axidev_io_keyboard_listener_create(void) {
+AXIDEV_IO_API void axidev_io_keyboard_sender_set_key_delay_spin(
+    axidev_io_keyboard_sender_t sender, uint32_t spin_us) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.setKeyDelaySpin(spin_us);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_set_key_delay_spin");
+  }
+}
+
+AXIDEV_IO_API void axidev_io_keyboard_sender_set_text_batch_size(
+    axidev_io_keyboard_sender_t sender, size_t characters) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.setTextBatchSize(characters);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_set_text_batch_size");
+  }
+}
+
+AXIDEV_IO_API size_t
+axidev_io_keyboard_sender_last_typed_count(axidev_io_keyboard_sender_t sender) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.lastTypedCount();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_last_typed_count");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_start_async(axidev_io_keyboard_sender_t sender,
+                                      size_t capacity) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    if (capacity == 0)
+      capacity = axidev::io::keyboard::Sender::kDefaultAsyncCapacity;
+    return w->sender.startAsync(capacity);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_start_async");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_sender_stop_async(axidev_io_keyboard_sender_t sender) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.stopAsync();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_stop_async");
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_tap_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    axidev::io::keyboard::KeyWithModifier kwm{
+        static_cast<axidev::io::keyboard::Key>(key_mod.key),
+        static_cast<axidev::io::keyboard::Modifier>(key_mod.mods)};
+    return w->sender.tapAsync(kwm);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_tap_async");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_key_down_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    axidev::io::keyboard::KeyWithModifier kwm{
+        static_cast<axidev::io::keyboard::Key>(key_mod.key),
+        static_cast<axidev::io::keyboard::Modifier>(key_mod.mods)};
+    return w->sender.keyDownAsync(kwm);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_key_down_async");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_key_up_async(
+    axidev_io_keyboard_sender_t sender,
+    axidev_io_keyboard_key_with_modifier_t key_mod) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    axidev::io::keyboard::KeyWithModifier kwm{
+        static_cast<axidev::io::keyboard::Key>(key_mod.key),
+        static_cast<axidev::io::keyboard::Modifier>(key_mod.mods)};
+    return w->sender.keyUpAsync(kwm);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_key_up_async");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_type_text_utf8_async(
+    axidev_io_keyboard_sender_t sender, const char *utf8_text) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  if (!utf8_text) {
+    set_last_error("utf8_text is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeTextAsync(std::string(utf8_text));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_type_text_utf8_async");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_sender_type_text_utf8_n_async(
+    axidev_io_keyboard_sender_t sender, const char *utf8_text, size_t length) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  if (!utf8_text && length > 0) {
+    set_last_error("utf8_text is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.typeTextAsync(std::string(utf8_text, length));
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in "
+                   "axidev_io_keyboard_sender_type_text_utf8_n_async");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait(axidev_io_keyboard_sender_t sender,
+                               uint64_t ticket, uint32_t timeout_ms) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.wait(ticket, timeout_ms);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_wait");
+    return false;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_sender_wait_idle(axidev_io_keyboard_sender_t sender,
+                                    uint32_t timeout_ms) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.waitIdle(timeout_ms);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_sender_wait_idle");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_sender_cancel_pending(axidev_io_keyboard_sender_t sender) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    w->sender.cancelPending();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_cancel_pending");
+  }
+}
+
+AXIDEV_IO_API uint64_t
+axidev_io_keyboard_sender_async_failures(axidev_io_keyboard_sender_t sender) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    SenderWrapper *w = reinterpret_cast<SenderWrapper *>(sender);
+    return w->sender.asyncFailures();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_sender_async_failures");
+    return 0;
+  }
+}
+
+/* ---------------- Listener implementation ---------------- */
+
+AXIDEV_IO_API axidev_io_keyboard_listener_t axidev_io_keyboard_listener_create(void) {
   try {
     clear_last_error();
     ListenerWrapper *w = new (std::nothrow) ListenerWrapper();
@@ -486,178 +1265,803 @@ AXIDEV_IO_API axidev_io_keyboard_listener_t axidev_io_keyboard_listener_create(v
       set_last_error("Out of memory (listener)");
       return nullptr;
     }
-    return reinterpret_cast<axidev_io_keyboard_listener_t>(w);
+    return reinterpret_cast<axidev_io_keyboard_listener_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_create");
+    return nullptr;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_listener_destroy(axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    return;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    // The dispatcher cannot join itself, and it still uses the wrapper once
+    // the callback returns.
+    if (w->batchThread.joinable() &&
+        w->batchThread.get_id() == std::this_thread::get_id()) {
+      set_last_error("listener cannot be destroyed from its batch callback");
+      return;
+    }
+    // Ensure the listener is stopped before destroying to avoid races with
+    // callbacks originating from background threads.
+    try {
+      w->listener.stop();
+    } catch (...) {
+      // Ignore stop failures; we still proceed to delete the wrapper.
+    }
+    stop_batch_dispatch(w);
+    delete w;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_destroy");
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_start(axidev_io_keyboard_listener_t listener,
+                                axidev_io_keyboard_listener_cb cb,
+                                void *user_data) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!cb) {
+    set_last_error("callback is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+
+    /**
+     * @internal
+     * @brief Bridge that forwards `axidev::io::keyboard::Listener` events to the
+     * C callback.
+     *
+     * Responsibilities:
+     *  - Carry the C callback pointer and `user_data` captured by value, so
+     *    the per-event path takes no lock. The listener publishes the bridge
+     *    before its event thread starts and drops it after `stop()`.
+     *  - Convert/normalize types for the C ABI: `char32_t` -> `uint32_t`,
+     *    `axidev::io::keyboard::Key` -> `axidev_io_keyboard_key_t`,
+     * `axidev::io::keyboard::Modifier` -> `axidev_io_modifier_t`.
+     *  - Invoke the user-supplied C callback if present. Any exceptions thrown
+     *    by the C callback are caught and swallowed to prevent exceptions from
+     *    escaping into the C++ internals (unwinding across the C ABI is
+     * undefined).
+     *
+     * Notes:
+     *  - This lambda is invoked on the listener's internal thread. The C
+     *    callback must be thread-safe and avoid long/blocking operations.
+     */
+    auto bridge = [cb, user_data](char32_t codepoint,
+                                  axidev::io::keyboard::KeyWithModifier keyMod,
+                                  bool pressed) {
+      try {
+        axidev_io_keyboard_key_with_modifier_t c_key_mod;
+        c_key_mod.key = static_cast<axidev_io_keyboard_key_t>(keyMod.key);
+        c_key_mod.mods = static_cast<axidev_io_keyboard_modifier_t>(
+            static_cast<uint8_t>(keyMod.requiredMods));
+
+        cb(static_cast<uint32_t>(codepoint), c_key_mod, pressed, user_data);
+      } catch (...) {
+        // Swallow exceptions from user-provided C callbacks to avoid letting
+        // them unwind into C++ internals.
+      }
+    };
+
+    return w->listener.start(bridge);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_start");
+    return false;
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_keyboard_listener_start_with_events(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_event_cb cb, void *user_data) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!cb) {
+    set_last_error("callback is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+
+    // Same contract as the bridge in axidev_io_keyboard_listener_start: the
+    // C callback is captured by value and its exceptions never escape.
+    auto bridge = [cb,
+                   user_data](const axidev::io::keyboard::Listener::Event &ev) {
+      try {
+        const axidev_io_keyboard_event_t c_event = to_c_event(ev);
+        cb(&c_event, user_data);
+      } catch (...) {
+      }
+    };
+
+    return w->listener.startWithEvents(bridge);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_start_with_events");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_listener_stop(axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    // stop() joins the event thread and releases the bridge, so no further
+    // events reach the C callback after this returns.
+    w->listener.stop();
+    stop_batch_dispatch(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_stop");
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_is_listening(axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    return w->listener.isListening();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_is_listening");
+    return false;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_start_queued(axidev_io_keyboard_listener_t listener,
+                                         size_t capacity) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    if (capacity == 0)
+      capacity = axidev::io::keyboard::Listener::kDefaultQueueCapacity;
+    return w->listener.startQueued(capacity);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_start_queued");
+    return false;
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_keyboard_listener_start_batched(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_batch_cb cb, void *user_data,
+    size_t capacity, size_t max_batch) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!cb) {
+    set_last_error("callback is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    if (w->listener.isListening()) {
+      set_last_error("listener is already listening");
+      return false;
+    }
+    // Collect a dispatcher that was stopped from its own callback.
+    stop_batch_dispatch(w);
+    if (w->batchThread.joinable()) {
+      set_last_error("batch callback is still running");
+      return false;
+    }
+    if (capacity == 0)
+      capacity = axidev::io::keyboard::Listener::kDefaultQueueCapacity;
+    if (max_batch == 0)
+      max_batch = kDefaultListenerBatch;
+    if (!w->listener.startQueued(capacity))
+      return false;
+    w->batchStop.store(false, std::memory_order_relaxed);
+    try {
+      w->batchThread = std::thread(run_batch_dispatch, w, cb, user_data,
+                                   max_batch);
+    } catch (...) {
+      w->listener.stop();
+      throw;
+    }
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_start_batched");
+    return false;
+  }
+}
+
+AXIDEV_IO_API size_t
+axidev_io_keyboard_listener_poll(axidev_io_keyboard_listener_t listener,
+                                 axidev_io_keyboard_event_t *out_events,
+                                 size_t max_events) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return 0;
+  }
+  if (!out_events && max_events > 0) {
+    set_last_error("out_events is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+
+    // Drain through a small stack buffer and convert to the C layout.
+    axidev::io::keyboard::Listener::Event chunk[64];
+    size_t total = 0;
+    while (total < max_events) {
+      size_t want = std::min(max_events - total, std::size(chunk));
+      size_t got = w->listener.poll(std::span(chunk, want));
+      for (size_t i = 0; i < got; ++i)
+        out_events[total + i] = to_c_event(chunk[i]);
+      total += got;
+      if (got < want)
+        break;
+    }
+    return total;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_poll");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API bool
+axidev_io_keyboard_listener_wait(axidev_io_keyboard_listener_t listener,
+                                 uint32_t timeout_ms) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    return w->listener.waitForEvents(timeout_ms);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_listener_wait");
+    return false;
+  }
+}
+
+AXIDEV_IO_API intptr_t
+axidev_io_keyboard_listener_wait_handle(axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return -1;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    return w->listener.eventWaitHandle();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return -1;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_wait_handle");
+    return -1;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_listener_dropped_events(
+    axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    return w->listener.droppedEvents();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_dropped_events");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_keyboard_listener_get_stats(
+    axidev_io_keyboard_listener_t listener,
+    axidev_io_keyboard_listener_stats_t *out_stats) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (!out_stats) {
+    set_last_error("out_stats is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    const axidev::io::keyboard::Listener::Stats stats = w->listener.stats();
+    out_stats->events_seen = stats.eventsSeen;
+    out_stats->events_dropped = stats.eventsDropped;
+    out_stats->events_filtered = stats.eventsFiltered;
+    out_stats->callback_time_max_ns = stats.callbackTimeMaxNs;
+    std::copy(stats.callbackTimeHistogram.begin(),
+              stats.callbackTimeHistogram.end(),
+              out_stats->callback_time_histogram);
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_get_stats");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_listener_reset_stats(axidev_io_keyboard_listener_t listener) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    w->listener.resetStats();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_reset_stats");
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_keyboard_listener_set_filter(
+    axidev_io_keyboard_listener_t listener,
+    const axidev_io_keyboard_listener_filter_t *filter) {
+  if (!listener) {
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (filter && ((!filter->keys && filter->key_count > 0) ||
+                 (!filter->chords && filter->chord_count > 0))) {
+    set_last_error("filter array is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    axidev::io::keyboard::Listener::Filter spec;
+    if (filter) {
+      for (size_t i = 0; i < filter->key_count; ++i)
+        spec.addKey(static_cast<axidev::io::keyboard::Key>(filter->keys[i]));
+      for (size_t i = 0; i < filter->chord_count; ++i)
+        spec.addChord(axidev::io::keyboard::KeyWithModifier{
+            static_cast<axidev::io::keyboard::Key>(filter->chords[i].key),
+            static_cast<axidev::io::keyboard::Modifier>(
+                filter->chords[i].mods)});
+      spec.pressOnly = filter->press_only;
+      spec.needCodepoint = filter->need_codepoint;
+    }
+    if (!w->listener.setFilter(std::move(spec))) {
+      set_last_error("cannot change the filter while listening");
+      return false;
+    }
+    return true;
   } catch (const std::exception &e) {
     set_last_error(e.what());
-    return nullptr;
+    return false;
   } catch (...) {
-    set_last_error("Unknown exception in axidev_io_keyboard_listener_create");
-    return nullptr;
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_set_filter");
+    return false;
   }
 }
 
-AXIDEV_IO_API void
-axidev_io_keyboard_listener_destroy(axidev_io_keyboard_listener_t listener) {
+AXIDEV_IO_API bool axidev_io_keyboard_listener_set_sources(
+    axidev_io_keyboard_listener_t listener,
+    const axidev_io_keyboard_listener_sources_t *sources) {
   if (!listener) {
-    return;
+    set_last_error("listener is NULL");
+    return false;
+  }
+  if (sources && ((!sources->seats && sources->seat_count > 0) ||
+                  (!sources->device_paths && sources->device_path_count > 0))) {
+    set_last_error("sources array is NULL");
+    return false;
   }
   try {
     clear_last_error();
     ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
-    // Ensure the listener is stopped before destroying to avoid races with
-    // callbacks originating from background threads.
-    try {
-      w->listener.stop();
-    } catch (...) {
-      // Ignore stop failures; we still proceed to delete the wrapper.
+    axidev::io::keyboard::Listener::Sources spec;
+    if (sources) {
+      for (size_t i = 0; i < sources->seat_count; ++i) {
+        if (!sources->seats[i]) {
+          set_last_error("seat name is NULL");
+          return false;
+        }
+        spec.addSeat(sources->seats[i]);
+      }
+      for (size_t i = 0; i < sources->device_path_count; ++i) {
+        if (!sources->device_paths[i]) {
+          set_last_error("device path is NULL");
+          return false;
+        }
+        spec.addDevicePath(sources->device_paths[i]);
+      }
     }
-    delete w;
+    const bool listening = w->listener.isListening();
+    if (!w->listener.setSources(std::move(spec))) {
+      set_last_error(listening
+                         ? "cannot change the sources while listening"
+                         : "seats and device paths are not supported here");
+      return false;
+    }
+    return true;
   } catch (const std::exception &e) {
     set_last_error(e.what());
+    return false;
   } catch (...) {
-    set_last_error("Unknown exception in axidev_io_keyboard_listener_destroy");
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_listener_set_sources");
+    return false;
   }
 }
 
-AXIDEV_IO_API bool
-axidev_io_keyboard_listener_start(axidev_io_keyboard_listener_t listener,
-                                axidev_io_keyboard_listener_cb cb,
-                                void *user_data) {
+AXIDEV_IO_API bool axidev_io_keyboard_measure_round_trip(
+    axidev_io_keyboard_sender_t sender, axidev_io_keyboard_listener_t listener,
+    uint32_t count, uint32_t timeout_ms,
+    axidev_io_keyboard_round_trip_t *out_result) {
+  if (!sender) {
+    set_last_error("sender is NULL");
+    return false;
+  }
   if (!listener) {
     set_last_error("listener is NULL");
     return false;
   }
-  if (!cb) {
-    set_last_error("callback is NULL");
+  if (!out_result) {
+    set_last_error("out_result is NULL");
     return false;
   }
   try {
     clear_last_error();
-    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
+    SenderWrapper *s = reinterpret_cast<SenderWrapper *>(sender);
+    ListenerWrapper *l = reinterpret_cast<ListenerWrapper *>(listener);
+    axidev::io::keyboard::RoundTripOptions options;
+    options.timeoutMs = timeout_ms;
+    axidev::io::keyboard::RoundTripHistogram latency;
+    if (!axidev::io::keyboard::measureRoundTrip(s->sender, l->listener, count,
+                                                latency, options)) {
+      set_last_error(l->listener.isListening()
+                         ? "listener is already listening"
+                         : "round trip probe could not run");
+      return false;
+    }
+    out_result->sent = latency.sent();
+    out_result->received = latency.received();
+    out_result->lost = latency.lost();
+    out_result->min_ns = latency.minNs();
+    out_result->mean_ns = latency.meanNs();
+    out_result->p50_ns = latency.percentileNs(0.50);
+    out_result->p90_ns = latency.percentileNs(0.90);
+    out_result->p99_ns = latency.percentileNs(0.99);
+    out_result->max_ns = latency.maxNs();
+    std::copy(latency.buckets().begin(), latency.buckets().end(),
+              out_result->histogram);
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_measure_round_trip");
+    return false;
+  }
+}
 
-    // Store callback and user_data before starting to avoid a race where an
-    // internal thread invokes the callback immediately after start() returns.
-    {
-      std::lock_guard<std::mutex> lk(w->cb_mutex);
-      w->cb = cb;
-      w->user_data = user_data;
+/* ---------------- Keystroke traces ---------------- */
+
+AXIDEV_IO_API axidev_io_keyboard_trace_recorder_t
+axidev_io_keyboard_trace_recorder_create(const char *path) {
+  if (!path) {
+    set_last_error("path is NULL");
+    return nullptr;
+  }
+  try {
+    clear_last_error();
+    TraceRecorderWrapper *w = new (std::nothrow) TraceRecorderWrapper();
+    if (!w) {
+      set_last_error("Out of memory (trace recorder)");
+      return nullptr;
+    }
+    if (!w->recorder.open(path)) {
+      delete w;
+      set_last_error("Failed to create trace file");
+      return nullptr;
     }
+    return reinterpret_cast<axidev_io_keyboard_trace_recorder_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_recorder_create");
+    return nullptr;
+  }
+}
 
-    /**
-     * @internal
-     * @brief Bridge that forwards `axidev::io::keyboard::Listener` events to the
-     * C callback.
-     *
-     * Responsibilities:
-     *  - Acquire `w->cb_mutex` to safely copy the stored C callback pointer
-     *    and the associated `user_data` pointer so invocation can occur
-     *    without holding the lock.
-     *  - Convert/normalize types for the C ABI: `char32_t` -> `uint32_t`,
-     *    `axidev::io::keyboard::Key` -> `axidev_io_keyboard_key_t`,
-     * `axidev::io::keyboard::Modifier` -> `axidev_io_modifier_t`.
-     *  - Invoke the user-supplied C callback if present. Any exceptions thrown
-     *    by the C callback are caught and swallowed to prevent exceptions from
-     *    escaping into the C++ internals (unwinding across the C ABI is
-     * undefined).
-     *
-     * Notes:
-     *  - This lambda is invoked on the listener's internal thread. The C
-     *    callback must be thread-safe and avoid long/blocking operations.
-     */
-    auto bridge = [w](char32_t codepoint,
-                      axidev::io::keyboard::KeyWithModifier keyMod,
-                      bool pressed) {
-      // Forward event to C callback; protect access to cb & user_data.
-      axidev_io_keyboard_listener_cb local_cb = nullptr;
-      void *local_ud = nullptr;
-      {
-        std::lock_guard<std::mutex> lk(w->cb_mutex);
-        local_cb = w->cb;
-        local_ud = w->user_data;
-      }
-      if (local_cb) {
-        try {
-          axidev_io_keyboard_key_with_modifier_t c_key_mod;
-          c_key_mod.key = static_cast<axidev_io_keyboard_key_t>(keyMod.key);
-          c_key_mod.mods = static_cast<axidev_io_keyboard_modifier_t>(
-              static_cast<uint8_t>(keyMod.requiredMods));
-
-          local_cb(static_cast<uint32_t>(codepoint), c_key_mod, pressed,
-                   local_ud);
-        } catch (...) {
-          // Swallow exceptions from user-provided C callbacks to avoid letting
-          // them unwind into C++ internals.
-        }
-      }
-    };
+AXIDEV_IO_API bool axidev_io_keyboard_trace_recorder_record(
+    axidev_io_keyboard_trace_recorder_t recorder,
+    const axidev_io_keyboard_event_t *event) {
+  if (!recorder) {
+    set_last_error("recorder is NULL");
+    return false;
+  }
+  if (!event) {
+    set_last_error("event is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    TraceRecorderWrapper *w =
+        reinterpret_cast<TraceRecorderWrapper *>(recorder);
+    if (!w->recorder.record(from_c_event(*event))) {
+      set_last_error("Failed to write trace");
+      return false;
+    }
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_recorder_record");
+    return false;
+  }
+}
 
-    bool ok = w->listener.start(bridge);
-    if (!ok) {
-      // On failure clear stored callback so listener_destroy/stop sees a clean
-      // state.
-      std::lock_guard<std::mutex> lk(w->cb_mutex);
-      w->cb = nullptr;
-      w->user_data = nullptr;
+AXIDEV_IO_API bool axidev_io_keyboard_trace_recorder_flush(
+    axidev_io_keyboard_trace_recorder_t recorder) {
+  if (!recorder) {
+    set_last_error("recorder is NULL");
+    return false;
+  }
+  try {
+    clear_last_error();
+    TraceRecorderWrapper *w =
+        reinterpret_cast<TraceRecorderWrapper *>(recorder);
+    if (!w->recorder.flush()) {
+      set_last_error("Failed to write trace");
+      return false;
     }
-    return ok;
+    return true;
   } catch (const std::exception &e) {
     set_last_error(e.what());
     return false;
   } catch (...) {
-    set_last_error("Unknown exception in axidev_io_keyboard_listener_start");
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_recorder_flush");
     return false;
   }
 }
 
-AXIDEV_IO_API void
-axidev_io_keyboard_listener_stop(axidev_io_keyboard_listener_t listener) {
-  if (!listener) {
-    set_last_error("listener is NULL");
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_recorder_recorded_count(
+    axidev_io_keyboard_trace_recorder_t recorder) {
+  if (!recorder) {
+    set_last_error("recorder is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    TraceRecorderWrapper *w =
+        reinterpret_cast<TraceRecorderWrapper *>(recorder);
+    return w->recorder.recordedCount();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_recorder_recorded_count");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API void axidev_io_keyboard_trace_recorder_destroy(
+    axidev_io_keyboard_trace_recorder_t recorder) {
+  if (!recorder) {
     return;
   }
   try {
     clear_last_error();
-    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
-    w->listener.stop();
-    // Clear callback & user_data so subsequent events are ignored.
-    std::lock_guard<std::mutex> lk(w->cb_mutex);
-    w->cb = nullptr;
-    w->user_data = nullptr;
+    TraceRecorderWrapper *w =
+        reinterpret_cast<TraceRecorderWrapper *>(recorder);
+    delete w;
   } catch (const std::exception &e) {
     set_last_error(e.what());
   } catch (...) {
-    set_last_error("Unknown exception in axidev_io_keyboard_listener_stop");
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_recorder_destroy");
+  }
+}
+
+AXIDEV_IO_API axidev_io_keyboard_trace_player_t
+axidev_io_keyboard_trace_player_open(const char *path) {
+  if (!path) {
+    set_last_error("path is NULL");
+    return nullptr;
+  }
+  try {
+    clear_last_error();
+    TracePlayerWrapper *w = new (std::nothrow) TracePlayerWrapper();
+    if (!w) {
+      set_last_error("Out of memory (trace player)");
+      return nullptr;
+    }
+    if (!w->player.open(path)) {
+      delete w;
+      set_last_error("Failed to open trace file");
+      return nullptr;
+    }
+    return reinterpret_cast<axidev_io_keyboard_trace_player_t>(w);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return nullptr;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_keyboard_trace_player_open");
+    return nullptr;
   }
 }
 
 AXIDEV_IO_API bool
-axidev_io_keyboard_listener_is_listening(axidev_io_keyboard_listener_t listener) {
-  if (!listener) {
-    set_last_error("listener is NULL");
+axidev_io_keyboard_trace_player_play(axidev_io_keyboard_trace_player_t player,
+                                     axidev_io_keyboard_sender_t sender,
+                                     double speed, uint32_t max_pause_us) {
+  if (!player) {
+    set_last_error("player is NULL");
+    return false;
+  }
+  if (!sender) {
+    set_last_error("sender is NULL");
     return false;
   }
   try {
     clear_last_error();
-    ListenerWrapper *w = reinterpret_cast<ListenerWrapper *>(listener);
-    return w->listener.isListening();
+    TracePlayerWrapper *p = reinterpret_cast<TracePlayerWrapper *>(player);
+    SenderWrapper *s = reinterpret_cast<SenderWrapper *>(sender);
+    axidev::io::keyboard::TracePlayOptions options;
+    options.speed = speed;
+    options.maxPauseUs = max_pause_us;
+    if (!p->player.play(s->sender, options)) {
+      set_last_error("sender is not ready");
+      return false;
+    }
+    return true;
   } catch (const std::exception &e) {
     set_last_error(e.what());
     return false;
   } catch (...) {
-    set_last_error(
-        "Unknown exception in axidev_io_keyboard_listener_is_listening");
+    set_last_error("Unknown exception in axidev_io_keyboard_trace_player_play");
     return false;
   }
 }
 
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_player_played_count(
+    axidev_io_keyboard_trace_player_t player) {
+  if (!player) {
+    set_last_error("player is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    TracePlayerWrapper *w = reinterpret_cast<TracePlayerWrapper *>(player);
+    return w->player.playedCount();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_player_played_count");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_keyboard_trace_player_skipped_count(
+    axidev_io_keyboard_trace_player_t player) {
+  if (!player) {
+    set_last_error("player is NULL");
+    return 0;
+  }
+  try {
+    clear_last_error();
+    TracePlayerWrapper *w = reinterpret_cast<TracePlayerWrapper *>(player);
+    return w->player.skippedCount();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return 0;
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_player_skipped_count");
+    return 0;
+  }
+}
+
+AXIDEV_IO_API void
+axidev_io_keyboard_trace_player_destroy(axidev_io_keyboard_trace_player_t player) {
+  if (!player) {
+    return;
+  }
+  try {
+    clear_last_error();
+    TracePlayerWrapper *w = reinterpret_cast<TracePlayerWrapper *>(player);
+    delete w;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error(
+        "Unknown exception in axidev_io_keyboard_trace_player_destroy");
+  }
+}
+
 /* ---------------- Utilities ---------------- */
 
 AXIDEV_IO_API char *axidev_io_keyboard_key_to_string(axidev_io_keyboard_key_t key) {
   try {
     clear_last_error();
-    std::string s = axidev::io::keyboard::keyToString(
-        static_cast<axidev::io::keyboard::Key>(key));
-    return duplicate_c_string(s);
+    return duplicate_c_string(axidev::io::keyboard::keyToStringView(
+        static_cast<axidev::io::keyboard::Key>(key)));
   } catch (const std::exception &e) {
     set_last_error(e.what());
     return nullptr;
@@ -667,6 +2071,41 @@ AXIDEV_IO_API char *axidev_io_keyboard_key_to_string(axidev_io_keyboard_key_t ke
   }
 }
 
+AXIDEV_IO_API size_t axidev_io_keyboard_key_to_string_buf(
+    axidev_io_keyboard_key_t key, char *buf, size_t buf_size) {
+  if (!buf && buf_size > 0) {
+    set_last_error("buf is NULL");
+    return 0;
+  }
+  clear_last_error();
+  BufferWriter out(buf, buf_size);
+  out.append(axidev::io::keyboard::keyToStringView(
+      static_cast<axidev::io::keyboard::Key>(key)));
+  return out.finish();
+}
+
+AXIDEV_IO_API size_t axidev_io_keyboard_keys_to_string_buf(
+    const axidev_io_keyboard_key_t *keys, size_t count, char separator,
+    char *buf, size_t buf_size) {
+  if (!keys && count > 0) {
+    set_last_error("keys is NULL");
+    return 0;
+  }
+  if (!buf && buf_size > 0) {
+    set_last_error("buf is NULL");
+    return 0;
+  }
+  clear_last_error();
+  BufferWriter out(buf, buf_size);
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0)
+      out.append(std::string_view(&separator, 1));
+    out.append(axidev::io::keyboard::keyToStringView(
+        static_cast<axidev::io::keyboard::Key>(keys[i])));
+  }
+  return out.finish();
+}
+
 AXIDEV_IO_API axidev_io_keyboard_key_t
 axidev_io_keyboard_string_to_key(const char *name) {
   if (!name) {
@@ -677,7 +2116,7 @@ axidev_io_keyboard_string_to_key(const char *name) {
   try {
     clear_last_error();
     axidev::io::keyboard::Key k =
-        axidev::io::keyboard::stringToKey(std::string(name));
+        axidev::io::keyboard::stringToKey(name);
     return static_cast<axidev_io_keyboard_key_t>(k);
   } catch (const std::exception &e) {
     set_last_error(e.what());
@@ -708,6 +2147,31 @@ AXIDEV_IO_API char *axidev_io_keyboard_key_to_string_with_modifier(
   }
 }
 
+AXIDEV_IO_API size_t axidev_io_keyboard_key_to_string_with_modifier_buf(
+    axidev_io_keyboard_key_with_modifier_t key_mod, char *buf,
+    size_t buf_size) {
+  using axidev::io::keyboard::Modifier;
+  if (!buf && buf_size > 0) {
+    set_last_error("buf is NULL");
+    return 0;
+  }
+  clear_last_error();
+  const auto mods = static_cast<Modifier>(key_mod.mods);
+  // Same prefix order as keyToStringWithModifier().
+  BufferWriter out(buf, buf_size);
+  if (axidev::io::keyboard::hasModifier(mods, Modifier::Super))
+    out.append("Super+");
+  if (axidev::io::keyboard::hasModifier(mods, Modifier::Ctrl))
+    out.append("Ctrl+");
+  if (axidev::io::keyboard::hasModifier(mods, Modifier::Alt))
+    out.append("Alt+");
+  if (axidev::io::keyboard::hasModifier(mods, Modifier::Shift))
+    out.append("Shift+");
+  out.append(axidev::io::keyboard::keyToStringView(
+      static_cast<axidev::io::keyboard::Key>(key_mod.key)));
+  return out.finish();
+}
+
 AXIDEV_IO_API bool axidev_io_keyboard_string_to_key_with_modifier(
     const char *combo, axidev_io_keyboard_key_with_modifier_t *out_key_mod) {
   if (!combo) {
@@ -721,7 +2185,7 @@ AXIDEV_IO_API bool axidev_io_keyboard_string_to_key_with_modifier(
   try {
     clear_last_error();
     auto kwm =
-        axidev::io::keyboard::stringToKeyWithModifier(std::string(combo));
+        axidev::io::keyboard::stringToKeyWithModifier(combo);
     out_key_mod->key = static_cast<axidev_io_keyboard_key_t>(kwm.key);
     out_key_mod->mods = static_cast<axidev_io_keyboard_modifier_t>(
         static_cast<uint8_t>(kwm.requiredMods));
@@ -816,6 +2280,60 @@ AXIDEV_IO_API bool axidev_io_log_is_enabled(axidev_io_log_level_t level) {
   }
 }
 
+AXIDEV_IO_API void axidev_io_log_set_sink(axidev_io_log_sink_cb sink,
+                                          void *user_data) {
+  try {
+    clear_last_error();
+    std::lock_guard<std::mutex> lk(g_log_sink_mutex);
+    std::unique_ptr<CLogSink> next;
+    if (sink) {
+      next = std::make_unique<CLogSink>(CLogSink{sink, user_data});
+      axidev::io::log::setSink(c_log_sink_trampoline, next.get());
+    } else {
+      axidev::io::log::setSink(nullptr);
+    }
+    g_log_sink = std::move(next);
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_log_set_sink");
+  }
+}
+
+AXIDEV_IO_API bool axidev_io_log_start_async(size_t capacity) {
+  try {
+    clear_last_error();
+    if (!axidev::io::log::startAsync(
+            capacity == 0 ? axidev::io::log::kDefaultAsyncCapacity
+                          : capacity)) {
+      set_last_error("Failed to start the async log writer");
+      return false;
+    }
+    return true;
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+    return false;
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_log_start_async");
+    return false;
+  }
+}
+
+AXIDEV_IO_API void axidev_io_log_stop_async(void) {
+  try {
+    clear_last_error();
+    axidev::io::log::stopAsync();
+  } catch (const std::exception &e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("Unknown exception in axidev_io_log_stop_async");
+  }
+}
+
+AXIDEV_IO_API uint64_t axidev_io_log_dropped_messages(void) {
+  return axidev::io::log::droppedMessages();
+}
+
 AXIDEV_IO_API void axidev_io_log_message(axidev_io_log_level_t level,
                                      const char *file, int line,
                                      const char *fmt, ...) {
@@ -0,0 +1,247 @@
+#pragma once
+/**
+ * @file keyboard/common/flat_keymap.hpp
+ * @brief Internal flat lookup tables backing the keyboard layout mappings.
+ *
+ * Every mapping the backends consult per key event is keyed by a small dense
+ * integer: `Key` is a `uint16_t` enum, evdev / VK / CGKeyCode values are all
+ * below 0x10000 and only three modifier bits take part in (keycode, mods)
+ * lookups. These tables index plain arrays instead of hashing, so a lookup is
+ * a bounds check and a load.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the keyboard backends.
+ */
+
+#include <axidev-io/keyboard/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace axidev::io::keyboard::detail {
+
+/// Largest index (exclusive) a dense table grows to.
+inline constexpr size_t kMaxDenseSlots = 0x10000;
+
+/**
+ * @brief Array indexed by a `Key` or a non-negative platform keycode.
+ *
+ * Slots holding @p kAbsent are empty. The table grows on insertion up to the
+ * largest index seen; lookups outside that range report absence. Insertion
+ * keeps the first value stored for an index, matching how the layout
+ * discovery passes prefer their earliest match.
+ *
+ * @tparam Index `Key` or an integral keycode type.
+ * @tparam Value Stored value type.
+ * @tparam kAbsent Sentinel marking an empty slot.
+ */
+template <typename Index, typename Value, Value kAbsent> class DenseTable {
+public:
+  /// Pointer to the value stored for @p index, or nullptr when absent.
+  const Value *find(Index index) const noexcept {
+    const size_t slot = toSlot(index);
+    if (slot >= slots_.size() || slots_[slot] == kAbsent)
+      return nullptr;
+    return &slots_[slot];
+  }
+
+  /**
+   * @brief Store @p value for @p index unless a value is already present.
+   * @return true when the value was stored.
+   */
+  bool insert(Index index, Value value) {
+    const size_t slot = toSlot(index);
+    if (slot >= kMaxDenseSlots || value == kAbsent)
+      return false;
+    if (slot >= slots_.size())
+      slots_.resize(slot + 1, kAbsent);
+    if (slots_[slot] != kAbsent)
+      return false;
+    slots_[slot] = value;
+    ++size_;
+    return true;
+  }
+
+  /// Call `fn(Index index, Value value)` for every occupied slot, in index
+  /// order.
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+      if (slots_[slot] != kAbsent)
+        fn(static_cast<Index>(slot), slots_[slot]);
+    }
+  }
+
+  /// Number of occupied slots.
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+private:
+  static size_t toSlot(Index index) noexcept {
+    if constexpr (std::is_enum_v<Index>) {
+      return static_cast<size_t>(index);
+    } else {
+      return index < 0 ? kMaxDenseSlots : static_cast<size_t>(index);
+    }
+  }
+
+  std::vector<Value> slots_;
+  size_t size_{0};
+};
+
+/// Logical key -> platform keycode (Sender side).
+using KeyCodeTable = DenseTable<Key, int32_t, -1>;
+
+/// Platform keycode -> logical key produced without modifiers.
+using CodeKeyTable = DenseTable<int32_t, Key, Key::Unknown>;
+
+/**
+ * @brief (platform keycode, modifiers) -> logical key produced.
+ *
+ * Each keycode owns a row of eight slots indexed by the Shift/Ctrl/Alt bits
+ * of the modifier state. Modifiers outside @p relevant are ignored on both
+ * insertion and lookup, so a platform that only distinguishes Shift and Alt
+ * resolves Ctrl+Shift+1 like Shift+1.
+ */
+class CodeModsKeyTable {
+public:
+  explicit CodeModsKeyTable(Modifier relevant = Modifier::Shift |
+                                                Modifier::Ctrl |
+                                                Modifier::Alt) noexcept
+      : mask_(static_cast<uint8_t>(static_cast<uint8_t>(relevant) &
+                                   kSlotMask)) {}
+
+  /// Pointer to the key stored for (@p keycode, @p mods), or nullptr.
+  const Key *find(int32_t keycode, Modifier mods) const noexcept {
+    if (keycode < 0 || static_cast<size_t>(keycode) >= rows_.size())
+      return nullptr;
+    const Key &key = rows_[static_cast<size_t>(keycode)][slot(mods)];
+    return key == Key::Unknown ? nullptr : &key;
+  }
+
+  /**
+   * @brief Store @p key for (@p keycode, @p mods) unless already present.
+   * @return true when the key was stored.
+   */
+  bool insert(int32_t keycode, Modifier mods, Key key) {
+    if (keycode < 0 || static_cast<size_t>(keycode) >= kMaxDenseSlots ||
+        key == Key::Unknown)
+      return false;
+    const size_t row = static_cast<size_t>(keycode);
+    if (row >= rows_.size())
+      rows_.resize(row + 1, Row{});
+    Key &stored = rows_[row][slot(mods)];
+    if (stored != Key::Unknown)
+      return false;
+    stored = key;
+    ++size_;
+    return true;
+  }
+
+  /// Call `fn(int32_t keycode, Modifier mods, Key key)` for every stored key;
+  /// @p mods only holds bits this table takes into account.
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (size_t row = 0; row < rows_.size(); ++row) {
+      for (size_t s = 0; s < rows_[row].size(); ++s) {
+        if (rows_[row][s] != Key::Unknown)
+          fn(static_cast<int32_t>(row), static_cast<Modifier>(s),
+             rows_[row][s]);
+      }
+    }
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+private:
+  // Shift, Ctrl and Alt occupy the low three bits of `Modifier`.
+  static constexpr uint8_t kSlotMask = 0x07;
+  using Row = std::array<Key, kSlotMask + 1>;
+
+  size_t slot(Modifier mods) const noexcept {
+    return static_cast<uint8_t>(mods) & mask_;
+  }
+
+  std::vector<Row> rows_;
+  uint8_t mask_;
+  size_t size_{0};
+};
+
+/**
+ * @brief Unicode codepoint -> keycode plus required modifiers.
+ *
+ * Latin-1 codepoints, which cover nearly all typed text on common layouts,
+ * live in a direct 256-entry table; everything else sits in a vector kept
+ * sorted by codepoint and searched with a binary search. Invalid mappings
+ * (negative keycode) are never stored.
+ */
+class CharMappingTable {
+public:
+  /// Pointer to the mapping stored for @p codepoint, or nullptr.
+  const KeyMapping *find(char32_t codepoint) const noexcept {
+    if (codepoint < kDirectSlots) {
+      const KeyMapping &mapping = direct_[codepoint];
+      return mapping.isValid() ? &mapping : nullptr;
+    }
+    auto it = lowerBound(codepoint);
+    if (it == others_.end() || it->first != codepoint)
+      return nullptr;
+    return &it->second;
+  }
+
+  /**
+   * @brief Store @p mapping for @p codepoint unless already present.
+   * @return true when the mapping was stored.
+   */
+  bool insert(char32_t codepoint, const KeyMapping &mapping) {
+    if (!mapping.isValid())
+      return false;
+    if (codepoint < kDirectSlots) {
+      KeyMapping &slot = direct_[codepoint];
+      if (slot.isValid())
+        return false;
+      slot = mapping;
+    } else {
+      auto it = lowerBound(codepoint);
+      if (it != others_.end() && it->first == codepoint)
+        return false;
+      others_.insert(it, {codepoint, mapping});
+    }
+    ++size_;
+    return true;
+  }
+
+  /// Call `fn(char32_t codepoint, const KeyMapping &mapping)` for every
+  /// stored mapping, in codepoint order.
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (char32_t cp = 0; cp < kDirectSlots; ++cp) {
+      if (direct_[cp].isValid())
+        fn(cp, direct_[cp]);
+    }
+    for (const Entry &entry : others_)
+      fn(entry.first, entry.second);
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+private:
+  static constexpr char32_t kDirectSlots = 0x100;
+  using Entry = std::pair<char32_t, KeyMapping>;
+
+  std::vector<Entry>::const_iterator lowerBound(char32_t codepoint) const {
+    return std::lower_bound(
+        others_.begin(), others_.end(), codepoint,
+        [](const Entry &entry, char32_t cp) { return entry.first < cp; });
+  }
+
+  std::array<KeyMapping, kDirectSlots> direct_{};
+  std::vector<Entry> others_;
+  size_t size_{0};
+};
+
+} // namespace axidev::io::keyboard::detail
@@ -6,17 +6,24 @@
  * This file implements `axidev::io::keyboard::keyToString` and
  * `axidev::io::keyboard::stringToKey` along with internal helpers used to
  * normalize and escape input for logging and lookups.
+ *
+ * Both directions are served from tables generated at compile time: a dense
+ * array indexed by the `Key` value for formatting, and a case-insensitively
+ * sorted array of canonical names and aliases for parsing. Neither direction
+ * allocates or takes a lock.
  */
 
 #include <axidev-io/keyboard/common.hpp>
 #include <axidev-io/log.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <string>
-#include <unordered_map>
-#include <vector>
+#include <string_view>
 
 namespace axidev {
 namespace io {
@@ -25,22 +32,61 @@ namespace keyboard {
 namespace {
 
 /**
- * @brief Convert a string to lower-case using a locale-independent algorithm.
- *
- * The function performs an unsigned-char `std::tolower` conversion to avoid
- * undefined behavior when `char` is signed. The input is moved for efficiency
- * and a lower-cased copy is returned.
+ * @brief Lower-case a single ASCII character.
  *
- * @param inputString String to convert (moved for efficiency).
- * @return std::string Lower-cased result.
+ * Locale-independent and usable in constant expressions; bytes outside
+ * `A-Z` are returned unchanged, matching `std::tolower` in the "C" locale.
+ */
+constexpr char asciiLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Three-way ASCII case-insensitive comparison.
+ * @return Negative, zero or positive like `std::string_view::compare`.
+ */
+constexpr int compareIgnoreCase(std::string_view a, std::string_view b) {
+  const size_t n = std::min(a.size(), b.size());
+  for (size_t i = 0; i < n; ++i) {
+    const auto ca = static_cast<unsigned char>(asciiLower(a[i]));
+    const auto cb = static_cast<unsigned char>(asciiLower(b[i]));
+    if (ca != cb)
+      return ca < cb ? -1 : 1;
+  }
+  if (a.size() == b.size())
+    return 0;
+  return a.size() < b.size() ? -1 : 1;
+}
+
+constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() && compareIgnoreCase(a, b) == 0;
+}
+
+constexpr bool startsWithIgnoreCase(std::string_view s,
+                                    std::string_view prefix) {
+  return s.size() >= prefix.size() &&
+         compareIgnoreCase(s.substr(0, prefix.size()), prefix) == 0;
+}
+
+/**
+ * @brief Case-insensitive substring search.
+ * @param needle Lower-case pattern to look for.
  */
-std::string toLower(std::string inputString) {
-  std::ranges::transform(
-      inputString, inputString.begin(), [](char character) -> char {
-        return static_cast<char>(
-            std::tolower(static_cast<unsigned char>(character)));
-      });
-  return inputString;
+constexpr bool containsIgnoreCase(std::string_view haystack,
+                                  std::string_view needle) {
+  if (needle.size() > haystack.size())
+    return false;
+  for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+    if (compareIgnoreCase(haystack.substr(i, needle.size()), needle) == 0)
+      return true;
+  }
+  return false;
+}
+
+/// True when @p s contains no upper-case ASCII letters.
+constexpr bool isLowerAscii(std::string_view s) {
+  return std::none_of(s.begin(), s.end(),
+                      [](char c) { return c >= 'A' && c <= 'Z'; });
 }
 
 /**
@@ -56,7 +102,7 @@ std::string toLower(std::string inputString) {
  * @param input Input string to escape.
  * @return std::string Escaped string suitable for inline debug logging.
  */
-std::string escapeForLog(const std::string &input) {
+std::string escapeForLog(std::string_view input) {
   std::string out;
   out.reserve(input.size() * 2);
   for (unsigned char c : input) {
@@ -84,791 +130,845 @@ std::string escapeForLog(const std::string &input) {
 }
 
 /**
- * @brief Return a static vector of canonical Key -> string mappings.
- *
- * The returned reference points to a function-local static vector that contains
- * canonical mappings used by `keyToString` and which is used to seed the
- * reverse lookup map in `stringToKey`.
+ * @brief A `Key` paired with one of its textual names.
  *
- * @return const std::vector<std::pair<Key, std::string>>& Reference to the
- *         static mapping vector.
+ * Names always point at string literals, so `name.data()` is null-terminated.
  */
-const std::vector<std::pair<Key, std::string>> &keyStringPairs() {
-  static const std::vector<std::pair<Key, std::string>> pairs = {
-      {Key::Unknown, "Unknown"},
-      // Letters
-      {Key::A, "A"},
-      {Key::B, "B"},
-      {Key::C, "C"},
-      {Key::D, "D"},
-      {Key::E, "E"},
-      {Key::F, "F"},
-      {Key::G, "G"},
-      {Key::H, "H"},
-      {Key::I, "I"},
-      {Key::J, "J"},
-      {Key::K, "K"},
-      {Key::L, "L"},
-      {Key::M, "M"},
-      {Key::N, "N"},
-      {Key::O, "O"},
-      {Key::P, "P"},
-      {Key::Q, "Q"},
-      {Key::R, "R"},
-      {Key::S, "S"},
-      {Key::T, "T"},
-      {Key::U, "U"},
-      {Key::V, "V"},
-      {Key::W, "W"},
-      {Key::X, "X"},
-      {Key::Y, "Y"},
-      {Key::Z, "Z"},
-      // Numbers (top row)
-      {Key::Num0, "0"},
-      {Key::Num1, "1"},
-      {Key::Num2, "2"},
-      {Key::Num3, "3"},
-      {Key::Num4, "4"},
-      {Key::Num5, "5"},
-      {Key::Num6, "6"},
-      {Key::Num7, "7"},
-      {Key::Num8, "8"},
-      {Key::Num9, "9"},
-      // Function keys
-      {Key::F1, "F1"},
-      {Key::F2, "F2"},
-      {Key::F3, "F3"},
-      {Key::F4, "F4"},
-      {Key::F5, "F5"},
-      {Key::F6, "F6"},
-      {Key::F7, "F7"},
-      {Key::F8, "F8"},
-      {Key::F9, "F9"},
-      {Key::F10, "F10"},
-      {Key::F11, "F11"},
-      {Key::F12, "F12"},
-      {Key::F13, "F13"},
-      {Key::F14, "F14"},
-      {Key::F15, "F15"},
-      {Key::F16, "F16"},
-      {Key::F17, "F17"},
-      {Key::F18, "F18"},
-      {Key::F19, "F19"},
-      {Key::F20, "F20"},
-      // Control keys
-      {Key::Enter, "Enter"},
-      {Key::Escape, "Escape"},
-      {Key::Backspace, "Backspace"},
-      {Key::Tab, "Tab"},
-      {Key::Space, "Space"},
-      // Navigation
-      {Key::Left, "Left"},
-      {Key::Right, "Right"},
-      {Key::Up, "Up"},
-      {Key::Down, "Down"},
-      {Key::Home, "Home"},
-      {Key::End, "End"},
-      {Key::PageUp, "PageUp"},
-      {Key::PageDown, "PageDown"},
-      {Key::Delete, "Delete"},
-      {Key::Insert, "Insert"},
-      {Key::PrintScreen, "PrintScreen"},
-      {Key::ScrollLock, "ScrollLock"},
-      {Key::Pause, "Pause"},
-      // Numpad
-      {Key::NumpadDivide, "NumpadDivide"},
-      {Key::NumpadMultiply, "NumpadMultiply"},
-      {Key::NumpadMinus, "NumpadMinus"},
-      {Key::NumpadPlus, "NumpadPlus"},
-      {Key::NumpadEnter, "NumpadEnter"},
-      {Key::NumpadDecimal, "NumpadDecimal"},
-      {Key::Numpad0, "Numpad0"},
-      {Key::Numpad1, "Numpad1"},
-      {Key::Numpad2, "Numpad2"},
-      {Key::Numpad3, "Numpad3"},
-      {Key::Numpad4, "Numpad4"},
-      {Key::Numpad5, "Numpad5"},
-      {Key::Numpad6, "Numpad6"},
-      {Key::Numpad7, "Numpad7"},
-      {Key::Numpad8, "Numpad8"},
-      {Key::Numpad9, "Numpad9"},
-      // Modifiers
-      {Key::ShiftLeft, "ShiftLeft"},
-      {Key::ShiftRight, "ShiftRight"},
-      {Key::CtrlLeft, "CtrlLeft"},
-      {Key::CtrlRight, "CtrlRight"},
-      {Key::AltLeft, "AltLeft"},
-      {Key::AltRight, "AltRight"},
-      {Key::SuperLeft, "SuperLeft"},
-      {Key::SuperRight, "SuperRight"},
-      {Key::CapsLock, "CapsLock"},
-      {Key::NumLock, "NumLock"},
-      // Misc
-      {Key::Help, "Help"},
-      {Key::Menu, "Menu"},
-      {Key::Power, "Power"},
-      {Key::Sleep, "Sleep"},
-      {Key::Wake, "Wake"},
-      {Key::Mute, "Mute"},
-      {Key::VolumeDown, "VolumeDown"},
-      {Key::VolumeUp, "VolumeUp"},
-      {Key::MediaPlayPause, "MediaPlayPause"},
-      {Key::MediaStop, "MediaStop"},
-      {Key::MediaNext, "MediaNext"},
-      {Key::MediaPrevious, "MediaPrevious"},
-      {Key::BrightnessDown, "BrightnessDown"},
-      {Key::BrightnessUp, "BrightnessUp"},
-      {Key::Eject, "Eject"},
-      // Punctuation / layout-dependent
-      {Key::Grave, "`"},
-      {Key::Minus, "-"},
-      {Key::Equal, "="},
-      {Key::LeftBracket, "["},
-      {Key::RightBracket, "]"},
-      {Key::Backslash, "\\"},
-      {Key::Semicolon, ";"},
-      {Key::Apostrophe, "'"},
-      {Key::Comma, ","},
-      {Key::Period, "."},
-      {Key::Slash, "/"},
-      // Shifted / symbol characters (canonical textual names)
-      {Key::At, "At"},
-      {Key::Hashtag, "Hashtag"},
-      {Key::Exclamation, "Exclamation"},
-      {Key::Dollar, "Dollar"},
-      {Key::Percent, "Percent"},
-      {Key::Caret, "Caret"},
-      {Key::Ampersand, "Ampersand"},
-      {Key::Asterisk, "Asterisk"},
-      {Key::LeftParen, "LeftParen"},
-      {Key::RightParen, "RightParen"},
-      {Key::Underscore, "Underscore"},
-      {Key::Plus, "Plus"},
-      {Key::Colon, "Colon"},
-      {Key::Quote, "Quote"},
-      {Key::QuestionMark, "QuestionMark"},
-      {Key::Bar, "Bar"},
-      {Key::LessThan, "LessThan"},
-      {Key::GreaterThan, "GreaterThan"},
-      // ASCII control canonical names (C0 / DEL)
-      {Key::AsciiNUL, "NUL"},
-      {Key::AsciiSOH, "SOH"},
-      {Key::AsciiSTX, "STX"},
-      {Key::AsciiETX, "ETX"},
-      {Key::AsciiEOT, "EOT"},
-      {Key::AsciiENQ, "ENQ"},
-      {Key::AsciiACK, "ACK"},
-      {Key::AsciiBell, "Bell"},
-      {Key::AsciiVT, "VT"},
-      {Key::AsciiFF, "FF"},
-      {Key::AsciiSO, "SO"},
-      {Key::AsciiSI, "SI"},
-      {Key::AsciiDLE, "DLE"},
-      {Key::AsciiDC1, "DC1"},
-      {Key::AsciiDC2, "DC2"},
-      {Key::AsciiDC3, "DC3"},
-      {Key::AsciiDC4, "DC4"},
-      {Key::AsciiNAK, "NAK"},
-      {Key::AsciiSYN, "SYN"},
-      {Key::AsciiETB, "ETB"},
-      {Key::AsciiCAN, "CAN"},
-      {Key::AsciiEM, "EM"},
-      {Key::AsciiSUB, "SUB"},
-      {Key::AsciiFS, "FS"},
-      {Key::AsciiGS, "GS"},
-      {Key::AsciiRS, "RS"},
-      {Key::AsciiUS, "US"},
-      {Key::AsciiDEL, "DEL"},
-      // Additional canonical names for X11 / XF86 / international keys added
-      // to the Key enum so they can roundtrip via `keyToString` and seed the
-      // reverse lookup in `stringToKey`.
-      {Key::NumpadEqual, "NumpadEqual"},
-      {Key::Degree, "Degree"},
-      {Key::Sterling, "Sterling"},
-      {Key::Mu, "Mu"},
-      {Key::PlusMinus, "PlusMinus"},
-      {Key::DeadCircumflex, "DeadCircumflex"},
-      {Key::DeadDiaeresis, "DeadDiaeresis"},
-      {Key::Section, "Section"},
-      {Key::Cancel, "Cancel"},
-      {Key::Redo, "Redo"},
-      {Key::Undo, "Undo"},
-      {Key::Find, "Find"},
-      {Key::Hangul, "Hangul"},
-      {Key::HangulHanja, "HangulHanja"},
-      {Key::Katakana, "Katakana"},
-      {Key::Hiragana, "Hiragana"},
-      {Key::Henkan, "Henkan"},
-      {Key::Muhenkan, "Muhenkan"},
-      {Key::OE, "OE"},
-      {Key::oe, "oe"},
-      {Key::SunProps, "SunProps"},
-      {Key::SunFront, "SunFront"},
-      {Key::Copy, "Copy"},
-      {Key::Open, "Open"},
-      {Key::Paste, "Paste"},
-      {Key::Cut, "Cut"},
-      {Key::Calculator, "Calculator"},
-      {Key::Explorer, "Explorer"},
-      {Key::Phone, "Phone"},
-      {Key::WebCam, "WebCam"},
-      {Key::AudioRecord, "AudioRecord"},
-      {Key::AudioRewind, "AudioRewind"},
-      {Key::AudioPreset, "AudioPreset"},
-      {Key::Messenger, "Messenger"},
-      {Key::Search, "Search"},
-      {Key::Go, "Go"},
-      {Key::Finance, "Finance"},
-      {Key::Game, "Game"},
-      {Key::Shop, "Shop"},
-      {Key::HomePage, "HomePage"},
-      {Key::Reload, "Reload"},
-      {Key::Close, "Close"},
-      {Key::Send, "Send"},
-      {Key::Xfer, "Xfer"},
-      {Key::LaunchA, "LaunchA"},
-      {Key::LaunchB, "LaunchB"},
-      {Key::Launch1, "Launch1"},
-      {Key::Launch2, "Launch2"},
-      {Key::Launch3, "Launch3"},
-      {Key::Launch4, "Launch4"},
-      {Key::Launch5, "Launch5"},
-      {Key::Launch6, "Launch6"},
-      {Key::Launch7, "Launch7"},
-      {Key::Launch8, "Launch8"},
-      {Key::Launch9, "Launch9"},
-      {Key::TouchpadToggle, "TouchpadToggle"},
-      {Key::TouchpadOn, "TouchpadOn"},
-      {Key::TouchpadOff, "TouchpadOff"},
-      {Key::KbdLightOnOff, "KbdLightOnOff"},
-      {Key::KbdBrightnessDown, "KbdBrightnessDown"},
-      {Key::KbdBrightnessUp, "KbdBrightnessUp"},
-      {Key::Mail, "Mail"},
-      {Key::MailForward, "MailForward"},
-      {Key::Save, "Save"},
-      {Key::Documents, "Documents"},
-      {Key::Battery, "Battery"},
-      {Key::Bluetooth, "Bluetooth"},
-      {Key::WLAN, "WLAN"},
-      {Key::UWB, "UWB"},
-      {Key::Next_VMode, "Next_VMode"},
-      {Key::Prev_VMode, "Prev_VMode"},
-      {Key::MonBrightnessCycle, "MonBrightnessCycle"},
-      {Key::BrightnessAuto, "BrightnessAuto"},
-      {Key::DisplayOff, "DisplayOff"},
-      {Key::WWAN, "WWAN"},
-      {Key::RFKill, "RFKill"},
-  };
-  return pairs;
-}
-
-} // namespace
+struct KeyName {
+  Key key;
+  std::string_view name;
+};
 
 /**
- * @brief Convert a `Key` to its canonical textual representation.
+ * @brief Canonical Key -> string mappings.
  *
- * @param key Logical key enum value to convert.
- * @return std::string Canonical name for the key (e.g., "A", "Enter").
- *         Returns "Unknown" if the key does not have a canonical name.
+ * The first entry for a given key is the name returned by `keyToString`; every
+ * entry is also accepted (case-insensitively) by `stringToKey`.
  */
-AXIDEV_IO_API std::string keyToString(Key key) {
-  for (const auto &pair : keyStringPairs()) {
-    if (pair.first == key) {
-      return pair.second;
-    }
-  }
-  return {"Unknown"};
-}
+constexpr KeyName kCanonicalNames[] = {
+    {Key::Unknown, "Unknown"},
+    // Letters
+    {Key::A, "A"},
+    {Key::B, "B"},
+    {Key::C, "C"},
+    {Key::D, "D"},
+    {Key::E, "E"},
+    {Key::F, "F"},
+    {Key::G, "G"},
+    {Key::H, "H"},
+    {Key::I, "I"},
+    {Key::J, "J"},
+    {Key::K, "K"},
+    {Key::L, "L"},
+    {Key::M, "M"},
+    {Key::N, "N"},
+    {Key::O, "O"},
+    {Key::P, "P"},
+    {Key::Q, "Q"},
+    {Key::R, "R"},
+    {Key::S, "S"},
+    {Key::T, "T"},
+    {Key::U, "U"},
+    {Key::V, "V"},
+    {Key::W, "W"},
+    {Key::X, "X"},
+    {Key::Y, "Y"},
+    {Key::Z, "Z"},
+    // Numbers (top row)
+    {Key::Num0, "0"},
+    {Key::Num1, "1"},
+    {Key::Num2, "2"},
+    {Key::Num3, "3"},
+    {Key::Num4, "4"},
+    {Key::Num5, "5"},
+    {Key::Num6, "6"},
+    {Key::Num7, "7"},
+    {Key::Num8, "8"},
+    {Key::Num9, "9"},
+    // Function keys
+    {Key::F1, "F1"},
+    {Key::F2, "F2"},
+    {Key::F3, "F3"},
+    {Key::F4, "F4"},
+    {Key::F5, "F5"},
+    {Key::F6, "F6"},
+    {Key::F7, "F7"},
+    {Key::F8, "F8"},
+    {Key::F9, "F9"},
+    {Key::F10, "F10"},
+    {Key::F11, "F11"},
+    {Key::F12, "F12"},
+    {Key::F13, "F13"},
+    {Key::F14, "F14"},
+    {Key::F15, "F15"},
+    {Key::F16, "F16"},
+    {Key::F17, "F17"},
+    {Key::F18, "F18"},
+    {Key::F19, "F19"},
+    {Key::F20, "F20"},
+    // Control keys
+    {Key::Enter, "Enter"},
+    {Key::Escape, "Escape"},
+    {Key::Backspace, "Backspace"},
+    {Key::Tab, "Tab"},
+    {Key::Space, "Space"},
+    // Navigation
+    {Key::Left, "Left"},
+    {Key::Right, "Right"},
+    {Key::Up, "Up"},
+    {Key::Down, "Down"},
+    {Key::Home, "Home"},
+    {Key::End, "End"},
+    {Key::PageUp, "PageUp"},
+    {Key::PageDown, "PageDown"},
+    {Key::Delete, "Delete"},
+    {Key::Insert, "Insert"},
+    {Key::PrintScreen, "PrintScreen"},
+    {Key::ScrollLock, "ScrollLock"},
+    {Key::Pause, "Pause"},
+    // Numpad
+    {Key::NumpadDivide, "NumpadDivide"},
+    {Key::NumpadMultiply, "NumpadMultiply"},
+    {Key::NumpadMinus, "NumpadMinus"},
+    {Key::NumpadPlus, "NumpadPlus"},
+    {Key::NumpadEnter, "NumpadEnter"},
+    {Key::NumpadDecimal, "NumpadDecimal"},
+    {Key::Numpad0, "Numpad0"},
+    {Key::Numpad1, "Numpad1"},
+    {Key::Numpad2, "Numpad2"},
+    {Key::Numpad3, "Numpad3"},
+    {Key::Numpad4, "Numpad4"},
+    {Key::Numpad5, "Numpad5"},
+    {Key::Numpad6, "Numpad6"},
+    {Key::Numpad7, "Numpad7"},
+    {Key::Numpad8, "Numpad8"},
+    {Key::Numpad9, "Numpad9"},
+    // Modifiers
+    {Key::ShiftLeft, "ShiftLeft"},
+    {Key::ShiftRight, "ShiftRight"},
+    {Key::CtrlLeft, "CtrlLeft"},
+    {Key::CtrlRight, "CtrlRight"},
+    {Key::AltLeft, "AltLeft"},
+    {Key::AltRight, "AltRight"},
+    {Key::SuperLeft, "SuperLeft"},
+    {Key::SuperRight, "SuperRight"},
+    {Key::CapsLock, "CapsLock"},
+    {Key::NumLock, "NumLock"},
+    // Misc
+    {Key::Help, "Help"},
+    {Key::Menu, "Menu"},
+    {Key::Power, "Power"},
+    {Key::Sleep, "Sleep"},
+    {Key::Wake, "Wake"},
+    {Key::Mute, "Mute"},
+    {Key::VolumeDown, "VolumeDown"},
+    {Key::VolumeUp, "VolumeUp"},
+    {Key::MediaPlayPause, "MediaPlayPause"},
+    {Key::MediaStop, "MediaStop"},
+    {Key::MediaNext, "MediaNext"},
+    {Key::MediaPrevious, "MediaPrevious"},
+    {Key::BrightnessDown, "BrightnessDown"},
+    {Key::BrightnessUp, "BrightnessUp"},
+    {Key::Eject, "Eject"},
+    // Punctuation / layout-dependent
+    {Key::Grave, "`"},
+    {Key::Minus, "-"},
+    {Key::Equal, "="},
+    {Key::LeftBracket, "["},
+    {Key::RightBracket, "]"},
+    {Key::Backslash, "\\"},
+    {Key::Semicolon, ";"},
+    {Key::Apostrophe, "'"},
+    {Key::Comma, ","},
+    {Key::Period, "."},
+    {Key::Slash, "/"},
+    // Shifted / symbol characters (canonical textual names)
+    {Key::At, "At"},
+    {Key::Hashtag, "Hashtag"},
+    {Key::Exclamation, "Exclamation"},
+    {Key::Dollar, "Dollar"},
+    {Key::Percent, "Percent"},
+    {Key::Caret, "Caret"},
+    {Key::Ampersand, "Ampersand"},
+    {Key::Asterisk, "Asterisk"},
+    {Key::LeftParen, "LeftParen"},
+    {Key::RightParen, "RightParen"},
+    {Key::Underscore, "Underscore"},
+    {Key::Plus, "Plus"},
+    {Key::Colon, "Colon"},
+    {Key::Quote, "Quote"},
+    {Key::QuestionMark, "QuestionMark"},
+    {Key::Bar, "Bar"},
+    {Key::LessThan, "LessThan"},
+    {Key::GreaterThan, "GreaterThan"},
+    // ASCII control canonical names (C0 / DEL)
+    {Key::AsciiNUL, "NUL"},
+    {Key::AsciiSOH, "SOH"},
+    {Key::AsciiSTX, "STX"},
+    {Key::AsciiETX, "ETX"},
+    {Key::AsciiEOT, "EOT"},
+    {Key::AsciiENQ, "ENQ"},
+    {Key::AsciiACK, "ACK"},
+    {Key::AsciiBell, "Bell"},
+    {Key::AsciiVT, "VT"},
+    {Key::AsciiFF, "FF"},
+    {Key::AsciiSO, "SO"},
+    {Key::AsciiSI, "SI"},
+    {Key::AsciiDLE, "DLE"},
+    {Key::AsciiDC1, "DC1"},
+    {Key::AsciiDC2, "DC2"},
+    {Key::AsciiDC3, "DC3"},
+    {Key::AsciiDC4, "DC4"},
+    {Key::AsciiNAK, "NAK"},
+    {Key::AsciiSYN, "SYN"},
+    {Key::AsciiETB, "ETB"},
+    {Key::AsciiCAN, "CAN"},
+    {Key::AsciiEM, "EM"},
+    {Key::AsciiSUB, "SUB"},
+    {Key::AsciiFS, "FS"},
+    {Key::AsciiGS, "GS"},
+    {Key::AsciiRS, "RS"},
+    {Key::AsciiUS, "US"},
+    {Key::AsciiDEL, "DEL"},
+    // Additional canonical names for X11 / XF86 / international keys added
+    // to the Key enum so they can roundtrip via `keyToString` and seed the
+    // reverse lookup in `stringToKey`.
+    {Key::NumpadEqual, "NumpadEqual"},
+    {Key::Degree, "Degree"},
+    {Key::Sterling, "Sterling"},
+    {Key::Mu, "Mu"},
+    {Key::PlusMinus, "PlusMinus"},
+    {Key::DeadCircumflex, "DeadCircumflex"},
+    {Key::DeadDiaeresis, "DeadDiaeresis"},
+    {Key::Section, "Section"},
+    {Key::Cancel, "Cancel"},
+    {Key::Redo, "Redo"},
+    {Key::Undo, "Undo"},
+    {Key::Find, "Find"},
+    {Key::Hangul, "Hangul"},
+    {Key::HangulHanja, "HangulHanja"},
+    {Key::Katakana, "Katakana"},
+    {Key::Hiragana, "Hiragana"},
+    {Key::Henkan, "Henkan"},
+    {Key::Muhenkan, "Muhenkan"},
+    {Key::OE, "OE"},
+    {Key::oe, "oe"},
+    {Key::SunProps, "SunProps"},
+    {Key::SunFront, "SunFront"},
+    {Key::Copy, "Copy"},
+    {Key::Open, "Open"},
+    {Key::Paste, "Paste"},
+    {Key::Cut, "Cut"},
+    {Key::Calculator, "Calculator"},
+    {Key::Explorer, "Explorer"},
+    {Key::Phone, "Phone"},
+    {Key::WebCam, "WebCam"},
+    {Key::AudioRecord, "AudioRecord"},
+    {Key::AudioRewind, "AudioRewind"},
+    {Key::AudioPreset, "AudioPreset"},
+    {Key::Messenger, "Messenger"},
+    {Key::Search, "Search"},
+    {Key::Go, "Go"},
+    {Key::Finance, "Finance"},
+    {Key::Game, "Game"},
+    {Key::Shop, "Shop"},
+    {Key::HomePage, "HomePage"},
+    {Key::Reload, "Reload"},
+    {Key::Close, "Close"},
+    {Key::Send, "Send"},
+    {Key::Xfer, "Xfer"},
+    {Key::LaunchA, "LaunchA"},
+    {Key::LaunchB, "LaunchB"},
+    {Key::Launch1, "Launch1"},
+    {Key::Launch2, "Launch2"},
+    {Key::Launch3, "Launch3"},
+    {Key::Launch4, "Launch4"},
+    {Key::Launch5, "Launch5"},
+    {Key::Launch6, "Launch6"},
+    {Key::Launch7, "Launch7"},
+    {Key::Launch8, "Launch8"},
+    {Key::Launch9, "Launch9"},
+    {Key::TouchpadToggle, "TouchpadToggle"},
+    {Key::TouchpadOn, "TouchpadOn"},
+    {Key::TouchpadOff, "TouchpadOff"},
+    {Key::KbdLightOnOff, "KbdLightOnOff"},
+    {Key::KbdBrightnessDown, "KbdBrightnessDown"},
+    {Key::KbdBrightnessUp, "KbdBrightnessUp"},
+    {Key::Mail, "Mail"},
+    {Key::MailForward, "MailForward"},
+    {Key::Save, "Save"},
+    {Key::Documents, "Documents"},
+    {Key::Battery, "Battery"},
+    {Key::Bluetooth, "Bluetooth"},
+    {Key::WLAN, "WLAN"},
+    {Key::UWB, "UWB"},
+    {Key::Next_VMode, "Next_VMode"},
+    {Key::Prev_VMode, "Prev_VMode"},
+    {Key::MonBrightnessCycle, "MonBrightnessCycle"},
+    {Key::BrightnessAuto, "BrightnessAuto"},
+    {Key::DisplayOff, "DisplayOff"},
+    {Key::WWAN, "WWAN"},
+    {Key::RFKill, "RFKill"},
+};
 
 /**
- * @brief Parse a textual key name into a `Key` value.
- *
- * The function accepts many aliases and single-character inputs. The reverse
- * mapping is seeded on first call and cached for subsequent invocations.
- * Comparison for textual aliases is case-insensitive when appropriate.
+ * @brief Additional spellings accepted by `stringToKey`.
  *
- * @param input Input textual name (e.g., "A", "esc", "@", "space").
- * @return Key Parsed `Key` value, or `Key::Unknown` for empty or unrecognized
- *         inputs.
+ * Aliases take precedence over canonical names that collide with them
+ * case-insensitively, and are matched with their exact spelling first so
+ * case-only aliases (e.g., "OE" vs "oe") stay distinguishable. Canonical names
+ * are matched as if they were written in lower case.
  */
-AXIDEV_IO_API Key stringToKey(const std::string &input) {
-  static std::unordered_map<std::string, Key> rev;
-  if (input.empty()) {
-    return Key::Unknown;
-  }
-
-  if (rev.empty()) {
-    // Defer canonical seeding until after alias synonyms are added so that
-    // case-only aliases (e.g., "OE" vs "oe") aren't overwritten by a
-    // lowercase canonical entry. Canonical entries are inserted later using
-    // `emplace` to avoid clobbering helpful aliases.
-
+constexpr KeyName kAliasNames[] = {
     // Helpful aliases / synonyms
-    rev.emplace("esc", Key::Escape);
-    rev.emplace("return", Key::Enter);
-    rev.emplace("spacebar", Key::Space);
-    rev.emplace("space", Key::Space);
-    rev.emplace("ctrl", Key::CtrlLeft);
-    rev.emplace("control", Key::CtrlLeft);
-    rev.emplace("shift", Key::ShiftLeft);
-    rev.emplace("alt", Key::AltLeft);
-    rev.emplace("super", Key::SuperLeft);
-    rev.emplace("meta", Key::SuperLeft);
-    rev.emplace("win", Key::SuperLeft);
+    {Key::Escape, "esc"},
+    {Key::Enter, "return"},
+    {Key::Space, "spacebar"},
+    {Key::Space, "space"},
+    {Key::CtrlLeft, "ctrl"},
+    {Key::CtrlLeft, "control"},
+    {Key::ShiftLeft, "shift"},
+    {Key::AltLeft, "alt"},
+    {Key::SuperLeft, "super"},
+    {Key::SuperLeft, "meta"},
+    {Key::SuperLeft, "win"},
 
     // Top-row numeric aliases like \"num0\" -> Key::Num0
-    rev.emplace("num0", Key::Num0);
-    rev.emplace("num1", Key::Num1);
-    rev.emplace("num2", Key::Num2);
-    rev.emplace("num3", Key::Num3);
-    rev.emplace("num4", Key::Num4);
-    rev.emplace("num5", Key::Num5);
-    rev.emplace("num6", Key::Num6);
-    rev.emplace("num7", Key::Num7);
-    rev.emplace("num8", Key::Num8);
-    rev.emplace("num9", Key::Num9);
+    {Key::Num0, "num0"},
+    {Key::Num1, "num1"},
+    {Key::Num2, "num2"},
+    {Key::Num3, "num3"},
+    {Key::Num4, "num4"},
+    {Key::Num5, "num5"},
+    {Key::Num6, "num6"},
+    {Key::Num7, "num7"},
+    {Key::Num8, "num8"},
+    {Key::Num9, "num9"},
 
     // Some punctuation aliases
-    rev.emplace("dash", Key::Minus);
-    rev.emplace("hyphen", Key::Minus);
-    rev.emplace("minus", Key::Minus);
-    rev.emplace("grave", Key::Grave);
-    rev.emplace("backslash", Key::Backslash);
-    rev.emplace("semicolon", Key::Semicolon);
-    rev.emplace("apostrophe", Key::Apostrophe);
-    rev.emplace("comma", Key::Comma);
-    rev.emplace("period", Key::Period);
-    rev.emplace("dot", Key::Period);
-    rev.emplace("slash", Key::Slash);
-    rev.emplace("bracketleft", Key::LeftBracket);
-    rev.emplace("bracketright", Key::RightBracket);
+    {Key::Minus, "dash"},
+    {Key::Minus, "hyphen"},
+    {Key::Minus, "minus"},
+    {Key::Grave, "grave"},
+    {Key::Backslash, "backslash"},
+    {Key::Semicolon, "semicolon"},
+    {Key::Apostrophe, "apostrophe"},
+    {Key::Comma, "comma"},
+    {Key::Period, "period"},
+    {Key::Period, "dot"},
+    {Key::Slash, "slash"},
+    {Key::LeftBracket, "bracketleft"},
+    {Key::RightBracket, "bracketright"},
 
     // Single-character aliases for common symbol characters observed in inputs.
-    rev.emplace("@", Key::At);
-    rev.emplace("&", Key::Ampersand);
-    rev.emplace("(", Key::LeftParen);
-    rev.emplace(")", Key::RightParen);
-    rev.emplace("!", Key::Exclamation);
-    rev.emplace("$", Key::Dollar);
-    rev.emplace("^", Key::Caret);
-    rev.emplace("*", Key::Asterisk);
+    {Key::At, "@"},
+    {Key::Ampersand, "&"},
+    {Key::LeftParen, "("},
+    {Key::RightParen, ")"},
+    {Key::Exclamation, "!"},
+    {Key::Dollar, "$"},
+    {Key::Caret, "^"},
+    {Key::Asterisk, "*"},
 
     // Single-character aliases for punctuation / shifted characters.
-    rev.emplace(" ", Key::Space);
-    rev.emplace("\t", Key::Tab);
+    {Key::Space, " "},
+    {Key::Tab, "\t"},
 
     // ASCII control single-character mappings: map raw control bytes to
     // a logical `Key` when observed as an input character.
-    rev.emplace("\x00", Key::AsciiNUL);
-    rev.emplace("\x01", Key::AsciiSOH);
-    rev.emplace("\x02", Key::AsciiSTX);
-    rev.emplace("\x03", Key::AsciiETX);
-    rev.emplace("\x04", Key::AsciiEOT);
-    rev.emplace("\x05", Key::AsciiENQ);
-    rev.emplace("\x06", Key::AsciiACK);
-    rev.emplace("\x07", Key::AsciiBell);
-    rev.emplace("\x08", Key::Backspace);
-    rev.emplace("\x09", Key::Tab);
-    rev.emplace("\x0A", Key::Enter);
-    rev.emplace("\x0B", Key::AsciiVT);
-    rev.emplace("\x0C", Key::AsciiFF);
-    rev.emplace("\x0D", Key::Enter);
-    rev.emplace("\x0E", Key::AsciiSO);
-    rev.emplace("\x0F", Key::AsciiSI);
-    rev.emplace("\x10", Key::AsciiDLE);
-    rev.emplace("\x11", Key::AsciiDC1);
-    rev.emplace("\x12", Key::AsciiDC2);
-    rev.emplace("\x13", Key::AsciiDC3);
-    rev.emplace("\x14", Key::AsciiDC4);
-    rev.emplace("\x15", Key::AsciiNAK);
-    rev.emplace("\x16", Key::AsciiSYN);
-    rev.emplace("\x17", Key::AsciiETB);
-    rev.emplace("\x18", Key::AsciiCAN);
-    rev.emplace("\x19", Key::AsciiEM);
-    rev.emplace("\x1A", Key::AsciiSUB);
-    rev.emplace("\x1B", Key::Escape);
-    rev.emplace("\x1C", Key::AsciiFS);
-    rev.emplace("\x1D", Key::AsciiGS);
-    rev.emplace("\x1E", Key::AsciiRS);
-    rev.emplace("\x1F", Key::AsciiUS);
-    rev.emplace("\x7F", Key::Delete);
+    {Key::AsciiNUL, std::string_view("\0", 1)},
+    {Key::AsciiSOH, "\x01"},
+    {Key::AsciiSTX, "\x02"},
+    {Key::AsciiETX, "\x03"},
+    {Key::AsciiEOT, "\x04"},
+    {Key::AsciiENQ, "\x05"},
+    {Key::AsciiACK, "\x06"},
+    {Key::AsciiBell, "\x07"},
+    {Key::Backspace, "\x08"},
+    {Key::Tab, "\x09"},
+    {Key::Enter, "\x0A"},
+    {Key::AsciiVT, "\x0B"},
+    {Key::AsciiFF, "\x0C"},
+    {Key::Enter, "\x0D"},
+    {Key::AsciiSO, "\x0E"},
+    {Key::AsciiSI, "\x0F"},
+    {Key::AsciiDLE, "\x10"},
+    {Key::AsciiDC1, "\x11"},
+    {Key::AsciiDC2, "\x12"},
+    {Key::AsciiDC3, "\x13"},
+    {Key::AsciiDC4, "\x14"},
+    {Key::AsciiNAK, "\x15"},
+    {Key::AsciiSYN, "\x16"},
+    {Key::AsciiETB, "\x17"},
+    {Key::AsciiCAN, "\x18"},
+    {Key::AsciiEM, "\x19"},
+    {Key::AsciiSUB, "\x1A"},
+    {Key::Escape, "\x1B"},
+    {Key::AsciiFS, "\x1C"},
+    {Key::AsciiGS, "\x1D"},
+    {Key::AsciiRS, "\x1E"},
+    {Key::AsciiUS, "\x1F"},
+    {Key::Delete, "\x7F"},
 
     // Other single-character punctuation aliases that map to existing
     // layout-dependent keys.
-    rev.emplace("_", Key::Minus);
-    rev.emplace("+", Key::Equal);
-    rev.emplace(":", Key::Semicolon);
-    rev.emplace("\"", Key::Apostrophe);
-    rev.emplace("?", Key::Slash);
-    rev.emplace("|", Key::Backslash);
-    rev.emplace("<", Key::Comma);
-    rev.emplace(">", Key::Period);
-    rev.emplace("{", Key::LeftBracket);
-    rev.emplace("}", Key::RightBracket);
-    rev.emplace("~", Key::Grave);
-
-    // Helpful textual aliases for common symbols (lowercased by seeding logic)
-    rev.emplace("at", Key::At);
-    rev.emplace("hash", Key::Hashtag);
-    rev.emplace("hashtag", Key::Hashtag);
-    rev.emplace("pound", Key::Hashtag);
-    rev.emplace("bang", Key::Exclamation);
-    rev.emplace("exclamation", Key::Exclamation);
-    rev.emplace("dollar", Key::Dollar);
-    rev.emplace("percent", Key::Percent);
-    rev.emplace("caret", Key::Caret);
-    rev.emplace("ampersand", Key::Ampersand);
-    rev.emplace("star", Key::Asterisk);
-    rev.emplace("asterisk", Key::Asterisk);
-    rev.emplace("lparen", Key::LeftParen);
-    rev.emplace("rparen", Key::RightParen);
-    rev.emplace("underscore", Key::Underscore);
-    rev.emplace("plus", Key::Plus);
-    rev.emplace("colon", Key::Colon);
-    rev.emplace("quote", Key::Quote);
-    rev.emplace("pipe", Key::Bar);
-    rev.emplace("bar", Key::Bar);
-    rev.emplace("lt", Key::LessThan);
-    rev.emplace("gt", Key::GreaterThan);
-    rev.emplace("less", Key::LessThan);
-    rev.emplace("greater", Key::GreaterThan);
+    {Key::Minus, "_"},
+    {Key::Equal, "+"},
+    {Key::Semicolon, ":"},
+    {Key::Apostrophe, "\""},
+    {Key::Slash, "?"},
+    {Key::Backslash, "|"},
+    {Key::Comma, "<"},
+    {Key::Period, ">"},
+    {Key::LeftBracket, "{"},
+    {Key::RightBracket, "}"},
+    {Key::Grave, "~"},
+
+    // Helpful textual aliases for common symbols
+    {Key::At, "at"},
+    {Key::Hashtag, "hash"},
+    {Key::Hashtag, "hashtag"},
+    {Key::Hashtag, "pound"},
+    {Key::Exclamation, "bang"},
+    {Key::Exclamation, "exclamation"},
+    {Key::Dollar, "dollar"},
+    {Key::Percent, "percent"},
+    {Key::Caret, "caret"},
+    {Key::Ampersand, "ampersand"},
+    {Key::Asterisk, "star"},
+    {Key::Asterisk, "asterisk"},
+    {Key::LeftParen, "lparen"},
+    {Key::RightParen, "rparen"},
+    {Key::Underscore, "underscore"},
+    {Key::Plus, "plus"},
+    {Key::Colon, "colon"},
+    {Key::Quote, "quote"},
+    {Key::Bar, "pipe"},
+    {Key::Bar, "bar"},
+    {Key::LessThan, "lt"},
+    {Key::GreaterThan, "gt"},
+    {Key::LessThan, "less"},
+    {Key::GreaterThan, "greater"},
     // ASCII textual aliases
-    rev.emplace("nul", Key::AsciiNUL);
-    rev.emplace("bell", Key::AsciiBell);
-    rev.emplace("vt", Key::AsciiVT);
-    rev.emplace("ff", Key::AsciiFF);
-    rev.emplace("dle", Key::AsciiDLE);
-    rev.emplace("sub", Key::AsciiSUB);
-    rev.emplace("can", Key::AsciiCAN);
-    rev.emplace("fs", Key::AsciiFS);
-    rev.emplace("gs", Key::AsciiGS);
-    rev.emplace("rs", Key::AsciiRS);
-    rev.emplace("us", Key::AsciiUS);
-    rev.emplace("del", Key::AsciiDEL);
+    {Key::AsciiNUL, "nul"},
+    {Key::AsciiBell, "bell"},
+    {Key::AsciiVT, "vt"},
+    {Key::AsciiFF, "ff"},
+    {Key::AsciiDLE, "dle"},
+    {Key::AsciiSUB, "sub"},
+    {Key::AsciiCAN, "can"},
+    {Key::AsciiFS, "fs"},
+    {Key::AsciiGS, "gs"},
+    {Key::AsciiRS, "rs"},
+    {Key::AsciiUS, "us"},
+    {Key::AsciiDEL, "del"},
 
     // Numeric keypad aliases (numpadX is already present via canonical mapping,
     // but also allow \"kpX\" and other X11 KP_* names that some users / systems
     // emit).
-    rev.emplace("kp0", Key::Numpad0);
-    rev.emplace("kp1", Key::Numpad1);
-    rev.emplace("kp2", Key::Numpad2);
-    rev.emplace("kp3", Key::Numpad3);
-    rev.emplace("kp4", Key::Numpad4);
-    rev.emplace("kp5", Key::Numpad5);
-    rev.emplace("kp6", Key::Numpad6);
-    rev.emplace("kp7", Key::Numpad7);
-    rev.emplace("kp8", Key::Numpad8);
-    rev.emplace("kp9", Key::Numpad9);
+    {Key::Numpad0, "kp0"},
+    {Key::Numpad1, "kp1"},
+    {Key::Numpad2, "kp2"},
+    {Key::Numpad3, "kp3"},
+    {Key::Numpad4, "kp4"},
+    {Key::Numpad5, "kp5"},
+    {Key::Numpad6, "kp6"},
+    {Key::Numpad7, "kp7"},
+    {Key::Numpad8, "kp8"},
+    {Key::Numpad9, "kp9"},
 
     // Common X11 / keysym aliases observed on Linux systems (lowercased).
     // Map keyboard modifier / special names to existing logical keys.
-    rev.emplace("control_l", Key::CtrlLeft);
-    rev.emplace("control_r", Key::CtrlRight);
-    rev.emplace("shift_l", Key::ShiftLeft);
-    rev.emplace("shift_r", Key::ShiftRight);
-    rev.emplace("alt_l", Key::AltLeft);
-    rev.emplace("alt_r", Key::AltRight);
-    rev.emplace("meta_l", Key::SuperLeft);
-    rev.emplace("super_l", Key::SuperLeft);
-    rev.emplace("super_r", Key::SuperRight);
-    rev.emplace("hyper_l", Key::SuperLeft);
-    rev.emplace("caps_lock", Key::CapsLock);
-    rev.emplace("num_lock", Key::NumLock);
-    rev.emplace("scroll_lock", Key::ScrollLock);
+    {Key::CtrlLeft, "control_l"},
+    {Key::CtrlRight, "control_r"},
+    {Key::ShiftLeft, "shift_l"},
+    {Key::ShiftRight, "shift_r"},
+    {Key::AltLeft, "alt_l"},
+    {Key::AltRight, "alt_r"},
+    {Key::SuperLeft, "meta_l"},
+    {Key::SuperLeft, "super_l"},
+    {Key::SuperRight, "super_r"},
+    {Key::SuperLeft, "hyper_l"},
+    {Key::CapsLock, "caps_lock"},
+    {Key::NumLock, "num_lock"},
+    {Key::ScrollLock, "scroll_lock"},
 
     // ISO / dead-key and punctuation aliases
-    rev.emplace("iso_left_tab", Key::Tab);
-    rev.emplace("iso_level3_shift", Key::AltRight);
-    rev.emplace("iso_level5_shift", Key::AltRight);
-    rev.emplace("quotedbl", Key::Quote);
-    rev.emplace("parenleft", Key::LeftParen);
-    rev.emplace("parenright", Key::RightParen);
-    rev.emplace("equal", Key::Equal);
-    rev.emplace("question", Key::QuestionMark);
-    rev.emplace("exclam", Key::Exclamation);
-    rev.emplace("section", Key::Section);
-    rev.emplace("degree", Key::Degree);
-    rev.emplace("sterling", Key::Sterling);
-    rev.emplace("plusminus", Key::PlusMinus);
-    rev.emplace("dead_circumflex", Key::DeadCircumflex);
-    rev.emplace("dead_diaeresis", Key::DeadDiaeresis);
+    {Key::Tab, "iso_left_tab"},
+    {Key::AltRight, "iso_level3_shift"},
+    {Key::AltRight, "iso_level5_shift"},
+    {Key::Quote, "quotedbl"},
+    {Key::LeftParen, "parenleft"},
+    {Key::RightParen, "parenright"},
+    {Key::Equal, "equal"},
+    {Key::QuestionMark, "question"},
+    {Key::Exclamation, "exclam"},
+    {Key::Section, "section"},
+    {Key::Degree, "degree"},
+    {Key::Sterling, "sterling"},
+    {Key::PlusMinus, "plusminus"},
+    {Key::DeadCircumflex, "dead_circumflex"},
+    {Key::DeadDiaeresis, "dead_diaeresis"},
 
     // Accented / ligature aliases -> map to reasonable logical letter keys
-    rev.emplace("eacute", Key::E);
-    rev.emplace("egrave", Key::E);
-    rev.emplace("agrave", Key::A);
-    rev.emplace("ugrave", Key::U);
-    rev.emplace("ccedilla", Key::C);
-    rev.emplace("oe", Key::oe);
-    rev.emplace("OE", Key::OE);
-    rev.emplace("mu", Key::Mu);
+    {Key::E, "eacute"},
+    {Key::E, "egrave"},
+    {Key::A, "agrave"},
+    {Key::U, "ugrave"},
+    {Key::C, "ccedilla"},
+    {Key::oe, "oe"},
+    {Key::OE, "OE"},
+    {Key::Mu, "mu"},
 
     // Misc control / text aliases
-    rev.emplace("linefeed", Key::Enter);
-    rev.emplace("prior", Key::PageUp);
-    rev.emplace("next", Key::PageDown);
-    rev.emplace("print", Key::PrintScreen);
-    rev.emplace("sys_req", Key::PrintScreen);
-    rev.emplace("break", Key::Pause);
-    rev.emplace("cancel", Key::Cancel);
-    rev.emplace("redo", Key::Redo);
-    rev.emplace("undo", Key::Undo);
-    rev.emplace("find", Key::Find);
-    rev.emplace("sunprops", Key::SunProps);
-    rev.emplace("sunfront", Key::SunFront);
+    {Key::Enter, "linefeed"},
+    {Key::PageUp, "prior"},
+    {Key::PageDown, "next"},
+    {Key::PrintScreen, "print"},
+    {Key::PrintScreen, "sys_req"},
+    {Key::Pause, "break"},
+    {Key::Cancel, "cancel"},
+    {Key::Redo, "redo"},
+    {Key::Undo, "undo"},
+    {Key::Find, "find"},
+    {Key::SunProps, "sunprops"},
+    {Key::SunFront, "sunfront"},
 
     // Common UX / XF86 app / hardware alias textual fallbacks
-    rev.emplace("menu", Key::Menu);
-    rev.emplace("copy", Key::Copy);
-    rev.emplace("open", Key::Open);
-    rev.emplace("paste", Key::Paste);
-    rev.emplace("cut", Key::Cut);
-    rev.emplace("calculator", Key::Calculator);
-    rev.emplace("explorer", Key::Explorer);
-    rev.emplace("phone", Key::Phone);
-    rev.emplace("webcam", Key::WebCam);
-    rev.emplace("mail", Key::Mail);
-    rev.emplace("mailforward", Key::MailForward);
-    rev.emplace("save", Key::Save);
-    rev.emplace("documents", Key::Documents);
-
-    // Now seed canonical mappings (lowercased). Use `emplace` so we don't
-    // overwrite existing helpful alias entries (case-only collisions).
-    size_t seeded = 0;
-    for (const auto &pair : keyStringPairs()) {
-      std::string lower = toLower(pair.second);
-      auto [it, inserted] = rev.emplace(lower, pair.first);
-      if (inserted) {
-        ++seeded;
-      }
-      // else {
-      //   AXIDEV_IO_LOG_DEBUG("stringToKey: canonical lowercase '%s' collides with "
-      //                     "existing mapping - keeping existing",
-      //                     lower.c_str());
-      // }
-    }
-    AXIDEV_IO_LOG_DEBUG(
-        "Seeding reverse map with %zu canonical entries (%zu inserted)",
-        keyStringPairs().size(), seeded);
+    {Key::Menu, "menu"},
+    {Key::Copy, "copy"},
+    {Key::Open, "open"},
+    {Key::Paste, "paste"},
+    {Key::Cut, "cut"},
+    {Key::Calculator, "calculator"},
+    {Key::Explorer, "explorer"},
+    {Key::Phone, "phone"},
+    {Key::WebCam, "webcam"},
+    {Key::Mail, "mail"},
+    {Key::MailForward, "mailforward"},
+    {Key::Save, "save"},
+    {Key::Documents, "documents"},
+};
 
-    // Numeric keypad textual aliases are already seeded - leave room for
-    // dynamic parsing for `KP_*` forms in the lookup logic below.
+/// Size of the dense name table: one slot per `Key` value up to the largest.
+constexpr size_t kKeyTableSize = [] {
+  size_t maxKey = 0;
+  for (const auto &entry : kCanonicalNames)
+    maxKey = std::max(maxKey, static_cast<size_t>(entry.key));
+  return maxKey + 1;
+}();
+
+/**
+ * @brief Dense `Key` -> canonical name table.
+ *
+ * Slots for values without a canonical name stay empty and are reported as
+ * "Unknown" by `keyToStringView`.
+ */
+constexpr auto kNameByKey = [] {
+  std::array<std::string_view, kKeyTableSize> table{};
+  for (const auto &entry : kCanonicalNames) {
+    auto &slot = table[static_cast<size_t>(entry.key)];
+    if (slot.empty())
+      slot = entry.name;
   }
+  return table;
+}();
+
+/**
+ * @brief Entry of the parse table.
+ *
+ * `order` records the position in the original alias-then-canonical sequence
+ * and breaks ties between case-insensitively equal names, so that the earlier
+ * (alias) spelling wins.
+ */
+struct ParseEntry {
+  std::string_view name;
+  Key key{Key::Unknown};
+  bool canonical{false};
+  uint16_t order{0};
+};
+
+constexpr size_t kParseTableSize =
+    std::size(kAliasNames) + std::size(kCanonicalNames);
 
-  // Exact-case lookup first: prefer an exact alias match (e.g., "OE")
-  // over falling back to a case-insensitive canonical match.
-  auto itExact = rev.find(input);
-  if (itExact != rev.end()) {
-    return itExact->second;
+/// All accepted names sorted case-insensitively for binary search.
+constexpr auto kParseTable = [] {
+  std::array<ParseEntry, kParseTableSize> table{};
+  size_t i = 0;
+  for (const auto &entry : kAliasNames) {
+    table[i] = {entry.name, entry.key, false, static_cast<uint16_t>(i)};
+    ++i;
   }
+  for (const auto &entry : kCanonicalNames) {
+    table[i] = {entry.name, entry.key, true, static_cast<uint16_t>(i)};
+    ++i;
+  }
+  std::sort(table.begin(), table.end(),
+            [](const ParseEntry &a, const ParseEntry &b) {
+              const int c = compareIgnoreCase(a.name, b.name);
+              return c != 0 ? c < 0 : a.order < b.order;
+            });
+  return table;
+}();
 
-  std::string key = toLower(input);
-  auto it = rev.find(key);
-  if (it != rev.end()) {
-    return it->second;
+struct ParseEntryLess {
+  constexpr bool operator()(const ParseEntry &a, std::string_view b) const {
+    return compareIgnoreCase(a.name, b) < 0;
+  }
+  constexpr bool operator()(std::string_view a, const ParseEntry &b) const {
+    return compareIgnoreCase(a, b.name) < 0;
   }
+};
 
-  // Handle X11 numeric keypad (KP_*) names that may appear in input. These are
-  // often emitted as 'KP_7', 'KP_Home', 'KP_Decimal', etc. Provide a
-  // best-effort mapping to our `Numpad*` values.
-  if (key.rfind("kp", 0) == 0) {
-    std::string suffix = key.substr(2);
-    if (!suffix.empty() && suffix[0] == '_') {
-      suffix.erase(0, 1);
+/**
+ * @brief Look up @p input in the parse table.
+ *
+ * Mirrors the exact-then-lowercase lookup order: an entry whose stored
+ * spelling (aliases as written, canonical names lower-cased) equals the input
+ * wins; otherwise the first entry whose stored spelling equals the lower-cased
+ * input is used.
+ *
+ * @return true and sets @p out when a table entry matched.
+ */
+bool lookupName(std::string_view input, Key &out) {
+  const auto [first, last] = std::equal_range(
+      kParseTable.begin(), kParseTable.end(), input, ParseEntryLess{});
+  if (first == last)
+    return false;
+
+  const bool inputIsLower = isLowerAscii(input);
+  for (auto it = first; it != last; ++it) {
+    if (it->canonical ? inputIsLower : it->name == input) {
+      out = it->key;
+      return true;
+    }
+  }
+  for (auto it = first; it != last; ++it) {
+    if (it->canonical || isLowerAscii(it->name)) {
+      out = it->key;
+      return true;
     }
-    if (suffix == "multiply" || suffix == "mul")
-      return Key::NumpadMultiply;
-    if (suffix == "divide" || suffix == "div")
-      return Key::NumpadDivide;
-    if (suffix == "add" || suffix == "plus")
-      return Key::NumpadPlus;
-    if (suffix == "subtract" || suffix == "minus")
-      return Key::NumpadMinus;
-    if (suffix == "enter")
-      return Key::NumpadEnter;
-    if (suffix == "decimal" || suffix == "delete" || suffix == "del")
-      return Key::NumpadDecimal;
-    if (suffix == "equal")
-      return Key::NumpadEqual;
-    if (suffix == "home" || suffix == "7")
-      return Key::Numpad7;
-    if (suffix == "up" || suffix == "8")
-      return Key::Numpad8;
-    if (suffix == "prior" || suffix == "9")
-      return Key::Numpad9;
-    if (suffix == "left" || suffix == "4")
-      return Key::Numpad4;
-    if (suffix == "begin" || suffix == "5")
-      return Key::Numpad5;
-    if (suffix == "right" || suffix == "6")
-      return Key::Numpad6;
-    if (suffix == "end" || suffix == "1")
-      return Key::Numpad1;
-    if (suffix == "down" || suffix == "2")
-      return Key::Numpad2;
-    if (suffix == "next" || suffix == "3")
-      return Key::Numpad3;
-    if (suffix == "insert" || suffix == "0")
-      return Key::Numpad0;
   }
+  return false;
+}
 
-  // ISO-level special modifiers/keys
-  if (key == "iso_level3_shift" || key == "iso_level5_shift") {
-    return Key::AltRight;
+/**
+ * @brief Map X11 numeric keypad (KP_*) names such as "KP_7", "KP_Home" or
+ * "KP_Decimal" to our `Numpad*` values.
+ *
+ * @param suffix Part of the name following the "kp" / "kp_" prefix.
+ */
+Key keypadFromSuffix(std::string_view suffix) {
+  auto is = [suffix](std::string_view name) {
+    return equalsIgnoreCase(suffix, name);
+  };
+  if (is("multiply") || is("mul"))
+    return Key::NumpadMultiply;
+  if (is("divide") || is("div"))
+    return Key::NumpadDivide;
+  if (is("add") || is("plus"))
+    return Key::NumpadPlus;
+  if (is("subtract") || is("minus"))
+    return Key::NumpadMinus;
+  if (is("enter"))
+    return Key::NumpadEnter;
+  if (is("decimal") || is("delete") || is("del"))
+    return Key::NumpadDecimal;
+  if (is("equal"))
+    return Key::NumpadEqual;
+  if (is("home") || is("7"))
+    return Key::Numpad7;
+  if (is("up") || is("8"))
+    return Key::Numpad8;
+  if (is("prior") || is("9"))
+    return Key::Numpad9;
+  if (is("left") || is("4"))
+    return Key::Numpad4;
+  if (is("begin") || is("5"))
+    return Key::Numpad5;
+  if (is("right") || is("6"))
+    return Key::Numpad6;
+  if (is("end") || is("1"))
+    return Key::Numpad1;
+  if (is("down") || is("2"))
+    return Key::Numpad2;
+  if (is("next") || is("3"))
+    return Key::Numpad3;
+  if (is("insert") || is("0"))
+    return Key::Numpad0;
+  return Key::Unknown;
+}
+
+/**
+ * @brief Map common XF86 hardware/media/app key names to logical keys.
+ * @param name Full keysym name, already known to start with "XF86".
+ */
+Key xf86FromName(std::string_view name) {
+  auto has = [name](std::string_view needle) {
+    return containsIgnoreCase(name, needle);
+  };
+  if (has("audiomute"))
+    return Key::Mute;
+  if (has("audiolowervolume"))
+    return Key::VolumeDown;
+  if (has("audioraisevolume"))
+    return Key::VolumeUp;
+  if (has("audionext"))
+    return Key::MediaNext;
+  if (has("audioplay") || has("audiopause"))
+    return Key::MediaPlayPause;
+  if (has("audioprev"))
+    return Key::MediaPrevious;
+  if (has("audiostop"))
+    return Key::MediaStop;
+  if (has("audiorecord"))
+    return Key::AudioRecord;
+  if (has("audiorewind"))
+    return Key::AudioRewind;
+  if (has("audioforward"))
+    return Key::MediaNext;
+  if (has("power"))
+    return Key::Power;
+  if (has("sleep"))
+    return Key::Sleep;
+  if (has("wakeup"))
+    return Key::Wake;
+  if (has("eject"))
+    return Key::Eject;
+  if (has("monbrightnessdown"))
+    return Key::BrightnessDown;
+  if (has("monbrightnessup"))
+    return Key::BrightnessUp;
+  if (has("audiomedia"))
+    return Key::MediaPlayPause;
+  if (has("menukb") || has("menu"))
+    return Key::Menu;
+  if (has("calculator"))
+    return Key::Calculator;
+  if (has("mail"))
+    return Key::Mail;
+  if (has("webcam"))
+    return Key::WebCam;
+  if (has("search"))
+    return Key::Search;
+  if (has("launcha"))
+    return Key::LaunchA;
+  if (has("launchb"))
+    return Key::LaunchB;
+  if (has("launch1"))
+    return Key::Launch1;
+  if (has("launch2"))
+    return Key::Launch2;
+  if (has("launch3"))
+    return Key::Launch3;
+  if (has("launch4"))
+    return Key::Launch4;
+  if (has("launch5"))
+    return Key::Launch5;
+  if (has("launch6"))
+    return Key::Launch6;
+  if (has("launch7"))
+    return Key::Launch7;
+  if (has("launch8"))
+    return Key::Launch8;
+  if (has("launch9"))
+    return Key::Launch9;
+  if (has("touchpad"))
+    return Key::TouchpadToggle;
+  if (has("kbd")) {
+    if (has("brightness")) {
+      if (has("down"))
+        return Key::KbdBrightnessDown;
+      if (has("up"))
+        return Key::KbdBrightnessUp;
+    }
+    return Key::KbdLightOnOff;
   }
-  if (key == "iso_left_tab") {
-    return Key::Tab;
+  if (has("battery"))
+    return Key::Battery;
+  if (has("bluetooth"))
+    return Key::Bluetooth;
+  if (has("wlan"))
+    return Key::WLAN;
+  if (has("wwan"))
+    return Key::WWAN;
+  if (has("rfkill"))
+    return Key::RFKill;
+  return Key::Unknown;
+}
+
+} // namespace
+
+/**
+ * @brief Convert a `Key` to its canonical textual representation without
+ * allocating.
+ *
+ * @param key Logical key enum value to convert.
+ * @return std::string_view Canonical name with static storage duration (the
+ *         characters are followed by a null terminator). Returns "Unknown" if
+ *         the key does not have a canonical name.
+ */
+AXIDEV_IO_API std::string_view keyToStringView(Key key) noexcept {
+  const auto index = static_cast<size_t>(key);
+  if (index < kNameByKey.size() && !kNameByKey[index].empty()) {
+    return kNameByKey[index];
   }
+  return "Unknown";
+}
 
-  // Map common XF86 hardware/media/app keys to logical keys where appropriate.
-  if (key.rfind("xf86", 0) == 0) {
-    if (key.find("audiomute") != std::string::npos)
-      return Key::Mute;
-    if (key.find("audiolowervolume") != std::string::npos)
-      return Key::VolumeDown;
-    if (key.find("audioraisevolume") != std::string::npos)
-      return Key::VolumeUp;
-    if (key.find("audionext") != std::string::npos)
-      return Key::MediaNext;
-    if (key.find("audioplay") != std::string::npos ||
-        key.find("audiopause") != std::string::npos)
-      return Key::MediaPlayPause;
-    if (key.find("audioprev") != std::string::npos)
-      return Key::MediaPrevious;
-    if (key.find("audiostop") != std::string::npos)
-      return Key::MediaStop;
-    if (key.find("audiorecord") != std::string::npos)
-      return Key::AudioRecord;
-    if (key.find("audiorewind") != std::string::npos)
-      return Key::AudioRewind;
-    if (key.find("audioforward") != std::string::npos)
-      return Key::MediaNext;
-    if (key.find("power") != std::string::npos)
-      return Key::Power;
-    if (key.find("sleep") != std::string::npos)
-      return Key::Sleep;
-    if (key.find("wakeup") != std::string::npos)
-      return Key::Wake;
-    if (key.find("eject") != std::string::npos)
-      return Key::Eject;
-    if (key.find("monbrightnessdown") != std::string::npos)
-      return Key::BrightnessDown;
-    if (key.find("monbrightnessup") != std::string::npos)
-      return Key::BrightnessUp;
-    if (key.find("audiomedia") != std::string::npos)
-      return Key::MediaPlayPause;
-    if (key.find("menukb") != std::string::npos ||
-        key.find("menu") != std::string::npos)
-      return Key::Menu;
-    if (key.find("calculator") != std::string::npos)
-      return Key::Calculator;
-    if (key.find("mail") != std::string::npos)
-      return Key::Mail;
-    if (key.find("webcam") != std::string::npos)
-      return Key::WebCam;
-    if (key.find("search") != std::string::npos)
-      return Key::Search;
-    if (key.find("launcha") != std::string::npos)
-      return Key::LaunchA;
-    if (key.find("launchb") != std::string::npos)
-      return Key::LaunchB;
-    if (key.find("launch1") != std::string::npos)
-      return Key::Launch1;
-    if (key.find("launch2") != std::string::npos)
-      return Key::Launch2;
-    if (key.find("launch3") != std::string::npos)
-      return Key::Launch3;
-    if (key.find("launch4") != std::string::npos)
-      return Key::Launch4;
-    if (key.find("launch5") != std::string::npos)
-      return Key::Launch5;
-    if (key.find("launch6") != std::string::npos)
-      return Key::Launch6;
-    if (key.find("launch7") != std::string::npos)
-      return Key::Launch7;
-    if (key.find("launch8") != std::string::npos)
-      return Key::Launch8;
-    if (key.find("launch9") != std::string::npos)
-      return Key::Launch9;
-    if (key.find("touchpad") != std::string::npos)
-      return Key::TouchpadToggle;
-    if (key.find("kbd") != std::string::npos) {
-      if (key.find("brightness") != std::string::npos) {
-        if (key.find("down") != std::string::npos)
-          return Key::KbdBrightnessDown;
-        if (key.find("up") != std::string::npos)
-          return Key::KbdBrightnessUp;
-      }
-      return Key::KbdLightOnOff;
+/**
+ * @brief Convert a `Key` to its canonical textual representation.
+ *
+ * @param key Logical key enum value to convert.
+ * @return std::string Canonical name for the key (e.g., "A", "Enter").
+ *         Returns "Unknown" if the key does not have a canonical name.
+ */
+AXIDEV_IO_API std::string keyToString(Key key) {
+  return std::string(keyToStringView(key));
+}
+
+/**
+ * @brief Parse a textual key name into a `Key` value.
+ *
+ * The function accepts many aliases and single-character inputs. Lookups are
+ * a binary search over a table built at compile time and never allocate.
+ * Comparison for textual aliases is case-insensitive when appropriate.
+ *
+ * @param input Input textual name (e.g., "A", "esc", "@", "space").
+ * @return Key Parsed `Key` value, or `Key::Unknown` for empty or unrecognized
+ *         inputs.
+ */
+AXIDEV_IO_API Key stringToKey(std::string_view input) {
+  if (input.empty()) {
+    return Key::Unknown;
+  }
+
+  Key key = Key::Unknown;
+  if (lookupName(input, key)) {
+    return key;
+  }
+
+  // Handle X11 numeric keypad (KP_*) names that may appear in input.
+  if (startsWithIgnoreCase(input, "kp")) {
+    std::string_view suffix = input.substr(2);
+    if (!suffix.empty() && suffix[0] == '_') {
+      suffix.remove_prefix(1);
     }
-    if (key.find("battery") != std::string::npos)
-      return Key::Battery;
-    if (key.find("bluetooth") != std::string::npos)
-      return Key::Bluetooth;
-    if (key.find("wlan") != std::string::npos)
-      return Key::WLAN;
-    if (key.find("wwan") != std::string::npos)
-      return Key::WWAN;
-    if (key.find("rfkill") != std::string::npos)
-      return Key::RFKill;
-
-    // If we don't find a match here, allow the code below to either map a more
-    // generic alias or fall back to Unknown (and log) so missing names are
-    // still discoverable.
+    key = keypadFromSuffix(suffix);
+    if (key != Key::Unknown)
+      return key;
   }
 
-  // Generic / common aliases that don't need XF86/KP prefixes.
-  if (key == "eacute" || key == "egrave")
-    return Key::E;
-  if (key == "agrave")
-    return Key::A;
-  if (key == "ugrave")
-    return Key::U;
-  if (key == "ccedilla")
-    return Key::C;
-  if (key == "OE")
-    return Key::OE;
-  if (key == "oe")
-    return Key::oe;
-  if (key == "quotedbl")
-    return Key::Quote;
-  if (key == "question")
-    return Key::QuestionMark;
-  if (key == "exclam")
-    return Key::Exclamation;
-  if (key == "degree")
-    return Key::Degree;
-  if (key == "sterling")
-    return Key::Sterling;
-  if (key == "mu")
-    return Key::Mu;
-  if (key == "section")
-    return Key::Section;
-  if (key == "plusminus")
-    return Key::PlusMinus;
-  if (key == "linefeed")
-    return Key::Enter;
-  if (key == "prior")
-    return Key::PageUp;
-  if (key == "next")
-    return Key::PageDown;
-  if (key == "print" || key == "sys_req")
-    return Key::PrintScreen;
-  if (key == "cancel")
-    return Key::Cancel;
-  if (key == "redo")
-    return Key::Redo;
-  if (key == "undo")
-    return Key::Undo;
-  if (key == "find")
-    return Key::Find;
-  if (key == "sunprops")
-    return Key::SunProps;
-  if (key == "sunfront")
-    return Key::SunFront;
+  if (startsWithIgnoreCase(input, "xf86")) {
+    key = xf86FromName(input);
+    if (key != Key::Unknown)
+      return key;
+    // If we don't find a match here, fall back to Unknown (and log) so
+    // missing names are still discoverable.
+  }
 
   AXIDEV_IO_LOG_DEBUG("stringToKey: unknown input='%s'",
-                    escapeForLog(input).c_str());
+                      escapeForLog(input).c_str());
   return Key::Unknown;
 }
 
@@ -895,7 +995,7 @@ AXIDEV_IO_API std::string keyToStringWithModifier(Key key, Modifier mods) {
     result += "Shift+";
   }
 
-  result += keyToString(key);
+  result += keyToStringView(key);
   return result;
 }
 
@@ -905,39 +1005,37 @@ AXIDEV_IO_API std::string keyToStringWithModifier(Key key, Modifier mods) {
  * @param str Input string (case-insensitive; accepts modifier prefixes).
  * @return KeyWithModifier Parsed key and required modifiers.
  */
-AXIDEV_IO_API KeyWithModifier stringToKeyWithModifier(const std::string &str) {
+AXIDEV_IO_API KeyWithModifier stringToKeyWithModifier(std::string_view str) {
   if (str.empty()) {
     return KeyWithModifier(Key::Unknown, Modifier::None);
   }
 
+  // Check for each modifier prefix
+  static constexpr std::pair<std::string_view, Modifier> modPrefixes[] = {
+      {"super+", Modifier::Super},  {"super-", Modifier::Super},
+      {"cmd+", Modifier::Super},    {"cmd-", Modifier::Super},
+      {"win+", Modifier::Super},    {"win-", Modifier::Super},
+      {"meta+", Modifier::Super},   {"meta-", Modifier::Super},
+      {"ctrl+", Modifier::Ctrl},    {"ctrl-", Modifier::Ctrl},
+      {"control+", Modifier::Ctrl}, {"control-", Modifier::Ctrl},
+      {"alt+", Modifier::Alt},      {"alt-", Modifier::Alt},
+      {"opt+", Modifier::Alt},      {"opt-", Modifier::Alt},
+      {"option+", Modifier::Alt},   {"option-", Modifier::Alt},
+      {"shift+", Modifier::Shift},  {"shift-", Modifier::Shift},
+  };
+
   Modifier mods = Modifier::None;
-  std::string remaining = str;
+  std::string_view remaining = str;
 
   // Parse modifier prefixes (case-insensitive)
   // We repeatedly look for known modifier prefixes followed by '+' or '-'
   bool foundModifier = true;
   while (foundModifier && !remaining.empty()) {
     foundModifier = false;
-    std::string lower = toLower(remaining);
-
-    // Check for each modifier prefix
-    static const std::pair<const char *, Modifier> modPrefixes[] = {
-        {"super+", Modifier::Super},  {"super-", Modifier::Super},
-        {"cmd+", Modifier::Super},    {"cmd-", Modifier::Super},
-        {"win+", Modifier::Super},    {"win-", Modifier::Super},
-        {"meta+", Modifier::Super},   {"meta-", Modifier::Super},
-        {"ctrl+", Modifier::Ctrl},    {"ctrl-", Modifier::Ctrl},
-        {"control+", Modifier::Ctrl}, {"control-", Modifier::Ctrl},
-        {"alt+", Modifier::Alt},      {"alt-", Modifier::Alt},
-        {"opt+", Modifier::Alt},      {"opt-", Modifier::Alt},
-        {"option+", Modifier::Alt},   {"option-", Modifier::Alt},
-        {"shift+", Modifier::Shift},  {"shift-", Modifier::Shift},
-    };
-
     for (const auto &[prefix, mod] : modPrefixes) {
-      if (lower.rfind(prefix, 0) == 0) {
+      if (startsWithIgnoreCase(remaining, prefix)) {
         mods = mods | mod;
-        remaining = remaining.substr(std::strlen(prefix));
+        remaining.remove_prefix(prefix.size());
         foundModifier = true;
         break;
       }
@@ -7,6 +7,7 @@
  */
 
 #include "keyboard/common/keymap.hpp"
+#include <atomic>
 #include <axidev-io/log.hpp>
 #include <mutex>
 
@@ -20,26 +21,11 @@
 
 namespace axidev::io::keyboard {
 
-namespace {
-
-// Encode keycode + modifiers for lookup (same encoding as platform keymaps)
-uint32_t encodeCodeMods(int32_t keycode, Modifier mods) {
-  uint8_t modBits = 0;
-  if (hasModifier(mods, Modifier::Shift))
-    modBits |= 0x01;
-  if (hasModifier(mods, Modifier::Ctrl))
-    modBits |= 0x02;
-  if (hasModifier(mods, Modifier::Alt))
-    modBits |= 0x04;
-  return (static_cast<uint32_t>(keycode) << 8) | modBits;
-}
-
-} // namespace
-
 // Singleton instance and mutex
 static std::unique_ptr<KeyMap> g_instance;
 static std::once_flag g_initFlag;
 static std::mutex g_reinitMutex;
+static std::atomic<uint64_t> g_generation{0};
 
 const KeyMap &KeyMap::instance() {
   std::call_once(g_initFlag,
@@ -49,81 +35,40 @@ const KeyMap &KeyMap::instance() {
 
 void KeyMap::reinitialize() {
   std::lock_guard<std::mutex> lock(g_reinitMutex);
+  // Bump the generation first so that the shared platform snapshot the new
+  // instance copies from is rebuilt rather than reused.
+  g_generation.fetch_add(1, std::memory_order_release);
   g_instance = std::unique_ptr<KeyMap>(new KeyMap());
 }
 
+uint64_t KeyMap::generation() noexcept {
+  return g_generation.load(std::memory_order_acquire);
+}
+
 KeyMap::KeyMap() {
   AXIDEV_IO_LOG_DEBUG("KeyMap: initializing platform keymap");
 
 #ifdef __APPLE__
-  auto km = detail::initMacOSKeyMap();
-
-  // Copy charToKeycode
-  for (const auto &[cp, mapping] : km.charToKeycode) {
-    charToMapping_[cp] = mapping;
-  }
-
-  // Copy codeToKey
-  for (const auto &[code, key] : km.codeToKey) {
-    codeToKey_[static_cast<int32_t>(code)] = key;
-  }
-
-  // Copy codeAndModsToKey
-  for (const auto &[encoded, key] : km.codeAndModsToKey) {
-    codeAndModsToKey_[encoded] = key;
-  }
-
-  // Copy keyToCode
-  for (const auto &[key, code] : km.keyToCode) {
-    keyToCode_[key] = static_cast<int32_t>(code);
-  }
+  const auto km = detail::acquireMacOSKeyMap();
+  charToMapping_ = km->charToKeycode;
+  codeToKey_ = km->codeToKey;
+  codeAndModsToKey_ = km->codeAndModsToKey;
+  keyToCode_ = km->keyToCode;
 
 #elif defined(_WIN32)
-  auto km = detail::initWindowsKeyMap();
-
-  // Copy charToKeycode
-  for (const auto &[cp, mapping] : km.charToKeycode) {
-    charToMapping_[cp] = mapping;
-  }
-
-  // Copy vkToKey
-  for (const auto &[vk, key] : km.vkToKey) {
-    codeToKey_[static_cast<int32_t>(vk)] = key;
-  }
-
-  // Copy vkAndModsToKey
-  for (const auto &[encoded, key] : km.vkAndModsToKey) {
-    codeAndModsToKey_[encoded] = key;
-  }
-
-  // Copy keyToVk
-  for (const auto &[key, vk] : km.keyToVk) {
-    keyToCode_[key] = static_cast<int32_t>(vk);
-  }
+  const auto km = detail::acquireWindowsKeyMap();
+  charToMapping_ = km->charToKeycode;
+  codeToKey_ = km->vkToKey;
+  codeAndModsToKey_ = km->vkAndModsToKey;
+  keyToCode_ = km->keyToVk;
 
 #elif defined(__linux__)
   // Linux needs XKB context - for now use fallback-only mode
   auto km = detail::initLinuxKeyMap(nullptr, nullptr);
-
-  // Copy charToKeycode
-  for (const auto &[cp, mapping] : km.charToKeycode) {
-    charToMapping_[cp] = mapping;
-  }
-
-  // Copy evdevToKey
-  for (const auto &[evdev, key] : km.evdevToKey) {
-    codeToKey_[evdev] = key;
-  }
-
-  // Copy codeAndModsToKey
-  for (const auto &[encoded, key] : km.codeAndModsToKey) {
-    codeAndModsToKey_[encoded] = key;
-  }
-
-  // Copy keyToEvdev
-  for (const auto &[key, evdev] : km.keyToEvdev) {
-    keyToCode_[key] = evdev;
-  }
+  charToMapping_ = std::move(km.charToKeycode);
+  codeToKey_ = std::move(km.evdevToKey);
+  codeAndModsToKey_ = std::move(km.codeAndModsToKey);
+  keyToCode_ = std::move(km.keyToEvdev);
 
 #else
   AXIDEV_IO_LOG_WARN("KeyMap: no platform keymap available");
@@ -138,18 +83,13 @@ KeyMap::KeyMap() {
 
 std::optional<KeyWithModifier>
 KeyMap::keyForCharacter(char32_t codepoint) const {
-  auto it = charToMapping_.find(codepoint);
-  if (it != charToMapping_.end()) {
-    const KeyMapping &mapping = it->second;
-    if (mapping.producedKey != Key::Unknown) {
-      return KeyWithModifier(mapping.producedKey, mapping.requiredMods);
+  if (const KeyMapping *mapping = charToMapping_.find(codepoint)) {
+    if (mapping->producedKey != Key::Unknown) {
+      return KeyWithModifier(mapping->producedKey, mapping->requiredMods);
     }
     // If we have a keycode but no produced key, try to look up the base key
-    if (mapping.keycode >= 0) {
-      auto baseIt = codeToKey_.find(mapping.keycode);
-      if (baseIt != codeToKey_.end()) {
-        return KeyWithModifier(baseIt->second, mapping.requiredMods);
-      }
+    if (const Key *base = codeToKey_.find(mapping->keycode)) {
+      return KeyWithModifier(*base, mapping->requiredMods);
     }
   }
   return std::nullopt;
@@ -157,10 +97,8 @@ KeyMap::keyForCharacter(char32_t codepoint) const {
 
 Key KeyMap::keyFromCode(int32_t keycode, Modifier mods) const {
   // First try exact match with modifiers
-  uint32_t encoded = encodeCodeMods(keycode, mods);
-  auto it = codeAndModsToKey_.find(encoded);
-  if (it != codeAndModsToKey_.end()) {
-    return it->second;
+  if (const Key *key = codeAndModsToKey_.find(keycode, mods)) {
+    return *key;
   }
 
   // Fall back to base key
@@ -168,32 +106,27 @@ Key KeyMap::keyFromCode(int32_t keycode, Modifier mods) const {
 }
 
 Key KeyMap::baseKeyFromCode(int32_t keycode) const {
-  auto it = codeToKey_.find(keycode);
-  if (it != codeToKey_.end()) {
-    return it->second;
-  }
-  return Key::Unknown;
+  const Key *key = codeToKey_.find(keycode);
+  return key ? *key : Key::Unknown;
 }
 
 std::optional<int32_t> KeyMap::codeForKey(Key key) const {
-  auto it = keyToCode_.find(key);
-  if (it != keyToCode_.end()) {
-    return it->second;
+  if (const int32_t *code = keyToCode_.find(key)) {
+    return *code;
   }
   return std::nullopt;
 }
 
 std::optional<KeyMapping>
 KeyMap::mappingForCharacter(char32_t codepoint) const {
-  auto it = charToMapping_.find(codepoint);
-  if (it != charToMapping_.end()) {
-    return it->second;
+  if (const KeyMapping *mapping = charToMapping_.find(codepoint)) {
+    return *mapping;
   }
   return std::nullopt;
 }
 
 bool KeyMap::canTypeCharacter(char32_t codepoint) const {
-  return charToMapping_.find(codepoint) != charToMapping_.end();
+  return charToMapping_.find(codepoint) != nullptr;
 }
 
 } // namespace axidev::io::keyboard
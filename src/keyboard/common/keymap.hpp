@@ -16,7 +16,8 @@
 
 #include <axidev-io/keyboard/common.hpp>
 #include <optional>
-#include <unordered_map>
+
+#include "keyboard/common/flat_keymap.hpp"
 
 namespace axidev::io::keyboard {
 
@@ -50,6 +51,17 @@ public:
    */
   static void reinitialize();
 
+  /**
+   * @brief Layout generation, incremented by every `reinitialize()`.
+   *
+   * Lets callers that cache data derived from the layout (such as compiled
+   * Sender sequences) detect that it may be stale. Does not initialize the
+   * keymap.
+   *
+   * @return uint64_t Number of `reinitialize()` calls so far.
+   */
+  static uint64_t generation() noexcept;
+
   /**
    * @brief Look up the Key and required modifiers to produce a character.
    *
@@ -115,11 +127,11 @@ public:
 private:
   KeyMap();
 
-  // Internal storage - platform-specific
-  std::unordered_map<char32_t, KeyMapping> charToMapping_;
-  std::unordered_map<int32_t, Key> codeToKey_;
-  std::unordered_map<uint32_t, Key> codeAndModsToKey_;
-  std::unordered_map<Key, int32_t> keyToCode_;
+  // Internal storage, moved from the platform keymap (see flat_keymap.hpp)
+  detail::CharMappingTable charToMapping_;
+  detail::CodeKeyTable codeToKey_;
+  detail::CodeModsKeyTable codeAndModsToKey_;
+  detail::KeyCodeTable keyToCode_;
 };
 
 } // namespace axidev::io::keyboard
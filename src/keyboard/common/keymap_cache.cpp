@@ -0,0 +1,281 @@
+/**
+ * @file keyboard/common/keymap_cache.cpp
+ * @brief On-disk format of the shared keymap cache.
+ *
+ * A cache file holds a header (magic, format version, byte-order mark, the
+ * library version and the layout identity it was built for) followed by
+ * each table as a count and fixed-width entries in host byte order. Files are only ever read back
+ * on the machine that wrote them; anything unexpected makes the load fail
+ * and the caller rebuild the keymap.
+ */
+
+#include "keyboard/common/keymap_cache.hpp"
+
+#include <axidev-io/core.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace axidev::io::keyboard::detail {
+
+namespace {
+
+constexpr char kMagic[4] = {'A', 'X', 'K', 'M'};
+constexpr uint32_t kFormatVersion = 2;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+/// Upper bound on the entries of one table; keeps a corrupt count from
+/// driving an endless read loop.
+constexpr uint32_t kMaxEntries = static_cast<uint32_t>(kMaxDenseSlots * 8);
+
+template <typename T> void put(std::ostream &out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> bool get(std::istream &in, T &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+void putKey(std::ostream &out, Key key) {
+  put(out, static_cast<uint16_t>(key));
+}
+
+bool getKey(std::istream &in, Key &key) {
+  uint16_t raw = 0;
+  if (!get(in, raw))
+    return false;
+  key = static_cast<Key>(raw);
+  return true;
+}
+
+void putMods(std::ostream &out, Modifier mods) {
+  put(out, static_cast<uint8_t>(mods));
+}
+
+bool getMods(std::istream &in, Modifier &mods) {
+  uint8_t raw = 0;
+  if (!get(in, raw))
+    return false;
+  mods = static_cast<Modifier>(raw);
+  return true;
+}
+
+bool getCount(std::istream &in, uint32_t &count) {
+  return get(in, count) && count <= kMaxEntries;
+}
+
+void putString(std::ostream &out, std::string_view value) {
+  put(out, static_cast<uint32_t>(value.size()));
+  out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+/// Read a string written by putString() and compare it with @p expected.
+bool expectString(std::istream &in, std::string_view expected) {
+  uint32_t size = 0;
+  if (!get(in, size) || size != expected.size())
+    return false;
+  std::string stored(size, '\0');
+  return in.read(stored.data(), static_cast<std::streamsize>(size)) &&
+         stored == expected;
+}
+
+/// Name beside @p path that no other process or save in this one uses.
+std::string temporaryPath(const std::string &path) {
+  static std::atomic<uint32_t> counter{0};
+#ifdef _WIN32
+  const long pid = static_cast<long>(_getpid());
+#else
+  const long pid = static_cast<long>(getpid());
+#endif
+  return path + "." + std::to_string(pid) + "." +
+         std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) +
+         ".tmp";
+}
+
+/// FNV-1a, used to give every layout identity a short file name.
+uint64_t hashLayout(std::string_view layout) noexcept {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : layout) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+} // namespace
+
+void writeKeyMapTable(std::ostream &out, const KeyCodeTable &table) {
+  put(out, static_cast<uint32_t>(table.size()));
+  table.forEach([&out](Key key, int32_t code) {
+    putKey(out, key);
+    put(out, code);
+  });
+}
+
+void writeKeyMapTable(std::ostream &out, const CodeKeyTable &table) {
+  put(out, static_cast<uint32_t>(table.size()));
+  table.forEach([&out](int32_t code, Key key) {
+    put(out, code);
+    putKey(out, key);
+  });
+}
+
+void writeKeyMapTable(std::ostream &out, const CharMappingTable &table) {
+  put(out, static_cast<uint32_t>(table.size()));
+  table.forEach([&out](char32_t codepoint, const KeyMapping &mapping) {
+    put(out, static_cast<uint32_t>(codepoint));
+    put(out, mapping.keycode);
+    putMods(out, mapping.requiredMods);
+    putKey(out, mapping.producedKey);
+  });
+}
+
+void writeKeyMapTable(std::ostream &out, const CodeModsKeyTable &table) {
+  put(out, static_cast<uint32_t>(table.size()));
+  table.forEach([&out](int32_t code, Modifier mods, Key key) {
+    put(out, code);
+    putMods(out, mods);
+    putKey(out, key);
+  });
+}
+
+bool readKeyMapTable(std::istream &in, KeyCodeTable &table) {
+  uint32_t count = 0;
+  if (!getCount(in, count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    Key key{};
+    int32_t code = 0;
+    if (!getKey(in, key) || !get(in, code) || !table.insert(key, code))
+      return false;
+  }
+  return true;
+}
+
+bool readKeyMapTable(std::istream &in, CodeKeyTable &table) {
+  uint32_t count = 0;
+  if (!getCount(in, count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    int32_t code = 0;
+    Key key{};
+    if (!get(in, code) || !getKey(in, key) || !table.insert(code, key))
+      return false;
+  }
+  return true;
+}
+
+bool readKeyMapTable(std::istream &in, CharMappingTable &table) {
+  uint32_t count = 0;
+  if (!getCount(in, count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t codepoint = 0;
+    KeyMapping mapping;
+    if (!get(in, codepoint) || !get(in, mapping.keycode) ||
+        !getMods(in, mapping.requiredMods) ||
+        !getKey(in, mapping.producedKey) ||
+        !table.insert(static_cast<char32_t>(codepoint), mapping))
+      return false;
+  }
+  return true;
+}
+
+bool readKeyMapTable(std::istream &in, CodeModsKeyTable &table) {
+  uint32_t count = 0;
+  if (!getCount(in, count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    int32_t code = 0;
+    Modifier mods{};
+    Key key{};
+    if (!get(in, code) || !getMods(in, mods) || !getKey(in, key) ||
+        !table.insert(code, mods, key))
+      return false;
+  }
+  return true;
+}
+
+std::string keyMapCachePath(std::string_view platform,
+                            std::string_view layout) {
+  const char *dir = std::getenv("AXIDEV_IO_KEYMAP_CACHE_DIR");
+  if (dir == nullptr || *dir == '\0')
+    return {};
+  char name[64];
+  std::snprintf(name, sizeof(name), "%.*s-%016llx.keymap",
+                static_cast<int>(platform.size()), platform.data(),
+                static_cast<unsigned long long>(hashLayout(layout)));
+  return (std::filesystem::path(dir) / name).string();
+}
+
+bool loadKeyMapFile(const std::string &path, std::string_view layout,
+                    const std::function<bool(std::istream &)> &readTables) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return false;
+
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint32_t byteOrder = 0;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !get(in, version) || version != kFormatVersion ||
+      !get(in, byteOrder) || byteOrder != kByteOrderMark ||
+      !expectString(in, AXIDEV_IO_VERSION) || !expectString(in, layout))
+    return false;
+
+  if (!readTables(in)) {
+    AXIDEV_IO_LOG_WARN("Keymap cache: ignoring malformed file %s",
+                       path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool saveKeyMapFile(const std::string &path, std::string_view layout,
+                    const std::function<void(std::ostream &)> &writeTables) {
+  // Write to a file of our own beside the target and rename over it: readers
+  // see either the old file or the complete new one, and concurrent saves
+  // cannot interleave their writes.
+  const std::string tmp = temporaryPath(path);
+  std::error_code ec;
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out)
+      return false;
+    out.write(kMagic, sizeof(kMagic));
+    put(out, kFormatVersion);
+    put(out, kByteOrderMark);
+    putString(out, AXIDEV_IO_VERSION);
+    putString(out, layout);
+    writeTables(out);
+    if (!out.flush()) {
+      out.close();
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+} // namespace axidev::io::keyboard::detail
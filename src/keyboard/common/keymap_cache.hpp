@@ -0,0 +1,217 @@
+#pragma once
+/**
+ * @file keyboard/common/keymap_cache.hpp
+ * @brief Internal process-wide cache of built keyboard layout mappings.
+ *
+ * Building a platform keymap scans every keycode under several modifier
+ * combinations, and on Linux first compiles an XKB keymap. The Sender, the
+ * Listener and `KeyMap::instance()` all need the same tables, so each
+ * platform builder publishes its result here as an immutable, shared
+ * snapshot keyed by the layout it was built for. Later constructions for the
+ * same layout only take a reference.
+ *
+ * Snapshots are tagged with `KeyMap::generation()`; after
+ * `KeyMap::reinitialize()` the next request rebuilds them. When the
+ * `AXIDEV_IO_KEYMAP_CACHE_DIR` environment variable names a directory, the
+ * first build of a layout in a process is also loaded from (or saved to) a
+ * file in that directory, so a fresh process can skip the scan entirely.
+ * A file is only used if it was written by the same library version and,
+ * where the platform provides one, the same layout data stamp.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the keyboard backends.
+ */
+
+#include <axidev-io/log.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/common/keymap.hpp"
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @name Keymap cache file helpers
+ * Implemented in keymap_cache.cpp. Table readers leave the table in an
+ * unspecified state and return false on malformed input.
+ * @{
+ */
+void writeKeyMapTable(std::ostream &out, const KeyCodeTable &table);
+void writeKeyMapTable(std::ostream &out, const CodeKeyTable &table);
+void writeKeyMapTable(std::ostream &out, const CharMappingTable &table);
+void writeKeyMapTable(std::ostream &out, const CodeModsKeyTable &table);
+bool readKeyMapTable(std::istream &in, KeyCodeTable &table);
+bool readKeyMapTable(std::istream &in, CodeKeyTable &table);
+bool readKeyMapTable(std::istream &in, CharMappingTable &table);
+bool readKeyMapTable(std::istream &in, CodeModsKeyTable &table);
+
+/**
+ * @brief Cache file for @p layout, or an empty string when the on-disk cache
+ * is disabled (`AXIDEV_IO_KEYMAP_CACHE_DIR` unset or empty).
+ */
+std::string keyMapCachePath(std::string_view platform,
+                            std::string_view layout);
+
+/**
+ * @brief Open the cache file at @p path and let @p readTables parse the body.
+ * @return false if the file is missing, was written for another layout
+ * identity, format or library version, or @p readTables fails.
+ */
+bool loadKeyMapFile(const std::string &path, std::string_view layout,
+                    const std::function<bool(std::istream &)> &readTables);
+
+/**
+ * @brief Atomically replace the cache file at @p path, writing through a
+ * temporary file private to the calling process.
+ * @return false if the file could not be written.
+ */
+bool saveKeyMapFile(const std::string &path, std::string_view layout,
+                    const std::function<void(std::ostream &)> &writeTables);
+/** @} */
+
+/**
+ * @brief Result of a keymap build that can fall short of the layout it was
+ * asked for.
+ *
+ * A build returning this with `complete` false (e.g. only the
+ * layout-independent fallback mappings, because the platform layout could not
+ * be loaded) hands its map to the caller, but the map is neither cached nor
+ * saved, so the next request retries the build.
+ */
+template <typename Map> struct KeyMapBuild {
+  Map map;
+  bool complete{true};
+};
+
+/**
+ * @brief Registry of immutable keymap snapshots, one per layout.
+ *
+ * @tparam Map Platform keymap struct. `keyMapTables(Map &)` and
+ * `keyMapTables(const Map &)` must return a tuple of references to its
+ * tables; that order is the on-disk order.
+ */
+template <typename Map> class SharedKeyMapCache {
+public:
+  using Snapshot = std::shared_ptr<const Map>;
+
+  /**
+   * @param platform Short tag used in log lines and cache file names.
+   * @param dataStamp Optional; returns a summary of the platform layout data
+   * (e.g. modification times) that is stored in cache files, so files
+   * written before that data changed are ignored.
+   */
+  explicit SharedKeyMapCache(const char *platform,
+                             std::string (*dataStamp)() = nullptr)
+      : platform_(platform), dataStamp_(dataStamp) {}
+
+  /**
+   * @brief Snapshot for @p layout, calling `build()` (returning a `Map` or a
+   * `KeyMapBuild<Map>`) only if no current snapshot exists.
+   *
+   * Concurrent callers asking for a layout that is being built wait for that
+   * build rather than repeating it.
+   */
+  template <typename Build>
+  Snapshot acquire(const std::string &layout, Build &&build) {
+    return acquire(layout, std::forward<Build>(build), [](Map &) {});
+  }
+
+  /**
+   * @brief As above, then `stamp(map)` on a new snapshot before it is shared,
+   * whether it was built or loaded; it fills the fields of `Map` that the
+   * cache file does not store.
+   */
+  template <typename Build, typename Stamp>
+  Snapshot acquire(const std::string &layout, Build &&build, Stamp &&stamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t generation = KeyMap::generation();
+    auto it = entries_.find(layout);
+    if (it != entries_.end() && it->second.generation == generation)
+      return it->second.map;
+
+    // The disk copy only stands in for the first build; once a process has
+    // seen the layout, a rebuild means the platform data may have changed.
+    const bool firstBuild = it == entries_.end();
+    const std::string path = keyMapCachePath(platform_, layout);
+    // The file name only depends on the layout, so a file made stale by new
+    // layout data is overwritten rather than left behind.
+    const std::string identity =
+        path.empty() || dataStamp_ == nullptr ? layout
+                                              : layout + '\n' + dataStamp_();
+    auto map = std::make_shared<Map>();
+    if (firstBuild && !path.empty() && load(path, identity, *map)) {
+      AXIDEV_IO_LOG_DEBUG("Keymap cache (%s): loaded '%s' from %s", platform_,
+                          layout.c_str(), path.c_str());
+    } else {
+      using Built = std::decay_t<decltype(build())>;
+      if constexpr (std::is_same_v<Built, KeyMapBuild<Map>>) {
+        KeyMapBuild<Map> built = build();
+        *map = std::move(built.map);
+        if (!built.complete) {
+          AXIDEV_IO_LOG_WARN("Keymap cache (%s): incomplete build of '%s' "
+                             "not cached",
+                             platform_, layout.c_str());
+          stamp(*map);
+          return map;
+        }
+      } else {
+        *map = build();
+      }
+      if (!path.empty() && !save(path, identity, *map)) {
+        AXIDEV_IO_LOG_WARN("Keymap cache (%s): could not write %s", platform_,
+                           path.c_str());
+      }
+    }
+    stamp(*map);
+
+    Snapshot snapshot = std::move(map);
+    entries_[layout] = Entry{snapshot, generation};
+    return snapshot;
+  }
+
+private:
+  struct Entry {
+    Snapshot map;
+    uint64_t generation{0};
+  };
+
+  static bool load(const std::string &path, std::string_view layout,
+                   Map &map) {
+    return loadKeyMapFile(path, layout, [&map](std::istream &in) {
+      return std::apply(
+          [&in](auto &...tables) {
+            return (readKeyMapTable(in, tables) && ...);
+          },
+          keyMapTables(map));
+    });
+  }
+
+  static bool save(const std::string &path, std::string_view layout,
+                   const Map &map) {
+    return saveKeyMapFile(path, layout, [&map](std::ostream &out) {
+      std::apply(
+          [&out](const auto &...tables) {
+            (writeKeyMapTable(out, tables), ...);
+          },
+          keyMapTables(map));
+    });
+  }
+
+  const char *platform_;
+  std::string (*dataStamp_)();
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace axidev::io::keyboard::detail
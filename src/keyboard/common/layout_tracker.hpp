@@ -0,0 +1,190 @@
+#pragma once
+/**
+ * @file keyboard/common/layout_tracker.hpp
+ * @brief Internal background rebuild and publication of the active keyboard
+ * layout's mappings.
+ *
+ * Backends that can observe a layout switch (an input-source notification,
+ * a changed foreground layout, a rewritten configuration file) report it with
+ * `LayoutTracker::notifyChanged()`. A background thread then takes the
+ * snapshot for the newly active layout from the shared keymap cache,
+ * building it if needed, and publishes it under a new epoch. Senders and
+ * Listeners compare that epoch with their own on each operation and swap in
+ * the new snapshot by reference. Readers never wait for a build, and an old
+ * snapshot stays alive until its last reader drops it.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the keyboard backends.
+ */
+
+#include <axidev-io/log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief Publishes the snapshot of the active layout, rebuilt off-thread.
+ *
+ * @tparam Map Platform keymap struct (see keymap_cache.hpp).
+ */
+template <typename Map> class LayoutTracker {
+public:
+  using Snapshot = std::shared_ptr<const Map>;
+  /// Returns the snapshot of the layout active now; runs on the tracker
+  /// thread.
+  using Build = std::function<Snapshot()>;
+
+  /**
+   * @param platform Short tag used in log lines.
+   * @param build Called on the tracker thread after each change.
+   */
+  LayoutTracker(const char *platform, Build build)
+      : platform_(platform), build_(std::move(build)) {}
+
+  ~LayoutTracker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wakeCv_.notify_all();
+    if (worker_.joinable())
+      worker_.join();
+  }
+
+  LayoutTracker(const LayoutTracker &) = delete;
+  LayoutTracker &operator=(const LayoutTracker &) = delete;
+
+  /// Number of snapshots published so far. A single atomic load, so readers
+  /// can check it on every operation.
+  [[nodiscard]] uint64_t epoch() const noexcept {
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief The last published snapshot and its epoch.
+   * @return nullptr until something was published.
+   */
+  Snapshot current(uint64_t &epochOut) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    epochOut = epoch_.load(std::memory_order_relaxed);
+    return current_;
+  }
+
+  /**
+   * @brief Report that the active layout may have changed.
+   *
+   * Returns immediately; bursts of reports are coalesced into one rebuild.
+   * A rebuild that finds the snapshot already published publishes nothing.
+   */
+  void notifyChanged() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_ = true;
+      if (!worker_.joinable())
+        worker_ = std::thread(&LayoutTracker::run, this);
+    }
+    wakeCv_.notify_one();
+  }
+
+  /**
+   * @brief Block until no rebuild is pending or running.
+   * @return false on timeout.
+   */
+  bool waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idleCv_.wait_for(lock, timeout,
+                            [this] { return !pending_ && !building_; });
+  }
+
+private:
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wakeCv_.wait(lock, [this] { return pending_ || stopping_; });
+      if (stopping_)
+        return;
+      pending_ = false;
+      building_ = true;
+      lock.unlock();
+
+      Snapshot next;
+      try {
+        next = build_();
+      } catch (const std::exception &e) {
+        AXIDEV_IO_LOG_ERROR("Layout tracker (%s): rebuild failed: %s",
+                            platform_, e.what());
+      }
+
+      lock.lock();
+      building_ = false;
+      if (next && next != current_) {
+        current_ = std::move(next);
+        const uint64_t published =
+            epoch_.fetch_add(1, std::memory_order_release) + 1;
+        AXIDEV_IO_LOG_INFO("Layout tracker (%s): published layout epoch %llu",
+                           platform_,
+                           static_cast<unsigned long long>(published));
+      }
+      idleCv_.notify_all();
+    }
+  }
+
+  const char *platform_;
+  Build build_;
+  mutable std::mutex mutex_;
+  std::condition_variable wakeCv_;
+  std::condition_variable idleCv_;
+  bool pending_{false};
+  bool building_{false};
+  bool stopping_{false};
+  Snapshot current_;
+  std::atomic<uint64_t> epoch_{0};
+  std::thread worker_;
+};
+
+/**
+ * @internal
+ * @brief Reader side of a LayoutTracker: the epoch a Sender or Listener last
+ * synchronized with.
+ */
+class LayoutSubscription {
+public:
+  /**
+   * @brief Swap @p map for the snapshot published since the last call, if
+   * any.
+   *
+   * Costs one atomic load when nothing changed.
+   *
+   * @return true when @p map was replaced.
+   */
+  template <typename Map>
+  bool refresh(const LayoutTracker<Map> &tracker,
+               std::shared_ptr<const Map> &map) {
+    if (tracker.epoch() == epoch_)
+      return false;
+    std::shared_ptr<const Map> next = tracker.current(epoch_);
+    if (!next || next == map)
+      return false;
+    map = std::move(next);
+    return true;
+  }
+
+  /// Tracker epoch of the last `refresh()` that saw a new one; 0 before.
+  [[nodiscard]] uint64_t epoch() const noexcept { return epoch_; }
+
+private:
+  uint64_t epoch_{0};
+};
+
+} // namespace axidev::io::keyboard::detail
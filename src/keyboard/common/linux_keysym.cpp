@@ -8,9 +8,14 @@
 #include "keyboard/common/linux_keysym.hpp"
 
 #include <axidev-io/log.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
 #include <vector>
 #include <xkbcommon/xkbcommon-keysyms.h>
 
+#include "keyboard/common/keymap_cache.hpp"
+
 namespace axidev::io::keyboard::detail {
 
 Key keysymToKey(xkb_keysym_t sym) {
@@ -143,11 +148,9 @@ Key keysymToKey(xkb_keysym_t sym) {
 
 void fillLinuxFallbackMappings(LinuxKeyMap &keyMap) {
   auto set = [&keyMap](Key k, int v) {
-    if (keyMap.keyToEvdev.find(k) == keyMap.keyToEvdev.end())
-      keyMap.keyToEvdev[k] = v;
+    keyMap.keyToEvdev.insert(k, v);
     // Also populate evdevToKey for base key lookups
-    if (keyMap.evdevToKey.find(v) == keyMap.evdevToKey.end())
-      keyMap.evdevToKey[v] = k;
+    keyMap.evdevToKey.insert(v, k);
   };
 
   // Modifiers
@@ -322,15 +325,10 @@ LinuxKeyMap initLinuxKeyMap(struct xkb_keymap *keymap,
       xkb_state_update_mask(state, 0, 0, 0, 0, 0, 0);
     }
 
-    if (mappedKey != Key::Unknown &&
-        out.keyToEvdev.find(mappedKey) == out.keyToEvdev.end()) {
-      out.keyToEvdev[mappedKey] = evdevCode;
-    }
-
-    // Also register the base evdevToKey mapping
-    if (mappedKey != Key::Unknown &&
-        out.evdevToKey.find(evdevCode) == out.evdevToKey.end()) {
-      out.evdevToKey[evdevCode] = mappedKey;
+    if (mappedKey != Key::Unknown) {
+      out.keyToEvdev.insert(mappedKey, evdevCode);
+      // Also register the base evdevToKey mapping
+      out.evdevToKey.insert(evdevCode, mappedKey);
     }
 
     // Scan all modifier combinations for charToKeycode and codeAndModsToKey
@@ -354,18 +352,13 @@ LinuxKeyMap initLinuxKeyMap(struct xkb_keymap *keymap,
         }
 
         // Register in charToKeycode (only if not already present)
-        if (out.charToKeycode.find(cp) == out.charToKeycode.end()) {
-          out.charToKeycode[cp] =
-              KeyMapping(evdevCode, scan.axidevMods, charMappedKey);
-        }
+        out.charToKeycode.insert(
+            cp, KeyMapping(evdevCode, scan.axidevMods, charMappedKey));
 
         // Register in codeAndModsToKey for reverse lookup
         if (charMappedKey != Key::Unknown) {
-          uint32_t lookupKey = encodeEvdevMods(evdevCode, scan.axidevMods);
-          if (out.codeAndModsToKey.find(lookupKey) ==
-              out.codeAndModsToKey.end()) {
-            out.codeAndModsToKey[lookupKey] = charMappedKey;
-          }
+          out.codeAndModsToKey.insert(evdevCode, scan.axidevMods,
+                                      charMappedKey);
         }
       }
     }
@@ -385,21 +378,167 @@ LinuxKeyMap initLinuxKeyMap(struct xkb_keymap *keymap,
 Key resolveKeyFromEvdevAndMods(const LinuxKeyMap &keyMap, int evdevCode,
                                Modifier mods) {
   // First, try to find an exact match with the modifiers
-  uint32_t lookupKey = encodeEvdevMods(evdevCode, mods);
-  auto it = keyMap.codeAndModsToKey.find(lookupKey);
-  if (it != keyMap.codeAndModsToKey.end()) {
-    return it->second;
+  if (const Key *key = keyMap.codeAndModsToKey.find(evdevCode, mods)) {
+    return *key;
   }
 
   // Fall back to the base key mapping (no modifiers)
-  auto baseIt = keyMap.evdevToKey.find(evdevCode);
-  if (baseIt != keyMap.evdevToKey.end()) {
-    return baseIt->second;
+  if (const Key *base = keyMap.evdevToKey.find(evdevCode)) {
+    return *base;
   }
 
   return Key::Unknown;
 }
 
+std::string xkbLayoutKey(const XkbRuleNamesStrings &names) {
+  return "rules=" + names.rules + ";model=" + names.model +
+         ";layout=" + names.layout + ";variant=" + names.variant +
+         ";options=" + names.options;
+}
+
+SharedXkbKeymap::~SharedXkbKeymap() {
+  if (keymap_)
+    xkb_keymap_unref(keymap_);
+}
+
+struct xkb_state *SharedXkbKeymap::newState() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  struct xkb_state *state = xkb_state_new(keymap_);
+  if (!state)
+    AXIDEV_IO_LOG_ERROR("Linux keymap: xkb_state_new() failed");
+  return state;
+}
+
+void SharedXkbKeymap::releaseState(struct xkb_state *state) const {
+  if (!state)
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  xkb_state_unref(state);
+}
+
+struct xkb_keymap *compileXkbKeymap(struct xkb_context *ctx,
+                                    const XkbRuleNamesStrings &names) {
+  auto field = [](const std::string &value) {
+    return value.empty() ? nullptr : value.c_str();
+  };
+  const struct xkb_rule_names ruleNames = {
+      field(names.rules), field(names.model), field(names.layout),
+      field(names.variant), field(names.options)};
+  if (!names.empty()) {
+    AXIDEV_IO_LOG_DEBUG("Linux keymap: xkb names: %s",
+                        xkbLayoutKey(names).c_str());
+  }
+  struct xkb_keymap *keymap = xkb_keymap_new_from_names(
+      ctx, names.empty() ? nullptr : &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+  if (!keymap)
+    AXIDEV_IO_LOG_ERROR("Linux keymap: xkb_keymap_new_from_names() failed");
+  return keymap;
+}
+
+namespace {
+
+// Compile a throwaway XKB keymap for `names` and scan it. If xkbcommon cannot
+// compile one, the result only holds the layout-independent fallback
+// mappings and is reported incomplete.
+KeyMapBuild<LinuxKeyMap> buildLinuxKeyMap(const XkbRuleNamesStrings &names) {
+  struct xkb_context *ctx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+  if (!ctx) {
+    AXIDEV_IO_LOG_ERROR("Linux keymap: xkb_context_new() failed");
+    return {initLinuxKeyMap(nullptr, nullptr), false};
+  }
+  struct xkb_keymap *keymap = compileXkbKeymap(ctx, names);
+  struct xkb_state *state = keymap ? xkb_state_new(keymap) : nullptr;
+  if (keymap && !state)
+    AXIDEV_IO_LOG_ERROR("Linux keymap: xkb_state_new() failed");
+
+  KeyMapBuild<LinuxKeyMap> out{initLinuxKeyMap(keymap, state),
+                               state != nullptr};
+  if (state)
+    xkb_state_unref(state);
+  if (keymap)
+    xkb_keymap_unref(keymap);
+  xkb_context_unref(ctx);
+  return out;
+}
+
+// Layout for the rule names detected now; runs on the tracker thread.
+std::shared_ptr<const LinuxLayout> buildLinuxLayout() {
+  // Only ever touched by the tracker thread.
+  static std::shared_ptr<const LinuxLayout> last;
+  const XkbRuleNamesStrings names = detectXkbRuleNames();
+  std::string key = xkbLayoutKey(names);
+  if (last && last->key == key && last->xkb)
+    return last;
+
+  auto layout = std::make_shared<LinuxLayout>();
+  layout->key = std::move(key);
+  struct xkb_context *ctx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+  if (!ctx)
+    AXIDEV_IO_LOG_ERROR("Linux keymap: xkb_context_new() failed");
+  // The keymap keeps its own reference on the context.
+  struct xkb_keymap *keymap = ctx ? compileXkbKeymap(ctx, names) : nullptr;
+  if (ctx)
+    xkb_context_unref(ctx);
+  if (keymap) {
+    auto xkb = std::make_shared<const SharedXkbKeymap>(keymap);
+    struct xkb_state *state = xkb->newState();
+    layout->keyMap = acquireLinuxKeyMap(names, keymap, state);
+    xkb->releaseState(state);
+    if (state)
+      layout->xkb = std::move(xkb);
+  } else {
+    layout->keyMap = acquireLinuxKeyMap(names);
+  }
+  last = std::move(layout);
+  return last;
+}
+
+// Modification times of the XKB data directories xkbcommon reads layouts
+// from. Package updates replace files by renaming over them, which touches
+// the directory, so a cache file written before an update is not reused.
+std::string xkbDataStamp() {
+  std::vector<std::filesystem::path> roots;
+  const char *root = std::getenv("XKB_CONFIG_ROOT");
+  roots.emplace_back(root && *root ? root : "/usr/share/X11/xkb");
+  if (const char *config = std::getenv("XDG_CONFIG_HOME"); config && *config)
+    roots.emplace_back(std::filesystem::path(config) / "xkb");
+  else if (const char *home = std::getenv("HOME"); home && *home)
+    roots.emplace_back(std::filesystem::path(home) / ".config" / "xkb");
+
+  static constexpr const char *kDirs[] = {"rules", "keycodes", "symbols",
+                                          "types", "compat"};
+  std::string stamp;
+  for (const auto &dir : roots) {
+    for (const char *sub : kDirs) {
+      std::error_code ec;
+      const auto time = std::filesystem::last_write_time(dir / sub, ec);
+      stamp += ec ? "-" : std::to_string(time.time_since_epoch().count());
+      stamp += ';';
+    }
+  }
+  return stamp;
+}
+
+} // namespace
+
+std::shared_ptr<const LinuxKeyMap>
+acquireLinuxKeyMap(const XkbRuleNamesStrings &names,
+                   struct xkb_keymap *keymap, struct xkb_state *state) {
+  static SharedKeyMapCache<LinuxKeyMap> cache("linux", xkbDataStamp);
+  return cache.acquire(xkbLayoutKey(names), [&]() {
+    if (keymap && state)
+      return KeyMapBuild<LinuxKeyMap>{initLinuxKeyMap(keymap, state)};
+    return buildLinuxKeyMap(names);
+  });
+}
+
+LayoutTracker<LinuxLayout> &linuxLayoutTracker() {
+  // Never destroyed, so a rebuild still running at exit cannot outlive it.
+  static auto *tracker =
+      new LayoutTracker<LinuxLayout>("linux", buildLinuxLayout);
+  return *tracker;
+}
+
 } // namespace axidev::io::keyboard::detail
 
 #endif // __linux__
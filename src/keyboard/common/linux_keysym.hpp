@@ -16,9 +16,17 @@
 
 #include <axidev-io/keyboard/common.hpp>
 #include <linux/input-event-codes.h>
-#include <unordered_map>
 #include <xkbcommon/xkbcommon.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/common/layout_tracker.hpp"
+#include "keyboard/common/linux_layout.hpp"
+
 namespace axidev::io::keyboard::detail {
 
 /**
@@ -30,40 +38,29 @@ namespace axidev::io::keyboard::detail {
  */
 struct LinuxKeyMap {
   /// Map from logical Key enum to evdev keycode (for Sender)
-  std::unordered_map<Key, int> keyToEvdev;
+  KeyCodeTable keyToEvdev;
 
   /// Map from evdev keycode to logical Key enum (for Listener - base keys)
-  std::unordered_map<int, Key> evdevToKey;
+  CodeKeyTable evdevToKey;
 
   /// Map for character to keycode + modifier requirements (for text typing)
   /// Uses KeyMapping to track which modifiers are needed to produce each char.
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
+  CharMappingTable charToKeycode;
 
-  /// Map from (evdev keycode, modifiers) to the Key produced.
+  /// Map from (evdev keycode, Shift/Ctrl/Alt) to the Key produced.
   /// This enables the Listener to resolve the correct Key based on what
   /// modifiers were active when the key was pressed.
-  /// The key is encoded as: (keycode << 8) | modifier_bits
-  std::unordered_map<uint32_t, Key> codeAndModsToKey;
+  CodeModsKeyTable codeAndModsToKey;
 };
 
-/**
- * @brief Encode an evdev keycode and modifier combination into a single lookup
- * key.
- * @param evdevCode The evdev keycode.
- * @param mods The modifier flags (only Shift, Ctrl, Alt are typically
- * relevant).
- * @return uint32_t Encoded lookup key for codeAndModsToKey map.
- */
-inline uint32_t encodeEvdevMods(int evdevCode, Modifier mods) {
-  // We care about Shift, Ctrl, and Alt for character production
-  uint8_t modBits = 0;
-  if (hasModifier(mods, Modifier::Shift))
-    modBits |= 0x01;
-  if (hasModifier(mods, Modifier::Ctrl))
-    modBits |= 0x02;
-  if (hasModifier(mods, Modifier::Alt))
-    modBits |= 0x04;
-  return (static_cast<uint32_t>(evdevCode) << 8) | modBits;
+/// Tables of @p keyMap in the order the keymap cache stores them.
+inline auto keyMapTables(LinuxKeyMap &keyMap) {
+  return std::tie(keyMap.keyToEvdev, keyMap.evdevToKey, keyMap.charToKeycode,
+                  keyMap.codeAndModsToKey);
+}
+inline auto keyMapTables(const LinuxKeyMap &keyMap) {
+  return std::tie(keyMap.keyToEvdev, keyMap.evdevToKey, keyMap.charToKeycode,
+                  keyMap.codeAndModsToKey);
 }
 
 /**
@@ -124,6 +121,93 @@ Key resolveKeyFromEvdevAndMods(const LinuxKeyMap &keyMap, int evdevCode,
  */
 LinuxKeyMap initLinuxKeyMap(struct xkb_keymap *keymap, struct xkb_state *state);
 
+/**
+ * @brief Layout identity of @p names, as used to key shared keymaps.
+ */
+std::string xkbLayoutKey(const XkbRuleNamesStrings &names);
+
+/**
+ * @brief Shared key mappings for the layout described by @p names.
+ *
+ * Returns the process-wide snapshot for that layout (see
+ * keymap_cache.hpp), building it on first use. The build scans @p keymap and
+ * @p state when given; otherwise it compiles a temporary XKB keymap from
+ * @p names, so callers that only need the tables never touch xkbcommon when
+ * the snapshot already exists. If that compile fails, the snapshot returned
+ * only holds the layout-independent fallback mappings and is not cached, so
+ * the next call tries again.
+ *
+ * @param names Detected rule names (see `detectXkbRuleNames()`).
+ * @param keymap XKB keymap compiled from @p names, or nullptr.
+ * @param state XKB state for @p keymap, or nullptr.
+ * @return std::shared_ptr<const LinuxKeyMap> Never null.
+ */
+std::shared_ptr<const LinuxKeyMap>
+acquireLinuxKeyMap(const XkbRuleNamesStrings &names,
+                   struct xkb_keymap *keymap = nullptr,
+                   struct xkb_state *state = nullptr);
+
+/**
+ * @brief Compiled XKB keymap shared by the Listeners that use it.
+ *
+ * xkbcommon keeps non-atomic reference counts, and every `xkb_state` holds a
+ * reference on its keymap, so states are created and released through this
+ * handle, under its mutex. Release every state before dropping the handle.
+ */
+class SharedXkbKeymap {
+public:
+  /// Takes over the caller's reference on @p keymap.
+  explicit SharedXkbKeymap(struct xkb_keymap *keymap) noexcept
+      : keymap_(keymap) {}
+  ~SharedXkbKeymap();
+
+  SharedXkbKeymap(const SharedXkbKeymap &) = delete;
+  SharedXkbKeymap &operator=(const SharedXkbKeymap &) = delete;
+
+  /// The keymap, for read-only queries such as modifier indices.
+  [[nodiscard]] struct xkb_keymap *get() const noexcept { return keymap_; }
+
+  /// New state for the keymap; nullptr (after logging) on failure.
+  [[nodiscard]] struct xkb_state *newState() const;
+
+  /// Release a state returned by `newState()`; null is ignored.
+  void releaseState(struct xkb_state *state) const;
+
+private:
+  struct xkb_keymap *keymap_;
+  mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Compile the XKB keymap described by @p names in @p ctx.
+ * @return nullptr (after logging) on failure.
+ */
+struct xkb_keymap *compileXkbKeymap(struct xkb_context *ctx,
+                                    const XkbRuleNamesStrings &names);
+
+/**
+ * @brief Layout published by `linuxLayoutTracker()`: the shared mappings and
+ * the XKB keymap they were scanned from, for the same rule names.
+ */
+struct LinuxLayout {
+  /// `xkbLayoutKey()` of the rule names.
+  std::string key;
+  /// Never null.
+  std::shared_ptr<const LinuxKeyMap> keyMap;
+  /// Null when the keymap could not be compiled; `keyMap` then only holds
+  /// the layout-independent fallback mappings.
+  std::shared_ptr<const SharedXkbKeymap> xkb;
+};
+
+/**
+ * @brief Process-wide tracker of the active layout (see layout_tracker.hpp).
+ *
+ * Each rebuild detects the rule names, compiles their XKB keymap and takes
+ * the shared mappings for them, all on the tracker thread. A rebuild that
+ * detects the layout already published publishes nothing.
+ */
+LayoutTracker<LinuxLayout> &linuxLayoutTracker();
+
 } // namespace axidev::io::keyboard::detail
 
 #endif // __linux__
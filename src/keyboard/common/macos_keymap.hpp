@@ -16,7 +16,12 @@
 
 #include <Carbon/Carbon.h>
 #include <axidev-io/keyboard/common.hpp>
-#include <unordered_map>
+
+#include <memory>
+#include <tuple>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/common/layout_tracker.hpp"
 
 namespace axidev::io::keyboard::detail {
 
@@ -29,36 +34,30 @@ namespace axidev::io::keyboard::detail {
  */
 struct MacOSKeyMap {
   /// Map from logical Key enum to macOS CGKeyCode (for Sender)
-  std::unordered_map<Key, CGKeyCode> keyToCode;
+  KeyCodeTable keyToCode;
 
   /// Map from macOS CGKeyCode to logical Key enum (for Listener - base keys)
-  std::unordered_map<CGKeyCode, Key> codeToKey;
+  CodeKeyTable codeToKey;
 
   /// Map for character to keycode + modifier requirements (for text typing)
   /// Uses KeyMapping to track which modifiers are needed to produce each char.
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
+  CharMappingTable charToKeycode;
 
-  /// Map from (keycode, modifiers) to the Key produced.
+  /// Map from (keycode, Shift/Alt) to the Key produced.
   /// This enables the Listener to resolve the correct Key based on what
-  /// modifiers were active when the key was pressed.
-  /// The key is encoded as: (keycode << 8) | modifier_bits
-  std::unordered_map<uint32_t, Key> codeAndModsToKey;
+  /// modifiers were active when the key was pressed. Only Shift and Alt
+  /// (Option) take part in character production on macOS; Ctrl is ignored.
+  CodeModsKeyTable codeAndModsToKey{Modifier::Shift | Modifier::Alt};
 };
 
-/**
- * @brief Encode a keycode and modifier combination into a single lookup key.
- * @param keycode The platform-specific keycode.
- * @param mods The modifier flags (only Shift and Alt are typically relevant).
- * @return uint32_t Encoded lookup key for codeAndModsToKey map.
- */
-inline uint32_t encodeKeycodeMods(CGKeyCode keycode, Modifier mods) {
-  // We only care about Shift and Alt for character production
-  uint8_t modBits = 0;
-  if (hasModifier(mods, Modifier::Shift))
-    modBits |= 0x01;
-  if (hasModifier(mods, Modifier::Alt))
-    modBits |= 0x02;
-  return (static_cast<uint32_t>(keycode) << 8) | modBits;
+/// Tables of @p keyMap in the order the keymap cache stores them.
+inline auto keyMapTables(MacOSKeyMap &keyMap) {
+  return std::tie(keyMap.keyToCode, keyMap.codeToKey, keyMap.charToKeycode,
+                  keyMap.codeAndModsToKey);
+}
+inline auto keyMapTables(const MacOSKeyMap &keyMap) {
+  return std::tie(keyMap.keyToCode, keyMap.codeToKey, keyMap.charToKeycode,
+                  keyMap.codeAndModsToKey);
 }
 
 /**
@@ -74,6 +73,25 @@ inline uint32_t encodeKeycodeMods(CGKeyCode keycode, Modifier mods) {
  */
 MacOSKeyMap initMacOSKeyMap();
 
+/**
+ * @brief Shared key mappings for the current keyboard input source.
+ *
+ * Returns the process-wide snapshot for the current input source (see
+ * keymap_cache.hpp), keyed by its `kTISPropertyInputSourceID` and built with
+ * `initMacOSKeyMap()` on first use.
+ *
+ * @return std::shared_ptr<const MacOSKeyMap> Never null.
+ */
+std::shared_ptr<const MacOSKeyMap> acquireMacOSKeyMap();
+
+/**
+ * @brief Process-wide tracker of the active layout (see layout_tracker.hpp).
+ *
+ * Each rebuild takes the snapshot for the input source selected at that
+ * time.
+ */
+LayoutTracker<MacOSKeyMap> &macOSLayoutTracker();
+
 /**
  * @brief Fill fallback mappings for non-printable keys.
  *
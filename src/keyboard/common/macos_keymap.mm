@@ -17,23 +17,24 @@
 #import <Foundation/Foundation.h>
 #include <array>
 #include <axidev-io/log.hpp>
+#include <string>
+
+#include "keyboard/common/keymap_cache.hpp"
 
 namespace axidev::io::keyboard::detail {
 
 void fillMacOSFallbackMappings(MacOSKeyMap &keyMap) {
   // Helper to set mapping in both directions if not already present
   auto setIfMissing = [&keyMap](Key key, CGKeyCode code) {
-    if (keyMap.keyToCode.find(key) == keyMap.keyToCode.end()) {
-      keyMap.keyToCode[key] = code;
+    if (keyMap.keyToCode.insert(key, code)) {
       AXIDEV_IO_LOG_DEBUG(
           "macOS keymap: adding fallback mapping for %s to code %d",
-          keyToString(key).c_str(), code);
+          keyToStringView(key).data(), code);
     }
-    if (keyMap.codeToKey.find(code) == keyMap.codeToKey.end()) {
-      keyMap.codeToKey[code] = key;
+    if (keyMap.codeToKey.insert(code, key)) {
       AXIDEV_IO_LOG_DEBUG(
           "macOS keymap: adding fallback mapping for code %d to %s", code,
-          keyToString(key).c_str());
+          keyToStringView(key).data());
     }
   };
 
@@ -248,12 +249,8 @@ MacOSKeyMap initMacOSKeyMap() {
         if (mappedKeyEnum != Key::Unknown) {
           CGKeyCode cgCode = static_cast<CGKeyCode>(keyCode);
           // Only add if not already present (first mapping wins)
-          if (keyMap.keyToCode.find(mappedKeyEnum) == keyMap.keyToCode.end()) {
-            keyMap.keyToCode[mappedKeyEnum] = cgCode;
-          }
-          if (keyMap.codeToKey.find(cgCode) == keyMap.codeToKey.end()) {
-            keyMap.codeToKey[cgCode] = mappedKeyEnum;
-          }
+          keyMap.keyToCode.insert(mappedKeyEnum, cgCode);
+          keyMap.codeToKey.insert(cgCode, mappedKeyEnum);
         }
       }
     }
@@ -305,23 +302,18 @@ MacOSKeyMap initMacOSKeyMap() {
           }
 
           // Register in charToKeycode (only if not already present)
-          if (keyMap.charToKeycode.find(codepoint) ==
-              keyMap.charToKeycode.end()) {
-            keyMap.charToKeycode[codepoint] = KeyMapping(
-                static_cast<int32_t>(keyCode), scan.axidevMods, mappedKey);
-          }
+          keyMap.charToKeycode.insert(
+              codepoint, KeyMapping(static_cast<int32_t>(keyCode),
+                                    scan.axidevMods, mappedKey));
 
           // Register in codeAndModsToKey for reverse lookup
           if (mappedKey != Key::Unknown) {
-            uint32_t lookupKey = encodeKeycodeMods(
-                static_cast<CGKeyCode>(keyCode), scan.axidevMods);
-            if (keyMap.codeAndModsToKey.find(lookupKey) ==
-                keyMap.codeAndModsToKey.end()) {
-              keyMap.codeAndModsToKey[lookupKey] = mappedKey;
+            if (keyMap.codeAndModsToKey.insert(static_cast<int32_t>(keyCode),
+                                               scan.axidevMods, mappedKey)) {
               AXIDEV_IO_LOG_DEBUG(
                   "macOS keymap: registered code=%d + mods=0x%02X -> Key::%s",
                   keyCode, static_cast<unsigned>(scan.axidevMods),
-                  keyToString(mappedKey).c_str());
+                  keyToStringView(mappedKey).data());
             }
           }
         }
@@ -347,21 +339,44 @@ MacOSKeyMap initMacOSKeyMap() {
 Key resolveKeyFromCodeAndMods(const MacOSKeyMap &keyMap, CGKeyCode keycode,
                               Modifier mods) {
   // First, try to find an exact match with the modifiers
-  uint32_t lookupKey = encodeKeycodeMods(keycode, mods);
-  auto it = keyMap.codeAndModsToKey.find(lookupKey);
-  if (it != keyMap.codeAndModsToKey.end()) {
-    return it->second;
+  if (const Key *key = keyMap.codeAndModsToKey.find(keycode, mods)) {
+    return *key;
   }
 
   // Fall back to the base key mapping (no modifiers)
-  auto baseIt = keyMap.codeToKey.find(keycode);
-  if (baseIt != keyMap.codeToKey.end()) {
-    return baseIt->second;
+  if (const Key *base = keyMap.codeToKey.find(keycode)) {
+    return *base;
   }
 
   return Key::Unknown;
 }
 
+std::shared_ptr<const MacOSKeyMap> acquireMacOSKeyMap() {
+  static SharedKeyMapCache<MacOSKeyMap> cache("macos");
+
+  // Input source IDs (e.g. "com.apple.keylayout.French") are stable across
+  // processes, so they also name the on-disk cache entry.
+  std::string layout = "source=";
+  if (TISInputSourceRef source = TISCopyCurrentKeyboardInputSource()) {
+    const auto *sourceId = static_cast<CFStringRef>(
+        TISGetInputSourceProperty(source, kTISPropertyInputSourceID));
+    char buf[256];
+    if (sourceId != nullptr &&
+        CFStringGetCString(sourceId, buf, sizeof(buf), kCFStringEncodingUTF8)) {
+      layout += buf;
+    }
+    CFRelease(source);
+  }
+  return cache.acquire(layout, []() { return initMacOSKeyMap(); });
+}
+
+LayoutTracker<MacOSKeyMap> &macOSLayoutTracker() {
+  // Never destroyed, so a rebuild still running at exit cannot outlive it.
+  static auto *tracker = new LayoutTracker<MacOSKeyMap>(
+      "macos", [] { return acquireMacOSKeyMap(); });
+  return *tracker;
+}
+
 } // namespace axidev::io::keyboard::detail
 
 #endif // __APPLE__
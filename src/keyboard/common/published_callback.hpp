@@ -0,0 +1,73 @@
+#pragma once
+/**
+ * @file keyboard/common/published_callback.hpp
+ * @brief Internal helper for publishing a listener callback to its event
+ * thread without locking on the hot path.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the Listener backends.
+ */
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @brief Immutable callback slot read lock-free by the listener event thread.
+ *
+ * The callback is copied to the heap once by `publish()` and exposed through
+ * an atomic pointer, so each event only performs an acquire load and calls
+ * through the pointer: no mutex, no `std::function` copy and no allocation.
+ *
+ * Lifetime contract: `publish()` and `retire()` must only be called while no
+ * thread can be reading the slot, i.e. before the event thread is started and
+ * after it has been joined. Every backend already brackets its worker thread
+ * this way in `start()` / `stop()`, which is what makes freeing the previous
+ * callback safe without an RCU grace period.
+ *
+ * @tparam Fn Callable type (typically `Listener::Callback`).
+ */
+template <typename Fn> class PublishedCallback {
+public:
+  PublishedCallback() = default;
+  ~PublishedCallback() { retire(); }
+
+  PublishedCallback(const PublishedCallback &) = delete;
+  PublishedCallback &operator=(const PublishedCallback &) = delete;
+
+  /**
+   * @brief Install a new callback, replacing (and freeing) any previous one.
+   * @param fn Callback to publish. An empty callable clears the slot.
+   */
+  void publish(Fn fn) {
+    std::unique_ptr<Fn> next;
+    if (fn)
+      next = std::make_unique<Fn>(std::move(fn));
+    current_.store(next.get(), std::memory_order_release);
+    owned_ = std::move(next);
+  }
+
+  /**
+   * @brief Clear the slot and free the stored callback.
+   */
+  void retire() {
+    current_.store(nullptr, std::memory_order_release);
+    owned_.reset();
+  }
+
+  /**
+   * @brief Access the published callback from the event thread.
+   * @return Pointer to the callback, or nullptr when none is published.
+   */
+  const Fn *get() const noexcept {
+    return current_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::unique_ptr<Fn> owned_;
+  std::atomic<const Fn *> current_{nullptr};
+};
+
+} // namespace axidev::io::keyboard::detail
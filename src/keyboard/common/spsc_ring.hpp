@@ -0,0 +1,123 @@
+#pragma once
+/**
+ * @file keyboard/common/spsc_ring.hpp
+ * @brief Internal fixed-capacity lock-free single-producer/single-consumer
+ * ring buffer.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the keyboard backends.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @brief Bounded wait-free SPSC ring for trivially copyable values.
+ *
+ * Exactly one thread may call `tryPush()` and exactly one (possibly other)
+ * thread may call `tryPop()` / `popBulk()`. The capacity is rounded up to a
+ * power of two so indices wrap with a mask. Head and tail live on separate
+ * cache lines to avoid false sharing between the producer and the consumer.
+ *
+ * @tparam T Element type; must be trivially copyable.
+ */
+template <typename T> class SpscRing {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SpscRing requires a trivially copyable element type");
+
+public:
+  /**
+   * @brief Construct a ring holding at least @p minCapacity elements.
+   * @param minCapacity Requested capacity (minimum 2, rounded up to a power of
+   * two).
+   */
+  explicit SpscRing(size_t minCapacity) {
+    size_t cap = 2;
+    while (cap < minCapacity)
+      cap <<= 1;
+    capacity_ = cap;
+    mask_ = cap - 1;
+    slots_ = std::make_unique<T[]>(cap);
+  }
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  /// Number of slots in the ring.
+  size_t capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Append a value (producer thread only).
+   * @return true on success; false when the ring is full.
+   */
+  bool tryPush(const T &value) noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cachedHead_ == capacity_) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      if (tail - cachedHead_ == capacity_)
+        return false;
+    }
+    slots_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest value (consumer thread only).
+   * @return true when a value was written to @p out; false when empty.
+   */
+  bool tryPop(T &out) noexcept { return popBulk(&out, 1) == 1; }
+
+  /**
+   * @brief Remove up to @p maxCount values in FIFO order (consumer thread
+   * only).
+   * @return Number of values written to @p out.
+   */
+  size_t popBulk(T *out, size_t maxCount) noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    size_t available = cachedTail_ - head;
+    if (available < maxCount) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      available = cachedTail_ - head;
+    }
+    const size_t count = available < maxCount ? available : maxCount;
+    for (size_t i = 0; i < count; ++i)
+      out[i] = slots_[(head + i) & mask_];
+    if (count > 0)
+      head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief Check for pending values.
+   *
+   * Exact when called from the consumer thread; otherwise a snapshot.
+   */
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  // Fixed rather than std::hardware_destructive_interference_size, whose
+  // value may differ between compilers and triggers ABI warnings in headers.
+  static constexpr size_t kCacheLine = 64;
+
+  size_t capacity_{0};
+  size_t mask_{0};
+  std::unique_ptr<T[]> slots_;
+
+  // Consumer-owned
+  alignas(kCacheLine) std::atomic<size_t> head_{0};
+  size_t cachedTail_{0};
+
+  // Producer-owned
+  alignas(kCacheLine) std::atomic<size_t> tail_{0};
+  size_t cachedHead_{0};
+};
+
+} // namespace axidev::io::keyboard::detail
@@ -0,0 +1,377 @@
+/**
+ * @file keyboard/common/trace.cpp
+ * @brief TraceRecorder and TracePlayer.
+ *
+ * The recorder encodes into a fixed buffer owned by its Impl and hands full
+ * buffers to an `std::ofstream`. The player maps the whole file read-only and
+ * decodes it into a fixed batch of `Sender::KeyEvent`s, so a sequence of any
+ * length goes through the Sender's batched path a batch at a time, with the
+ * recorded pauses carried in `KeyEvent::delayUs`.
+ */
+
+#include <axidev-io/keyboard/trace.hpp>
+
+#include <axidev-io/log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include "keyboard/common/trace_batcher.hpp"
+#include "keyboard/common/trace_format.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace axidev::io::keyboard {
+
+namespace {
+
+/// Size of the recorder's write buffer.
+constexpr size_t kRecordBufferSize = 64 * 1024;
+
+/**
+ * @internal
+ * @brief Read-only mapping of a whole file.
+ */
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path) {
+    close();
+#if defined(_WIN32)
+    const std::filesystem::path fsPath(path);
+    HANDLE file = CreateFileW(fsPath.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      AXIDEV_IO_LOG_WARN("Trace: cannot open '%s' (error=%lu)", path.c_str(),
+                         static_cast<unsigned long>(GetLastError()));
+      return false;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+      AXIDEV_IO_LOG_WARN("Trace: '%s' is empty or unreadable", path.c_str());
+      CloseHandle(file);
+      return false;
+    }
+    HANDLE mapping =
+        CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      AXIDEV_IO_LOG_WARN("Trace: CreateFileMapping failed for '%s' "
+                         "(error=%lu)",
+                         path.c_str(),
+                         static_cast<unsigned long>(GetLastError()));
+      return false;
+    }
+    // The view keeps the mapping alive once both handles are closed.
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+      AXIDEV_IO_LOG_WARN("Trace: MapViewOfFile failed for '%s' (error=%lu)",
+                         path.c_str(),
+                         static_cast<unsigned long>(GetLastError()));
+      return false;
+    }
+    data_ = static_cast<const uint8_t *>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      AXIDEV_IO_LOG_WARN("Trace: cannot open '%s' (errno=%d)", path.c_str(),
+                         errno);
+      return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      AXIDEV_IO_LOG_WARN("Trace: '%s' is empty or unreadable", path.c_str());
+      ::close(fd);
+      return false;
+    }
+    const auto fileSize = static_cast<size_t>(st.st_size);
+    void *view = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+      AXIDEV_IO_LOG_WARN("Trace: mmap failed for '%s' (errno=%d)",
+                         path.c_str(), errno);
+      return false;
+    }
+    // Playback reads the file once, front to back.
+    ::madvise(view, fileSize, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t *>(view);
+    size_ = fileSize;
+#endif
+    return true;
+  }
+
+  void close() {
+    if (data_ == nullptr)
+      return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  [[nodiscard]] const uint8_t *data() const { return data_; }
+  [[nodiscard]] size_t size() const { return size_; }
+
+private:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// TraceRecorder
+// ---------------------------------------------------------------------------
+
+struct TraceRecorder::Impl {
+  std::ofstream out;
+  std::array<uint8_t, kRecordBufferSize> buffer{};
+  size_t used{0};
+  /// Microsecond time of the last record, or of the start of the trace.
+  /// Deltas are taken between truncated absolute times so that rounding
+  /// does not accumulate over long sessions.
+  uint64_t lastUs{0};
+  uint64_t recorded{0};
+
+  bool flush() {
+    if (!out.is_open())
+      return false;
+    if (used != 0) {
+      out.write(reinterpret_cast<const char *>(buffer.data()),
+                static_cast<std::streamsize>(used));
+      used = 0;
+    }
+    out.flush();
+    if (!out) {
+      AXIDEV_IO_LOG_ERROR("TraceRecorder: write failed");
+      return false;
+    }
+    return true;
+  }
+};
+
+TraceRecorder::TraceRecorder() : m_impl(std::make_unique<Impl>()) {}
+
+TraceRecorder::~TraceRecorder() {
+  if (m_impl)
+    close();
+}
+
+TraceRecorder::TraceRecorder(TraceRecorder &&) noexcept = default;
+TraceRecorder &TraceRecorder::operator=(TraceRecorder &&other) noexcept {
+  if (this != &other) {
+    if (m_impl)
+      close();
+    m_impl = std::move(other.m_impl);
+  }
+  return *this;
+}
+
+bool TraceRecorder::open(const std::string &path) {
+  if (!m_impl)
+    m_impl = std::make_unique<Impl>();
+  close();
+  Impl &impl = *m_impl;
+  impl.out.open(path, std::ios::binary | std::ios::trunc);
+  if (!impl.out) {
+    AXIDEV_IO_LOG_WARN("TraceRecorder: cannot create '%s'", path.c_str());
+    impl.out.close();
+    return false;
+  }
+  const uint64_t startNs = detail::steadyNowNs();
+  detail::encodeTraceHeader(impl.buffer.data(), startNs);
+  impl.used = detail::kTraceHeaderSize;
+  impl.lastUs = startNs / 1000;
+  impl.recorded = 0;
+  if (!impl.flush()) {
+    impl.out.close();
+    return false;
+  }
+  AXIDEV_IO_LOG_INFO("TraceRecorder: recording to '%s'", path.c_str());
+  return true;
+}
+
+bool TraceRecorder::record(const Listener::Event &event) {
+  if (!m_impl || !m_impl->out.is_open())
+    return false;
+  Impl &impl = *m_impl;
+  const uint64_t ns =
+      event.timestampNs != 0 ? event.timestampNs : detail::steadyNowNs();
+  const uint64_t us = ns / 1000;
+  detail::TraceRecord rec;
+  // Events stamped before the previous one (or before open()) get no pause.
+  rec.deltaUs = us > impl.lastUs ? us - impl.lastUs : 0;
+  rec.key = event.keyMod.key;
+  rec.mods = event.keyMod.requiredMods;
+  rec.pressed = event.pressed;
+  if (impl.used + detail::kMaxTraceRecordSize > impl.buffer.size() &&
+      !impl.flush())
+    return false;
+  impl.used += detail::encodeTraceRecord(impl.buffer.data() + impl.used, rec);
+  impl.lastUs = std::max(impl.lastUs, us);
+  ++impl.recorded;
+  return true;
+}
+
+bool TraceRecorder::flush() { return m_impl && m_impl->flush(); }
+
+void TraceRecorder::close() {
+  if (!m_impl || !m_impl->out.is_open())
+    return;
+  m_impl->flush();
+  m_impl->out.close();
+  AXIDEV_IO_LOG_DEBUG("TraceRecorder: closed after %llu events",
+                      static_cast<unsigned long long>(m_impl->recorded));
+}
+
+bool TraceRecorder::isOpen() const { return m_impl && m_impl->out.is_open(); }
+
+uint64_t TraceRecorder::recordedCount() const {
+  return m_impl ? m_impl->recorded : 0;
+}
+
+// ---------------------------------------------------------------------------
+// TracePlayer
+// ---------------------------------------------------------------------------
+
+struct TracePlayer::Impl {
+  MappedFile file;
+  uint64_t played{0};
+  uint64_t skipped{0};
+  std::array<Sender::KeyEvent, detail::kTracePlayBatchSize> batch{};
+  // Whether the Sender of the current play() can map each key, indexed by
+  // Key value: 0 not yet asked, 1 yes, 2 no.
+  std::vector<uint8_t> mappable;
+
+  /// Ask @p sender once per key whether it can send it, resolving the key
+  /// exactly as sendSequence() would, so that a whole batch of mappable
+  /// keys only fails when sending itself fails.
+  bool canSend(Sender &sender, Key key) {
+    const size_t index = static_cast<size_t>(key);
+    if (index >= mappable.size())
+      mappable.resize(index + 1, 0);
+    if (mappable[index] == 0) {
+      const Sender::KeyEvent probe{key, true, 0};
+      mappable[index] = sender.compile({&probe, 1}).valid() ? 1 : 2;
+    }
+    return mappable[index] == 1;
+  }
+
+  /// Send the first @p count events of the batch. Keys were checked before
+  /// they were batched, so a failure means part of the batch may already be
+  /// out; it is not retried, to avoid sending those events twice.
+  bool submit(Sender &sender, size_t count) {
+    if (!sender.sendSequence({batch.data(), count})) {
+      AXIDEV_IO_LOG_ERROR("TracePlayer: sending a batch of %zu events failed "
+                          "after %llu events",
+                          count, static_cast<unsigned long long>(played));
+      return false;
+    }
+    played += count;
+    return true;
+  }
+};
+
+TracePlayer::TracePlayer() : m_impl(std::make_unique<Impl>()) {}
+TracePlayer::~TracePlayer() = default;
+TracePlayer::TracePlayer(TracePlayer &&) noexcept = default;
+TracePlayer &TracePlayer::operator=(TracePlayer &&) noexcept = default;
+
+bool TracePlayer::open(const std::string &path) {
+  if (!m_impl)
+    m_impl = std::make_unique<Impl>();
+  close();
+  MappedFile &file = m_impl->file;
+  if (!file.open(path))
+    return false;
+  uint64_t startNs = 0;
+  if (!detail::decodeTraceHeader(file.data(), file.size(), startNs)) {
+    AXIDEV_IO_LOG_WARN("TracePlayer: '%s' is not a version %u trace",
+                       path.c_str(),
+                       static_cast<unsigned>(detail::kTraceVersion));
+    file.close();
+    return false;
+  }
+  AXIDEV_IO_LOG_INFO("TracePlayer: opened '%s' (%zu bytes)", path.c_str(),
+                     file.size());
+  return true;
+}
+
+void TracePlayer::close() {
+  if (!m_impl)
+    return;
+  m_impl->file.close();
+  m_impl->played = 0;
+  m_impl->skipped = 0;
+}
+
+bool TracePlayer::isOpen() const {
+  return m_impl && m_impl->file.data() != nullptr;
+}
+
+bool TracePlayer::play(Sender &sender, const TracePlayOptions &options) {
+  if (!isOpen()) {
+    AXIDEV_IO_LOG_WARN("TracePlayer::play: no trace open");
+    return false;
+  }
+  if (!sender.isReady()) {
+    AXIDEV_IO_LOG_WARN("TracePlayer::play: sender is not ready");
+    return false;
+  }
+  Impl &impl = *m_impl;
+  impl.played = 0;
+  impl.skipped = 0;
+  impl.mappable.clear();
+
+  const detail::TraceBatchResult result = detail::batchTraceRecords(
+      impl.file.data() + detail::kTraceHeaderSize,
+      impl.file.size() - detail::kTraceHeaderSize, options, impl.batch,
+      [&impl, &sender](Key key) { return impl.canSend(sender, key); },
+      [&impl, &sender](size_t count) { return impl.submit(sender, count); });
+  impl.skipped += result.skipped;
+  if (result.stopped)
+    return false;
+  if (!result.complete) {
+    AXIDEV_IO_LOG_DEBUG("TracePlayer: incomplete record at offset %zu",
+                        detail::kTraceHeaderSize + result.consumed);
+  }
+
+  AXIDEV_IO_LOG_INFO("TracePlayer: played %llu events, skipped %llu",
+                     static_cast<unsigned long long>(impl.played),
+                     static_cast<unsigned long long>(impl.skipped));
+  return true;
+}
+
+uint64_t TracePlayer::playedCount() const {
+  return m_impl ? m_impl->played : 0;
+}
+
+uint64_t TracePlayer::skippedCount() const {
+  return m_impl ? m_impl->skipped : 0;
+}
+
+} // namespace axidev::io::keyboard
@@ -0,0 +1,122 @@
+#pragma once
+/**
+ * @file keyboard/common/trace_batcher.hpp
+ * @brief Internal conversion of trace records into `Sender::KeyEvent`
+ * batches, as replayed by `TracePlayer::play()`.
+ *
+ * Kept apart from the player so the pacing rules (pauses carried over
+ * skipped records, scaling, batch boundaries) can be exercised without a
+ * Sender or a trace file.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail of the trace player.
+ */
+
+#include <axidev-io/keyboard/sender.hpp>
+#include <axidev-io/keyboard/trace.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "keyboard/common/trace_format.hpp"
+
+namespace axidev::io::keyboard::detail {
+
+/// Events handed to `Sender::sendSequence()` at once during playback.
+inline constexpr size_t kTracePlayBatchSize = 256;
+
+/// Recorded pause of @p us microseconds as played with @p options.
+inline uint32_t scaleTracePause(uint64_t us,
+                                const TracePlayOptions &options) noexcept {
+  if (options.speed <= 0.0)
+    return 0;
+  double scaled = static_cast<double>(us) / options.speed;
+  if (options.maxPauseUs != 0)
+    scaled = std::min(scaled, static_cast<double>(options.maxPauseUs));
+  constexpr auto kMax = std::numeric_limits<uint32_t>::max();
+  return scaled >= static_cast<double>(kMax) ? kMax
+                                             : static_cast<uint32_t>(scaled);
+}
+
+/**
+ * @internal
+ * @brief Outcome of `batchTraceRecords()`.
+ */
+struct TraceBatchResult {
+  uint64_t skipped{0}; ///< Records left out (unknown or unplayable keys).
+  size_t consumed{0};  ///< Bytes of complete records decoded.
+  bool complete{true}; ///< False when an incomplete record ended decoding.
+  bool stopped{false}; ///< True when `onBatch` asked to stop.
+};
+
+/**
+ * @brief Decode the records in @p data (a trace without its header) into
+ * @p batch, calling `onBatch(size_t count)` each time the first `count`
+ * events of @p batch are ready to be sent. `onBatch` returns false to stop
+ * decoding.
+ *
+ * Records of `Key::Unknown`, and of keys for which `playable(Key)` returns
+ * false, are left out. Each event carries the scaled pause to the next one
+ * sent; the pause of a record left out carries over to the event before it,
+ * and the last event of a batch already holds the pause to the first event
+ * of the next. The pause before the first event and after the last one are
+ * dropped. An incomplete record ends decoding.
+ */
+template <typename Playable, typename OnBatch>
+TraceBatchResult batchTraceRecords(const uint8_t *data, size_t size,
+                                   const TracePlayOptions &options,
+                                   std::span<Sender::KeyEvent> batch,
+                                   Playable &&playable, OnBatch &&onBatch) {
+  TraceBatchResult result;
+  size_t count = 0;
+  // Time since the last event put in a batch; becomes that event's pause
+  // once the next one is known, so skipped records keep their share.
+  uint64_t gapUs = 0;
+  while (result.consumed < size) {
+    TraceRecord rec;
+    const size_t used = decodeTraceRecord(data + result.consumed,
+                                          size - result.consumed, rec);
+    if (used == 0) {
+      result.complete = false;
+      break;
+    }
+    result.consumed += used;
+    gapUs += rec.deltaUs;
+    if (rec.key == Key::Unknown || !playable(rec.key)) {
+      ++result.skipped;
+      continue;
+    }
+    if (count != 0) {
+      batch[count - 1].delayUs = scaleTracePause(gapUs, options);
+      if (count == batch.size()) {
+        if (!onBatch(count)) {
+          result.stopped = true;
+          return result;
+        }
+        count = 0;
+      }
+    }
+    gapUs = 0;
+    batch[count++] = Sender::KeyEvent{rec.key, rec.pressed, 0};
+  }
+  if (count != 0 && !onBatch(count))
+    result.stopped = true;
+  return result;
+}
+
+/// As above, with every known key playable.
+template <typename OnBatch>
+TraceBatchResult batchTraceRecords(const uint8_t *data, size_t size,
+                                   const TracePlayOptions &options,
+                                   std::span<Sender::KeyEvent> batch,
+                                   OnBatch &&onBatch) {
+  return batchTraceRecords(
+      data, size, options, batch, [](Key) { return true; },
+      std::forward<OnBatch>(onBatch));
+}
+
+} // namespace axidev::io::keyboard::detail
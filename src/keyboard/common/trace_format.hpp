@@ -0,0 +1,138 @@
+#pragma once
+/**
+ * @file keyboard/common/trace_format.hpp
+ * @brief Internal encoding of the keystroke trace files written by
+ * `TraceRecorder` and read by `TracePlayer`.
+ *
+ * A trace is a 16-byte header followed by variable-length records, with
+ * every multi-byte field little-endian:
+ *
+ * | Offset | Size | Field                                              |
+ * |--------|------|----------------------------------------------------|
+ * | 0      | 4    | Magic `AXKT`                                       |
+ * | 4      | 2    | Format version (`kTraceVersion`)                   |
+ * | 6      | 2    | Reserved, 0                                        |
+ * | 8      | 8    | Steady-clock time the recording started, in ns     |
+ *
+ * Each record holds the time since the previous record (or since the start
+ * for the first one) in microseconds as an unsigned LEB128 varint, the `Key`
+ * as a `uint16_t`, and one byte with the `Modifier` bits in bits 0-5 and the
+ * press flag in bit 7. A keystroke typically takes 5 or 6 bytes.
+ *
+ * Records are only ever appended, so the prefix of a trace whose recorder
+ * stopped abruptly is still a valid trace.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail of the trace recorder and player.
+ */
+
+#include <axidev-io/keyboard/common.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace axidev::io::keyboard::detail {
+
+inline constexpr char kTraceMagic[4] = {'A', 'X', 'K', 'T'};
+inline constexpr uint16_t kTraceVersion = 1;
+inline constexpr size_t kTraceHeaderSize = 16;
+/// Largest encoded record: a 10-byte varint, the key and the flags byte.
+inline constexpr size_t kMaxTraceRecordSize = 13;
+
+inline constexpr uint8_t kTracePressedBit = 0x80;
+inline constexpr uint8_t kTraceModifierMask = 0x3F;
+
+/**
+ * @internal
+ * @brief One decoded trace record.
+ */
+struct TraceRecord {
+  uint64_t deltaUs{0}; ///< Time since the previous record.
+  Key key{Key::Unknown};
+  Modifier mods{Modifier::None}; ///< Informational; not replayed.
+  bool pressed{false};
+};
+
+/// Write the header of a recording started at @p startNs into @p out.
+inline void encodeTraceHeader(uint8_t *out, uint64_t startNs) noexcept {
+  std::memcpy(out, kTraceMagic, sizeof(kTraceMagic));
+  out[4] = static_cast<uint8_t>(kTraceVersion & 0xFF);
+  out[5] = static_cast<uint8_t>(kTraceVersion >> 8);
+  out[6] = 0;
+  out[7] = 0;
+  for (size_t i = 0; i < 8; ++i)
+    out[8 + i] = static_cast<uint8_t>(startNs >> (8 * i));
+}
+
+/**
+ * @brief Validate the header at the start of @p data.
+ * @return false when @p data is too short, is not a trace, or has another
+ *         format version.
+ */
+inline bool decodeTraceHeader(const uint8_t *data, size_t size,
+                              uint64_t &startNs) noexcept {
+  if (size < kTraceHeaderSize ||
+      std::memcmp(data, kTraceMagic, sizeof(kTraceMagic)) != 0)
+    return false;
+  const auto version = static_cast<uint16_t>(data[4] | (data[5] << 8));
+  if (version != kTraceVersion)
+    return false;
+  startNs = 0;
+  for (size_t i = 0; i < 8; ++i)
+    startNs |= static_cast<uint64_t>(data[8 + i]) << (8 * i);
+  return true;
+}
+
+/**
+ * @brief Encode @p record into @p out, which must hold at least
+ * `kMaxTraceRecordSize` bytes.
+ * @return Number of bytes written.
+ */
+inline size_t encodeTraceRecord(uint8_t *out,
+                                const TraceRecord &record) noexcept {
+  size_t n = 0;
+  uint64_t delta = record.deltaUs;
+  do {
+    uint8_t byte = delta & 0x7F;
+    delta >>= 7;
+    if (delta != 0)
+      byte |= 0x80;
+    out[n++] = byte;
+  } while (delta != 0);
+  const auto key = static_cast<uint16_t>(record.key);
+  out[n++] = static_cast<uint8_t>(key & 0xFF);
+  out[n++] = static_cast<uint8_t>(key >> 8);
+  out[n++] = static_cast<uint8_t>(
+      (static_cast<uint8_t>(record.mods) & kTraceModifierMask) |
+      (record.pressed ? kTracePressedBit : 0));
+  return n;
+}
+
+/**
+ * @brief Decode the record at the start of @p data.
+ * @return Number of bytes consumed, or 0 when @p data ends inside the record
+ *         or the varint is longer than 64 bits.
+ */
+inline size_t decodeTraceRecord(const uint8_t *data, size_t size,
+                                TraceRecord &record) noexcept {
+  size_t n = 0;
+  uint64_t delta = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    if (n == size || shift > 63)
+      return 0;
+    const uint8_t byte = data[n++];
+    delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      break;
+  }
+  if (size - n < 3)
+    return 0;
+  record.deltaUs = delta;
+  record.key = static_cast<Key>(data[n] | (data[n + 1] << 8));
+  record.mods = static_cast<Modifier>(data[n + 2] & kTraceModifierMask);
+  record.pressed = (data[n + 2] & kTracePressedBit) != 0;
+  return n + 3;
+}
+
+} // namespace axidev::io::keyboard::detail
@@ -0,0 +1,272 @@
+#pragma once
+/**
+ * @file keyboard/common/utf8.hpp
+ * @brief Internal validating UTF-8 decoder shared by the Sender backends.
+ *
+ * This header is intentionally placed under `src/` (not installed) because it
+ * is an internal implementation detail shared by the keyboard backends.
+ *
+ * Decoding follows the well-formed byte sequences of the Unicode standard
+ * (Table 3-7): overlong forms, encoded surrogates, code points above U+10FFFF
+ * and truncated sequences are rejected rather than guessed at. Runs of ASCII
+ * are detected 16 bytes at a time (SSE2 / NEON, falling back to 8-byte words)
+ * and handed to the caller in bulk, so plain-ASCII text never goes through
+ * the multi-byte decoding branches.
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AXIDEV_IO_UTF8_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define AXIDEV_IO_UTF8_NEON 1
+#endif
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @brief Length of the leading run of ASCII bytes in @p data.
+ * @param data First byte to inspect.
+ * @param size Number of bytes available at @p data.
+ * @return Index of the first byte >= 0x80, or @p size if there is none.
+ */
+inline size_t asciiPrefixLength(const char *data, size_t size) noexcept {
+  size_t i = 0;
+#if defined(AXIDEV_IO_UTF8_SSE2)
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    const auto mask = static_cast<unsigned>(_mm_movemask_epi8(block));
+    if (mask != 0)
+      return i + static_cast<size_t>(std::countr_zero(mask));
+  }
+#elif defined(AXIDEV_IO_UTF8_NEON)
+  for (; i + 16 <= size; i += 16) {
+    const uint8x16_t block =
+        vld1q_u8(reinterpret_cast<const uint8_t *>(data + i));
+    if (vmaxvq_u8(block) >= 0x80)
+      break;
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0)
+      break;
+  }
+  while (i < size && static_cast<unsigned char>(data[i]) < 0x80)
+    ++i;
+  return i;
+}
+
+/**
+ * @brief Decode UTF-8, reporting ASCII runs and other code points separately.
+ *
+ * Decoding stops at the first ill-formed sequence; callbacks made before that
+ * point are not undone, so callers that must be all-or-nothing roll back
+ * their own output on failure.
+ *
+ * @param in UTF-8 input.
+ * @param onAscii Called as `onAscii(const unsigned char *bytes, size_t n)` for
+ * each run of ASCII bytes.
+ * @param onCodepoint Called as `onCodepoint(char32_t cp)` for each non-ASCII
+ * code point.
+ * @return true if @p in is well-formed UTF-8.
+ */
+template <typename OnAscii, typename OnCodepoint>
+bool decodeUtf8(std::string_view in, OnAscii &&onAscii,
+                OnCodepoint &&onCodepoint) {
+  const auto *bytes = reinterpret_cast<const unsigned char *>(in.data());
+  const size_t size = in.size();
+  size_t i = 0;
+  while (i < size) {
+    const size_t run = asciiPrefixLength(in.data() + i, size - i);
+    if (run != 0) {
+      onAscii(bytes + i, run);
+      i += run;
+      if (i == size)
+        break;
+    }
+
+    const unsigned char lead = bytes[i];
+    size_t length = 0;
+    char32_t cp = 0;
+    // Bounds for the first continuation byte; they exclude overlongs,
+    // surrogates and code points above U+10FFFF.
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      length = 2;
+      cp = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      length = 3;
+      cp = lead & 0x0F;
+      if (lead == 0xE0)
+        low = 0xA0;
+      else if (lead == 0xED)
+        high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      length = 4;
+      cp = lead & 0x07;
+      if (lead == 0xF0)
+        low = 0x90;
+      else if (lead == 0xF4)
+        high = 0x8F;
+    } else {
+      return false;
+    }
+    if (size - i < length)
+      return false;
+
+    const unsigned char first = bytes[i + 1];
+    if (first < low || first > high)
+      return false;
+    cp = (cp << 6) | (first & 0x3F);
+    for (size_t k = 2; k < length; ++k) {
+      const unsigned char next = bytes[i + k];
+      if ((next & 0xC0) != 0x80)
+        return false;
+      cp = (cp << 6) | (next & 0x3F);
+    }
+    onCodepoint(cp);
+    i += length;
+  }
+  return true;
+}
+
+/// True for Unicode scalar values (code points that are not surrogates).
+constexpr bool isUnicodeScalar(char32_t cp) noexcept {
+  return cp < 0xD800 || (cp > 0xDFFF && cp <= 0x10FFFF);
+}
+
+/// True if @p in is well-formed UTF-8.
+inline bool isValidUtf8(std::string_view in) {
+  return decodeUtf8(
+      in, [](const unsigned char *, size_t) {}, [](char32_t) {});
+}
+
+/// True if every value of @p in is a Unicode scalar value.
+constexpr bool isValidUtf32(std::u32string_view in) noexcept {
+  for (char32_t cp : in) {
+    if (!isUnicodeScalar(cp))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Emit the UTF-16 code unit(s) of a Unicode scalar value.
+ * @param cp Scalar value (see `isUnicodeScalar()`).
+ * @param emit Called as `emit(char16_t unit)` once or twice.
+ */
+template <typename Emit> void encodeUtf16(char32_t cp, Emit &&emit) {
+  if (cp <= 0xFFFF) {
+    emit(static_cast<char16_t>(cp));
+    return;
+  }
+  cp -= 0x10000;
+  emit(static_cast<char16_t>(0xD800 | (cp >> 10)));
+  emit(static_cast<char16_t>(0xDC00 | (cp & 0x3FF)));
+}
+
+/**
+ * @brief Call `fn(char32_t cp)` for every code point of UTF-8 @p in.
+ * @return false, after the code points preceding it, at the first
+ * ill-formed sequence.
+ */
+template <typename Fn> bool forEachCodepoint(std::string_view in, Fn &&fn) {
+  return decodeUtf8(
+      in,
+      [&fn](const unsigned char *ascii, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+          fn(static_cast<char32_t>(ascii[i]));
+      },
+      fn);
+}
+
+/**
+ * @brief Call `fn(char32_t cp)` for every value of UTF-32 @p in.
+ * @return false, after the values preceding it, at the first value that is
+ * not a Unicode scalar value.
+ */
+template <typename Fn>
+bool forEachCodepoint(std::u32string_view in, Fn &&fn) {
+  for (char32_t cp : in) {
+    if (!isUnicodeScalar(cp))
+      return false;
+    fn(cp);
+  }
+  return true;
+}
+
+/**
+ * @brief Append the code points of UTF-8 @p in to @p out.
+ * @return false (leaving @p out unchanged) if @p in is ill-formed.
+ */
+inline bool appendUtf8AsUtf32(std::string_view in, std::u32string &out) {
+  const size_t base = out.size();
+  out.reserve(base + in.size());
+  const bool ok = decodeUtf8(
+      in,
+      [&out](const unsigned char *ascii, size_t n) {
+        out.append(ascii, ascii + n);
+      },
+      [&out](char32_t cp) { out.push_back(cp); });
+  if (!ok)
+    out.resize(base);
+  return ok;
+}
+
+/**
+ * @brief Append the UTF-16 code units of UTF-8 @p in to @p out.
+ * @tparam Unit 16-bit code unit type (`char16_t`, `wchar_t`, `UniChar`...).
+ * @return false (leaving @p out unchanged) if @p in is ill-formed.
+ */
+template <typename Unit>
+bool appendUtf8AsUtf16(std::string_view in, std::vector<Unit> &out) {
+  const size_t base = out.size();
+  // A UTF-8 sequence never has fewer bytes than its UTF-16 form has units.
+  out.reserve(base + in.size());
+  const bool ok = decodeUtf8(
+      in,
+      [&out](const unsigned char *ascii, size_t n) {
+        out.insert(out.end(), ascii, ascii + n);
+      },
+      [&out](char32_t cp) {
+        encodeUtf16(cp, [&out](char16_t u) { out.push_back(Unit(u)); });
+      });
+  if (!ok)
+    out.resize(base);
+  return ok;
+}
+
+/**
+ * @brief Append the UTF-16 code units of UTF-32 @p in to @p out.
+ * @tparam Unit 16-bit code unit type.
+ * @return false (leaving @p out unchanged) if @p in holds a surrogate or a
+ * value above U+10FFFF.
+ */
+template <typename Unit>
+bool appendUtf32AsUtf16(std::u32string_view in, std::vector<Unit> &out) {
+  const size_t base = out.size();
+  out.reserve(base + in.size());
+  for (char32_t cp : in) {
+    if (!isUnicodeScalar(cp)) {
+      out.resize(base);
+      return false;
+    }
+    encodeUtf16(cp, [&out](char16_t u) { out.push_back(Unit(u)); });
+  }
+  return true;
+}
+
+} // namespace axidev::io::keyboard::detail
@@ -14,6 +14,11 @@
 
 #include <axidev-io/log.hpp>
 
+#include <atomic>
+#include <cstdio>
+
+#include "keyboard/common/keymap_cache.hpp"
+
 namespace axidev::io::keyboard::detail {
 
 bool isWindowsExtendedKey(WORD vk) {
@@ -45,17 +50,15 @@ bool isWindowsExtendedKey(WORD vk) {
 void fillWindowsFallbackMappings(WindowsKeyMap &keyMap) {
   // Helper to set mapping in both directions if not already present
   auto setIfMissing = [&keyMap](Key key, WORD vk) {
-    if (keyMap.keyToVk.find(key) == keyMap.keyToVk.end()) {
-      keyMap.keyToVk[key] = vk;
+    if (keyMap.keyToVk.insert(key, vk)) {
       AXIDEV_IO_LOG_DEBUG(
           "Windows keymap: adding fallback mapping for %s to VK 0x%02X",
-          keyToString(key).c_str(), vk);
+          keyToStringView(key).data(), vk);
     }
-    if (keyMap.vkToKey.find(vk) == keyMap.vkToKey.end()) {
-      keyMap.vkToKey[vk] = key;
+    if (keyMap.vkToKey.insert(vk, key)) {
       AXIDEV_IO_LOG_DEBUG(
           "Windows keymap: adding fallback mapping for VK 0x%02X to %s", vk,
-          keyToString(key).c_str());
+          keyToStringView(key).data());
     }
   };
 
@@ -215,12 +218,8 @@ WindowsKeyMap initWindowsKeyMap(HKL layout) {
         if (mapped != Key::Unknown) {
           WORD vkWord = static_cast<WORD>(vk);
           // Only add if not already present (first mapping wins)
-          if (keyMap.keyToVk.find(mapped) == keyMap.keyToVk.end()) {
-            keyMap.keyToVk[mapped] = vkWord;
-          }
-          if (keyMap.vkToKey.find(vkWord) == keyMap.vkToKey.end()) {
-            keyMap.vkToKey[vkWord] = mapped;
-          }
+          keyMap.keyToVk.insert(mapped, vkWord);
+          keyMap.vkToKey.insert(vkWord, mapped);
         }
       }
     }
@@ -276,20 +275,14 @@ WindowsKeyMap initWindowsKeyMap(HKL layout) {
           }
 
           // Register in charToKeycode (only if not already present)
-          if (keyMap.charToKeycode.find(codepoint) ==
-              keyMap.charToKeycode.end()) {
-            keyMap.charToKeycode[codepoint] = KeyMapping(
-                static_cast<int32_t>(vk), scan.axidevMods, mappedKey);
-          }
+          keyMap.charToKeycode.insert(
+              codepoint, KeyMapping(static_cast<int32_t>(vk), scan.axidevMods,
+                                    mappedKey));
 
           // Register in vkAndModsToKey for reverse lookup
           if (mappedKey != Key::Unknown) {
-            uint32_t lookupKey =
-                encodeVkMods(static_cast<WORD>(vk), scan.axidevMods);
-            if (keyMap.vkAndModsToKey.find(lookupKey) ==
-                keyMap.vkAndModsToKey.end()) {
-              keyMap.vkAndModsToKey[lookupKey] = mappedKey;
-            }
+            keyMap.vkAndModsToKey.insert(static_cast<int32_t>(vk),
+                                         scan.axidevMods, mappedKey);
           }
         }
       }
@@ -312,21 +305,65 @@ WindowsKeyMap initWindowsKeyMap(HKL layout) {
 Key resolveKeyFromVkAndMods(const WindowsKeyMap &keyMap, WORD vk,
                             Modifier mods) {
   // First, try to find an exact match with the modifiers
-  uint32_t lookupKey = encodeVkMods(vk, mods);
-  auto it = keyMap.vkAndModsToKey.find(lookupKey);
-  if (it != keyMap.vkAndModsToKey.end()) {
-    return it->second;
+  if (const Key *key = keyMap.vkAndModsToKey.find(vk, mods)) {
+    return *key;
   }
 
   // Fall back to the base key mapping (no modifiers)
-  auto baseIt = keyMap.vkToKey.find(vk);
-  if (baseIt != keyMap.vkToKey.end()) {
-    return baseIt->second;
+  if (const Key *base = keyMap.vkToKey.find(vk)) {
+    return *base;
   }
 
   return Key::Unknown;
 }
 
+std::shared_ptr<const WindowsKeyMap> acquireWindowsKeyMap(HKL layout) {
+  static SharedKeyMapCache<WindowsKeyMap> cache("windows");
+  if (layout == nullptr) {
+    layout = GetKeyboardLayout(0);
+  }
+  // The HKL packs the language and layout identifiers, so it names the same
+  // layout in every process.
+  char key[32];
+  std::snprintf(key, sizeof(key), "hkl=%llx",
+                static_cast<unsigned long long>(
+                    reinterpret_cast<uintptr_t>(layout)));
+  return cache.acquire(
+      key, [layout]() { return initWindowsKeyMap(layout); },
+      [layout](WindowsKeyMap &map) { map.layout = layout; });
+}
+
+HKL foregroundKeyboardLayout() {
+  if (HWND window = GetForegroundWindow()) {
+    if (DWORD thread = GetWindowThreadProcessId(window, nullptr))
+      return GetKeyboardLayout(thread);
+  }
+  return GetKeyboardLayout(0);
+}
+
+void pollForegroundLayout() {
+  static std::atomic<uint64_t> nextPollMs{0};
+  static std::atomic<HKL> lastLayout{nullptr};
+  const uint64_t now = GetTickCount64();
+  uint64_t due = nextPollMs.load(std::memory_order_relaxed);
+  // One caller per interval queries; the others keep their current mappings.
+  if (now < due ||
+      !nextPollMs.compare_exchange_strong(due, now + kForegroundLayoutPollMs,
+                                          std::memory_order_relaxed))
+    return;
+  const HKL layout = foregroundKeyboardLayout();
+  if (lastLayout.exchange(layout, std::memory_order_relaxed) != layout)
+    windowsLayoutTracker().notifyChanged();
+}
+
+LayoutTracker<WindowsKeyMap> &windowsLayoutTracker() {
+  // Never destroyed, so a rebuild still running at exit cannot outlive it.
+  static auto *tracker = new LayoutTracker<WindowsKeyMap>(
+      "windows",
+      [] { return acquireWindowsKeyMap(foregroundKeyboardLayout()); });
+  return *tracker;
+}
+
 } // namespace axidev::io::keyboard::detail
 
 #endif // _WIN32
@@ -17,7 +17,13 @@
 
 #include <Windows.h>
 #include <axidev-io/keyboard/common.hpp>
-#include <unordered_map>
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/common/layout_tracker.hpp"
 
 namespace axidev::io::keyboard::detail {
 
@@ -30,39 +36,34 @@ namespace axidev::io::keyboard::detail {
  */
 struct WindowsKeyMap {
   /// Map from logical Key enum to Windows VK code (for Sender)
-  std::unordered_map<Key, WORD> keyToVk;
+  KeyCodeTable keyToVk;
 
   /// Map from Windows VK code to logical Key enum (for Listener - base keys)
-  std::unordered_map<WORD, Key> vkToKey;
+  CodeKeyTable vkToKey;
 
   /// Map for character to VK code + modifier requirements (for text typing)
   /// Uses KeyMapping to track which modifiers are needed to produce each char.
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
+  CharMappingTable charToKeycode;
 
-  /// Map from (VK code, modifiers) to the Key produced.
+  /// Map from (VK code, Shift/Ctrl/Alt) to the Key produced.
   /// This enables the Listener to resolve the correct Key based on what
   /// modifiers were active when the key was pressed.
-  /// The key is encoded as: (vk << 8) | modifier_bits
-  std::unordered_map<uint32_t, Key> vkAndModsToKey;
+  CodeModsKeyTable vkAndModsToKey;
+
+  /// Layout the tables were built for, set by `acquireWindowsKeyMap()`; it is
+  /// not stored in the keymap cache file. Translate with this handle so the
+  /// HKL and the tables always switch together.
+  HKL layout{nullptr};
 };
 
-/**
- * @brief Encode a VK code and modifier combination into a single lookup key.
- * @param vk The Windows virtual key code.
- * @param mods The modifier flags (only Shift, Ctrl, Alt are typically
- * relevant).
- * @return uint32_t Encoded lookup key for vkAndModsToKey map.
- */
-inline uint32_t encodeVkMods(WORD vk, Modifier mods) {
-  // We care about Shift, Ctrl, and Alt for character production
-  uint8_t modBits = 0;
-  if (hasModifier(mods, Modifier::Shift))
-    modBits |= 0x01;
-  if (hasModifier(mods, Modifier::Ctrl))
-    modBits |= 0x02;
-  if (hasModifier(mods, Modifier::Alt))
-    modBits |= 0x04;
-  return (static_cast<uint32_t>(vk) << 8) | modBits;
+/// Tables of @p keyMap in the order the keymap cache stores them.
+inline auto keyMapTables(WindowsKeyMap &keyMap) {
+  return std::tie(keyMap.keyToVk, keyMap.vkToKey, keyMap.charToKeycode,
+                  keyMap.vkAndModsToKey);
+}
+inline auto keyMapTables(const WindowsKeyMap &keyMap) {
+  return std::tie(keyMap.keyToVk, keyMap.vkToKey, keyMap.charToKeycode,
+                  keyMap.vkAndModsToKey);
 }
 
 /**
@@ -80,6 +81,45 @@ inline uint32_t encodeVkMods(WORD vk, Modifier mods) {
  */
 WindowsKeyMap initWindowsKeyMap(HKL layout = nullptr);
 
+/**
+ * @brief Shared key mappings for the specified keyboard layout.
+ *
+ * Returns the process-wide snapshot for @p layout (see keymap_cache.hpp),
+ * building it with `initWindowsKeyMap()` on first use.
+ *
+ * @param layout Keyboard layout handle (HKL). Pass nullptr to use the
+ *               current thread's layout.
+ * @return std::shared_ptr<const WindowsKeyMap> Never null.
+ */
+std::shared_ptr<const WindowsKeyMap> acquireWindowsKeyMap(HKL layout = nullptr);
+
+/**
+ * @brief Layout of the thread owning the foreground window, i.e. the layout
+ * that translates injected and typed keys; the calling thread's layout when
+ * there is no foreground window.
+ */
+HKL foregroundKeyboardLayout();
+
+/**
+ * @brief Report a change of `foregroundKeyboardLayout()` to
+ * `windowsLayoutTracker()`, querying it at most every
+ * `kForegroundLayoutPollMs` across the process.
+ *
+ * Senders and Listeners call this before their `LayoutSubscription::refresh()`;
+ * between polls it costs one clock read and one atomic load.
+ */
+void pollForegroundLayout();
+
+/// Minimum interval between two foreground layout queries.
+inline constexpr uint64_t kForegroundLayoutPollMs = 200;
+
+/**
+ * @brief Process-wide tracker of the active layout (see layout_tracker.hpp).
+ *
+ * Each rebuild takes the snapshot for `foregroundKeyboardLayout()`.
+ */
+LayoutTracker<WindowsKeyMap> &windowsLayoutTracker();
+
 /**
  * @brief Fill fallback mappings for non-printable keys.
  *
@@ -0,0 +1,211 @@
+/**
+ * @file keyboard/listener/hotkey_matcher.cpp
+ * @brief Trie construction and the flat transition table of HotkeyMatcher.
+ *
+ * `add()` grows a trie of strokes, with children kept in a hash map keyed by
+ * (node, stroke). `compile()` copies those edges into an open-addressing
+ * table sized to stay at most half full, so `feed()` resolves a transition
+ * with one multiply-shift hash and a short linear probe over contiguous
+ * slots.
+ */
+
+#include <axidev-io/keyboard/hotkey.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace axidev::io::keyboard {
+
+namespace {
+
+// Lock states never take part in stroke matching.
+constexpr uint8_t kStrokeMods = static_cast<uint8_t>(Modifier::Shift) |
+                                static_cast<uint8_t>(Modifier::Ctrl) |
+                                static_cast<uint8_t>(Modifier::Alt) |
+                                static_cast<uint8_t>(Modifier::Super);
+
+bool isModifierKey(Key key) {
+  return key >= Key::ShiftLeft && key <= Key::NumLock;
+}
+
+uint32_t strokeCode(KeyWithModifier keyMod) {
+  return (static_cast<uint32_t>(keyMod.key) << 8) |
+         (static_cast<uint8_t>(keyMod.requiredMods) & kStrokeMods);
+}
+
+uint64_t edgeKey(uint32_t node, uint32_t stroke) {
+  return (static_cast<uint64_t>(node) << 32) | stroke;
+}
+
+} // namespace
+
+struct HotkeyMatcher::Impl {
+  struct Slot {
+    uint64_t edge{kEmpty};
+    uint32_t next{0};
+  };
+
+  // Node ids are 32-bit and the root is 0, so no edge key is all ones.
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
+  static constexpr uint32_t kNoNode = ~uint32_t{0};
+
+  size_t slotFor(uint64_t edge) const noexcept {
+    // Fibonacci hashing: the top bits of the product index the table.
+    return static_cast<size_t>((edge * 0x9E3779B97F4A7C15ull) >> shift);
+  }
+
+  uint32_t lookup(uint32_t node, uint32_t stroke) const noexcept {
+    const uint64_t edge = edgeKey(node, stroke);
+    const size_t mask = table.size() - 1;
+    for (size_t i = slotFor(edge);; i = (i + 1) & mask) {
+      if (table[i].edge == edge)
+        return table[i].next;
+      if (table[i].edge == kEmpty)
+        return kNoNode;
+    }
+  }
+
+  void compile() {
+    const size_t capacity =
+        std::bit_ceil(std::max<size_t>(16, edges.size() * 2));
+    table.assign(capacity, Slot{});
+    shift = 64 - std::countr_zero(capacity);
+    const size_t mask = capacity - 1;
+    for (const auto &[edge, next] : edges) {
+      size_t i = slotFor(edge);
+      while (table[i].edge != kEmpty)
+        i = (i + 1) & mask;
+      table[i] = Slot{edge, next};
+    }
+    state = 0;
+    dirty = false;
+  }
+
+  // Trie being built by add(); node 0 is the root.
+  std::vector<BindingId> bindings{kInvalidBinding}; // per node
+  std::unordered_map<uint64_t, uint32_t> edges;
+  std::vector<Action> actions; // indexed by BindingId - 1
+
+  // Compiled form read by feed().
+  std::vector<Slot> table;
+  int shift{64};
+  bool dirty{true};
+  uint32_t state{0};
+};
+
+HotkeyMatcher::HotkeyMatcher() : m_impl(std::make_unique<Impl>()) {}
+HotkeyMatcher::~HotkeyMatcher() = default;
+HotkeyMatcher::HotkeyMatcher(HotkeyMatcher &&) noexcept = default;
+HotkeyMatcher &HotkeyMatcher::operator=(HotkeyMatcher &&) noexcept = default;
+
+HotkeyMatcher::BindingId
+HotkeyMatcher::add(std::span<const KeyWithModifier> sequence, Action action) {
+  if (!m_impl || sequence.empty())
+    return kInvalidBinding;
+  for (const KeyWithModifier &stroke : sequence) {
+    if (!stroke.isValid() || isModifierKey(stroke.key))
+      return kInvalidBinding;
+  }
+
+  // Reject conflicts before touching the trie, so a failed add leaves no
+  // dangling nodes behind.
+  uint32_t node = 0;
+  size_t depth = 0;
+  for (; depth < sequence.size(); ++depth) {
+    if (m_impl->bindings[node] != kInvalidBinding)
+      return kInvalidBinding; // an existing binding is a prefix
+    auto it = m_impl->edges.find(edgeKey(node, strokeCode(sequence[depth])));
+    if (it == m_impl->edges.end())
+      break;
+    node = it->second;
+  }
+  if (depth == sequence.size())
+    return kInvalidBinding; // equal to, or a prefix of, an existing binding
+
+  for (; depth < sequence.size(); ++depth) {
+    const auto child = static_cast<uint32_t>(m_impl->bindings.size());
+    m_impl->bindings.push_back(kInvalidBinding);
+    m_impl->edges.emplace(edgeKey(node, strokeCode(sequence[depth])), child);
+    node = child;
+  }
+
+  m_impl->actions.push_back(std::move(action));
+  const auto id = static_cast<BindingId>(m_impl->actions.size());
+  m_impl->bindings[node] = id;
+  m_impl->dirty = true;
+  return id;
+}
+
+HotkeyMatcher::BindingId HotkeyMatcher::add(KeyWithModifier chord,
+                                            Action action) {
+  return add(std::span<const KeyWithModifier>(&chord, 1), std::move(action));
+}
+
+HotkeyMatcher::BindingId HotkeyMatcher::add(std::string_view sequence,
+                                            Action action) {
+  std::vector<KeyWithModifier> strokes;
+  while (!sequence.empty()) {
+    const size_t start = sequence.find_first_not_of(' ');
+    if (start == std::string_view::npos)
+      break;
+    sequence.remove_prefix(start);
+    const size_t end = std::min(sequence.find(' '), sequence.size());
+    strokes.push_back(stringToKeyWithModifier(sequence.substr(0, end)));
+    sequence.remove_prefix(end);
+  }
+  return add(std::span<const KeyWithModifier>(strokes), std::move(action));
+}
+
+void HotkeyMatcher::clear() {
+  if (m_impl)
+    *m_impl = Impl{};
+}
+
+size_t HotkeyMatcher::size() const {
+  return m_impl ? m_impl->actions.size() : 0;
+}
+
+void HotkeyMatcher::compile() {
+  if (m_impl)
+    m_impl->compile();
+}
+
+HotkeyMatcher::BindingId HotkeyMatcher::feed(KeyWithModifier keyMod,
+                                             bool pressed) {
+  if (!m_impl || !pressed || !keyMod.isValid() || isModifierKey(keyMod.key))
+    return kInvalidBinding;
+  Impl &impl = *m_impl;
+  if (impl.dirty)
+    impl.compile();
+
+  const uint32_t stroke = strokeCode(keyMod);
+  uint32_t next = impl.lookup(impl.state, stroke);
+  if (next == Impl::kNoNode && impl.state != 0)
+    next = impl.lookup(0, stroke); // abandon the sequence, retry from root
+  if (next == Impl::kNoNode) {
+    impl.state = 0;
+    return kInvalidBinding;
+  }
+
+  const BindingId id = impl.bindings[next];
+  if (id == kInvalidBinding) {
+    impl.state = next;
+    return kInvalidBinding;
+  }
+  impl.state = 0;
+  if (const Action &action = impl.actions[id - 1])
+    action(id);
+  return id;
+}
+
+bool HotkeyMatcher::pending() const { return m_impl && m_impl->state != 0; }
+
+void HotkeyMatcher::reset() {
+  if (m_impl)
+    m_impl->state = 0;
+}
+
+} // namespace axidev::io::keyboard
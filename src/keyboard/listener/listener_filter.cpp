@@ -0,0 +1,115 @@
+/**
+ * @file keyboard/listener/listener_filter.cpp
+ * @brief `Listener::Filter` builders and their compiled form, and the
+ * `Listener::Sources` builders.
+ */
+
+#include "keyboard/listener/listener_filter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace axidev::io::keyboard {
+
+Listener::Filter &Listener::Filter::addKey(Key key) {
+  keys.push_back(key);
+  return *this;
+}
+
+Listener::Filter &Listener::Filter::addKeyRange(Key first, Key last) {
+  const auto lo = static_cast<uint16_t>(first);
+  const auto hi = static_cast<uint16_t>(last);
+  for (uint32_t k = lo; k <= hi; ++k)
+    keys.push_back(static_cast<Key>(k));
+  return *this;
+}
+
+Listener::Filter &Listener::Filter::addChord(KeyWithModifier chord) {
+  chords.push_back(chord);
+  return *this;
+}
+
+Listener::Sources &Listener::Sources::addSeat(std::string seat) {
+  seats.push_back(std::move(seat));
+  return *this;
+}
+
+Listener::Sources &Listener::Sources::addDevicePath(std::string path) {
+  devicePaths.push_back(std::move(path));
+  return *this;
+}
+
+namespace detail {
+
+namespace {
+
+// Lock states never take part in chord matching.
+constexpr uint8_t kChordMask = static_cast<uint8_t>(Modifier::Shift) |
+                               static_cast<uint8_t>(Modifier::Ctrl) |
+                               static_cast<uint8_t>(Modifier::Alt) |
+                               static_cast<uint8_t>(Modifier::Super);
+
+uint8_t chordBits(Modifier mods) {
+  return static_cast<uint8_t>(mods) & kChordMask;
+}
+
+} // namespace
+
+KeyFilter::KeyFilter(const Listener::Filter &spec, const CodeKeyTable &base,
+                     const CodeModsKeyTable &withMods)
+    : restricted_(!spec.keys.empty() || !spec.chords.empty()),
+      pressOnly_(spec.pressOnly), needCodepoint_(spec.needCodepoint) {
+  if (!restricted_)
+    return;
+
+  for (Key key : spec.keys) {
+    if (static_cast<size_t>(key) < kMaxKeys)
+      anyMods_.set(static_cast<size_t>(key));
+  }
+  for (const KeyWithModifier &chord : spec.chords) {
+    if (static_cast<size_t>(chord.key) < kMaxKeys) {
+      chordKeys_.set(static_cast<size_t>(chord.key));
+      chords_.push_back(chord);
+    }
+  }
+
+  std::bitset<kMaxCodes> known;
+  auto visit = [this, &known](int32_t code, Key key) {
+    if (code < 0 || static_cast<size_t>(code) >= kMaxCodes)
+      return;
+    known.set(static_cast<size_t>(code));
+    if (wantsKey(key))
+      codes_.set(static_cast<size_t>(code));
+  };
+  base.forEach(visit);
+  withMods.forEach(
+      [&visit](int32_t code, Modifier, Key key) { visit(code, key); });
+  codes_ |= ~known;
+}
+
+bool KeyFilter::wantsKey(Key key) const noexcept {
+  const auto index = static_cast<size_t>(key);
+  return index < kMaxKeys && (anyMods_.test(index) || chordKeys_.test(index));
+}
+
+bool KeyFilter::admits(KeyWithModifier keyMod) const noexcept {
+  if (!restricted_)
+    return true;
+  const auto index = static_cast<size_t>(keyMod.key);
+  if (index >= kMaxKeys)
+    return false;
+  if (anyMods_.test(index))
+    return true;
+  if (!chordKeys_.test(index))
+    return false;
+  const uint8_t held = chordBits(keyMod.requiredMods);
+  return std::any_of(chords_.begin(), chords_.end(),
+                     [&keyMod, held](const KeyWithModifier &chord) {
+                       return chord.key == keyMod.key &&
+                              chordBits(chord.requiredMods) == held;
+                     });
+}
+
+} // namespace detail
+
+} // namespace axidev::io::keyboard
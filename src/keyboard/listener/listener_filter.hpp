@@ -0,0 +1,77 @@
+#pragma once
+/**
+ * @file keyboard/listener/listener_filter.hpp
+ * @brief Internal compiled form of `Listener::Filter`.
+ *
+ * A filter is checked twice per event. Before translation, `admitsCode()`
+ * tests the native keycode against a bitset of every code that the layout
+ * can turn into a wanted key; events that fail are handed back to the OS
+ * untouched. After translation, `admits()` applies the exact key and chord
+ * rules, since one keycode can produce different keys under different
+ * modifiers.
+ */
+
+#include <axidev-io/keyboard/listener.hpp>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "keyboard/common/flat_keymap.hpp"
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief `Listener::Filter` compiled against one platform keymap.
+ *
+ * A default-constructed KeyFilter admits everything.
+ */
+class KeyFilter {
+public:
+  /// Native keycodes tracked by the bitset; larger codes always pass.
+  static constexpr size_t kMaxCodes = 1024;
+
+  KeyFilter() = default;
+
+  /**
+   * @brief Compile @p spec for the layout described by @p base (code -> key)
+   * and @p withMods (code + modifiers -> key).
+   *
+   * A keycode passes the pre-translation check when either table maps it to
+   * a wanted key, or when neither table knows it at all, because the backend
+   * may still resolve such a code through its fallback path.
+   */
+  KeyFilter(const Listener::Filter &spec, const CodeKeyTable &base,
+            const CodeModsKeyTable &withMods);
+
+  /// Cheap check run before any translation.
+  [[nodiscard]] bool admitsCode(uint32_t code, bool pressed) const noexcept {
+    if (pressOnly_ && !pressed)
+      return false;
+    return !restricted_ || code >= kMaxCodes || codes_.test(code);
+  }
+
+  /// Exact check on the translated key and modifiers.
+  [[nodiscard]] bool admits(KeyWithModifier keyMod) const noexcept;
+
+  /// Whether the consumer wants `codepoint` computed.
+  [[nodiscard]] bool wantsCodepoint() const noexcept { return needCodepoint_; }
+
+private:
+  static constexpr size_t kMaxKeys = 512;
+
+  [[nodiscard]] bool wantsKey(Key key) const noexcept;
+
+  bool restricted_{false};
+  bool pressOnly_{false};
+  bool needCodepoint_{true};
+  std::bitset<kMaxCodes> codes_;
+  // Keys wanted with any modifiers, and keys that appear in some chord.
+  std::bitset<kMaxKeys> anyMods_;
+  std::bitset<kMaxKeys> chordKeys_;
+  std::vector<KeyWithModifier> chords_;
+};
+
+} // namespace axidev::io::keyboard::detail
@@ -4,8 +4,9 @@
  *
  * Provides a libinput-based global keyboard event listener that translates
  * low-level input events into logical keys and Unicode codepoints using
- * xkbcommon. The implementation handles device discovery, event translation,
- * and invokes the public Listener callback on observed events.
+ * xkbcommon. The implementation handles device discovery on any number of
+ * udev seats and explicit device nodes, keeps a separate xkb state per
+ * keyboard, and invokes the public Listener callback on observed events.
  */
 #if defined(__linux__)
 
@@ -13,27 +14,37 @@
 #include <axidev-io/log.hpp>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
 #include <fstream>
 #include <libinput.h>
 #include <libudev.h>
+#include <memory>
 #include <mutex>
 #include <poll.h>
 #include <string>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <thread>
 #include <unistd.h>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <xkbcommon/xkbcommon-keysyms.h>
 #include <xkbcommon/xkbcommon.h>
 
 #include "keyboard/common/linux_keysym.hpp"
 #include "keyboard/common/linux_layout.hpp"
+#include "keyboard/common/published_callback.hpp"
+#include "keyboard/listener/listener_filter.hpp"
+#include "keyboard/listener/listener_queue.hpp"
+#include "keyboard/listener/listener_stats.hpp"
 
 namespace axidev::io::keyboard {
 
@@ -126,66 +137,109 @@ static char32_t codepointFromKey(Key key) {
  * part of the public API; they may change without notice.
  */
 struct Listener::Impl {
-  Impl() = default;
-  ~Impl() { stop(); }
+  Impl() {
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0) {
+      AXIDEV_IO_LOG_WARN("Listener (Linux/libinput): eventfd() failed: %s; "
+                         "falling back to periodic stop checks",
+                         strerror(errno));
+    }
+  }
+  ~Impl() {
+    stop();
+    if (wakeFd >= 0)
+      ::close(wakeFd);
+  }
 
   /**
    * @internal
    * @brief Start the implementation worker thread and store the callback.
    *
-   * The provided callback is stored under `cbMutex` to avoid races with the
-   * worker thread. This method starts a background thread which performs
-   * device discovery and event processing; it waits briefly for the worker to
-   * report readiness and returns whether initialization succeeded.
+   * The provided callback is published before the worker thread is created,
+   * so the worker can read it without locking. This method starts a
+   * background thread which performs device discovery and event processing;
+   * it waits (up to `kStartTimeout`) for the worker to report the outcome of
+   * its initialization through `readyCv` and returns whether it succeeded.
    *
    * @param cb Callback that will be invoked for each observed event.
    * @return true on success and when the worker becomes ready.
    */
-  bool start(Callback cb) {
-    std::lock_guard<std::mutex> lk(cbMutex);
+  bool start(EventCallback cb) {
+    std::lock_guard<std::mutex> lk(startMutex);
     if (running.load())
       return false;
+    if (worker.joinable())
+      worker.join();
 
-    callback = std::move(cb);
+    callback.publish(std::move(cb));
+    counters.reset();
     running.store(true);
     ready.store(false);
     worker = std::thread(&Impl::threadMain, this);
 
-    // Wait (up to ~200ms) for initialization
-    for (int i = 0; i < 40; ++i) {
-      if (!running.load())
-        return false;
-      if (ready.load())
-        return true;
-      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    bool ok = false;
+    {
+      std::unique_lock<std::mutex> lock(readyMutex);
+      readyCv.wait_for(lock, kStartTimeout,
+                       [this] { return ready.load() || !running.load(); });
+      ok = ready.load();
     }
-    bool ok = ready.load();
     AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput): start result=%u",
                       static_cast<unsigned>(ok));
+    // A failed or timed-out start leaves no worker behind.
+    if (!ok)
+      stop();
     return ok;
   }
 
+  /**
+   * @internal
+   * @brief Store the filter compiled by the next start().
+   * @return false while the worker is running.
+   */
+  bool setFilter(Filter spec) {
+    std::lock_guard<std::mutex> lk(startMutex);
+    if (running.load())
+      return false;
+    filterSpec = std::move(spec);
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Store the sources opened by the next start().
+   * @return false while the worker is running.
+   */
+  bool setSources(Sources spec) {
+    std::lock_guard<std::mutex> lk(startMutex);
+    if (running.load())
+      return false;
+    sourcesSpec = std::move(spec);
+    return true;
+  }
+
   /**
    * @internal
    * @brief Stop the worker thread and clear the stored callback.
    *
    * Safe to call from any thread. If a worker is running it will be asked to
-   * stop and joined; the callback pointer is cleared under `cbMutex` to prevent
-   * further invocations.
+   * stop and joined; the callback is retired only after the join so the
+   * worker can never observe a freed callback. The worker blocks in poll()
+   * without a timeout, so it is woken through `wakeFd` rather than waiting
+   * for a poll interval.
    */
   void stop() {
-    if (!running.load())
+    // A worker that exited on its own (init or poll failure) has already
+    // cleared `running` but still needs to be joined.
+    if (!running.load() && !worker.joinable())
       return;
 
     running.store(false);
+    wakeWorker();
     if (worker.joinable())
       worker.join();
 
-    // Clear callback under lock
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = nullptr;
-    }
+    callback.retire();
 
     AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): stopped");
   }
@@ -197,175 +251,493 @@ struct Listener::Impl {
    */
   bool isRunning() const { return running.load(); }
 
+  /// Event counters reported by `Listener::stats()`.
+  detail::ListenerStats &stats() { return counters; }
+
 private:
   /**
    * @internal
-   * @brief Worker thread main loop.
-   *
-   * Initializes udev/libinput/xkb state, performs device enumeration, and
-   * enters the event loop. Events are translated into logical `Key` values and
-   * Unicode codepoints which are forwarded to the user-provided callback.
-   *
-   * This method runs on a dedicated background thread and must not be invoked
-   * directly by user code.
+   * @brief Translation state of one keyboard, attached to its
+   * libinput_device as user data.
    */
-  void threadMain() {
-    struct udev *udev = udev_new();
-    if (!udev) {
-      AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): udev_new() failed");
-      running.store(false);
-      ready.store(false);
+  struct Device {
+    uint32_t id{0};
+    struct xkb_state *state{nullptr};
+    // Effective modifiers after the last key event of this keyboard.
+    Modifier activeMods{Modifier::None};
+    // Unicode codepoints computed at key-press time so they can be
+    // delivered on key-release events. Indexed by evdev keycode; 0 means
+    // none.
+    std::array<char32_t, KEY_CNT> pendingCodepoints{};
+  };
+
+  /**
+   * @internal
+   * @brief Signal the worker thread's eventfd so a blocking poll() returns.
+   */
+  void wakeWorker() {
+    if (wakeFd < 0)
       return;
+    uint64_t one = 1;
+    while (::write(wakeFd, &one, sizeof(one)) < 0 && errno == EINTR) {
     }
+  }
 
-    li = libinput_udev_create_context(&kInterface, nullptr, udev);
-    if (!li) {
-      AXIDEV_IO_LOG_ERROR(
-          "Listener (Linux/libinput): libinput_udev_create_context() failed");
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
+  /**
+   * @internal
+   * @brief Reset the eventfd counter after a wakeup (or a stale signal left
+   * over from a previous stop()).
+   */
+  void drainWakeFd() {
+    if (wakeFd < 0)
       return;
+    uint64_t value = 0;
+    while (::read(wakeFd, &value, sizeof(value)) < 0 && errno == EINTR) {
     }
+  }
 
-    if (libinput_udev_assign_seat(li, "seat0") < 0) {
-      AXIDEV_IO_LOG_ERROR(
-          "Listener (Linux/libinput): libinput_udev_assign_seat() failed. "
-          "Are you in the 'input' group or running with necessary privileges?");
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
+  /**
+   * @internal
+   * @brief Publish the outcome of worker initialization and wake `start()`.
+   *
+   * The flags are updated under `readyMutex` so that a waiting `start()`
+   * cannot miss the notification.
+   *
+   * @param ok true once monitoring has started; false if initialization
+   * failed, which also ends the worker.
+   */
+  void reportStartup(bool ok) {
+    {
+      std::lock_guard<std::mutex> lock(readyMutex);
+      if (!ok)
+        running.store(false);
+      ready.store(ok);
+    }
+    readyCv.notify_all();
+  }
+
+  /**
+   * @internal
+   * @brief Worker thread main loop.
+   *
+   * Opens the configured seats and devices, initializes the shared xkb
+   * keymap, and enters the event loop. All libinput contexts are polled
+   * together, so events from every source reach the callback from this one
+   * thread, in arrival order. Events are translated into logical `Key`
+   * values and Unicode codepoints using the state of the keyboard they came
+   * from.
+   *
+   * This method runs on a dedicated background thread and must not be invoked
+   * directly by user code.
+   */
+  void threadMain() {
+    struct udev *udev = nullptr;
+    if (!openSources(udev)) {
+      closeAll(udev);
+      reportStartup(false);
       return;
     }
 
-    // Initialize xkbcommon context / keymap / state for translating keycodes
-    xkbCtx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    // Initialize xkbcommon context / keymap for translating keycodes. Each
+    // keyboard gets its own state from this keymap (see deviceFor()).
+    struct xkb_context *xkbCtx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
     if (!xkbCtx) {
-      AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): xkb_context_new() failed");
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
+      AXIDEV_IO_LOG_ERROR(
+          "Listener (Linux/libinput): xkb_context_new() failed");
+      closeAll(udev);
+      reportStartup(false);
       return;
     }
     // Try to initialize XKB keymap names from environment variables or a
     // system configuration file (/etc/default/keyboard). This helps ensure the
     // keymap used for translating evdev keycodes matches the user's actual
-    // layout (e.g. non-QWERTY layouts).
+    // layout (e.g. non-QWERTY layouts). The keymap keeps its own reference on
+    // the context.
     const auto detected = axidev::io::keyboard::detail::detectXkbRuleNames();
-
-    const std::string &rulesStr = detected.rules;
-    const std::string &modelStr = detected.model;
-    const std::string &layoutStr = detected.layout;
-    const std::string &variantStr = detected.variant;
-    const std::string &optionsStr = detected.options;
-
-    struct xkb_rule_names names = {nullptr, nullptr, nullptr, nullptr, nullptr};
-    std::string dbg;
-    if (!rulesStr.empty()) {
-      names.rules = rulesStr.c_str();
-      dbg += "rules=" + rulesStr + " ";
+    struct xkb_keymap *keymap = detail::compileXkbKeymap(xkbCtx, detected);
+    xkb_context_unref(xkbCtx);
+    if (!keymap) {
+      closeAll(udev);
+      reportStartup(false);
+      return;
     }
-    if (!modelStr.empty()) {
-      names.model = modelStr.c_str();
-      dbg += "model=" + modelStr + " ";
+    xkbKeymap = std::make_shared<const detail::SharedXkbKeymap>(keymap);
+    struct xkb_state *scanState = xkbKeymap->newState();
+    if (!scanState) {
+      closeAll(udev);
+      reportStartup(false);
+      return;
     }
-    if (!layoutStr.empty()) {
-      names.layout = layoutStr.c_str();
-      dbg += "layout=" + layoutStr + " ";
+
+    // Take the shared keymap for modifier-aware key resolution; if no other
+    // Sender or Listener built this layout yet, it is scanned from the xkb
+    // keymap and a throwaway state.
+    linuxKeyMap = detail::acquireLinuxKeyMap(detected, keymap, scanState);
+    xkbKeymap->releaseState(scanState);
+    layoutKey = detail::xkbLayoutKey(detected);
+    cacheModifierMasks();
+    filter = detail::KeyFilter(filterSpec, linuxKeyMap->evdevToKey,
+                               linuxKeyMap->codeAndModsToKey);
+    AXIDEV_IO_LOG_DEBUG(
+        "Listener (Linux/libinput): Initialized keymap with %zu "
+        "evdev->Key mappings and %zu char->keycode mappings",
+        linuxKeyMap->evdevToKey.size(), linuxKeyMap->charToKeycode.size());
+
+    reportStartup(true);
+    AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): Monitoring started on %zu "
+                       "libinput context(s)",
+                       contexts.size());
+
+    // Block until a libinput context has events or stop() signals wakeFd;
+    // there is no timeout, so an idle listener never wakes up and events are
+    // dispatched as soon as they arrive. Without an eventfd, fall back to a
+    // periodic timeout so `running` is still observed.
+    drainWakeFd();
+    openLayoutWatch();
+    std::vector<struct pollfd> pfds;
+    pfds.reserve(contexts.size() + 2);
+    for (struct libinput *ctx : contexts)
+      pfds.push_back({.fd = libinput_get_fd(ctx), .events = POLLIN,
+                      .revents = 0});
+    const size_t wakeIndex = pfds.size();
+    if (wakeFd >= 0)
+      pfds.push_back({.fd = wakeFd, .events = POLLIN, .revents = 0});
+    const size_t watchIndex = pfds.size();
+    if (layoutWatchFd >= 0)
+      pfds.push_back({.fd = layoutWatchFd, .events = POLLIN, .revents = 0});
+    const int timeoutMs = wakeFd >= 0 ? -1 : 100;
+
+    while (running.load()) {
+      int ret = ::poll(pfds.data(), pfds.size(), timeoutMs);
+      if (ret < 0) {
+        if (errno == EINTR)
+          continue;
+        AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): poll() failed: %s",
+                            strerror(errno));
+        break;
+      }
+      if (wakeFd >= 0 && (pfds[wakeIndex].revents & POLLIN)) {
+        drainWakeFd();
+        continue;
+      }
+      if (layoutWatchFd >= 0 && (pfds[watchIndex].revents & POLLIN))
+        handleLayoutWatch();
+      // A layout published since the last batch applies to this one.
+      adoptPublishedLayout();
+      for (size_t i = 0; i < contexts.size(); ++i) {
+        if (pfds[i].revents & POLLIN)
+          dispatchContext(contexts[i]);
+      }
     }
-    if (!variantStr.empty()) {
-      names.variant = variantStr.c_str();
-      dbg += "variant=" + variantStr + " ";
+    running.store(false);
+
+    closeAll(udev);
+    ready.store(false);
+  }
+
+  /**
+   * @internal
+   * @brief Watch /etc/default for rewrites of the `keyboard` file, the
+   * layout configuration `detectXkbRuleNames()` falls back to.
+   *
+   * Best-effort: without inotify the listener keeps the layout it started
+   * with, unless another Sender or Listener reports a change.
+   */
+  void openLayoutWatch() {
+    layoutWatchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (layoutWatchFd < 0) {
+      AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput): inotify_init1() "
+                          "failed: %s",
+                          strerror(errno));
+      return;
     }
-    if (!optionsStr.empty()) {
-      names.options = optionsStr.c_str();
-      dbg += "options=" + optionsStr + " ";
+    if (inotify_add_watch(layoutWatchFd, kLayoutConfigDir,
+                          IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+      AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput): cannot watch %s: %s",
+                          kLayoutConfigDir, strerror(errno));
+      ::close(layoutWatchFd);
+      layoutWatchFd = -1;
     }
-    if (!dbg.empty()) {
-      AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput): xkb names: %s",
-                        dbg.c_str());
+  }
+
+  /**
+   * @internal
+   * @brief Drain the layout watch and report a rewritten configuration to
+   * the tracker, which detects and rebuilds the layout off this thread.
+   */
+  void handleLayoutWatch() {
+    alignas(struct inotify_event) char buf[4096];
+    bool touched = false;
+    for (;;) {
+      const ssize_t n = ::read(layoutWatchFd, buf, sizeof(buf));
+      if (n <= 0)
+        break;
+      for (ssize_t off = 0; off < n;) {
+        const auto *ie =
+            reinterpret_cast<const struct inotify_event *>(buf + off);
+        if (ie->len > 0 && std::strcmp(ie->name, kLayoutConfigFile) == 0)
+          touched = true;
+        off += static_cast<ssize_t>(sizeof(struct inotify_event) + ie->len);
+      }
     }
+    if (touched)
+      detail::linuxLayoutTracker().notifyChanged();
+  }
 
-    xkbKeymap =
-        xkb_keymap_new_from_names(xkbCtx, &names, XKB_KEYMAP_COMPILE_NO_FLAGS);
-    if (!xkbKeymap) {
-      AXIDEV_IO_LOG_ERROR(
-          "Listener (Linux/libinput): xkb_keymap_new_from_names() failed");
-      xkb_context_unref(xkbCtx);
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
+  /**
+   * @internal
+   * @brief Switch to the layout `linuxLayoutTracker()` published since the
+   * last call, if any.
+   *
+   * Costs one atomic load when nothing was published. Otherwise every
+   * keyboard gets a fresh state from the published xkb keymap, so modifiers
+   * held across the switch are forgotten; nothing is detected or compiled
+   * here. On failure the previous layout stays in use.
+   */
+  void adoptPublishedLayout() {
+    std::shared_ptr<const detail::LinuxLayout> next;
+    if (!layoutUpdates.refresh(detail::linuxLayoutTracker(), next))
       return;
-    }
-    xkbState = xkb_state_new(xkbKeymap);
-    if (!xkbState) {
-      AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): xkb_state_new() failed");
-      xkb_keymap_unref(xkbKeymap);
-      xkb_context_unref(xkbCtx);
-      libinput_unref(li);
-      udev_unref(udev);
-      running.store(false);
-      ready.store(false);
+    if (next->key == layoutKey && next->keyMap == linuxKeyMap)
+      return;
+    if (!next->xkb) {
+      AXIDEV_IO_LOG_WARN("Listener (Linux/libinput): no xkb keymap for %s, "
+                         "keeping %s",
+                         next->key.c_str(), layoutKey.c_str());
       return;
     }
+    std::vector<struct xkb_state *> states;
+    states.reserve(devices.size());
+    for (size_t i = 0; i < devices.size(); ++i) {
+      struct xkb_state *state = next->xkb->newState();
+      if (!state) {
+        for (struct xkb_state *created : states)
+          next->xkb->releaseState(created);
+        return;
+      }
+      states.push_back(state);
+    }
 
-    // Initialize our keymap for modifier-aware key resolution using the
-    // xkb keymap and state that was just set up.
-    linuxKeyMap = detail::initLinuxKeyMap(xkbKeymap, xkbState);
-    AXIDEV_IO_LOG_DEBUG(
-        "Listener (Linux/libinput): Initialized keymap with %zu "
-        "evdev->Key mappings and %zu char->keycode mappings",
-        linuxKeyMap.evdevToKey.size(), linuxKeyMap.charToKeycode.size());
-
-    ready.store(true);
-    AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): Monitoring started");
+    for (size_t i = 0; i < devices.size(); ++i) {
+      Device &device = *devices[i];
+      xkbKeymap->releaseState(device.state);
+      device.state = states[i];
+      device.activeMods = modifiersFromState(device.state);
+      device.pendingCodepoints.fill(0);
+    }
+    xkbKeymap = next->xkb;
+    cacheModifierMasks();
+    linuxKeyMap = next->keyMap;
+    layoutKey = next->key;
+    filter = detail::KeyFilter(filterSpec, linuxKeyMap->evdevToKey,
+                               linuxKeyMap->codeAndModsToKey);
+    AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): switched to layout %s",
+                       layoutKey.c_str());
+  }
 
-    int fd = libinput_get_fd(li);
-    struct pollfd pfd = {.fd = fd, .events = POLLIN, .revents = 0};
+  /**
+   * @internal
+   * @brief Create one libinput context per configured seat, plus one path
+   * context holding every configured device node.
+   *
+   * Default Sources open "seat0". Contexts are appended to `contexts` as
+   * they are created, so closeAll() releases them on failure too.
+   *
+   * @param udev Receives the udev handle shared by the seat contexts.
+   * @return false when any seat or device cannot be opened.
+   */
+  bool openSources(struct udev *&udev) {
+    std::vector<std::string> seats = sourcesSpec.seats;
+    if (seats.empty() && sourcesSpec.devicePaths.empty())
+      seats.emplace_back("seat0");
+
+    if (!seats.empty()) {
+      udev = udev_new();
+      if (!udev) {
+        AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): udev_new() failed");
+        return false;
+      }
+    }
+    for (const std::string &seat : seats) {
+      struct libinput *ctx =
+          libinput_udev_create_context(&kInterface, nullptr, udev);
+      if (!ctx) {
+        AXIDEV_IO_LOG_ERROR(
+            "Listener (Linux/libinput): libinput_udev_create_context() failed");
+        return false;
+      }
+      contexts.push_back(ctx);
+      if (libinput_udev_assign_seat(ctx, seat.c_str()) < 0) {
+        AXIDEV_IO_LOG_ERROR(
+            "Listener (Linux/libinput): libinput_udev_assign_seat(%s) failed. "
+            "Are you in the 'input' group or running with necessary "
+            "privileges?",
+            seat.c_str());
+        return false;
+      }
+    }
 
-    while (running.load()) {
-      int ret = poll(&pfd, 1, 100);
-      if (ret > 0 && (pfd.revents & POLLIN)) {
-        libinput_dispatch(li);
-        struct libinput_event *ev;
-        while ((ev = libinput_get_event(li))) {
-          enum libinput_event_type t = libinput_event_get_type(ev);
-          if (t == LIBINPUT_EVENT_KEYBOARD_KEY) {
-            handleKeyEvent(libinput_event_get_keyboard_event(ev));
-          }
-          libinput_event_destroy(ev);
-        }
+    if (sourcesSpec.devicePaths.empty())
+      return true;
+    struct libinput *ctx = libinput_path_create_context(&kInterface, nullptr);
+    if (!ctx) {
+      AXIDEV_IO_LOG_ERROR(
+          "Listener (Linux/libinput): libinput_path_create_context() failed");
+      return false;
+    }
+    contexts.push_back(ctx);
+    for (const std::string &path : sourcesSpec.devicePaths) {
+      if (!libinput_path_add_device(ctx, path.c_str())) {
+        AXIDEV_IO_LOG_ERROR(
+            "Listener (Linux/libinput): libinput_path_add_device(%s) failed",
+            path.c_str());
+        return false;
       }
-      // small sleep if poll timed out or no events - helps on idle loops
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    return true;
+  }
 
-    // Cleanup
-    if (xkbState) {
-      xkb_state_unref(xkbState);
-      xkbState = nullptr;
+  /**
+   * @internal
+   * @brief Release the per-keyboard states, the xkb keymap and every
+   * libinput context; safe on partially initialized state.
+   */
+  void closeAll(struct udev *udev) {
+    if (layoutWatchFd >= 0) {
+      ::close(layoutWatchFd);
+      layoutWatchFd = -1;
     }
-    if (xkbKeymap) {
-      xkb_keymap_unref(xkbKeymap);
-      xkbKeymap = nullptr;
+    // Devices only hold states once the keymap exists.
+    for (const std::unique_ptr<Device> &device : devices)
+      xkbKeymap->releaseState(device->state);
+    devices.clear();
+    nextDeviceId = 1;
+    xkbKeymap.reset();
+    for (struct libinput *ctx : contexts)
+      libinput_unref(ctx);
+    contexts.clear();
+    if (udev)
+      udev_unref(udev);
+  }
+
+  /**
+   * @internal
+   * @brief Handle every pending event of one libinput context.
+   */
+  void dispatchContext(struct libinput *ctx) {
+    libinput_dispatch(ctx);
+    struct libinput_event *ev;
+    while ((ev = libinput_get_event(ctx))) {
+      struct libinput_device *dev = libinput_event_get_device(ev);
+      switch (libinput_event_get_type(ev)) {
+      case LIBINPUT_EVENT_DEVICE_ADDED:
+        if (libinput_device_has_capability(dev, LIBINPUT_DEVICE_CAP_KEYBOARD))
+          deviceFor(dev);
+        break;
+      case LIBINPUT_EVENT_DEVICE_REMOVED:
+        removeDevice(dev);
+        break;
+      case LIBINPUT_EVENT_KEYBOARD_KEY:
+        if (Device *device = deviceFor(dev))
+          handleKeyEvent(*device, libinput_event_get_keyboard_event(ev));
+        break;
+      default:
+        break;
+      }
+      libinput_event_destroy(ev);
     }
-    if (xkbCtx) {
-      xkb_context_unref(xkbCtx);
-      xkbCtx = nullptr;
+  }
+
+  /**
+   * @internal
+   * @brief Translation state of the keyboard behind @p dev, created on first
+   * use and attached to it as libinput user data.
+   * @return nullptr if no xkb state could be created for it.
+   */
+  Device *deviceFor(struct libinput_device *dev) {
+    if (!dev)
+      return nullptr;
+    if (void *known = libinput_device_get_user_data(dev))
+      return static_cast<Device *>(known);
+
+    struct xkb_state *state = xkbKeymap->newState();
+    if (!state) {
+      AXIDEV_IO_LOG_ERROR("Listener (Linux/libinput): no xkb state for %s",
+                          libinput_device_get_sysname(dev));
+      return nullptr;
     }
-    if (li) {
-      libinput_unref(li);
-      li = nullptr;
+    auto device = std::make_unique<Device>();
+    device->id = nextDeviceId++;
+    device->state = state;
+    device->activeMods = modifiersFromState(state);
+    libinput_device_set_user_data(dev, device.get());
+    AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): keyboard %u is %s (%s)",
+                       device->id, libinput_device_get_name(dev),
+                       libinput_device_get_sysname(dev));
+    devices.push_back(std::move(device));
+    return devices.back().get();
+  }
+
+  /**
+   * @internal
+   * @brief Drop the translation state of a keyboard that went away.
+   */
+  void removeDevice(struct libinput_device *dev) {
+    auto *gone = static_cast<Device *>(libinput_device_get_user_data(dev));
+    if (!gone)
+      return;
+    libinput_device_set_user_data(dev, nullptr);
+    AXIDEV_IO_LOG_INFO("Listener (Linux/libinput): keyboard %u removed",
+                       gone->id);
+    xkbKeymap->releaseState(gone->state);
+    std::erase_if(devices, [gone](const std::unique_ptr<Device> &device) {
+      return device.get() == gone;
+    });
+  }
+
+  /**
+   * @internal
+   * @brief Resolve the xkb mask bit of each tracked modifier once per keymap.
+   *
+   * Looking modifiers up by name costs a string search per call; doing it
+   * here leaves a single `xkb_state_serialize_mods()` per modifier change.
+   * Modifiers the keymap does not define get an empty mask.
+   */
+  void cacheModifierMasks() {
+    static constexpr struct {
+      const char *name;
+      Modifier mod;
+    } kTracked[] = {
+        {XKB_MOD_NAME_SHIFT, Modifier::Shift},
+        {XKB_MOD_NAME_CTRL, Modifier::Ctrl},
+        {XKB_MOD_NAME_ALT, Modifier::Alt},
+        {XKB_MOD_NAME_LOGO, Modifier::Super},
+        {XKB_MOD_NAME_CAPS, Modifier::CapsLock},
+    };
+    static_assert(std::size(kTracked) == std::tuple_size_v<ModifierBits>);
+    for (size_t i = 0; i < std::size(kTracked); ++i) {
+      const xkb_mod_index_t index =
+          xkb_keymap_mod_get_index(xkbKeymap->get(), kTracked[i].name);
+      const xkb_mod_mask_t mask =
+          index < 32 ? (xkb_mod_mask_t{1} << index) : xkb_mod_mask_t{0};
+      modifierBits[i] = {mask, kTracked[i].mod};
     }
-    udev_unref(udev);
+  }
 
-    ready.store(false);
+  /// Translate the effective xkb modifier mask of @p state into our
+  /// Modifier bits.
+  [[nodiscard]] Modifier modifiersFromState(struct xkb_state *state) const {
+    const xkb_mod_mask_t effective =
+        xkb_state_serialize_mods(state, XKB_STATE_MODS_EFFECTIVE);
+    Modifier mods = Modifier::None;
+    for (const ModifierBit &bit : modifierBits) {
+      if ((effective & bit.mask) != 0)
+        mods = mods | bit.mod;
+    }
+    return mods;
   }
 
-  void handleKeyEvent(struct libinput_event_keyboard *kev) {
+  void handleKeyEvent(Device &device, struct libinput_event_keyboard *kev) {
     if (!kev)
       return;
 
@@ -376,105 +748,117 @@ private:
     // libinput provides evdev keycodes; xkbcommon expects keycodes offset by 8
     xkb_keycode_t xkbKey = static_cast<xkb_keycode_t>(keycode + 8);
 
-    // Update xkb state
-    xkb_state_update_key(xkbState, xkbKey, pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
+    // Update the xkb state of this keyboard only, so that modifiers held on
+    // another keyboard do not affect its translation.
+    const enum xkb_state_component changed = xkb_state_update_key(
+        device.state, xkbKey, pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
+
+    // Modifiers are needed first for modifier-aware key resolution. They
+    // are only recomputed when this event actually changed them.
+    if ((changed & XKB_STATE_MODS_EFFECTIVE) != 0)
+      device.activeMods = modifiersFromState(device.state);
+    const Modifier mods = device.activeMods;
+
+    // The xkb state above must see every key; everything below is skipped
+    // for keys the filter does not want.
+    if (!filter.admitsCode(keycode, pressed)) {
+      counters.skip();
+      return;
+    }
 
-    // Extract modifiers via xkb state FIRST (needed for modifier-aware key
-    // resolution)
-    Modifier mods = Modifier::None;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_SHIFT,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Shift;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_CTRL,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Ctrl;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_ALT,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Alt;
-    if (xkb_state_mod_name_is_active(xkbState, XKB_MOD_NAME_LOGO,
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::Super;
-    // CapsLock is typically exposed as the "Lock" modifier name
-    if (xkb_state_mod_name_is_active(xkbState, "Lock",
-                                     XKB_STATE_MODS_EFFECTIVE))
-      mods = mods | Modifier::CapsLock;
-
-    // Determine keysym and unicode codepoint (best-effort)
-    xkb_keysym_t sym = xkb_state_key_get_one_sym(xkbState, xkbKey);
+    // Determine keysym and unicode codepoint (best-effort). The keysym is
+    // only needed for the codepoint or as a fallback for unmapped keys.
+    const bool wantCodepoint = filter.wantsCodepoint();
+    xkb_keysym_t sym = XKB_KEY_NoSymbol;
     char32_t codepoint = 0;
-    if (pressed) {
-      // Compute codepoint for this key on press. Only stash printable
-      // characters (non-control). Control characters (e.g., Enter/Backspace)
-      // should not be delivered as a non-zero cp; they are handled via Key.
-      char32_t cp = static_cast<char32_t>(xkb_keysym_to_utf32(sym));
-      // Treat as printable if >= 0x20 and not DEL (0x7F). This is a simple,
-      // conservative heuristic that covers typical keyboard input.
-      if (cp >= 0x20 && cp != 0x7F) {
-        pendingCodepoints[keycode] = cp;
+    if (wantCodepoint) {
+      sym = xkb_state_key_get_one_sym(device.state, xkbKey);
+      if (pressed) {
+        // Compute codepoint for this key on press. Only stash printable
+        // characters (non-control). Control characters (e.g., Enter or
+        // Backspace) should not be delivered as a non-zero cp; they are
+        // handled via Key.
+        char32_t cp = static_cast<char32_t>(xkb_keysym_to_utf32(sym));
+        // Treat as printable if >= 0x20 and not DEL (0x7F). This is a simple,
+        // conservative heuristic that covers typical keyboard input.
+        if (cp < 0x20 || cp == 0x7F)
+          cp = 0; // Ensure no stale mapping remains for this key
+        setPendingCodepoint(device, keycode, cp);
       } else {
-        // Ensure no stale mapping remains for this key
-        auto it = pendingCodepoints.find(keycode);
-        if (it != pendingCodepoints.end())
-          pendingCodepoints.erase(it);
-      }
-    } else {
-      // Deliver any codepoint we previously computed at press time for this
-      // key. This ensures callbacks observing only key-release events still
-      // receive the character that was generated when the key was pressed.
-      auto it = pendingCodepoints.find(keycode);
-      if (it != pendingCodepoints.end()) {
-        codepoint = it->second;
-        pendingCodepoints.erase(it);
-      } else {
-        codepoint = 0;
+        // Deliver any codepoint we previously computed at press time for
+        // this key. This ensures callbacks observing only key-release events
+        // still receive the character that was generated when the key was
+        // pressed.
+        codepoint = takePendingCodepoint(device, keycode);
       }
     }
 
     // Use modifier-aware key resolution to get the correct logical key
     // based on the evdev keycode and active modifiers.
-    Key mapped = detail::resolveKeyFromEvdevAndMods(linuxKeyMap, keycode, mods);
+    Key mapped =
+        detail::resolveKeyFromEvdevAndMods(*linuxKeyMap, keycode, mods);
 
     // Fall back to keysym-based mapping if modifier-aware lookup didn't find
     // anything
     if (mapped == Key::Unknown) {
+      if (sym == XKB_KEY_NoSymbol)
+        sym = xkb_state_key_get_one_sym(device.state, xkbKey);
       mapped = mapKeysymToKey(sym);
     }
 
+    if (!filter.admits(KeyWithModifier(mapped, mods))) {
+      counters.skip();
+      return;
+    }
+
     // For letter and number keys, derive the codepoint from the Key enum
     // rather than trusting xkb_keysym_to_utf32. This ensures consistent output
     // regardless of keyboard layout mismatches between keymap initialization
     // and event delivery (e.g., AZERTY vs QWERTY).
     // Only override when Shift is not pressed (to get lowercase letters).
-    if (mapped != Key::Unknown && !hasModifier(mods, Modifier::Shift)) {
+    if (wantCodepoint && mapped != Key::Unknown &&
+        !hasModifier(mods, Modifier::Shift)) {
       char32_t derivedCp = codepointFromKey(mapped);
       if (derivedCp != 0) {
         codepoint = derivedCp;
         // Update pendingCodepoints for release event consistency
         if (pressed) {
-          pendingCodepoints[keycode] = derivedCp;
+          setPendingCodepoint(device, keycode, derivedCp);
         }
       }
     }
 
-    // Copy/dispatch callback under lock
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
-    }
-    if (cbCopy)
-      cbCopy(codepoint, KeyWithModifier(mapped, mods), pressed);
+    // Dispatch without locking or copying: the callback is immutable while
+    // the worker runs. libinput stamps events with CLOCK_MONOTONIC, which is
+    // also what std::chrono::steady_clock reads on Linux.
+    Event ev;
+    ev.codepoint = codepoint;
+    ev.keyMod = KeyWithModifier(mapped, mods);
+    ev.pressed = pressed;
+    ev.osTimestampNs = libinput_event_keyboard_get_time_usec(kev) * 1000;
+    ev.deviceId = device.id;
+    counters.dispatch(callback, ev);
 
     // Debug logging
-    {
-      std::string kname = keyToString(mapped);
-      AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput) %s: evdev=%u keysym=%u "
-                        "key=%s cp=%u mods=0x%02x",
-                        pressed ? "press" : "release", keycode,
-                        static_cast<unsigned>(sym), kname.c_str(),
+    AXIDEV_IO_LOG_DEBUG("Listener (Linux/libinput) %s: device=%u evdev=%u "
+                        "keysym=%u key=%s cp=%u mods=0x%02x",
+                        pressed ? "press" : "release", device.id, keycode,
+                        static_cast<unsigned>(sym),
+                        keyToStringView(mapped).data(),
                         static_cast<unsigned>(codepoint),
                         static_cast<int>(static_cast<uint8_t>(mods)));
-    }
+  }
+
+  static void setPendingCodepoint(Device &device, uint32_t keycode,
+                                  char32_t cp) {
+    if (keycode < device.pendingCodepoints.size())
+      device.pendingCodepoints[keycode] = cp;
+  }
+
+  static char32_t takePendingCodepoint(Device &device, uint32_t keycode) {
+    if (keycode >= device.pendingCodepoints.size())
+      return 0;
+    return std::exchange(device.pendingCodepoints[keycode], 0);
   }
 
   Key mapKeysymToKey(xkb_keysym_t sym) {
@@ -484,7 +868,7 @@ private:
 
     char name[64] = {0};
     if (xkb_keysym_get_name(sym, name, sizeof(name)) > 0) {
-      Key fallback = stringToKey(std::string(name));
+      Key fallback = stringToKey(name);
       if (fallback != Key::Unknown)
         return fallback;
     }
@@ -495,20 +879,48 @@ private:
   std::thread worker;
   std::atomic_bool running{false};
   std::atomic_bool ready{false};
-  std::mutex cbMutex;
-  Callback callback;
-
-  // Store unicode codepoints computed at key-press time so they can be
-  // delivered on key-release events.
-  std::unordered_map<uint32_t, char32_t> pendingCodepoints;
+  // Signalled by reportStartup(); start() waits on it instead of polling.
+  static constexpr std::chrono::milliseconds kStartTimeout{200};
+  std::mutex readyMutex;
+  std::condition_variable readyCv;
+  int wakeFd{-1};
+  std::mutex startMutex;
+  detail::PublishedCallback<EventCallback> callback;
+  detail::ListenerStats counters;
+  // Filter set through setFilter(), and its form compiled for the keymap.
+  Filter filterSpec;
+  detail::KeyFilter filter;
+  // Seats and device nodes set through setSources().
+  Sources sourcesSpec;
+
+  // Keyboards seen during the current session, and the next id to assign.
+  std::vector<std::unique_ptr<Device>> devices;
+  uint32_t nextDeviceId{1};
 
   // Full keymap for modifier-aware key resolution
-  detail::LinuxKeyMap linuxKeyMap;
-
-  struct libinput *li = nullptr;
-  struct xkb_context *xkbCtx = nullptr;
-  struct xkb_keymap *xkbKeymap = nullptr;
-  struct xkb_state *xkbState = nullptr;
+  std::shared_ptr<const detail::LinuxKeyMap> linuxKeyMap;
+  // `xkbLayoutKey()` of the layout in use, and the last layout published by
+  // `linuxLayoutTracker()` that was adopted.
+  std::string layoutKey;
+  detail::LayoutSubscription layoutUpdates;
+  // inotify watch of the layout configuration (see openLayoutWatch()).
+  static constexpr const char *kLayoutConfigDir = "/etc/default";
+  static constexpr const char *kLayoutConfigFile = "keyboard";
+  int layoutWatchFd{-1};
+
+  // xkb mask bit of each tracked modifier (see cacheModifierMasks()).
+  struct ModifierBit {
+    xkb_mod_mask_t mask{0};
+    Modifier mod{Modifier::None};
+  };
+  using ModifierBits = std::array<ModifierBit, 5>;
+  ModifierBits modifierBits{};
+
+  // One udev context per seat, then the path context if devices were given.
+  std::vector<struct libinput *> contexts;
+  // Keymap every keyboard's state was created from: compiled at startup,
+  // then the one published with each adopted layout.
+  std::shared_ptr<const detail::SharedXkbKeymap> xkbKeymap;
 };
 
 // Public wrappers
@@ -519,6 +931,19 @@ Listener &Listener::operator=(Listener &&) noexcept = default;
 
 bool Listener::start(Callback cb) {
   AXIDEV_IO_LOG_DEBUG("Listener::start() called (Linux/libinput)");
+  return m_impl ? m_impl->start(detail::adaptCallback(std::move(cb))) : false;
+}
+
+bool Listener::setFilter(Filter filter) {
+  return m_impl ? m_impl->setFilter(std::move(filter)) : false;
+}
+
+bool Listener::setSources(Sources sources) {
+  return m_impl ? m_impl->setSources(std::move(sources)) : false;
+}
+
+bool Listener::startWithEvents(EventCallback cb) {
+  AXIDEV_IO_LOG_DEBUG("Listener::startWithEvents() called (Linux/libinput)");
   return m_impl ? m_impl->start(std::move(cb)) : false;
 }
 
@@ -533,6 +958,15 @@ bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
 
+Listener::Stats Listener::stats() const {
+  return m_impl ? m_impl->stats().snapshot(droppedEvents()) : Stats{};
+}
+
+void Listener::resetStats() {
+  if (m_impl)
+    m_impl->stats().reset();
+}
+
 } // namespace axidev::io::keyboard
 
 #endif // __linux__
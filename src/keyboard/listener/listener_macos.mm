@@ -13,17 +13,24 @@
 #include <ApplicationServices/ApplicationServices.h>
 #include <Carbon/Carbon.h>
 #import <Foundation/Foundation.h>
+#include <mach/mach_time.h>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <axidev-io/log.hpp>
-#include <unordered_map>
 
 #include "keyboard/common/macos_keymap.hpp"
+#include "keyboard/common/published_callback.hpp"
+#include "keyboard/listener/listener_filter.hpp"
+#include "keyboard/listener/listener_queue.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+#include "keyboard/listener/release_tracker.hpp"
 
 namespace axidev::io::keyboard {
 
@@ -50,7 +57,9 @@ Modifier flagsToModifier(CGEventFlags flags) {
   return mods;
 }
 
-static bool output_debug_enabled() { return ::axidev::io::log::debugEnabled(); }
+static bool output_debug_enabled() {
+  return AXIDEV_IO_LOG_ENABLED(::axidev::io::log::Level::Debug);
+}
 
 /**
  * @brief Derive the canonical lowercase codepoint for a Key enum value.
@@ -92,39 +101,49 @@ struct Listener::Impl {
 
   ~Impl() { stop(); }
 
-  bool start(Callback cb) {
-    std::lock_guard<std::mutex> lk(cbMutex);
+  bool start(EventCallback cb) {
+    std::lock_guard<std::mutex> lk(startMutex);
     if (running.load())
       return false;
+    if (worker.joinable())
+      worker.join();
     AXIDEV_IO_LOG_INFO("Listener (macOS): start requested");
-    callback = std::move(cb);
+    // Published before the run loop thread exists; the tap reads it lock-free.
+    callback.publish(std::move(cb));
+    counters.reset();
+    filter = ::axidev::io::keyboard::detail::KeyFilter(
+        filterSpec, keyMap->codeToKey, keyMap->codeAndModsToKey);
     running.store(true);
     ready.store(false);
     worker = std::thread([this]() { threadMain(); });
 
-    // Wait briefly for successful startup (event tap installed) or failure.
-    for (int i = 0; i < 40; ++i) {
-      if (!running.load())
-        return false;
-      if (ready.load())
-        return true;
-      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    // Wait for successful startup (event tap installed) or failure.
+    bool ok = false;
+    {
+      std::unique_lock<std::mutex> lock(readyMutex);
+      readyCv.wait_for(lock, kStartTimeout,
+                       [this] { return ready.load() || !running.load(); });
+      ok = ready.load();
     }
-    bool ok = ready.load();
     AXIDEV_IO_LOG_DEBUG("Listener (macOS): start result=%u",
                       static_cast<unsigned>(ok));
+    // A failed or timed-out start leaves no worker behind.
+    if (!ok)
+      stop();
     return ok;
   }
 
   void stop() {
-    if (!running.load())
+    // A worker whose tap failed has already cleared `running` but still
+    // needs to be joined.
+    if (!running.load() && !worker.joinable())
       return;
     AXIDEV_IO_LOG_INFO("Listener (macOS): stop requested");
     running.store(false);
 
     // Stop the CFRunLoop (may be called from another thread)
-    if (runLoop != nullptr) {
-      CFRunLoopStop(runLoop);
+    if (CFRunLoopRef loop = runLoop.load()) {
+      CFRunLoopStop(loop);
     }
 
     if (worker.joinable())
@@ -140,17 +159,38 @@ struct Listener::Impl {
       CFRelease(runLoopSource);
       runLoopSource = nullptr;
     }
-    runLoop = nullptr;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = nullptr;
-    }
+    runLoop.store(nullptr);
+    callback.retire();
     AXIDEV_IO_LOG_INFO("Listener (macOS): stopped");
   }
 
   bool isRunning() const { return running.load(); }
 
+  /// Store the filter compiled by the next start(); false while running.
+  bool setFilter(Filter spec) {
+    std::lock_guard<std::mutex> lk(startMutex);
+    if (running.load())
+      return false;
+    filterSpec = std::move(spec);
+    return true;
+  }
+
+  /// Event counters reported by `Listener::stats()`.
+  ::axidev::io::keyboard::detail::ListenerStats &stats() { return counters; }
+
 private:
+  // Publish the outcome of the tap installation and wake start(). A failure
+  // also ends the listener.
+  void reportStartup(bool ok) {
+    {
+      std::lock_guard<std::mutex> lock(readyMutex);
+      if (!ok)
+        running.store(false);
+      ready.store(ok);
+    }
+    readyCv.notify_all();
+  }
+
   // Thread main installs an event tap and runs a CFRunLoop to receive events.
   void threadMain() {
     // Create an event mask for key down + key up
@@ -164,8 +204,7 @@ private:
                                 &Impl::eventTapCallback, this);
     if (eventTap == nullptr) {
       // Failed to create event tap -> nothing we can do here
-      running.store(false);
-      ready.store(false);
+      reportStartup(false);
       AXIDEV_IO_LOG_ERROR("Listener (macOS): failed to create CGEventTap. Input "
                         "Monitoring permission may be missing.");
       return;
@@ -179,17 +218,31 @@ private:
     // Enable the tap
     CGEventTapEnable(eventTap, true);
 
+    // Store the run loop so `stop` can stop it from another thread, before
+    // start() can give up waiting and call it.
+    runLoop.store(CFRunLoopGetCurrent());
+
     // Signal successful initialization and optionally log
-    ready.store(true);
+    reportStartup(true);
     AXIDEV_IO_LOG_INFO("Listener (macOS): event tap created and enabled");
 
-    // Store the run loop so `stop` can stop it from another thread
-    runLoop = CFRunLoopGetCurrent();
+    // Input source switches are delivered on this run loop; the tracker
+    // rebuilds the mappings off it.
+    CFNotificationCenterAddObserver(
+        CFNotificationCenterGetDistributedCenter(), this,
+        &Impl::inputSourceChanged,
+        kTISNotifySelectedKeyboardInputSourceChanged, nullptr,
+        CFNotificationSuspensionBehaviorDeliverImmediately);
 
-    // Run the loop until stop() calls CFRunLoopStop()
-    CFRunLoopRun();
+    // Run the loop until stop() calls CFRunLoopStop(), unless a stop()
+    // already came in.
+    if (running.load())
+      CFRunLoopRun();
 
     // Clean up (some cleanup is also done in stop())
+    CFNotificationCenterRemoveObserver(
+        CFNotificationCenterGetDistributedCenter(), this,
+        kTISNotifySelectedKeyboardInputSourceChanged, nullptr);
     if (eventTap) {
       CGEventTapEnable(eventTap, false);
       CFRelease(eventTap);
@@ -199,7 +252,26 @@ private:
       CFRelease(runLoopSource);
       runLoopSource = nullptr;
     }
-    runLoop = nullptr;
+    runLoop.store(nullptr);
+  }
+
+  // Input source notification (invoked on the run loop thread)
+  static void inputSourceChanged(CFNotificationCenterRef, void *,
+                                 CFNotificationName, const void *,
+                                 CFDictionaryRef) {
+    AXIDEV_IO_LOG_INFO("Listener (macOS): input source changed");
+    ::axidev::io::keyboard::detail::macOSLayoutTracker().notifyChanged();
+  }
+
+  // Adopt the mappings the tracker published since the last event, if any.
+  // Costs one atomic load when nothing was published.
+  void syncLayout() {
+    if (!layoutUpdates.refresh(
+            ::axidev::io::keyboard::detail::macOSLayoutTracker(), keyMap))
+      return;
+    filter = ::axidev::io::keyboard::detail::KeyFilter(
+        filterSpec, keyMap->codeToKey, keyMap->codeAndModsToKey);
+    AXIDEV_IO_LOG_INFO("Listener (macOS): switched to the new layout");
   }
 
   // Event tap callback (invoked on the run loop thread)
@@ -222,13 +294,23 @@ private:
     bool pressed = (type == kCGEventKeyDown);
     CGKeyCode keyCode = static_cast<CGKeyCode>(
         CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode));
+    self->syncLayout();
+
+    // Keys the filter does not want pass through before any translation.
+    if (!self->filter.admitsCode(keyCode, pressed)) {
+      self->counters.skip();
+      return event;
+    }
+    const bool wantCodepoint = self->filter.wantsCodepoint();
 
     // Unicode extraction - macOS gives us UTF-16 UniChar sequences
     std::array<UniChar, 4> uniBuf{};
     UniCharCount actualLen = 0;
-    CGEventKeyboardGetUnicodeString(event,
-                                    static_cast<UniCharCount>(uniBuf.size()),
-                                    &actualLen, uniBuf.data());
+    if (wantCodepoint) {
+      CGEventKeyboardGetUnicodeString(event,
+                                      static_cast<UniCharCount>(uniBuf.size()),
+                                      &actualLen, uniBuf.data());
+    }
 
     char32_t codepoint = 0;
     if (actualLen > 0) {
@@ -252,9 +334,8 @@ private:
 
     // Map CGKeyCode to our Key enum
     Key mapped = Key::Unknown;
-    auto it = self->keyMap.codeToKey.find(keyCode);
-    if (it != self->keyMap.codeToKey.end()) {
-      mapped = it->second;
+    if (const Key *base = self->keyMap->codeToKey.find(keyCode)) {
+      mapped = *base;
     }
 
     // Modifiers
@@ -266,7 +347,7 @@ private:
     // to Key::Exclamation.
     Key modifierAwareKey =
         ::axidev::io::keyboard::detail::resolveKeyFromCodeAndMods(
-            self->keyMap, keyCode, mods);
+            *self->keyMap, keyCode, mods);
     if (modifierAwareKey != Key::Unknown) {
       // Use the modifier-aware key, but keep the base key in 'mapped' for
       // control/navigation keys where we want the physical key identity.
@@ -276,17 +357,24 @@ private:
             "Listener (macOS): modifier-aware resolution: keycode=%u "
             "mods=0x%02X -> Key::%s (base was Key::%s)",
             static_cast<unsigned>(keyCode), static_cast<unsigned>(mods),
-            keyToString(modifierAwareKey).c_str(), keyToString(mapped).c_str());
+            keyToStringView(modifierAwareKey).data(),
+            keyToStringView(mapped).data());
         mapped = modifierAwareKey;
       }
     }
 
+    if (!self->filter.admits(KeyWithModifier(mapped, mods))) {
+      self->counters.skip();
+      return event;
+    }
+
     // For letter and number keys, derive the codepoint from the Key enum
     // rather than trusting CGEventKeyboardGetUnicodeString. This ensures
     // consistent output regardless of keyboard layout mismatches between
     // keymap initialization and event delivery (e.g., AZERTY vs QWERTY).
     // Only override when Shift is not pressed (to get lowercase letters).
-    if (mapped != Key::Unknown && !hasModifier(mods, Modifier::Shift)) {
+    if (wantCodepoint && mapped != Key::Unknown &&
+        !hasModifier(mods, Modifier::Shift)) {
       char32_t derivedCp = codepointFromKey(mapped);
       if (derivedCp != 0) {
         codepoint = derivedCp;
@@ -309,55 +397,29 @@ private:
     //  2) In some cases the release event does not contain a Unicode string
     //     (actualLen == 0) while the corresponding press did. Cache the last
     //     press codepoint and use it as a fallback for the release.
-    static constexpr std::chrono::milliseconds kReleaseDebounceMs{50};
-
     if (pressed) {
       // On press, remember the unicode output (if any) for potential use on
-      // the paired release event.
-      if (codepoint != 0) {
-        self->lastPressCp[keyCode] = codepoint;
-      } else {
-        // Clear any stale entry for this keycode when press does not produce
-        // a unicode character (e.g., modifiers).
-        self->lastPressCp.erase(keyCode);
-      }
+      // the paired release event. A press without one (e.g. a modifier)
+      // clears any stale entry for this keycode.
+      self->releases.press(keyCode, codepoint);
     } else {
-      // On release, debounce rapid duplicates coming from the system.
-      auto now = std::chrono::steady_clock::now();
-      auto rtIt = self->lastReleaseTime.find(keyCode);
-      auto sigIt = self->lastReleaseSig.find(keyCode);
-      if (rtIt != self->lastReleaseTime.end() &&
-          sigIt != self->lastReleaseSig.end()) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - rtIt->second);
-        if (elapsed < kReleaseDebounceMs && sigIt->second.first == codepoint &&
-            sigIt->second.second == mods) {
-          if (output_debug_enabled()) {
-            std::string kname = keyToString(mapped);
-            AXIDEV_IO_LOG_DEBUG(
-                "Listener (macOS): ignoring duplicate release (same cp+mods) "
-                "for keycode=%u key=%s cp=%u mods=%u",
-                (unsigned)keyCode, kname.c_str(), (unsigned)codepoint,
-                (unsigned)mods);
-          }
-          // Update timestamp & signature so subsequent quick duplicates remain
-          // debounced.
-          self->lastReleaseTime[keyCode] = now;
-          self->lastReleaseSig[keyCode] = std::make_pair(codepoint, mods);
-          return event;
-        }
+      // On release, debounce rapid duplicates coming from the system. The
+      // release is recorded either way, so quick repeats stay debounced.
+      if (self->releases.release(keyCode, codepoint, mods,
+                                 std::chrono::steady_clock::now())) {
+        AXIDEV_IO_LOG_DEBUG(
+            "Listener (macOS): ignoring duplicate release (same cp+mods) "
+            "for keycode=%u key=%s cp=%u mods=%u",
+            (unsigned)keyCode, keyToStringView(mapped).data(),
+            (unsigned)codepoint, (unsigned)mods);
+        return event;
       }
-      // Not a duplicate matching the last cp+mods -> record the new
-      // signature/time.
-      self->lastReleaseTime[keyCode] = now;
-      self->lastReleaseSig[keyCode] = std::make_pair(codepoint, mods);
 
       // If the release lacks a unicode string, fall back to the cached press
       // codepoint for this keycode (if available).
       if (codepoint == 0) {
-        auto cpIt = self->lastPressCp.find(keyCode);
-        if (cpIt != self->lastPressCp.end()) {
-          codepoint = cpIt->second;
+        if (const char32_t pressCp = self->releases.pressCodepoint(keyCode)) {
+          codepoint = pressCp;
           if (output_debug_enabled()) {
             AXIDEV_IO_LOG_DEBUG("Listener (macOS): using last-press cp=%u for "
                               "release keycode=%u",
@@ -369,75 +431,77 @@ private:
 
       // We've handled the release, clear the cached press codepoint so we
       // don't accidentally reuse it for future, unrelated events.
-      self->lastPressCp.erase(keyCode);
+      self->releases.press(keyCode, 0);
     }
 
-    // Invoke user callback outside the lock
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(self->cbMutex);
-      cbCopy = self->callback;
-    }
-    if (cbCopy) {
-      cbCopy(static_cast<char32_t>(codepoint), KeyWithModifier(mapped, mods),
-             pressed);
-    }
+    // Invoke user callback without locking or copying it
+    Event ev;
+    ev.codepoint = static_cast<char32_t>(codepoint);
+    ev.keyMod = KeyWithModifier(mapped, mods);
+    ev.pressed = pressed;
+    ev.osTimestampNs = machTicksToNs(CGEventGetTimestamp(event));
+    self->counters.dispatch(self->callback, ev);
 
-    {
-      std::string kname = keyToString(mapped);
-      AXIDEV_IO_LOG_DEBUG("Listener (macOS) %s: keycode=%u key=%s cp=%u mods=%u",
+    AXIDEV_IO_LOG_DEBUG("Listener (macOS) %s: keycode=%u key=%s cp=%u mods=%u",
                         pressed ? "press" : "release", (unsigned)keyCode,
-                        kname.c_str(), (unsigned)codepoint, (unsigned)mods);
-    }
+                        keyToStringView(mapped).data(), (unsigned)codepoint,
+                        (unsigned)mods);
 
     // Let the event pass through unchanged
     return event;
   }
 
-  // Build key map using the same discovery logic used by the InputBackend on
-  // macOS. Store the full key map so we can use modifier-aware key resolution.
+  // Take the key map shared with the Sender on macOS (built on first use).
+  // Keep the full key map so we can use modifier-aware key resolution.
   void initKeyMap() {
-    keyMap = ::axidev::io::keyboard::detail::initMacOSKeyMap();
+    keyMap = ::axidev::io::keyboard::detail::acquireMacOSKeyMap();
   }
 
-  // Safely invoke user callback
-  void invokeCallback(char32_t cp, KeyWithModifier keyMod, bool pressed) {
-    Callback cbCopy;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
-    }
-    if (cbCopy) {
-      cbCopy(cp, keyMod, pressed);
-    }
+  // CGEventGetTimestamp() counts mach_absolute_time() ticks, the same clock
+  // std::chrono::steady_clock reads (as nanoseconds) on macOS.
+  static uint64_t machTicksToNs(uint64_t ticks) {
+    static const mach_timebase_info_data_t timebase = [] {
+      mach_timebase_info_data_t tb{};
+      mach_timebase_info(&tb);
+      return tb;
+    }();
+    if (timebase.numer == timebase.denom)
+      return ticks;
+    return static_cast<uint64_t>(static_cast<__uint128_t>(ticks) *
+                                 timebase.numer / timebase.denom);
   }
 
   std::thread worker;
   std::atomic_bool running;
   std::atomic<bool> ready{false};
-  Callback callback;
-  std::mutex cbMutex;
+  // Signalled by reportStartup(); start() waits on it instead of polling.
+  static constexpr std::chrono::milliseconds kStartTimeout{200};
+  std::mutex readyMutex;
+  std::condition_variable readyCv;
+  ::axidev::io::keyboard::detail::PublishedCallback<EventCallback> callback;
+  ::axidev::io::keyboard::detail::ListenerStats counters;
+  std::mutex startMutex;
+  // Filter set through setFilter(), and its form compiled in start().
+  Filter filterSpec;
+  ::axidev::io::keyboard::detail::KeyFilter filter;
 
   // CF / CG resources on the run loop thread
   CFMachPortRef eventTap;
   CFRunLoopSourceRef runLoopSource;
-  CFRunLoopRef runLoop;
-
-  // Full key map for modifier-aware key resolution
-  ::axidev::io::keyboard::detail::MacOSKeyMap keyMap;
-
-  // Last-seen unicode codepoint for keycodes (press -> release fallback).
-  // Some macOS configurations produce keyup events without a Unicode string
-  // while the corresponding keydown contained the character. We cache the
-  // last press codepoint per keycode so releases can fall back to it.
-  std::unordered_map<CGKeyCode, char32_t> lastPressCp;
-
-  // Timestamp of the last release seen for a given keycode. Used to debounce
-  // duplicate release events which can otherwise cause repeated characters in
-  // the observed output.
-  std::unordered_map<CGKeyCode, std::chrono::steady_clock::time_point>
-      lastReleaseTime;
-  std::unordered_map<CGKeyCode, std::pair<char32_t, Modifier>> lastReleaseSig;
+  std::atomic<CFRunLoopRef> runLoop;
+
+  // Full key map for modifier-aware key resolution, and the last layout
+  // published by `macOSLayoutTracker()` that was adopted.
+  std::shared_ptr<const ::axidev::io::keyboard::detail::MacOSKeyMap> keyMap;
+  ::axidev::io::keyboard::detail::LayoutSubscription layoutUpdates;
+
+  // Last-seen unicode codepoint per keycode (press -> release fallback) and
+  // the last release of each keycode. Some macOS configurations produce
+  // keyup events without a Unicode string while the corresponding keydown
+  // contained the character, and some deliver a release twice, which would
+  // otherwise cause repeated characters in the observed output. Indexed by
+  // keycode, so the event tap never allocates.
+  ::axidev::io::keyboard::detail::ReleaseTracker<256> releases;
 };
 
 // OutputListener public wrappers
@@ -446,6 +510,22 @@ Listener::~Listener() { stop(); }
 Listener::Listener(Listener &&) noexcept = default;
 Listener &Listener::operator=(Listener &&) noexcept = default;
 bool Listener::start(Callback cb) {
+  return m_impl ? m_impl->start(detail::adaptCallback(std::move(cb))) : false;
+}
+bool Listener::setFilter(Filter filter) {
+  return m_impl ? m_impl->setFilter(std::move(filter)) : false;
+}
+bool Listener::setSources(Sources sources) {
+  // macOS has a single system-wide keyboard stream; only the default
+  // sources describe it.
+  if (!sources.seats.empty() || !sources.devicePaths.empty()) {
+    AXIDEV_IO_LOG_WARN("Listener (macOS): seats and device paths are only "
+                       "supported on Linux");
+    return false;
+  }
+  return m_impl && !m_impl->isRunning();
+}
+bool Listener::startWithEvents(EventCallback cb) {
   return m_impl ? m_impl->start(std::move(cb)) : false;
 }
 void Listener::stop() {
@@ -455,6 +535,13 @@ void Listener::stop() {
 bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
+Listener::Stats Listener::stats() const {
+  return m_impl ? m_impl->stats().snapshot(droppedEvents()) : Stats{};
+}
+void Listener::resetStats() {
+  if (m_impl)
+    m_impl->stats().reset();
+}
 
 } // namespace axidev::io::keyboard
 
@@ -0,0 +1,246 @@
+/**
+ * @file keyboard/listener/listener_queue.cpp
+ * @brief Queued-mode support for axidev::io::keyboard::Listener.
+ *
+ * Implements the SPSC event queue used by `Listener::startQueued()` and the
+ * platform-independent public queued-mode entry points. Backends are
+ * unchanged: queued mode is a regular `startWithEvents()` whose callback only
+ * copies the event, already timestamped, into the ring.
+ */
+
+#include "keyboard/listener/listener_queue.hpp"
+
+#include <axidev-io/log.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+#endif
+
+namespace axidev::io::keyboard {
+
+Listener::Queue::Queue(size_t capacity) : ring(capacity) {
+#if defined(_WIN32)
+  event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (event == nullptr) {
+    AXIDEV_IO_LOG_WARN("Listener queue: CreateEvent failed (error=%lu)",
+                       static_cast<unsigned long>(GetLastError()));
+  }
+#elif defined(__linux__)
+  readFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  writeFd = readFd;
+  if (readFd < 0) {
+    AXIDEV_IO_LOG_WARN("Listener queue: eventfd() failed: %s",
+                       strerror(errno));
+  }
+#else
+  int fds[2] = {-1, -1};
+  if (pipe(fds) == 0) {
+    for (int fd : fds) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    readFd = fds[0];
+    writeFd = fds[1];
+  } else {
+    AXIDEV_IO_LOG_WARN("Listener queue: pipe() failed: %s", strerror(errno));
+  }
+#endif
+}
+
+Listener::Queue::~Queue() {
+#if defined(_WIN32)
+  if (event != nullptr)
+    CloseHandle(event);
+#else
+  if (writeFd >= 0 && writeFd != readFd)
+    close(writeFd);
+  if (readFd >= 0)
+    close(readFd);
+#endif
+}
+
+void Listener::Queue::push(const Event &ev) noexcept {
+  if (!ring.tryPush(ev)) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Only the empty-to-pending edge needs a syscall; later pushes piggyback
+  // on the already raised signal until the consumer drains.
+  if (!signaled.exchange(true, std::memory_order_acq_rel))
+    raiseSignal();
+}
+
+size_t Listener::Queue::drain(Event *out, size_t maxCount) noexcept {
+  // Reset before popping: anything pushed after this point raises the signal
+  // again, anything pushed before it is visible to popBulk().
+  if (signaled.exchange(false, std::memory_order_acq_rel))
+    resetSignal();
+
+  size_t n = ring.popBulk(out, maxCount);
+
+  // The caller's buffer was too small to take everything; keep waiters awake.
+  if (!ring.empty() && !signaled.exchange(true, std::memory_order_acq_rel))
+    raiseSignal();
+  return n;
+}
+
+bool Listener::Queue::wait(uint32_t timeoutMs) {
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point deadline =
+      Clock::now() + std::chrono::milliseconds(timeoutMs);
+  uint32_t remainingMs = timeoutMs;
+  while (ring.empty()) {
+    // Checked on every pass: wake() raises the signal only after setting the
+    // flag, so a wake consumed by the reset below is still seen here.
+    if (woken.exchange(false, std::memory_order_acq_rel))
+      return false;
+    if (!waitSignal(remainingMs))
+      return false;
+    if (!ring.empty())
+      break;
+    // drain() popped events pushed after it reset the signal, leaving the
+    // signal raised over an empty ring: clear it as drain() does and wait on.
+    if (signaled.exchange(false, std::memory_order_acq_rel))
+      resetSignal();
+    if (!ring.empty()) {
+      if (!signaled.exchange(true, std::memory_order_acq_rel))
+        raiseSignal();
+      break;
+    }
+    if (timeoutMs != kWaitInfinite) {
+      const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+          deadline - Clock::now());
+      if (left.count() <= 0)
+        return false;
+      remainingMs = static_cast<uint32_t>(left.count());
+    }
+  }
+  return true;
+}
+
+void Listener::Queue::wake() noexcept {
+  woken.store(true, std::memory_order_release);
+  if (!signaled.exchange(true, std::memory_order_acq_rel))
+    raiseSignal();
+}
+
+bool Listener::Queue::waitSignal(uint32_t timeoutMs) {
+#if defined(_WIN32)
+  if (event == nullptr)
+    return false;
+  DWORD res = WaitForSingleObject(
+      event, timeoutMs == kWaitInfinite ? INFINITE : timeoutMs);
+  return res == WAIT_OBJECT_0;
+#else
+  if (readFd < 0)
+    return false;
+  int timeout = timeoutMs == kWaitInfinite
+                    ? -1
+                    : static_cast<int>(std::min<uint32_t>(timeoutMs, INT_MAX));
+  struct pollfd pfd = {.fd = readFd, .events = POLLIN, .revents = 0};
+  int ret;
+  do {
+    ret = ::poll(&pfd, 1, timeout);
+  } while (ret < 0 && errno == EINTR);
+  return ret > 0 && (pfd.revents & POLLIN);
+#endif
+}
+
+intptr_t Listener::Queue::handle() const noexcept {
+#if defined(_WIN32)
+  return event != nullptr ? reinterpret_cast<intptr_t>(event) : -1;
+#else
+  return readFd;
+#endif
+}
+
+void Listener::Queue::raiseSignal() noexcept {
+#if defined(_WIN32)
+  if (event != nullptr)
+    SetEvent(event);
+#else
+  if (writeFd < 0)
+    return;
+#if defined(__linux__)
+  uint64_t one = 1;
+  while (::write(writeFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+  }
+#else
+  char one = 1;
+  while (::write(writeFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+  }
+#endif
+#endif
+}
+
+void Listener::Queue::resetSignal() noexcept {
+#if defined(_WIN32)
+  if (event != nullptr)
+    ResetEvent(event);
+#else
+  if (readFd < 0)
+    return;
+  char buf[64];
+  while (true) {
+    ssize_t n = ::read(readFd, buf, sizeof(buf));
+    if (n < 0 && errno == EINTR)
+      continue;
+    // eventfd resets fully in one read; a pipe is read until it would block.
+    if (n <= 0 || readFd == writeFd)
+      break;
+  }
+#endif
+}
+
+// Public queued-mode wrappers
+
+bool Listener::startQueued(size_t capacity) {
+  AXIDEV_IO_LOG_DEBUG("Listener::startQueued() called (capacity=%zu)",
+                      capacity);
+  if (!m_impl || isListening())
+    return false;
+
+  // Safe to replace: no backend thread is running, so nothing can still be
+  // pushing into the previous queue.
+  m_queue = std::make_unique<Queue>(capacity);
+  Queue *queue = m_queue.get();
+  return startWithEvents([queue](const Event &ev) { queue->push(ev); });
+}
+
+size_t Listener::poll(std::span<Event> out) {
+  if (!m_queue || out.empty())
+    return 0;
+  return m_queue->drain(out.data(), out.size());
+}
+
+bool Listener::waitForEvents(uint32_t timeoutMs) {
+  return m_queue ? m_queue->wait(timeoutMs) : false;
+}
+
+void Listener::wakeWaiter() {
+  if (m_queue)
+    m_queue->wake();
+}
+
+intptr_t Listener::eventWaitHandle() const {
+  return m_queue ? m_queue->handle() : -1;
+}
+
+uint64_t Listener::droppedEvents() const {
+  return m_queue ? m_queue->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace axidev::io::keyboard
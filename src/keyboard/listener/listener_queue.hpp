@@ -0,0 +1,75 @@
+#pragma once
+/**
+ * @file keyboard/listener/listener_queue.hpp
+ * @brief Internal event queue backing `Listener::startQueued()`.
+ *
+ * Every listener backend includes this header so that `Listener`'s special
+ * members (defined per backend) see the complete `Listener::Queue` type. The
+ * implementation is platform-independent apart from the wait handle and lives
+ * in `listener_queue.cpp`.
+ */
+
+#include <axidev-io/keyboard/listener.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "keyboard/common/spsc_ring.hpp"
+
+namespace axidev::io::keyboard {
+
+/**
+ * @internal
+ * @brief SPSC event ring plus a waitable readiness signal.
+ *
+ * The producer is the backend's event thread (hook, event tap or libinput
+ * worker); it only copies the event into the ring and, on an empty-to-pending
+ * transition, raises the native signal. The consumer resets the signal before
+ * draining and re-raises it when it leaves events behind, so a waiter never
+ * sleeps while events are pending.
+ */
+struct Listener::Queue {
+  explicit Queue(size_t capacity);
+  ~Queue();
+
+  Queue(const Queue &) = delete;
+  Queue &operator=(const Queue &) = delete;
+
+  /// Producer side: enqueue an event or count it as dropped.
+  void push(const Event &ev) noexcept;
+
+  /// Consumer side: dequeue up to @p maxCount events.
+  size_t drain(Event *out, size_t maxCount) noexcept;
+
+  /// Consumer side: block until events are pending, the timeout expires or
+  /// wake() is called. Never returns true with the ring empty.
+  bool wait(uint32_t timeoutMs);
+
+  /// Any thread: make the current or next wait() on an empty ring return
+  /// false.
+  void wake() noexcept;
+
+  /// Native wait handle (see `Listener::eventWaitHandle()`).
+  intptr_t handle() const noexcept;
+
+  std::atomic<uint64_t> dropped{0};
+
+private:
+  void raiseSignal() noexcept;
+  void resetSignal() noexcept;
+  bool waitSignal(uint32_t timeoutMs);
+
+  detail::SpscRing<Event> ring;
+  std::atomic<bool> signaled{false};
+  std::atomic<bool> woken{false};
+
+#if defined(_WIN32)
+  void *event{nullptr}; // manual-reset event HANDLE
+#else
+  int readFd{-1};
+  int writeFd{-1}; // equal to readFd for a Linux eventfd
+#endif
+};
+
+} // namespace axidev::io::keyboard
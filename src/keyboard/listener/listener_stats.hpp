@@ -0,0 +1,128 @@
+#pragma once
+/**
+ * @file keyboard/listener/listener_stats.hpp
+ * @brief Internal event dispatch and counters behind `Listener::stats()`.
+ *
+ * Every listener backend translates an OS event into a `Listener::Event` and
+ * hands it to `ListenerStats::dispatch()`, which stamps the dispatch time,
+ * calls the published callback and records how long it took. The counters
+ * are relaxed atomics written only by the backend's event thread, so the
+ * cost per event is two clock reads and a few uncontended increments.
+ */
+
+#include <axidev-io/keyboard/listener.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "keyboard/common/published_callback.hpp"
+
+namespace axidev::io::keyboard::detail {
+
+/// Current `std::chrono::steady_clock` time in nanoseconds.
+inline uint64_t steadyNowNs() noexcept {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/**
+ * @internal
+ * @brief Wrap a plain `Listener::Callback` so backends only ever publish an
+ * `EventCallback`. An empty callback stays empty.
+ */
+inline Listener::EventCallback adaptCallback(Listener::Callback cb) {
+  if (!cb)
+    return {};
+  return [cb = std::move(cb)](const Listener::Event &ev) {
+    cb(ev.codepoint, ev.keyMod, ev.pressed);
+  };
+}
+
+/**
+ * @internal
+ * @brief Event counters and callback timing histogram of one Listener.
+ */
+class ListenerStats {
+public:
+  using Histogram =
+      std::array<std::atomic<uint64_t>, Listener::kCallbackHistogramBuckets>;
+
+  /**
+   * @brief Deliver @p ev to the published callback, if any, and record it.
+   *
+   * Sets `ev.timestampNs`; the backend fills in everything else.
+   */
+  void dispatch(const PublishedCallback<Listener::EventCallback> &callback,
+                Listener::Event &ev) {
+    seen_.fetch_add(1, std::memory_order_relaxed);
+    const Listener::EventCallback *cb = callback.get();
+    if (!cb) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    ev.timestampNs = steadyNowNs();
+    (*cb)(ev);
+    record(steadyNowNs() - ev.timestampNs);
+  }
+
+  /// Count an event that the `Listener::Filter` rejected.
+  void skip() noexcept {
+    seen_.fetch_add(1, std::memory_order_relaxed);
+    filtered_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Counters so far; @p queueDropped is added to `eventsDropped`.
+  Listener::Stats snapshot(uint64_t queueDropped) const {
+    Listener::Stats out;
+    out.eventsSeen = seen_.load(std::memory_order_relaxed);
+    out.eventsDropped =
+        dropped_.load(std::memory_order_relaxed) + queueDropped;
+    out.eventsFiltered = filtered_.load(std::memory_order_relaxed);
+    out.callbackTimeMaxNs = maxNs_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < histogram_.size(); ++i)
+      out.callbackTimeHistogram[i] =
+          histogram_[i].load(std::memory_order_relaxed);
+    return out;
+  }
+
+  void reset() {
+    seen_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    filtered_.store(0, std::memory_order_relaxed);
+    maxNs_.store(0, std::memory_order_relaxed);
+    for (auto &bucket : histogram_)
+      bucket.store(0, std::memory_order_relaxed);
+  }
+
+  /// Histogram bucket of a callback that took @p ns (see `Listener::Stats`).
+  static constexpr size_t bucketFor(uint64_t ns) noexcept {
+    const uint64_t us = ns / 1000;
+    const size_t bucket = static_cast<size_t>(std::bit_width(us));
+    return bucket < Listener::kCallbackHistogramBuckets
+               ? bucket
+               : Listener::kCallbackHistogramBuckets - 1;
+  }
+
+private:
+  void record(uint64_t ns) noexcept {
+    histogram_[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    // Single writer: a plain compare is enough to keep the maximum.
+    if (ns > maxNs_.load(std::memory_order_relaxed))
+      maxNs_.store(ns, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> seen_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> filtered_{0};
+  std::atomic<uint64_t> maxNs_{0};
+  Histogram histogram_{};
+};
+
+} // namespace axidev::io::keyboard::detail
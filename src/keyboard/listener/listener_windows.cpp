@@ -19,12 +19,20 @@
 #ifdef _WIN32
 #include <Windows.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <axidev-io/log.hpp>
 
+#include "keyboard/common/published_callback.hpp"
 #include "keyboard/common/windows_keymap.hpp"
+#include "keyboard/listener/listener_filter.hpp"
+#include "keyboard/listener/listener_queue.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+#include "keyboard/listener/release_tracker.hpp"
 
 namespace axidev::io::keyboard {
 
@@ -36,11 +44,14 @@ namespace {
  *
  * The behaviour follows the logging facility: it is influenced by the
  * environment and the global log level (legacy `AXIDEV_OSK_DEBUG_BACKEND` or the
- * newer `AXIDEV_IO_LOG_LEVEL` mechanism).
+ * newer `AXIDEV_IO_LOG_LEVEL` mechanism) and compiles to `false` when Debug is
+ * below `AXIDEV_IO_MIN_LOG_LEVEL`.
  *
  * @return true if debug-level logging is enabled for the process.
  */
-static bool output_debug_enabled() { return ::axidev::io::log::debugEnabled(); }
+static bool output_debug_enabled() {
+  return AXIDEV_IO_LOG_ENABLED(::axidev::io::log::Level::Debug);
+}
 
 /**
  * @brief Derive the canonical lowercase codepoint for a Key enum value.
@@ -95,39 +106,44 @@ struct Listener::Impl {
    * @brief Start the Windows listener.
    *
    * Installs the low-level keyboard hook on a dedicated thread and stores the
-   * provided callback. This function waits briefly for the hook to be
-   * installed and returns whether the implementation reported readiness.
+   * provided callback. This function waits (up to `kStartTimeout`) for the
+   * hook thread to report through `readyCv` whether the hook was installed.
    *
    * @param cb Callback invoked for each observed key event. The callback may
    *           be called from the hook thread and therefore must be thread-safe.
    * @return true if the listener started successfully and the hook became
    * ready.
    */
-  bool start(Callback cb) {
+  bool start(EventCallback cb) {
     if (running.load())
       return false;
-    {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      callback = std::move(cb);
-    }
+    if (worker.joinable())
+      worker.join();
+    // Published before the hook thread exists; the hook reads it lock-free.
+    callback.publish(std::move(cb));
+    counters.reset();
+    filter = ::axidev::io::keyboard::detail::KeyFilter(
+        filterSpec, keyMap->vkToKey, keyMap->vkAndModsToKey);
     running.store(true);
     // Mark not-ready until the hook is actually installed.
     ready.store(false);
     AXIDEV_IO_LOG_INFO("Listener (Windows): start requested");
     worker = std::thread(&Impl::threadMain, this);
 
-    // Wait briefly for the hook to be installed (or to fail). This allows
+    // Wait for the hook to be installed (or to fail). This allows
     // startListening to return an accurate success/failure result.
-    for (int i = 0; i < 40; ++i) {
-      if (!running.load())
-        return false;
-      if (ready.load())
-        return true;
-      Sleep(5);
+    bool ok = false;
+    {
+      std::unique_lock<std::mutex> lock(readyMutex);
+      readyCv.wait_for(lock, kStartTimeout,
+                       [this] { return ready.load() || !running.load(); });
+      ok = ready.load();
     }
-    bool ok = ready.load();
     AXIDEV_IO_LOG_DEBUG("Listener (Windows): start result=%u",
                       static_cast<unsigned>(ok));
+    // A failed or timed-out start leaves no worker behind.
+    if (!ok)
+      stop();
     return ok;
   }
 
@@ -139,7 +155,9 @@ struct Listener::Impl {
    * then joins the worker thread. Safe to call from any thread.
    */
   void stop() {
-    if (!running.load())
+    // A worker whose hook failed has already cleared `running` but still
+    // needs to be joined.
+    if (!running.load() && !worker.joinable())
       return;
     AXIDEV_IO_LOG_INFO("Listener (Windows): stop requested");
     running.store(false);
@@ -152,9 +170,22 @@ struct Listener::Impl {
 
     if (worker.joinable())
       worker.join();
+    callback.retire();
     AXIDEV_IO_LOG_INFO("Listener (Windows): stopped");
   }
 
+  /**
+   * @internal
+   * @brief Store the filter compiled by the next start().
+   * @return false while the listener is running.
+   */
+  bool setFilter(Filter spec) {
+    if (running.load())
+      return false;
+    filterSpec = std::move(spec);
+    return true;
+  }
+
   /**
    * @internal
    * @brief Query whether the listener's worker thread is currently active.
@@ -162,19 +193,23 @@ struct Listener::Impl {
    */
   bool isRunning() const { return running.load(); }
 
+  /// Event counters reported by `Listener::stats()`.
+  ::axidev::io::keyboard::detail::ListenerStats &stats() { return counters; }
+
   /**
    * @internal
    * @brief Discover and initialize the mapping from virtual-key (VK) codes
    * to logical `Key` values.
    *
-   * This procedure queries the active keyboard layout to map printable
-   * characters to logical keys, and inserts sensible fallbacks for common
-   * control, navigation and modifier keys so the listener can provide a
-   * consistent mapping across Windows systems.
+   * This procedure takes the shared snapshot for the active keyboard layout,
+   * which maps printable characters to logical keys and inserts sensible
+   * fallbacks for common control, navigation and modifier keys so the
+   * listener can provide a consistent mapping across Windows systems. The
+   * layout is only scanned if no other Sender or Listener has done so.
    */
   void initKeyMap() {
-    keyMap =
-        ::axidev::io::keyboard::detail::initWindowsKeyMap(GetKeyboardLayout(0));
+    keyMap = ::axidev::io::keyboard::detail::acquireWindowsKeyMap(
+        GetKeyboardLayout(0));
   }
 
 private:
@@ -184,26 +219,36 @@ private:
   std::atomic<DWORD> threadId{0};
   HHOOK hook{nullptr};
 
-  // User callback
-  Callback callback;
-  std::mutex cbMutex;
+  // User callback, published in start() and retired after the hook thread
+  // has been joined in stop().
+  ::axidev::io::keyboard::detail::PublishedCallback<EventCallback> callback;
+  ::axidev::io::keyboard::detail::ListenerStats counters;
+  // Filter set through setFilter(), and its form compiled in start().
+  Filter filterSpec;
+  ::axidev::io::keyboard::detail::KeyFilter filter;
 
   // Hook readiness handshake - set to true once the hook is successfully
-  // installed and the listener is active.
+  // installed and the listener is active. Changes are signalled through
+  // readyCv (see reportStartup()).
   std::atomic<bool> ready{false};
+  static constexpr std::chrono::milliseconds kStartTimeout{200};
+  std::mutex readyMutex;
+  std::condition_variable readyCv;
 
-  // Full keymap for modifier-aware key resolution
-  ::axidev::io::keyboard::detail::WindowsKeyMap keyMap;
+  // Full keymap for modifier-aware key resolution; its HKL translates
+  // codepoints.
+  std::shared_ptr<const ::axidev::io::keyboard::detail::WindowsKeyMap> keyMap;
+  // Last layout published by `windowsLayoutTracker()` that was adopted (hook
+  // thread only).
+  ::axidev::io::keyboard::detail::LayoutSubscription layoutUpdates;
 
   // Debounce & release handling (works on the hook thread only).
   // - Record the last codepoint seen on press to use as a fallback on release
   //   when the release event lacks a unicode output.
   // - Debounce rapid duplicate releases (same vk+cp+mods within a short
   //   interval) to avoid emitting duplicate characters to consumers.
-  std::unordered_map<WORD, char32_t> lastPressCp;
-  std::unordered_map<WORD, std::chrono::steady_clock::time_point>
-      lastReleaseTime;
-  std::unordered_map<WORD, std::pair<char32_t, Modifier>> lastReleaseSig;
+  // Indexed by virtual-key code, so the hook never allocates.
+  ::axidev::io::keyboard::detail::ReleaseTracker<256> releases;
 
   // The hook proc needs to locate the current instance; allow a single
   // active instance via an atomic pointer. (Simple and practical for the app.)
@@ -239,6 +284,28 @@ private:
     return CallNextHookEx(nullptr, nCode, wParam, lParam);
   }
 
+  /**
+   * @internal
+   * @brief Follow the layout of the foreground window.
+   *
+   * The foreground layout is polled at a bounded rate (see
+   * `pollForegroundLayout()`); a switch is reported to the tracker, which
+   * builds the new mappings off the hook thread. They are adopted, with their
+   * HKL, by the first event after they were published; until then both keys
+   * and codepoints come from the previous layout.
+   */
+  void syncLayout() {
+    ::axidev::io::keyboard::detail::pollForegroundLayout();
+    if (layoutUpdates.refresh(
+            ::axidev::io::keyboard::detail::windowsLayoutTracker(), keyMap)) {
+      filter = ::axidev::io::keyboard::detail::KeyFilter(
+          filterSpec, keyMap->vkToKey, keyMap->vkAndModsToKey);
+      AXIDEV_IO_LOG_INFO("Listener (Windows): switched to layout 0x%llx",
+                         static_cast<unsigned long long>(
+                             reinterpret_cast<uintptr_t>(keyMap->layout)));
+    }
+  }
+
   // Map the low-level keyboard event to a (codepoint, Key, Modifier, pressed)
   // and invoke the user callback (if set).
   //
@@ -258,6 +325,13 @@ private:
       return;
 
     WORD vk = static_cast<WORD>(kbd->vkCode);
+    syncLayout();
+
+    // Keys the filter does not want go straight back to the hook chain.
+    if (!filter.admitsCode(vk, pressed)) {
+      counters.skip();
+      return;
+    }
 
     // Capture modifiers first so we can use them for key resolution
     Modifier mods = deriveModifiers();
@@ -265,13 +339,22 @@ private:
     // Use modifier-aware key resolution to get the correct logical key
     // based on the VK code and active modifiers.
     Key mappedKey = ::axidev::io::keyboard::detail::resolveKeyFromVkAndMods(
-        keyMap, vk, mods);
+        *keyMap, vk, mods);
 
     // Fall back to base vkToKey if modifier-aware lookup didn't find anything
     if (mappedKey == Key::Unknown) {
-      auto it = keyMap.vkToKey.find(vk);
-      if (it != keyMap.vkToKey.end())
-        mappedKey = it->second;
+      if (const Key *base = keyMap->vkToKey.find(vk))
+        mappedKey = *base;
+    }
+
+    if (!filter.admits(KeyWithModifier(mappedKey, mods))) {
+      counters.skip();
+      return;
+    }
+    // Without a codepoint, skip GetKeyboardState and ToUnicodeEx entirely.
+    if (!filter.wantsCodepoint()) {
+      invokeCallback(kbd, 0, KeyWithModifier(mappedKey, mods), pressed);
+      return;
     }
 
     // Determine Unicode character (simple BMP handling). ToUnicodeEx can
@@ -279,16 +362,16 @@ private:
     BYTE keyboardState[256];
     if (!GetKeyboardState(keyboardState)) {
       // Fall back: no keyboard state; still report key with no codepoint.
-      invokeCallback(0, KeyWithModifier(mappedKey, deriveModifiers()), pressed);
+      invokeCallback(kbd, 0, KeyWithModifier(mappedKey, deriveModifiers()),
+                     pressed);
       return;
     }
 
     wchar_t wbuf[4]{0};
-    HKL layout = GetKeyboardLayout(0);
     // Use scan code from the hook; use ToUnicodeEx to get the Unicode output.
     int ret = ToUnicodeEx(vk, kbd->scanCode, keyboardState, wbuf,
                           static_cast<int>(sizeof(wbuf) / sizeof(wbuf[0])), 0,
-                          layout);
+                          keyMap->layout);
 
     char32_t codepoint = 0;
     if (ret > 0) {
@@ -327,9 +410,6 @@ private:
       }
     }
 
-    // Map to textual key name for logging
-    std::string keyName = keyToString(mappedKey);
-
     // Treat Enter and Backspace as control keys (non-printable). If we pass a
     // non-zero codepoint for these keys the consumer callback will append that
     // control character into the observed string rather than handling the
@@ -346,18 +426,11 @@ private:
     //  2) In some cases the release event can lack a Unicode output (ret == 0).
     //     Cache the last press codepoint and use it as a fallback for the
     //     release so the character stream aligns with what applications see.
-    static constexpr std::chrono::milliseconds kReleaseDebounceMs{50};
-
     if (pressed) {
       // On press, remember the unicode output (if any) for potential use on
-      // the paired release event.
-      if (codepoint != 0) {
-        lastPressCp[vk] = codepoint;
-      } else {
-        // Clear any stale entry for this vk when press does not produce
-        // a unicode character (e.g., modifiers).
-        lastPressCp.erase(vk);
-      }
+      // the paired release event. A press without one (e.g. a modifier)
+      // clears any stale entry for this vk.
+      releases.press(vk, codepoint);
     } else {
       // On release, prefer using the cached press codepoint if the release
       // did not produce a unicode character. This helps align the character
@@ -365,9 +438,8 @@ private:
       // keys (Enter/Backspace) which are intentionally cleared above.
       if (codepoint == 0 && mappedKey != Key::Enter &&
           mappedKey != Key::Backspace) {
-        auto cpIt = lastPressCp.find(vk);
-        if (cpIt != lastPressCp.end()) {
-          codepoint = cpIt->second;
+        if (const char32_t pressCp = releases.pressCodepoint(vk)) {
+          codepoint = pressCp;
           if (output_debug_enabled()) {
             AXIDEV_IO_LOG_DEBUG(
                 "Listener (Windows): using last-press cp=%u for release vk=%u",
@@ -376,50 +448,35 @@ private:
         }
       }
 
-      // On release, debounce rapid duplicates coming from the system.
-      auto now = std::chrono::steady_clock::now();
-      auto rtIt = lastReleaseTime.find(vk);
-      auto sigIt = lastReleaseSig.find(vk);
-      if (rtIt != lastReleaseTime.end() && sigIt != lastReleaseSig.end()) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - rtIt->second);
-        if (elapsed < kReleaseDebounceMs && sigIt->second.first == codepoint &&
-            sigIt->second.second == mods) {
-          if (output_debug_enabled()) {
-            AXIDEV_IO_LOG_DEBUG("Listener (Windows): ignoring duplicate release "
+      // On release, debounce rapid duplicates coming from the system. The
+      // release is recorded either way, so quick repeats stay debounced.
+      const bool duplicate = releases.release(
+          vk, codepoint, mods, std::chrono::steady_clock::now());
+
+      // We've handled the release, clear the cached press codepoint so we
+      // don't accidentally reuse it for future, unrelated events.
+      releases.press(vk, 0);
+
+      if (duplicate) {
+        if (output_debug_enabled()) {
+          AXIDEV_IO_LOG_DEBUG("Listener (Windows): ignoring duplicate release "
                               "(same cp+mods) for vk=%u key=%s cp=%u mods=%u",
-                              static_cast<unsigned>(vk), keyName.c_str(),
+                              static_cast<unsigned>(vk),
+                              keyToStringView(mappedKey).data(),
                               static_cast<unsigned>(codepoint),
                               static_cast<unsigned>(mods));
-          }
-          // Update timestamp & signature so subsequent quick duplicates remain
-          // debounced.
-          lastReleaseTime[vk] = now;
-          lastReleaseSig[vk] = std::make_pair(codepoint, mods);
-          // We've handled the release; clear cached press cp so it won't be
-          // accidentally reused later.
-          lastPressCp.erase(vk);
-          return;
         }
+        return;
       }
-
-      // Not a duplicate matching the last cp+mods -> record the new
-      // signature/time.
-      lastReleaseTime[vk] = now;
-      lastReleaseSig[vk] = std::make_pair(codepoint, mods);
-
-      // We've handled the release, clear the cached press codepoint so we
-      // don't accidentally reuse it for future, unrelated events.
-      lastPressCp.erase(vk);
     }
 
-    invokeCallback(codepoint, KeyWithModifier(mappedKey, mods), pressed);
+    invokeCallback(kbd, codepoint, KeyWithModifier(mappedKey, mods), pressed);
 
     AXIDEV_IO_LOG_DEBUG(
         "Listener (Windows) %s: vk=%u sc=%u flags=%u key=%s cp=%u mods=%u",
         pressed ? "press" : "release", static_cast<unsigned>(vk),
         static_cast<unsigned>(kbd->scanCode), static_cast<unsigned>(kbd->flags),
-        keyName.c_str(), static_cast<unsigned>(codepoint),
+        keyToStringView(mappedKey).data(), static_cast<unsigned>(codepoint),
         static_cast<unsigned>(mods));
   }
 
@@ -451,22 +508,46 @@ private:
    * @internal
    * @brief Safely invoke the user-provided callback.
    *
-   * Copies the stored callback under `cbMutex` and then invokes it outside
-   * the lock to avoid holding internal mutexes while calling user code.
+   * Reads the published callback with a single atomic load. This runs inside
+   * the low-level hook, which Windows times out, so it takes no lock and does
+   * not copy (or allocate) the `std::function`.
    *
+   * The hook's `time` field is a `GetTickCount()` value; it is placed on the
+   * steady_clock timeline through the event's age, which wraps correctly in
+   * 32-bit arithmetic.
+   *
+   * @param kbd Hook data of the event (for its timestamp).
    * @param cp Unicode codepoint produced by the event (0 if none).
    * @param keyMod Combined key and modifier information for the event.
    * @param pressed True for key press, false for release.
    */
-  void invokeCallback(char32_t cp, KeyWithModifier keyMod, bool pressed) {
-    Callback cbCopy;
+  void invokeCallback(const KBDLLHOOKSTRUCT *kbd, char32_t cp,
+                      KeyWithModifier keyMod, bool pressed) {
+    Event ev;
+    ev.codepoint = cp;
+    ev.keyMod = keyMod;
+    ev.pressed = pressed;
+    const uint64_t ageNs =
+        static_cast<uint64_t>(static_cast<DWORD>(GetTickCount() - kbd->time)) *
+        1'000'000;
+    const uint64_t now = ::axidev::io::keyboard::detail::steadyNowNs();
+    ev.osTimestampNs = now > ageNs ? now - ageNs : 0;
+    counters.dispatch(callback, ev);
+  }
+
+  /**
+   * @internal
+   * @brief Publish whether the hook was installed and wake `start()`.
+   * @param ok false if installation failed, which also ends the listener.
+   */
+  void reportStartup(bool ok) {
     {
-      std::lock_guard<std::mutex> lk(cbMutex);
-      cbCopy = callback;
-    }
-    if (cbCopy) {
-      cbCopy(cp, keyMod, pressed);
+      std::lock_guard<std::mutex> lock(readyMutex);
+      if (!ok)
+        running.store(false);
+      ready.store(ok);
     }
+    readyCv.notify_all();
   }
 
   /**
@@ -491,19 +572,20 @@ private:
       // Failed to create hook; clear instance and exit thread.
       s_instance.store(nullptr);
       threadId.store(0);
-      running.store(false);
-      ready.store(false);
+      reportStartup(false);
       AXIDEV_IO_LOG_ERROR("Listener (Windows): SetWindowsHookEx failed");
       return;
     }
 
     // Hook installed successfully
-    ready.store(true);
+    reportStartup(true);
     AXIDEV_IO_LOG_INFO("Listener (Windows): low-level keyboard hook installed");
 
-    // Standard message loop (blocks on GetMessage; WM_QUIT ends it).
+    // Standard message loop (blocks on GetMessage; WM_QUIT ends it). A stop()
+    // that ran before the hook created this thread's queue could not post
+    // WM_QUIT, so `running` is checked first.
     MSG msg;
-    while (GetMessage(&msg, nullptr, 0, 0) > 0) {
+    while (running.load() && GetMessage(&msg, nullptr, 0, 0) > 0) {
       TranslateMessage(&msg);
       DispatchMessage(&msg);
     }
@@ -529,6 +611,26 @@ AXIDEV_IO_API Listener &Listener::operator=(Listener &&) noexcept = default;
 
 AXIDEV_IO_API bool Listener::start(Callback cb) {
   AXIDEV_IO_LOG_DEBUG("Listener::start() called (Windows)");
+  return m_impl ? m_impl->start(detail::adaptCallback(std::move(cb))) : false;
+}
+
+AXIDEV_IO_API bool Listener::setFilter(Filter filter) {
+  return m_impl ? m_impl->setFilter(std::move(filter)) : false;
+}
+
+AXIDEV_IO_API bool Listener::setSources(Sources sources) {
+  // Windows has a single system-wide keyboard stream; only the default
+  // sources describe it.
+  if (!sources.seats.empty() || !sources.devicePaths.empty()) {
+    AXIDEV_IO_LOG_WARN("Listener (Windows): seats and device paths are only "
+                       "supported on Linux");
+    return false;
+  }
+  return m_impl && !m_impl->isRunning();
+}
+
+AXIDEV_IO_API bool Listener::startWithEvents(EventCallback cb) {
+  AXIDEV_IO_LOG_DEBUG("Listener::startWithEvents() called (Windows)");
   return m_impl ? m_impl->start(std::move(cb)) : false;
 }
 
@@ -543,6 +645,15 @@ AXIDEV_IO_API bool Listener::isListening() const {
   return m_impl ? m_impl->isRunning() : false;
 }
 
+AXIDEV_IO_API Listener::Stats Listener::stats() const {
+  return m_impl ? m_impl->stats().snapshot(droppedEvents()) : Stats{};
+}
+
+AXIDEV_IO_API void Listener::resetStats() {
+  if (m_impl)
+    m_impl->stats().reset();
+}
+
 } // namespace axidev::io::keyboard
 
 #endif // _WIN32
@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file keyboard/listener/release_tracker.hpp
+ * @brief Internal per-keycode press/release bookkeeping of the Windows and
+ * macOS listeners.
+ *
+ * Both hooks remember the codepoint of each press so that a release without
+ * a Unicode output can still report it, and debounce releases the OS
+ * delivers twice. The state is held in a fixed array indexed by keycode, so
+ * the hook thread never allocates; keycodes outside the array are simply not
+ * tracked.
+ */
+
+#include <axidev-io/keyboard/common.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief Last press codepoint and last release of every keycode below @p N.
+ *
+ * Only used from the listener's event thread; not thread-safe.
+ *
+ * @tparam N Number of keycodes tracked (256 covers Windows virtual keys and
+ *           macOS virtual keycodes).
+ */
+template <size_t N> class ReleaseTracker {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Releases of the same keycode, codepoint and modifiers closer together
+  /// than this are duplicates.
+  static constexpr std::chrono::milliseconds kDebounce{50};
+
+  /// Remember @p cp as the output of the press of @p code; 0 forgets it.
+  void press(uint32_t code, char32_t cp) noexcept {
+    if (code < N)
+      slots_[code].pressCp = cp;
+  }
+
+  /// Codepoint remembered for the last press of @p code, 0 if none.
+  [[nodiscard]] char32_t pressCodepoint(uint32_t code) const noexcept {
+    return code < N ? slots_[code].pressCp : 0;
+  }
+
+  /**
+   * @brief Record a release of @p code at @p now.
+   *
+   * The release is recorded either way, so a burst of duplicates stays
+   * debounced.
+   *
+   * @return true when it repeats the previous release of @p code (same
+   *         codepoint and modifiers within `kDebounce`).
+   */
+  bool release(uint32_t code, char32_t cp, Modifier mods,
+               Clock::time_point now) noexcept {
+    if (code >= N)
+      return false;
+    Slot &slot = slots_[code];
+    const bool duplicate = slot.released &&
+                           now - slot.releaseTime < kDebounce &&
+                           slot.releaseCp == cp && slot.releaseMods == mods;
+    slot.released = true;
+    slot.releaseTime = now;
+    slot.releaseCp = cp;
+    slot.releaseMods = mods;
+    return duplicate;
+  }
+
+private:
+  struct Slot {
+    char32_t pressCp{0};
+    bool released{false};
+    char32_t releaseCp{0};
+    Modifier releaseMods{Modifier::None};
+    Clock::time_point releaseTime{};
+  };
+  std::array<Slot, N> slots_{};
+};
+
+} // namespace axidev::io::keyboard::detail
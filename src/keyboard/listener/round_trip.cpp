@@ -0,0 +1,214 @@
+/**
+ * @file keyboard/listener/round_trip.cpp
+ * @brief RoundTripHistogram and the `measureRoundTrip()` probe.
+ */
+
+#include <axidev-io/keyboard/round_trip.hpp>
+
+#include <algorithm>
+#include <axidev-io/log.hpp>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "keyboard/listener/listener_stats.hpp"
+
+namespace axidev::io::keyboard {
+
+void RoundTripHistogram::add(uint64_t ns) {
+  m_min = m_received == 0 ? ns : std::min(m_min, ns);
+  m_max = std::max(m_max, ns);
+  m_sum += ns;
+  ++m_received;
+  ++m_buckets[detail::ListenerStats::bucketFor(ns)];
+  if (m_samples.size() < kMaxSamples) {
+    insertSorted(ns);
+    return;
+  }
+  // Reservoir sampling: the new latency replaces a kept one with
+  // probability kMaxSamples / received, so every latency seen so far is
+  // equally likely to be kept.
+  const size_t slot = randomBelow(m_received);
+  if (slot >= kMaxSamples)
+    return;
+  m_samples.erase(m_samples.begin() + static_cast<std::ptrdiff_t>(slot));
+  insertSorted(ns);
+}
+
+void RoundTripHistogram::merge(const RoundTripHistogram &other) {
+  if (&other == this)
+    return;
+  if (other.m_received != 0) {
+    m_min = m_received == 0 ? other.m_min : std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+  const uint64_t received = m_received + other.m_received;
+  if (m_samples.size() + other.m_samples.size() > kMaxSamples) {
+    // Each side keeps a share of the samples proportional to the probes it
+    // stands for.
+    const auto keepOwn = static_cast<size_t>(
+        static_cast<double>(kMaxSamples) * static_cast<double>(m_received) /
+        static_cast<double>(received));
+    keepRandom(std::min(keepOwn, m_samples.size()));
+    RoundTripHistogram theirs = other;
+    theirs.keepRandom(
+        std::min(kMaxSamples - m_samples.size(), theirs.m_samples.size()));
+    for (uint64_t ns : theirs.m_samples)
+      insertSorted(ns);
+  } else {
+    for (uint64_t ns : other.m_samples)
+      insertSorted(ns);
+  }
+  m_received = received;
+  m_sum += other.m_sum;
+  m_lost += other.m_lost;
+  for (size_t i = 0; i < kBuckets; ++i)
+    m_buckets[i] += other.m_buckets[i];
+}
+
+void RoundTripHistogram::clear() { *this = RoundTripHistogram{}; }
+
+uint64_t RoundTripHistogram::minNs() const { return m_min; }
+
+uint64_t RoundTripHistogram::maxNs() const { return m_max; }
+
+uint64_t RoundTripHistogram::meanNs() const {
+  return m_received == 0 ? 0 : m_sum / m_received;
+}
+
+uint64_t RoundTripHistogram::percentileNs(double q) const {
+  if (m_samples.empty())
+    return 0;
+  q = std::clamp(q, 0.0, 1.0);
+  // Nearest rank: the smallest sample with at least q of all samples at or
+  // below it.
+  const auto rank = static_cast<size_t>(
+      std::ceil(q * static_cast<double>(m_samples.size())));
+  return m_samples[rank == 0 ? 0 : rank - 1];
+}
+
+size_t RoundTripHistogram::randomBelow(uint64_t bound) {
+  // splitmix64; statistical quality is ample for picking samples.
+  uint64_t z = (m_rng += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  return static_cast<size_t>(z % bound);
+}
+
+void RoundTripHistogram::keepRandom(size_t count) {
+  if (count >= m_samples.size())
+    return;
+  // Partial Fisher-Yates: the first `count` slots end up a uniform subset.
+  for (size_t i = 0; i < count; ++i)
+    std::swap(m_samples[i],
+              m_samples[i + randomBelow(m_samples.size() - i)]);
+  m_samples.resize(count);
+  std::sort(m_samples.begin(), m_samples.end());
+}
+
+void RoundTripHistogram::insertSorted(uint64_t ns) {
+  m_samples.insert(std::upper_bound(m_samples.begin(), m_samples.end(), ns),
+                   ns);
+}
+
+namespace {
+
+/**
+ * @internal
+ * @brief State shared between the probe loop and the listener thread.
+ */
+struct ProbeState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  Key expected{Key::Unknown};
+  uint64_t arrivedNs{0}; ///< 0 until the expected marker arrives.
+
+  void onEvent(const Listener::Event &ev) {
+    if (!ev.pressed)
+      return;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (ev.keyMod.key != expected || arrivedNs != 0)
+        return; // another key, or a late marker of an earlier probe
+      arrivedNs = ev.timestampNs;
+    }
+    cv.notify_one();
+  }
+
+  void expect(Key marker) {
+    std::lock_guard<std::mutex> lock(mutex);
+    expected = marker;
+    arrivedNs = 0;
+  }
+
+  /// Dispatch time of the expected marker, or 0 on timeout.
+  uint64_t await(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait_for(lock, timeout, [this] { return arrivedNs != 0; });
+    return arrivedNs;
+  }
+};
+
+} // namespace
+
+AXIDEV_IO_API bool measureRoundTrip(Sender &sender, Listener &listener,
+                                    uint32_t count, RoundTripHistogram &out,
+                                    const RoundTripOptions &options) {
+  if (options.markers.empty() || listener.isListening())
+    return false;
+  const auto timeout = std::chrono::milliseconds(options.timeoutMs);
+  if (!sender.waitUntilReady(options.timeoutMs)) {
+    AXIDEV_IO_LOG_WARN("measureRoundTrip: Sender is not ready");
+    return false;
+  }
+
+  ProbeState state;
+  if (!listener.startWithEvents(
+          [&state](const Listener::Event &ev) { state.onEvent(ev); })) {
+    AXIDEV_IO_LOG_WARN("measureRoundTrip: Listener failed to start");
+    return false;
+  }
+
+  // Untimed warm-up, retried briefly: on Linux the Listener may only see a
+  // freshly created virtual device some time after it starts.
+  const Key first = options.markers.front();
+  bool warm = false;
+  for (int attempt = 0; attempt < 4 && !warm; ++attempt) {
+    state.expect(first);
+    warm = sender.tap(KeyWithModifier(first)) && state.await(timeout) != 0;
+  }
+  if (!warm) {
+    listener.stop();
+    AXIDEV_IO_LOG_WARN("measureRoundTrip: warm-up marker never arrived");
+    return false;
+  }
+
+  RoundTripHistogram run;
+  for (uint32_t i = 0; i < count; ++i) {
+    // Start after the warm-up marker so consecutive probes differ.
+    const Key marker = options.markers[(i + 1) % options.markers.size()];
+    state.expect(marker);
+    const uint64_t sentNs = detail::steadyNowNs();
+    const uint64_t arrivedNs =
+        sender.tap(KeyWithModifier(marker)) ? state.await(timeout) : 0;
+    if (arrivedNs != 0)
+      run.add(arrivedNs > sentNs ? arrivedNs - sentNs : 0);
+    else
+      run.addLost();
+    if (options.intervalMs != 0)
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(options.intervalMs));
+  }
+  listener.stop();
+
+  AXIDEV_IO_LOG_DEBUG("measureRoundTrip: %llu/%u probes arrived, p50=%llu ns",
+                      static_cast<unsigned long long>(run.received()), count,
+                      static_cast<unsigned long long>(run.percentileNs(0.5)));
+  out.merge(run);
+  return true;
+}
+
+} // namespace axidev::io::keyboard
@@ -0,0 +1,253 @@
+/**
+ * @file keyboard/sender/sender_async.cpp
+ * @brief Asynchronous injection mode for axidev::io::keyboard::Sender.
+ *
+ * Implements the command queue used by `Sender::startAsync()` and the
+ * platform-independent public async entry points. Backends are unchanged: the
+ * injection thread replays each command through the synchronous API.
+ */
+
+#include "keyboard/sender/sender_async.hpp"
+
+#include <axidev-io/log.hpp>
+
+#include <chrono>
+#include <new>
+#include <system_error>
+#include <utility>
+
+namespace axidev::io::keyboard {
+
+Sender::AsyncQueue::AsyncQueue(Sender &owner, size_t capacity)
+    : owner(owner), ring(capacity) {}
+
+Sender::AsyncQueue::~AsyncQueue() {
+  cancelPending();
+  if (worker.joinable())
+    stop();
+  // Never started: release whatever the producer managed to queue.
+  Command cmd;
+  while (ring.tryPop(cmd))
+    release(cmd);
+}
+
+bool Sender::AsyncQueue::start() {
+  try {
+    worker = std::thread(&AsyncQueue::run, this);
+  } catch (const std::system_error &e) {
+    AXIDEV_IO_LOG_ERROR("Sender: failed to start injection thread: %s",
+                        e.what());
+    return false;
+  }
+  return true;
+}
+
+Sender::AsyncTicket Sender::AsyncQueue::push(Command cmd) noexcept {
+  cmd.ticket = issued.load(std::memory_order_relaxed) + 1;
+  if (!ring.tryPush(cmd)) {
+    release(cmd);
+    return 0;
+  }
+  issued.store(cmd.ticket, std::memory_order_release);
+  // Only the idle-to-pending edge wakes the injection thread. Notifying
+  // under wakeMutex keeps the wake-up from falling between the thread's
+  // predicate check and its wait.
+  if (!signaled.exchange(true, std::memory_order_acq_rel)) {
+    std::lock_guard<std::mutex> lk(wakeMutex);
+    wake.notify_one();
+  }
+  return cmd.ticket;
+}
+
+void Sender::AsyncQueue::cancelPending() noexcept {
+  cancelledThrough.store(issued.load(std::memory_order_acquire),
+                         std::memory_order_release);
+}
+
+bool Sender::AsyncQueue::waitFor(AsyncTicket ticket, uint32_t timeoutMs) {
+  if (ticket == 0 || ticket > lastIssued())
+    return false;
+  std::unique_lock<std::mutex> lk(doneMutex);
+  auto finished = [this, ticket] { return completed >= ticket; };
+  if (timeoutMs == kWaitInfinite) {
+    done.wait(lk, finished);
+    return true;
+  }
+  return done.wait_for(lk, std::chrono::milliseconds(timeoutMs), finished);
+}
+
+void Sender::AsyncQueue::stop() {
+  {
+    std::lock_guard<std::mutex> lk(wakeMutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  if (worker.joinable())
+    worker.join();
+}
+
+void Sender::AsyncQueue::run() {
+  std::unique_lock<std::mutex> lk(wakeMutex);
+  for (;;) {
+    wake.wait(lk, [this] {
+      return stopping || signaled.load(std::memory_order_acquire);
+    });
+    // stop() is called from the producer thread, so once it is observed no
+    // further commands can arrive and the drain below is the final one.
+    const bool stopRequested = stopping;
+    lk.unlock();
+
+    signaled.store(false, std::memory_order_release);
+    Command cmd;
+    while (ring.tryPop(cmd)) {
+      if (cmd.ticket > cancelledThrough.load(std::memory_order_acquire))
+        execute(cmd);
+      release(cmd);
+      {
+        std::lock_guard<std::mutex> doneLock(doneMutex);
+        completed = cmd.ticket;
+      }
+      done.notify_all();
+    }
+
+    if (stopRequested)
+      return;
+    lk.lock();
+  }
+}
+
+void Sender::AsyncQueue::execute(const Command &cmd) {
+  bool ok = false;
+  try {
+    switch (cmd.kind) {
+    case Kind::Tap:
+      ok = owner.tap(cmd.keyMod);
+      break;
+    case Kind::KeyDown:
+      ok = owner.keyDown(cmd.keyMod);
+      break;
+    case Kind::KeyUp:
+      ok = owner.keyUp(cmd.keyMod);
+      break;
+    case Kind::TypeUtf32:
+      ok = cmd.utf32 && owner.typeText(*cmd.utf32);
+      break;
+    case Kind::TypeUtf8:
+      ok = cmd.utf8 && owner.typeText(*cmd.utf8);
+      break;
+    }
+  } catch (const std::exception &e) {
+    AXIDEV_IO_LOG_ERROR("Sender: async command %llu threw: %s",
+                        static_cast<unsigned long long>(cmd.ticket), e.what());
+  }
+  if (!ok)
+    failures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Sender::AsyncQueue::release(Command &cmd) noexcept {
+  delete cmd.utf32;
+  delete cmd.utf8;
+  cmd.utf32 = nullptr;
+  cmd.utf8 = nullptr;
+}
+
+// Public async wrappers
+
+bool Sender::startAsync(size_t capacity) {
+  AXIDEV_IO_LOG_DEBUG("Sender::startAsync() called (capacity=%zu)", capacity);
+  if (!m_impl || m_async)
+    return false;
+  auto queue = std::make_unique<AsyncQueue>(*this, capacity);
+  if (!queue->start())
+    return false;
+  m_async = std::move(queue);
+  return true;
+}
+
+void Sender::stopAsync() {
+  if (!m_async)
+    return;
+  AXIDEV_IO_LOG_DEBUG("Sender::stopAsync() draining %llu queued commands",
+                      static_cast<unsigned long long>(m_async->lastIssued()));
+  m_async->stop();
+  m_async.reset();
+}
+
+void Sender::discardAsync() noexcept {
+  if (!m_async)
+    return;
+  // The queue's destructor cancels what has not started and joins.
+  m_async.reset();
+}
+
+bool Sender::asyncEnabled() const { return m_async != nullptr; }
+
+Sender::AsyncTicket Sender::tapAsync(KeyWithModifier keyMod) {
+  return m_async ? m_async->push({AsyncQueue::Kind::Tap, keyMod, 0, nullptr,
+                                  nullptr})
+                 : 0;
+}
+
+Sender::AsyncTicket Sender::keyDownAsync(KeyWithModifier keyMod) {
+  return m_async ? m_async->push({AsyncQueue::Kind::KeyDown, keyMod, 0,
+                                  nullptr, nullptr})
+                 : 0;
+}
+
+Sender::AsyncTicket Sender::keyUpAsync(KeyWithModifier keyMod) {
+  return m_async ? m_async->push({AsyncQueue::Kind::KeyUp, keyMod, 0, nullptr,
+                                  nullptr})
+                 : 0;
+}
+
+Sender::AsyncTicket Sender::typeTextAsync(const std::u32string &text) {
+  if (!m_async)
+    return 0;
+  auto *copy = new (std::nothrow) std::u32string();
+  if (!copy)
+    return 0;
+  try {
+    *copy = text;
+  } catch (const std::bad_alloc &) {
+    delete copy;
+    return 0;
+  }
+  return m_async->push({AsyncQueue::Kind::TypeUtf32, {}, 0, copy, nullptr});
+}
+
+Sender::AsyncTicket Sender::typeTextAsync(const std::string &utf8Text) {
+  if (!m_async)
+    return 0;
+  auto *copy = new (std::nothrow) std::string();
+  if (!copy)
+    return 0;
+  try {
+    *copy = utf8Text;
+  } catch (const std::bad_alloc &) {
+    delete copy;
+    return 0;
+  }
+  return m_async->push({AsyncQueue::Kind::TypeUtf8, {}, 0, nullptr, copy});
+}
+
+bool Sender::wait(AsyncTicket ticket, uint32_t timeoutMs) {
+  return m_async ? m_async->waitFor(ticket, timeoutMs) : false;
+}
+
+bool Sender::waitIdle(uint32_t timeoutMs) {
+  if (!m_async)
+    return false;
+  const AsyncTicket last = m_async->lastIssued();
+  return last == 0 || m_async->waitFor(last, timeoutMs);
+}
+
+void Sender::cancelPending() {
+  if (m_async)
+    m_async->cancelPending();
+}
+
+uint64_t Sender::asyncFailures() const {
+  return m_async ? m_async->failures.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace axidev::io::keyboard
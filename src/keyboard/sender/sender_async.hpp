@@ -0,0 +1,99 @@
+#pragma once
+/**
+ * @file keyboard/sender/sender_async.hpp
+ * @brief Internal command queue backing `Sender::startAsync()`.
+ *
+ * Every sender backend includes this header so that `Sender`'s special
+ * members (defined per backend) see the complete `Sender::AsyncQueue` type.
+ * The implementation is platform-independent and lives in
+ * `sender_async.cpp`; the injection thread drives the backend through the
+ * ordinary public `Sender` methods.
+ */
+
+#include <axidev-io/keyboard/sender.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "keyboard/common/spsc_ring.hpp"
+
+namespace axidev::io::keyboard {
+
+/**
+ * @internal
+ * @brief SPSC command ring plus the injection thread that drains it.
+ *
+ * The producer is the application thread calling the `...Async()` methods;
+ * it copies the command into the ring and wakes the injection thread on the
+ * idle-to-pending edge. Text payloads are heap copies owned by the command
+ * and released by the injection thread. Completion is published as the
+ * ticket of the last finished command, which is monotonic because commands
+ * run in order.
+ */
+struct Sender::AsyncQueue {
+  enum class Kind : uint8_t { Tap, KeyDown, KeyUp, TypeUtf32, TypeUtf8 };
+
+  struct Command {
+    Kind kind;
+    KeyWithModifier keyMod;
+    AsyncTicket ticket;
+    std::u32string *utf32; ///< owned, for Kind::TypeUtf32
+    std::string *utf8;     ///< owned, for Kind::TypeUtf8
+  };
+
+  AsyncQueue(Sender &owner, size_t capacity);
+  ~AsyncQueue();
+
+  AsyncQueue(const AsyncQueue &) = delete;
+  AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+  /// Launch the injection thread; false when it could not be created.
+  bool start();
+
+  /// Producer side: enqueue a command and return its ticket, or 0 when full.
+  AsyncTicket push(Command cmd) noexcept;
+
+  /// Mark every command issued so far as cancelled unless already started.
+  void cancelPending() noexcept;
+
+  /// Block until @p ticket has finished or the timeout expires.
+  bool waitFor(AsyncTicket ticket, uint32_t timeoutMs);
+
+  /// Let the thread drain the queue, then join it.
+  void stop();
+
+  /// Ticket of the most recently queued command.
+  AsyncTicket lastIssued() const noexcept {
+    return issued.load(std::memory_order_acquire);
+  }
+
+  std::atomic<uint64_t> failures{0};
+
+private:
+  void run();
+  void execute(const Command &cmd);
+  static void release(Command &cmd) noexcept;
+
+  Sender &owner;
+  detail::SpscRing<Command> ring;
+  std::thread worker;
+
+  std::atomic<AsyncTicket> issued{0};
+  std::atomic<AsyncTicket> cancelledThrough{0};
+  std::atomic<bool> signaled{false};
+
+  std::mutex wakeMutex;
+  std::condition_variable wake;
+  bool stopping{false}; // guarded by wakeMutex
+
+  std::mutex doneMutex;
+  std::condition_variable done;
+  AsyncTicket completed{0}; // guarded by doneMutex
+};
+
+} // namespace axidev::io::keyboard
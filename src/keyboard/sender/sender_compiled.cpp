@@ -0,0 +1,61 @@
+/**
+ * @file keyboard/sender/sender_compiled.cpp
+ * @brief Platform-independent part of axidev::io::keyboard::CompiledSequence.
+ *
+ * The event buffer itself (`CompiledSequence::Data`) is defined by each
+ * Sender backend; this file only implements the handle.
+ */
+
+#include <axidev-io/keyboard/sender.hpp>
+
+#include <utility>
+
+#include "keyboard/common/keymap.hpp"
+
+#ifdef __APPLE__
+#include "keyboard/common/macos_keymap.hpp"
+#elif defined(_WIN32)
+#include "keyboard/common/windows_keymap.hpp"
+#elif defined(__linux__)
+#include "keyboard/common/linux_keysym.hpp"
+#endif
+
+namespace axidev::io::keyboard {
+
+namespace {
+
+// Epoch of the last layout the platform's tracker published.
+uint64_t layoutEpoch() {
+#ifdef __APPLE__
+  return detail::macOSLayoutTracker().epoch();
+#elif defined(_WIN32)
+  return detail::windowsLayoutTracker().epoch();
+#elif defined(__linux__)
+  return detail::linuxLayoutTracker().epoch();
+#else
+  return 0;
+#endif
+}
+
+} // namespace
+
+CompiledSequence::CompiledSequence() = default;
+CompiledSequence::~CompiledSequence() = default;
+CompiledSequence::CompiledSequence(const CompiledSequence &) = default;
+CompiledSequence &
+CompiledSequence::operator=(const CompiledSequence &) = default;
+CompiledSequence::CompiledSequence(CompiledSequence &&) noexcept = default;
+CompiledSequence &
+CompiledSequence::operator=(CompiledSequence &&) noexcept = default;
+
+CompiledSequence::CompiledSequence(std::shared_ptr<const Data> data,
+                                   uint64_t generation, uint64_t layoutEpoch)
+    : m_data(std::move(data)), m_generation(generation),
+      m_layoutEpoch(layoutEpoch) {}
+
+bool CompiledSequence::valid() const {
+  return m_data != nullptr && m_generation == KeyMap::generation() &&
+         m_layoutEpoch == layoutEpoch();
+}
+
+} // namespace axidev::io::keyboard
@@ -13,12 +13,21 @@
 #include <ApplicationServices/ApplicationServices.h>
 #include <Carbon/Carbon.h>
 #import <Foundation/Foundation.h>
-#include <chrono>
-#include <thread>
+#include <array>
 #include <axidev-io/log.hpp>
-#include <unordered_map>
-
+#include <mach/mach_time.h>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "keyboard/common/keymap.hpp"
 #include "keyboard/common/macos_keymap.hpp"
+#include "keyboard/common/utf8.hpp"
+#include "keyboard/sender/sender_async.hpp"
+#include "keyboard/sender/sender_pacer.hpp"
+#include "keyboard/sender/sender_sequence.hpp"
 
 namespace axidev::io::keyboard {
 
@@ -48,24 +57,39 @@ CGEventFlags modifierToFlags(Modifier mod) {
 
 } // namespace
 
+namespace detail {
+
+/// Releases a CGEvent owned by a compiled buffer.
+struct CGEventReleaser {
+  void operator()(CGEventRef event) const noexcept { CFRelease(event); }
+};
+using OwnedCGEvent =
+    std::unique_ptr<std::remove_pointer_t<CGEventRef>, CGEventReleaser>;
+
+} // namespace detail
+
+/**
+ * @internal
+ * @brief macOS payload of a CompiledSequence: cached, ready-to-post
+ * `CGEventRef`s.
+ */
+struct CompiledSequence::Data : detail::CompiledBuffer<detail::OwnedCGEvent> {
+};
+
 struct Sender::Impl {
-  // Unicode and UTF-16 surrogate pair constants
-  static constexpr char32_t kUnicodeMaxBMP = 0xFFFF;
-  static constexpr char32_t kUnicodeMax = 0x10FFFF;
-  static constexpr char32_t kUnicodeSurrogateOffset = 0x10000;
-  static constexpr char32_t kUnicodeHighSurrogateBase = 0xD800;
-  static constexpr char32_t kUnicodeLowSurrogateBase = 0xDC00;
-  static constexpr char32_t kUnicodeSurrogateMask = 0x3FF;
   CGEventSourceRef eventSource{nullptr};
   Modifier currentMods{Modifier::None};
   static constexpr uint32_t kDefaultKeyDelayUs = 1000;
-  uint32_t keyDelayUs{kDefaultKeyDelayUs};
+  detail::Pacer pacer{kDefaultKeyDelayUs};
   bool ready{false};
 
-  // Map from our Key enum to macOS keycodes
-  std::unordered_map<Key, CGKeyCode> keyMap;
-  // Map from character to keycode and modifiers
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
+  // Key -> macOS keycode and character -> keycode + modifiers mappings,
+  // shared with every other Sender and Listener on the same input source.
+  std::shared_ptr<const detail::MacOSKeyMap> layoutMap;
+  // KeyMap::generation() the mappings above were built for.
+  uint64_t layoutGeneration{KeyMap::generation()};
+  // Last layout published by `macOSLayoutTracker()` that was adopted.
+  detail::LayoutSubscription layoutUpdates;
 
   Impl()
       : eventSource(CGEventSourceCreate(kCGEventSourceStateHIDSystemState)),
@@ -75,9 +99,9 @@ struct Sender::Impl {
                      static_cast<unsigned>(ready));
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): eventSource=%p", eventSource);
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): keyMap initialized with %zu entries",
-                      keyMap.size());
+                      layoutMap->keyToCode.size());
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): charToKeycode initialized with %zu entries",
-                      charToKeycode.size());
+                      layoutMap->charToKeycode.size());
   }
 
   ~Impl() {
@@ -91,12 +115,14 @@ struct Sender::Impl {
 
   Impl(Impl &&other) noexcept
       : eventSource(other.eventSource), currentMods(other.currentMods),
-        keyDelayUs(other.keyDelayUs), ready(other.ready),
-        keyMap(std::move(other.keyMap)),
-        charToKeycode(std::move(other.charToKeycode)) {
+        pacer(std::move(other.pacer)), ready(other.ready),
+        layoutMap(std::move(other.layoutMap)),
+        layoutGeneration(other.layoutGeneration),
+        layoutUpdates(other.layoutUpdates),
+        keyEvents(std::move(other.keyEvents)),
+        unicodeEvents(std::move(other.unicodeEvents)) {
     other.eventSource = nullptr;
     other.currentMods = Modifier::None;
-    other.keyDelayUs = 0;
     other.ready = false;
   }
 
@@ -109,127 +135,386 @@ struct Sender::Impl {
     }
     eventSource = other.eventSource;
     currentMods = other.currentMods;
-    keyDelayUs = other.keyDelayUs;
+    pacer = std::move(other.pacer);
     ready = other.ready;
-    keyMap = std::move(other.keyMap);
-    charToKeycode = std::move(other.charToKeycode);
+    layoutMap = std::move(other.layoutMap);
+    layoutGeneration = other.layoutGeneration;
+    layoutUpdates = other.layoutUpdates;
+    keyEvents = std::move(other.keyEvents);
+    unicodeEvents = std::move(other.unicodeEvents);
 
     other.eventSource = nullptr;
     other.currentMods = Modifier::None;
-    other.keyDelayUs = 0;
     other.ready = false;
 
     return *this;
   }
 
   void initKeyMap() {
-    auto km = ::axidev::io::keyboard::detail::initMacOSKeyMap();
-    keyMap = std::move(km.keyToCode);
-    charToKeycode = std::move(km.charToKeycode);
+    layoutMap = ::axidev::io::keyboard::detail::acquireMacOSKeyMap();
+  }
+
+  /**
+   * @internal
+   * @brief Reload the layout mappings if `KeyMap::reinitialize()` ran since
+   * they were built, and adopt a layout the tracker published since the last
+   * call.
+   *
+   * Costs two atomic loads when nothing changed, so it runs before every
+   * operation that looks up the mappings.
+   */
+  void syncLayout() {
+    const uint64_t generation = KeyMap::generation();
+    if (generation != layoutGeneration) {
+      AXIDEV_IO_LOG_INFO("Sender (macOS): layout changed, reloading mappings");
+      initKeyMap();
+      layoutGeneration = generation;
+    }
+    if (layoutUpdates.refresh(detail::macOSLayoutTracker(), layoutMap))
+      AXIDEV_IO_LOG_INFO("Sender (macOS): switched to the new layout");
   }
 
   [[nodiscard]] CGKeyCode macKeyCodeFor(Key key) const {
-    auto keyMapIt = keyMap.find(key);
     static constexpr CGKeyCode kInvalidKeyCode = UINT16_MAX;
-    if (keyMapIt != keyMap.end())
-      return keyMapIt->second;
+    if (const int32_t *code = layoutMap->keyToCode.find(key))
+      return static_cast<CGKeyCode>(*code);
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): macKeyCodeFor(key=%s) -> invalid",
-                      keyToString(key).c_str());
+                      keyToStringView(key).data());
     return kInvalidKeyCode;
   }
 
-  bool sendKey(Key key, bool down) const {
+  // Virtual keycodes with a pooled event; every key of a Mac keyboard is
+  // below this.
+  static constexpr CGKeyCode kPooledKeyCodes = 128;
+  // Keyboard events reused for every post, created on first use: one per
+  // pooled keycode and direction, and one down/up pair for Unicode text.
+  // CGEventPost() copies the event, so each post only rewrites the fields
+  // that differ.
+  std::array<detail::OwnedCGEvent, 2 * kPooledKeyCodes> keyEvents;
+  std::array<detail::OwnedCGEvent, 2> unicodeEvents;
+
+  /**
+   * @internal
+   * @brief Post a key transition of @p keyCode carrying @p flags.
+   *
+   * Uses the pooled event of the keycode and direction; keycodes outside the
+   * pool get a one-off event.
+   *
+   * @return false when no event could be created.
+   */
+  bool postKey(CGKeyCode keyCode, bool down, CGEventFlags flags) {
+    detail::OwnedCGEvent oneOff;
+    CGEventRef event = nullptr;
+    if (keyCode < kPooledKeyCodes) {
+      detail::OwnedCGEvent &slot = keyEvents[(keyCode * 2) + (down ? 1 : 0)];
+      if (!slot)
+        slot.reset(CGEventCreateKeyboardEvent(eventSource, keyCode, down));
+      event = slot.get();
+    } else {
+      oneOff.reset(CGEventCreateKeyboardEvent(eventSource, keyCode, down));
+      event = oneOff.get();
+    }
+    if (event == nullptr)
+      return false;
+    CGEventSetFlags(event, flags);
+    CGEventSetTimestamp(event, mach_absolute_time());
+    CGEventPost(kCGHIDEventTap, event);
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Post a Unicode key transition typing @p length UTF-16 units.
+   * @return false when no event could be created.
+   */
+  bool postUnicode(bool down, const UniChar *text, size_t length) {
+    detail::OwnedCGEvent &slot = unicodeEvents[down ? 1 : 0];
+    if (!slot)
+      slot.reset(CGEventCreateKeyboardEvent(eventSource, 0, down));
+    if (!slot)
+      return false;
+    CGEventKeyboardSetUnicodeString(slot.get(), length, text);
+    // A pooled event keeps the flags it was created with; typed text must
+    // not carry a modifier that happened to be held back then.
+    CGEventSetFlags(slot.get(), 0);
+    CGEventSetTimestamp(slot.get(), mach_absolute_time());
+    CGEventPost(kCGHIDEventTap, slot.get());
+    return true;
+  }
+
+  bool sendKey(Key key, bool down) {
     CGKeyCode keyCode = macKeyCodeFor(key);
     static constexpr CGKeyCode kInvalidKeyCode = UINT16_MAX;
     if (keyCode == kInvalidKeyCode) {
       AXIDEV_IO_LOG_DEBUG("Sender (macOS): sendKey - no mapping for key=%s",
-                        keyToString(key).c_str());
+                        keyToStringView(key).data());
       return false;
     }
 
-    CGEventRef event = CGEventCreateKeyboardEvent(eventSource, keyCode, down);
-    if (event == nullptr) {
+    // Apply current modifier state
+    if (!postKey(keyCode, down, modifierToFlags(currentMods))) {
       AXIDEV_IO_LOG_ERROR(
           "Sender (macOS): CGEventCreateKeyboardEvent returned null for key=%s",
-          keyToString(key).c_str());
+          keyToStringView(key).data());
       return false;
     }
-
-    // Apply current modifier state
-    CGEventSetFlags(event, modifierToFlags(currentMods));
-    CGEventPost(kCGHIDEventTap, event);
-    CFRelease(event);
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): sendKey key=%s keycode=%u down=%u",
-                      keyToString(key).c_str(), static_cast<unsigned>(keyCode),
+                      keyToStringView(key).data(),
+                      static_cast<unsigned>(keyCode),
                       static_cast<unsigned>(down));
     return true;
   }
 
-  [[nodiscard]] bool typeUnicode(const std::u32string &text) const {
-    AXIDEV_IO_LOG_DEBUG("Sender (macOS): typeUnicode called len=%zu",
-                      text.size());
-    if (text.empty()) {
-      return true;
+  /**
+   * @internal
+   * @brief A resolved key transition, posted through the event pool.
+   */
+  struct KeyStroke {
+    CGKeyCode keyCode;
+    bool down;
+    CGEventFlags flags;
+  };
+  using StrokeBuffer = detail::CompiledBuffer<KeyStroke>;
+  using EventBuffer = detail::CompiledBuffer<detail::OwnedCGEvent>;
+
+  // Scratch buffer for sendSequence() and compileEvents(), reused across
+  // calls.
+  StrokeBuffer sequenceBuffer;
+
+  /**
+   * @internal
+   * @brief Resolve a raw key sequence into @p out.
+   *
+   * Nothing is posted. Each stroke carries the modifier flags in effect at
+   * that point of the sequence, starting from @p mods; a per-event delay
+   * closes the current run.
+   *
+   * @return false when a key has no mapping.
+   */
+  bool planEvents(StrokeBuffer &out, std::span<const KeyEvent> events,
+                  Modifier mods) const {
+    static constexpr CGKeyCode kInvalidKeyCode = UINT16_MAX;
+    for (const KeyEvent &ev : events) {
+      CGKeyCode keyCode = macKeyCodeFor(ev.key);
+      if (keyCode == kInvalidKeyCode)
+        return false;
+      mods = detail::applyModifierKey(mods, ev.key, ev.down);
+      out.events.push_back({keyCode, ev.down, modifierToFlags(mods)});
+      out.trackModifier(ev.key, ev.down);
+      if (ev.delayUs > 0)
+        out.endSegment(ev.delayUs);
+    }
+    out.endSegment(0);
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Create the CGEvents for a raw key sequence into @p out.
+   *
+   * Unlike the pooled events, these are owned by @p out, so a compiled
+   * sequence can be replayed while this Sender posts other keys.
+   *
+   * @return false when a key has no mapping or an event could not be
+   * created.
+   */
+  bool compileEvents(EventBuffer &out, std::span<const KeyEvent> events,
+                     Modifier mods) {
+    sequenceBuffer.clear();
+    if (!planEvents(sequenceBuffer, events, mods))
+      return false;
+    out.events.reserve(sequenceBuffer.events.size());
+    for (const KeyStroke &stroke : sequenceBuffer.events) {
+      CGEventRef event =
+          CGEventCreateKeyboardEvent(eventSource, stroke.keyCode, stroke.down);
+      if (event == nullptr) {
+        AXIDEV_IO_LOG_ERROR("Sender (macOS): sequence - "
+                            "CGEventCreateKeyboardEvent returned null for "
+                            "keycode=%u",
+                            static_cast<unsigned>(stroke.keyCode));
+        return false;
+      }
+      CGEventSetFlags(event, stroke.flags);
+      out.events.emplace_back(event);
     }
+    out.segments = sequenceBuffer.segments;
+    out.pressedMods = sequenceBuffer.pressedMods;
+    out.releasedMods = sequenceBuffer.releasedMods;
+    return true;
+  }
 
-    // Convert to UTF-16
-    std::vector<UniChar> utf16;
-    for (char32_t codepoint : text) {
-      if (codepoint <= kUnicodeMaxBMP) {
-        utf16.push_back(static_cast<UniChar>(codepoint));
-      } else if (codepoint <= kUnicodeMax) {
-        char32_t codepointTmp = codepoint - kUnicodeSurrogateOffset;
-        utf16.push_back(
-            static_cast<UniChar>(kUnicodeHighSurrogateBase |
-                                 (static_cast<uint32_t>(codepointTmp) >> 10)));
-        utf16.push_back(static_cast<UniChar>(
-            kUnicodeLowSurrogateBase |
-            (static_cast<uint32_t>(codepointTmp) & kUnicodeSurrogateMask)));
+  /**
+   * @internal
+   * @brief Create the Unicode CGEvents typing `utf16` into @p out.
+   * @return false when an event could not be created.
+   */
+  bool compileText(EventBuffer &out) const {
+    for (size_t utf16Index = 0; utf16Index < utf16.size();) {
+      const size_t chunkLength = chunkLengthAt(utf16Index);
+      for (bool down : {true, false}) {
+        CGEventRef event = CGEventCreateKeyboardEvent(eventSource, 0, down);
+        if (event == nullptr) {
+          AXIDEV_IO_LOG_ERROR(
+              "Sender (macOS): compileText failed to create CGEvents");
+          return false;
+        }
+        CGEventKeyboardSetUnicodeString(event, chunkLength,
+                                        &utf16[utf16Index]);
+        out.events.emplace_back(event);
       }
+      utf16Index += chunkLength;
     }
+    out.endSegment(0);
+    return true;
+  }
 
-    // macOS limit: 20 characters per event
-    static constexpr size_t kMaxCharsPerEvent = 20;
+  /**
+   * @internal
+   * @brief Post a compiled buffer in one tight loop per run.
+   */
+  bool submit(const EventBuffer &buffer) {
+    const bool ok = buffer.replay(
+        [](const detail::OwnedCGEvent *first, size_t count) {
+          for (size_t i = 0; i < count; ++i)
+            CGEventPost(kCGHIDEventTap, first[i].get());
+          return true;
+        },
+        [this](uint32_t pauseUs) { pacer.pause(pauseUs); });
+    currentMods = buffer.applyTo(currentMods);
+    return ok;
+  }
 
-    for (size_t utf16Index = 0; utf16Index < utf16.size();
-         utf16Index += kMaxCharsPerEvent) {
-      size_t chunkLength =
-          std::min(kMaxCharsPerEvent, utf16.size() - utf16Index);
+  /**
+   * @internal
+   * @brief Post a resolved stroke buffer through the event pool.
+   * @return false when an event could not be created.
+   */
+  bool submit(const StrokeBuffer &buffer) {
+    const bool ok = buffer.replay(
+        [this](const KeyStroke *first, size_t count) {
+          for (size_t i = 0; i < count; ++i) {
+            if (!postKey(first[i].keyCode, first[i].down, first[i].flags)) {
+              AXIDEV_IO_LOG_ERROR("Sender (macOS): sequence - "
+                                  "CGEventCreateKeyboardEvent returned null "
+                                  "for keycode=%u",
+                                  static_cast<unsigned>(first[i].keyCode));
+              return false;
+            }
+          }
+          return true;
+        },
+        [this](uint32_t pauseUs) { pacer.pause(pauseUs); });
+    currentMods = buffer.applyTo(currentMods);
+    return ok;
+  }
 
-      CGEventRef eventDown = CGEventCreateKeyboardEvent(eventSource, 0, true);
-      CGEventRef eventUp = CGEventCreateKeyboardEvent(eventSource, 0, false);
-      if ((eventDown == nullptr) || (eventUp == nullptr)) {
-        if (eventDown != nullptr) {
-          CFRelease(eventDown);
-        }
-        if (eventUp != nullptr) {
-          CFRelease(eventUp);
-        }
+  bool sendSequence(std::span<const KeyEvent> events) {
+    syncLayout();
+    sequenceBuffer.clear();
+    return planEvents(sequenceBuffer, events, currentMods) &&
+           submit(sequenceBuffer);
+  }
+
+  // macOS limit: 20 characters per event
+  static constexpr size_t kMaxCharsPerEvent = 20;
+
+  // UTF-16 text for the next typeUnicode()/compileText(), reused across calls
+  // so typing does not allocate once it has grown to the longest text so far.
+  std::vector<UniChar> utf16;
+  // Characters posted by the last typeText() call.
+  size_t lastTyped{0};
+
+  /**
+   * @internal
+   * @brief Encode UTF-8 @p text into `utf16`.
+   * @return false (with a warning) if the text is not well-formed UTF-8.
+   */
+  bool encodeText(std::string_view text) {
+    lastTyped = 0;
+    utf16.clear();
+    if (!detail::appendUtf8AsUtf16(text, utf16)) {
+      AXIDEV_IO_LOG_WARN("Sender (macOS): rejecting ill-formed UTF-8 text");
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Encode UTF-32 @p text into `utf16`.
+   * @return false (with a warning) if @p text holds a surrogate or a value
+   * above U+10FFFF.
+   */
+  bool encodeText(std::u32string_view text) {
+    lastTyped = 0;
+    utf16.clear();
+    if (!detail::appendUtf32AsUtf16(text, utf16)) {
+      AXIDEV_IO_LOG_WARN("Sender (macOS): rejecting invalid UTF-32 text");
+      return false;
+    }
+    return true;
+  }
+
+  /// Number of characters (low surrogates excluded) in a `utf16` range.
+  [[nodiscard]] size_t charactersIn(size_t index, size_t length) const {
+    size_t chars = 0;
+    for (size_t i = index; i < index + length; ++i) {
+      if (utf16[i] < 0xDC00 || utf16[i] > 0xDFFF)
+        ++chars;
+    }
+    return chars;
+  }
+
+  /**
+   * @internal
+   * @brief Length of the `utf16` chunk starting at @p index.
+   *
+   * At most `kMaxCharsPerEvent` units, shortened by one rather than splitting
+   * a surrogate pair across two events.
+   */
+  [[nodiscard]] size_t chunkLengthAt(size_t index) const {
+    size_t length = std::min(kMaxCharsPerEvent, utf16.size() - index);
+    const UniChar last = utf16[index + length - 1];
+    if (length > 1 && index + length < utf16.size() && last >= 0xD800 &&
+        last <= 0xDBFF)
+      --length;
+    return length;
+  }
+
+  /**
+   * @internal
+   * @brief Post `utf16` as Unicode keyboard events, one chunk at a time.
+   *
+   * `lastTyped` counts the characters of every chunk posted so far.
+   */
+  [[nodiscard]] bool typeUnicode() {
+    AXIDEV_IO_LOG_DEBUG("Sender (macOS): typeUnicode called len=%zu",
+                      utf16.size());
+    if (utf16.empty()) {
+      return true;
+    }
+
+    for (size_t utf16Index = 0; utf16Index < utf16.size();) {
+      const size_t chunkLength = chunkLengthAt(utf16Index);
+      if (!postUnicode(true, &utf16[utf16Index], chunkLength) ||
+          !postUnicode(false, &utf16[utf16Index], chunkLength)) {
         AXIDEV_IO_LOG_ERROR(
             "Sender (macOS): typeUnicode failed to create CGEvents for chunk");
         return false;
       }
-
-      CGEventKeyboardSetUnicodeString(eventDown, chunkLength,
-                                      &utf16[utf16Index]);
-      CGEventKeyboardSetUnicodeString(eventUp, chunkLength, &utf16[utf16Index]);
-
-      CGEventPost(kCGHIDEventTap, eventDown);
-      CGEventPost(kCGHIDEventTap, eventUp);
+      lastTyped += charactersIn(utf16Index, chunkLength);
       AXIDEV_IO_LOG_DEBUG("Sender (macOS): posted unicode chunk length=%zu",
                         chunkLength);
-
-      CFRelease(eventDown);
-      CFRelease(eventUp);
+      utf16Index += chunkLength;
     }
     AXIDEV_IO_LOG_DEBUG("Sender (macOS): typeUnicode completed");
     return true;
   }
 
-  void delay() const {
-    if (keyDelayUs > 0) {
-      AXIDEV_IO_LOG_DEBUG("Sender (macOS): delay %u us", keyDelayUs);
-      std::this_thread::sleep_for(std::chrono::microseconds(keyDelayUs));
+  void delay() {
+    if (pacer.interval() > 0) {
+      AXIDEV_IO_LOG_DEBUG("Sender (macOS): delay %u us", pacer.interval());
+      pacer.wait();
     }
   }
 };
@@ -239,8 +524,21 @@ Sender::Sender() : m_impl(std::make_unique<Impl>()) {
                    static_cast<unsigned>(isReady()));
 }
 Sender::~Sender() = default;
-Sender::Sender(Sender &&) noexcept = default;
-Sender &Sender::operator=(Sender &&) noexcept = default;
+// The injection thread holds a reference to the Sender it was started on, so
+// async mode is stopped before the backend changes hands. Queued commands
+// are discarded rather than run, as a noexcept move must not block on them.
+Sender::Sender(Sender &&other) noexcept {
+  other.discardAsync();
+  m_impl = std::move(other.m_impl);
+}
+Sender &Sender::operator=(Sender &&other) noexcept {
+  if (this != &other) {
+    discardAsync();
+    other.discardAsync();
+    m_impl = std::move(other.m_impl);
+  }
+  return *this;
+}
 
 BackendType Sender::type() const {
   AXIDEV_IO_LOG_DEBUG("Sender::type() -> MacOS");
@@ -266,6 +564,9 @@ bool Sender::isReady() const {
   return r;
 }
 
+// CGEventPost needs no device setup.
+bool Sender::waitUntilReady(uint32_t /*timeoutMs*/) { return isReady(); }
+
 bool Sender::requestPermissions() {
   AXIDEV_IO_LOG_DEBUG("Sender::requestPermissions() called (macOS)");
   NSDictionary *opts =
@@ -332,9 +633,61 @@ bool Sender::sendRawKey(Key key, bool down) {
       break;
     }
   }
+  m_impl->syncLayout();
   return m_impl->sendKey(key, down);
 }
 
+bool Sender::sendSequence(std::span<const KeyEvent> events) {
+  return m_impl && m_impl->sendSequence(events);
+}
+
+CompiledSequence Sender::compile(std::span<const KeyEvent> events) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileEvents(*data, events, Modifier::None))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+CompiledSequence Sender::compile(std::u32string_view text) {
+  if (!m_impl || !m_impl->encodeText(text))
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileText(*data))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+CompiledSequence Sender::compile(std::string_view utf8Text) {
+  if (!m_impl || !m_impl->encodeText(utf8Text))
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileText(*data))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+bool Sender::replay(const CompiledSequence &sequence) {
+  if (!m_impl)
+    return false;
+  // Adopt a pending layout switch first, so that a sequence compiled for
+  // the previous layout is refused rather than typed with the wrong keys.
+  m_impl->syncLayout();
+  if (!sequence.valid() ||
+      sequence.m_layoutEpoch != m_impl->layoutUpdates.epoch()) {
+    AXIDEV_IO_LOG_DEBUG("Sender (macOS): replay of an invalid sequence");
+    return false;
+  }
+  return m_impl->submit(*sequence.m_data);
+}
+
 bool Sender::keyDown(KeyWithModifier keyMod) {
   AXIDEV_IO_LOG_DEBUG(
       "Sender::keyDown(%s)",
@@ -433,83 +786,21 @@ bool Sender::releaseAllModifiers() {
   return ok;
 }
 
-bool Sender::typeText(const std::u32string &text) {
+bool Sender::typeText(std::u32string_view text) {
   AXIDEV_IO_LOG_DEBUG("Sender::typeText (utf32) called with %zu codepoints",
                     text.size());
-  return m_impl->typeUnicode(text);
+  return m_impl->encodeText(text) && m_impl->typeUnicode();
 }
 
-bool Sender::typeText(const std::string &utf8Text) {
+bool Sender::typeText(std::string_view utf8Text) {
   AXIDEV_IO_LOG_DEBUG("Sender::typeText (utf8) called len=%zu", utf8Text.size());
-  std::u32string utf32;
-  size_t utf8Index = 0;
-  static constexpr unsigned char kUtf8Mask6 = 0x3F;
-  static constexpr unsigned char kUtf8Mask5 = 0x1F;
-  static constexpr unsigned char kUtf8Mask4 = 0x0F;
-  static constexpr unsigned char kUtf8Mask3 = 0x07;
-  static constexpr unsigned char kUtf8Mask7 = 0x80;
-  static constexpr unsigned char kUtf8Mask8 = 0xC0;
-  static constexpr unsigned char kUtf8Mask9 = 0xE0;
-  static constexpr unsigned char kUtf8Mask10 = 0xF0;
-  static constexpr unsigned char kUtf8Mask11 = 0xF8;
-  static constexpr unsigned int kUtf8Shift6 = 6;
-  static constexpr unsigned int kUtf8Shift12 = 12;
-  static constexpr unsigned int kUtf8Shift18 = 18;
-
-  while (utf8Index < utf8Text.size()) {
-    char32_t decodedCodepoint = 0;
-    auto utf8Char = static_cast<unsigned char>(utf8Text[utf8Index]);
-    if ((utf8Char & kUtf8Mask7) == 0) {
-      decodedCodepoint = utf8Char;
-      utf8Index += 1;
-    } else if ((utf8Char & kUtf8Mask9) == kUtf8Mask8) {
-      decodedCodepoint = (utf8Char & kUtf8Mask5) << kUtf8Shift6;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |= (utf8Text[utf8Index + 1] & 0x3F);
-      }
-      utf8Index += 2;
-    } else if ((utf8Char & kUtf8Mask10) == kUtf8Mask9) {
-      decodedCodepoint = (utf8Char & kUtf8Mask4) << kUtf8Shift12;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 1]) & kUtf8Mask6)
-            << kUtf8Shift6;
-      }
-      if (utf8Index + 2 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 2]) & kUtf8Mask6);
-      }
-      utf8Index += 3;
-    } else if ((utf8Char & kUtf8Mask11) == kUtf8Mask10) {
-      decodedCodepoint = (utf8Char & kUtf8Mask3) << kUtf8Shift18;
-      if (utf8Index + 1 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 1]) & kUtf8Mask6)
-            << kUtf8Shift12;
-      }
-      if (utf8Index + 2 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 2]) & kUtf8Mask6)
-            << kUtf8Shift6;
-      }
-      if (utf8Index + 3 < utf8Text.size()) {
-        decodedCodepoint |=
-            (static_cast<unsigned char>(utf8Text[utf8Index + 3]) & kUtf8Mask6);
-      }
-      utf8Index += 4;
-    } else {
-      utf8Index += 1;
-      continue;
-    }
-    utf32.push_back(decodedCodepoint);
-  }
-  return typeText(utf32);
+  return m_impl->encodeText(utf8Text) && m_impl->typeUnicode();
 }
 
 bool Sender::typeCharacter(char32_t codepoint) {
   AXIDEV_IO_LOG_DEBUG("Sender::typeCharacter(codepoint=%u)",
                     static_cast<unsigned>(codepoint));
-  return typeText(std::u32string(1, codepoint));
+  return typeText(std::u32string_view(&codepoint, 1));
 }
 
 void Sender::flush() {
@@ -519,9 +810,22 @@ void Sender::flush() {
 
 void Sender::setKeyDelay(uint32_t delayUs) {
   AXIDEV_IO_LOG_DEBUG("Sender::setKeyDelay(%u)", delayUs);
-  m_impl->keyDelayUs = delayUs;
+  m_impl->pacer.setInterval(delayUs);
+}
+
+void Sender::setKeyDelaySpin(uint32_t spinUs) {
+  AXIDEV_IO_LOG_DEBUG("Sender::setKeyDelaySpin(%u)", spinUs);
+  m_impl->pacer.setSpinUs(spinUs);
 }
 
+// Text is already posted kMaxCharsPerEvent UTF-16 units per event, so the
+// batch size has nothing to bound here.
+void Sender::setTextBatchSize(size_t characters) {
+  AXIDEV_IO_LOG_DEBUG("Sender::setTextBatchSize(%zu) ignored", characters);
+}
+
+size_t Sender::lastTypedCount() const { return m_impl->lastTyped; }
+
 } // namespace axidev::io::keyboard
 
 #endif // __APPLE__
@@ -0,0 +1,178 @@
+/**
+ * @file keyboard/sender/sender_pacer.cpp
+ * @brief Deadline-based pacing shared by the Sender backends.
+ */
+
+#include "keyboard/sender/sender_pacer.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace axidev::io::keyboard::detail {
+
+namespace {
+
+constexpr int64_t kNsPerSec = 1'000'000'000;
+
+// The spin set by setSpinUs() never takes more than 1/kSpinFractionDivisor
+// of a wait, so a short interval is not turned into a busy loop.
+constexpr int64_t kSpinFractionDivisor = 8;
+
+#if defined(__APPLE__)
+const mach_timebase_info_data_t &timebase() {
+  static const mach_timebase_info_data_t info = [] {
+    mach_timebase_info_data_t tb{};
+    mach_timebase_info(&tb);
+    return tb;
+  }();
+  return info;
+}
+#endif
+
+} // namespace
+
+Pacer::Pacer(uint32_t intervalUs) : intervalUs_(intervalUs) {
+#if defined(_WIN32)
+  timer_ = CreateWaitableTimerExW(nullptr, nullptr,
+                                  CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                  TIMER_ALL_ACCESS);
+#endif
+}
+
+Pacer::~Pacer() {
+#if defined(_WIN32)
+  if (timer_ != nullptr)
+    CloseHandle(timer_);
+#endif
+}
+
+Pacer::Pacer(Pacer &&other) noexcept
+    : intervalUs_(other.intervalUs_), spinNs_(other.spinNs_),
+      deadlineNs_(other.deadlineNs_) {
+#if defined(_WIN32)
+  timer_ = std::exchange(other.timer_, nullptr);
+#endif
+}
+
+Pacer &Pacer::operator=(Pacer &&other) noexcept {
+  if (this == &other)
+    return *this;
+  intervalUs_ = other.intervalUs_;
+  spinNs_ = other.spinNs_;
+  deadlineNs_ = other.deadlineNs_;
+#if defined(_WIN32)
+  if (timer_ != nullptr)
+    CloseHandle(timer_);
+  timer_ = std::exchange(other.timer_, nullptr);
+#endif
+  return *this;
+}
+
+void Pacer::setInterval(uint32_t intervalUs) noexcept {
+  intervalUs_ = intervalUs;
+}
+
+void Pacer::setSpinUs(uint32_t spinUs) noexcept {
+  spinNs_ = static_cast<int64_t>(spinUs) * 1000;
+}
+
+int64_t Pacer::nowNs() noexcept {
+#if defined(_WIN32)
+  static const int64_t freq = [] {
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    return static_cast<int64_t>(f.QuadPart);
+  }();
+  LARGE_INTEGER c;
+  QueryPerformanceCounter(&c);
+  const int64_t ticks = static_cast<int64_t>(c.QuadPart);
+  return (ticks / freq) * kNsPerSec + (ticks % freq) * kNsPerSec / freq;
+#elif defined(__APPLE__)
+  const auto &tb = timebase();
+  const auto ticks = static_cast<int64_t>(mach_absolute_time());
+  return (ticks / tb.denom) * tb.numer +
+         (ticks % tb.denom) * tb.numer / tb.denom;
+#else
+  struct timespec ts{};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * kNsPerSec + ts.tv_nsec;
+#endif
+}
+
+void Pacer::wait() noexcept {
+  if (intervalUs_ == 0)
+    return;
+  const int64_t intervalNs = static_cast<int64_t>(intervalUs_) * 1000;
+  const int64_t now = nowNs();
+  int64_t deadline = deadlineNs_ + intervalNs;
+  // More than one interval behind the previous deadline: start a new chain
+  // rather than issuing the missed waits back to back.
+  if (deadline < now)
+    deadline = now + intervalNs;
+  sleepUntil(deadline);
+  deadlineNs_ = deadline;
+}
+
+void Pacer::pause(uint32_t delayUs) noexcept {
+  if (delayUs == 0)
+    return;
+  const int64_t deadline = nowNs() + static_cast<int64_t>(delayUs) * 1000;
+  sleepUntil(deadline);
+  deadlineNs_ = deadline;
+}
+
+void Pacer::sleepUntil(int64_t deadlineNs) noexcept {
+  const int64_t now = nowNs();
+  if (now >= deadlineNs)
+    return;
+  const int64_t spinNs =
+      std::min(spinNs_, (deadlineNs - now) / kSpinFractionDivisor);
+  const int64_t sleepTarget = deadlineNs - spinNs;
+#if defined(_WIN32)
+  const int64_t remaining = sleepTarget - now;
+  if (remaining > 0) {
+    if (timer_ != nullptr) {
+      LARGE_INTEGER due;
+      due.QuadPart = -(remaining / 100); // relative, in 100 ns units
+      if (SetWaitableTimer(timer_, &due, 0, nullptr, nullptr, FALSE))
+        WaitForSingleObject(timer_, INFINITE);
+    } else if (remaining >= 1'000'000) {
+      Sleep(static_cast<DWORD>(remaining / 1'000'000));
+    }
+  }
+#elif defined(__APPLE__)
+  if (sleepTarget > now) {
+    const auto &tb = timebase();
+    const auto ns = static_cast<uint64_t>(sleepTarget);
+    mach_wait_until((ns / tb.numer) * tb.denom +
+                    (ns % tb.numer) * tb.denom / tb.numer);
+  }
+#else
+  if (sleepTarget > now) {
+    struct timespec ts{};
+    ts.tv_sec = static_cast<time_t>(sleepTarget / kNsPerSec);
+    ts.tv_nsec = static_cast<long>(sleepTarget % kNsPerSec);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
+    }
+  }
+#endif
+  if (spinNs == 0)
+    return;
+  while (nowNs() < deadlineNs) {
+  }
+}
+
+} // namespace axidev::io::keyboard::detail
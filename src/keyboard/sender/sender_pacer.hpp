@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file keyboard/sender/sender_pacer.hpp
+ * @brief Internal deadline-based pacing for Sender key delays.
+ *
+ * Every Sender backend spaces synthesized events by `Sender::setKeyDelay()`.
+ * Sleeping for the delay after each event lets oversleep and the time spent
+ * emitting events add up over a long string; the pacer instead schedules each
+ * event against an absolute deadline on the monotonic clock, so the error of
+ * one wait is absorbed by the next.
+ */
+
+#include <cstdint>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief Waits for successive deadlines spaced by a fixed interval.
+ *
+ * The platform wait is `clock_nanosleep(TIMER_ABSTIME)` on Linux,
+ * `mach_wait_until()` on macOS and a high-resolution waitable timer on
+ * Windows (falling back to `Sleep()` on systems without one). By default
+ * the thread sleeps for the whole wait. `setSpinUs()` opts into stopping
+ * short of the deadline and spinning the rest, for callers that need
+ * sub-millisecond accuracy from a coarse timer; the spin is capped to an
+ * eighth of each wait.
+ *
+ * Deadlines chain from one `wait()` to the next. When the caller falls more
+ * than one interval behind (an idle gap between API calls, or emitting took
+ * longer than the delay), the chain restarts from the current time instead
+ * of firing a catch-up burst.
+ */
+class Pacer {
+public:
+  explicit Pacer(uint32_t intervalUs = 0);
+  ~Pacer();
+
+  Pacer(const Pacer &) = delete;
+  Pacer &operator=(const Pacer &) = delete;
+  Pacer(Pacer &&other) noexcept;
+  Pacer &operator=(Pacer &&other) noexcept;
+
+  /// Set the spacing between deadlines; 0 makes `wait()` a no-op.
+  void setInterval(uint32_t intervalUs) noexcept;
+  uint32_t interval() const noexcept { return intervalUs_; }
+
+  /// Busy-wait the last @p spinUs of each wait instead of sleeping; 0 (the
+  /// default) always sleeps.
+  void setSpinUs(uint32_t spinUs) noexcept;
+
+  /// Block until the next deadline.
+  void wait() noexcept;
+
+  /// Block for @p delayUs from now; the next `wait()` chains from its end.
+  void pause(uint32_t delayUs) noexcept;
+
+  /// Current monotonic time in nanoseconds.
+  static int64_t nowNs() noexcept;
+
+private:
+  void sleepUntil(int64_t deadlineNs) noexcept;
+
+  uint32_t intervalUs_{0};
+  int64_t spinNs_{0};
+  int64_t deadlineNs_{0};
+#if defined(_WIN32)
+  void *timer_{nullptr}; // waitable timer HANDLE
+#endif
+};
+
+} // namespace axidev::io::keyboard::detail
@@ -0,0 +1,131 @@
+#pragma once
+/**
+ * @file keyboard/sender/sender_sequence.hpp
+ * @brief Internal helpers shared by the `Sender::sendSequence()` and
+ * `Sender::compile()` backends.
+ */
+
+#include <axidev-io/keyboard/common.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief Modifier flag contributed by a modifier key.
+ * @return The flag for left/right Shift, Ctrl, Alt and Super; `None` for any
+ * other key.
+ */
+inline Modifier modifierForKey(Key key) noexcept {
+  switch (key) {
+  case Key::ShiftLeft:
+  case Key::ShiftRight:
+    return Modifier::Shift;
+  case Key::CtrlLeft:
+  case Key::CtrlRight:
+    return Modifier::Ctrl;
+  case Key::AltLeft:
+  case Key::AltRight:
+    return Modifier::Alt;
+  case Key::SuperLeft:
+  case Key::SuperRight:
+    return Modifier::Super;
+  default:
+    return Modifier::None;
+  }
+}
+
+/**
+ * @internal
+ * @brief Tracked modifier state after @p key is pressed or released.
+ */
+inline Modifier applyModifierKey(Modifier state, Key key, bool down) noexcept {
+  const Modifier flag = modifierForKey(key);
+  if (flag == Modifier::None)
+    return state;
+  return down ? (state | flag)
+              : static_cast<Modifier>(static_cast<uint8_t>(state) &
+                                      ~static_cast<uint8_t>(flag));
+}
+
+/**
+ * @internal
+ * @brief Backend-native events split into runs submitted in one call each.
+ *
+ * Each segment ends a run at an index into `events` and carries the pause
+ * that follows it. Builders close the buffer with `endSegment(0)` so every
+ * event belongs to a segment. The net effect of the modifier keys in the
+ * buffer is tracked so replaying it can update the sender's modifier state
+ * without rescanning the events.
+ *
+ * @tparam Native Backend event record (`INPUT`, `input_event`, ...).
+ */
+template <typename Native> struct CompiledBuffer {
+  struct Segment {
+    size_t end;       ///< One past the last event of the run.
+    uint32_t pauseUs; ///< Pause after the run, in microseconds.
+  };
+
+  std::vector<Native> events;
+  std::vector<Segment> segments;
+  Modifier pressedMods{Modifier::None};  ///< Left held after a replay.
+  Modifier releasedMods{Modifier::None}; ///< Left released after a replay.
+
+  void clear() {
+    events.clear();
+    segments.clear();
+    pressedMods = Modifier::None;
+    releasedMods = Modifier::None;
+  }
+
+  /// Close the current run; @p pauseUs elapses before the next one starts.
+  void endSegment(uint32_t pauseUs) {
+    const size_t start = segments.empty() ? 0 : segments.back().end;
+    if (start == events.size() && !segments.empty()) {
+      segments.back().pauseUs += pauseUs;
+      return;
+    }
+    segments.push_back({events.size(), pauseUs});
+  }
+
+  /// Record that @p key goes down or up at this point of the buffer.
+  void trackModifier(Key key, bool down) {
+    const auto flag = static_cast<uint8_t>(modifierForKey(key));
+    auto &set = down ? pressedMods : releasedMods;
+    auto &unset = down ? releasedMods : pressedMods;
+    set = static_cast<Modifier>(static_cast<uint8_t>(set) | flag);
+    unset = static_cast<Modifier>(static_cast<uint8_t>(unset) & ~flag);
+  }
+
+  /// Modifier state after replaying the buffer from @p state.
+  Modifier applyTo(Modifier state) const {
+    return static_cast<Modifier>(
+        (static_cast<uint8_t>(state) & ~static_cast<uint8_t>(releasedMods)) |
+        static_cast<uint8_t>(pressedMods));
+  }
+
+  /**
+   * @brief Submit every run in order, pausing between runs.
+   * @param submit Callable `bool(const Native *first, size_t count)`.
+   * @param pause Callable `void(uint32_t pauseUs)`.
+   * @return false as soon as a submission fails.
+   */
+  template <typename Submit, typename Pause>
+  bool replay(Submit &&submit, Pause &&pause) const {
+    size_t first = 0;
+    for (const Segment &segment : segments) {
+      if (segment.end > first &&
+          !submit(events.data() + first, segment.end - first))
+        return false;
+      first = segment.end;
+      if (segment.pauseUs > 0)
+        pause(segment.pauseUs);
+    }
+    return true;
+  }
+};
+
+} // namespace axidev::io::keyboard::detail
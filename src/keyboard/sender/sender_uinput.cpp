@@ -18,242 +18,283 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <errno.h>
-#include <fcntl.h>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <linux/input.h>
 #include <linux/uinput.h>
-#include <sys/ioctl.h>
 #include <thread>
 #include <unistd.h>
-#include <unordered_map>
-#include <xkbcommon/xkbcommon.h>
+#include <utility>
+#include <vector>
 
+#include "keyboard/common/keymap.hpp"
 #include "keyboard/common/linux_keysym.hpp"
 #include "keyboard/common/linux_layout.hpp"
+#include "keyboard/common/utf8.hpp"
+#include "keyboard/sender/sender_async.hpp"
+#include "keyboard/sender/sender_pacer.hpp"
+#include "keyboard/sender/sender_sequence.hpp"
+#include "keyboard/sender/uinput_device.hpp"
 
 namespace axidev::io::keyboard {
 
+/**
+ * @internal
+ * @brief uinput payload of a CompiledSequence: ready-to-write EV_KEY and
+ * SYN_REPORT records.
+ */
+struct CompiledSequence::Data : detail::CompiledBuffer<struct input_event> {};
+
 /**
  * @internal
  * @brief Pimpl for Sender (uinput backend).
  *
- * Manages the uinput device file descriptor, XKB context/keymap/state, and
- * layout-aware mappings from logical `Key` values and Unicode characters to
- * evdev keycodes. These members and methods are internal implementation
- * details and are not part of the public API.
+ * Holds a reference on the process-wide uinput device (see
+ * `detail::UinputDevice`) and the shared layout-aware mappings from logical
+ * `Key` values and Unicode characters to evdev keycodes. These members and
+ * methods are internal implementation details and are not part of the public
+ * API.
  */
 struct Sender::Impl {
-  int fd{-1};
+  // Process-wide virtual keyboard, shared with every other Sender.
+  std::shared_ptr<detail::UinputDevice> device{detail::UinputDevice::acquire()};
   Modifier currentMods{Modifier::None};
-  uint32_t keyDelayUs{1000};
+  detail::Pacer pacer{1000};
 
   // Layout-aware mappings: character/Key -> evdev keycode with required
-  // modifiers
-  std::unordered_map<Key, int> keyMap;
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
-
-  // XKB context for layout detection
-  struct xkb_context *xkbCtx{nullptr};
-  struct xkb_keymap *xkbKeymap{nullptr};
-  struct xkb_state *xkbState{nullptr};
+  // modifiers. The snapshot is shared with every other Sender and Listener
+  // on the same layout; it stays empty when the device could not be created.
+  std::shared_ptr<const detail::LinuxKeyMap> layoutMap{
+      std::make_shared<const detail::LinuxKeyMap>()};
+  // KeyMap::generation() the mappings above were built for.
+  uint64_t layoutGeneration{KeyMap::generation()};
+  // Last layout published by `linuxLayoutTracker()` that was adopted.
+  detail::LayoutSubscription layoutUpdates;
+
+  // Events queued by emit() and not yet written to the device. Writes are
+  // coalesced per logical group (see Batch) so that a tap or a whole string
+  // typed with no key delay costs a single write() syscall.
+  static constexpr size_t kMaxPendingEvents = 256;
+  std::vector<struct input_event> pending;
+  int batchDepth{0};
+  // Set when writePending() fails; typeCodepoints() resets it and stops
+  // typing once it is set.
+  bool writeFailed{false};
+  // Characters injected by the last typeText() call.
+  size_t lastTyped{0};
+
+  // Keys pressed through the device by this Sender and not yet released;
+  // maintained by `UinputDevice::write()`.
+  detail::UinputDevice::HeldKeys heldKeys;
 
-  Impl() {
-    fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
-    if (fd < 0) {
-      AXIDEV_IO_LOG_ERROR("Sender (uinput): failed to open /dev/uinput: %s",
-                          strerror(errno));
-      return;
+  /**
+   * @internal
+   * @brief RAII scope grouping emitted events into a single device write.
+   *
+   * While at least one Batch is alive, events accumulate in `pending` and
+   * are only written when the buffer fills, before a key delay sleep, or when
+   * the outermost Batch is destroyed. Scopes nest, so a `tap()` inside a
+   * `typeText()` call does not flush early. A null Impl is tolerated so that
+   * public methods can open a scope before their own null check.
+   */
+  class Batch {
+  public:
+    explicit Batch(Impl *impl) : impl_(impl) {
+      if (impl_)
+        ++impl_->batchDepth;
     }
-
-    ioctl(fd, UI_SET_EVBIT, EV_KEY);
-
-#ifdef KEY_MAX
-    for (int i = 0; i < KEY_MAX; ++i) {
-      ioctl(fd, UI_SET_KEYBIT, i);
+    ~Batch() {
+      if (impl_ && --impl_->batchDepth == 0)
+        impl_->writePending();
     }
-#endif
-
-    struct uinput_setup usetup{};
-    std::memset(&usetup, 0, sizeof(usetup));
-    usetup.id.bustype = BUS_USB;
-    usetup.id.vendor = 0x1234;
-    usetup.id.product = 0x5678;
-    std::strncpy(usetup.name, "Virtual Keyboard", UINPUT_MAX_NAME_SIZE - 1);
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
 
-    ioctl(fd, UI_DEV_SETUP, &usetup);
-    ioctl(fd, UI_DEV_CREATE);
+  private:
+    Impl *impl_;
+  };
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Impl() {
+    pending.reserve(kMaxPendingEvents);
+    if (!hasDevice())
+      return;
 
-    initXkb();
     initKeyMap();
 
     AXIDEV_IO_LOG_INFO(
-        "Sender (uinput): device initialized fd=%d keymap_entries=%zu "
+        "Sender (uinput): initialized fd=%d keymap_entries=%zu "
         "char_entries=%zu",
-        fd, keyMap.size(), charToKeycode.size());
+        device->fd(), layoutMap->keyToEvdev.size(),
+        layoutMap->charToKeycode.size());
   }
 
   ~Impl() {
-    if (xkbState)
-      xkb_state_unref(xkbState);
-    if (xkbKeymap)
-      xkb_keymap_unref(xkbKeymap);
-    if (xkbCtx)
-      xkb_context_unref(xkbCtx);
-
-    if (fd >= 0) {
-      ioctl(fd, UI_DEV_DESTROY);
-      close(fd);
-      AXIDEV_IO_LOG_INFO("Sender (uinput): device destroyed (fd=%d)", fd);
-    }
+    writePending();
+    releaseHeldKeys();
   }
 
   Impl(const Impl &) = delete;
   Impl &operator=(const Impl &) = delete;
   Impl(Impl &&other) noexcept
-      : fd(other.fd), currentMods(other.currentMods),
-        keyDelayUs(other.keyDelayUs), keyMap(std::move(other.keyMap)),
-        charToKeycode(std::move(other.charToKeycode)), xkbCtx(other.xkbCtx),
-        xkbKeymap(other.xkbKeymap), xkbState(other.xkbState) {
-    other.fd = -1;
-    other.xkbCtx = nullptr;
-    other.xkbKeymap = nullptr;
-    other.xkbState = nullptr;
+      : device(std::move(other.device)), currentMods(other.currentMods),
+        pacer(std::move(other.pacer)), layoutMap(std::move(other.layoutMap)),
+        layoutGeneration(other.layoutGeneration),
+        layoutUpdates(other.layoutUpdates), pending(std::move(other.pending)),
+        batchDepth(other.batchDepth),
+        heldKeys(other.heldKeys) {
+    other.heldKeys.reset();
   }
 
   Impl &operator=(Impl &&other) noexcept {
     if (this == &other)
       return *this;
 
-    if (xkbState)
-      xkb_state_unref(xkbState);
-    if (xkbKeymap)
-      xkb_keymap_unref(xkbKeymap);
-    if (xkbCtx)
-      xkb_context_unref(xkbCtx);
-    if (fd >= 0) {
-      ioctl(fd, UI_DEV_DESTROY);
-      close(fd);
-    }
+    writePending();
+    releaseHeldKeys();
 
-    fd = other.fd;
+    device = std::move(other.device);
     currentMods = other.currentMods;
-    keyDelayUs = other.keyDelayUs;
-    keyMap = std::move(other.keyMap);
-    charToKeycode = std::move(other.charToKeycode);
-    xkbCtx = other.xkbCtx;
-    xkbKeymap = other.xkbKeymap;
-    xkbState = other.xkbState;
-
-    other.fd = -1;
-    other.xkbCtx = nullptr;
-    other.xkbKeymap = nullptr;
-    other.xkbState = nullptr;
+    pacer = std::move(other.pacer);
+    layoutMap = std::move(other.layoutMap);
+    layoutGeneration = other.layoutGeneration;
+    layoutUpdates = other.layoutUpdates;
+    pending = std::move(other.pending);
+    batchDepth = other.batchDepth;
+    heldKeys = other.heldKeys;
+
+    other.heldKeys.reset();
     return *this;
   }
 
+  /// True when the shared virtual device exists.
+  bool hasDevice() const { return device && device->valid(); }
+
   /**
    * @internal
-   * @brief Initialize xkbcommon context, keymap and state for layout
-   * translation.
+   * @brief Release every key this Sender still holds down.
    *
-   * This routine attempts to create an `xkb_context`, detect the active
-   * keyboard layout (via `detectKeyboardLayout`), and then compile and install
-   * a corresponding `xkb_keymap` and `xkb_state`. On any failure the function
-   * logs an error and returns without a usable xkb state.
+   * The device is shared and outlives the Sender, so the kernel no longer
+   * releases these keys on UI_DEV_DESTROY; without this a Sender destroyed
+   * mid-hold would leave its keys stuck for every other user of the device.
+   * Keys another Sender still holds stay down (see `UinputDevice`).
    */
-  void initXkb() {
-    xkbCtx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-    if (!xkbCtx) {
-      AXIDEV_IO_LOG_ERROR("Sender (uinput): xkb_context_new() failed");
-      return;
-    }
-
-    // Try to detect the actual keyboard layout (and related XKB fields)
-    const auto detected = axidev::io::keyboard::detail::detectXkbRuleNames();
-
-    struct xkb_rule_names names = {nullptr, nullptr, nullptr, nullptr, nullptr};
-    std::string dbg;
-    if (!detected.rules.empty()) {
-      names.rules = detected.rules.c_str();
-      dbg += "rules=" + detected.rules + " ";
-    }
-    if (!detected.model.empty()) {
-      names.model = detected.model.c_str();
-      dbg += "model=" + detected.model + " ";
-    }
-    if (!detected.layout.empty()) {
-      names.layout = detected.layout.c_str();
-      dbg += "layout=" + detected.layout + " ";
-    }
-    if (!detected.variant.empty()) {
-      names.variant = detected.variant.c_str();
-      dbg += "variant=" + detected.variant + " ";
-    }
-    if (!detected.options.empty()) {
-      names.options = detected.options.c_str();
-      dbg += "options=" + detected.options + " ";
-    }
-    if (!dbg.empty()) {
-      AXIDEV_IO_LOG_INFO("Sender (uinput): xkb names: %s", dbg.c_str());
-    }
-
-    xkbKeymap =
-        xkb_keymap_new_from_names(xkbCtx, detected.empty() ? nullptr : &names,
-                                  XKB_KEYMAP_COMPILE_NO_FLAGS);
-
-    if (!xkbKeymap) {
-      AXIDEV_IO_LOG_ERROR(
-          "Sender (uinput): xkb_keymap_new_from_names() failed");
-      return;
-    }
-
-    xkbState = xkb_state_new(xkbKeymap);
-    if (!xkbState) {
-      AXIDEV_IO_LOG_ERROR("Sender (uinput): xkb_state_new() failed");
+  void releaseHeldKeys() {
+    if (!hasDevice() || heldKeys.none())
       return;
+    std::vector<struct input_event> up;
+    for (size_t code = 0; code < heldKeys.size(); ++code) {
+      if (heldKeys.test(code))
+        up.push_back(makeEvent(EV_KEY, static_cast<int>(code), 0));
     }
+    up.push_back(makeEvent(EV_SYN, SYN_REPORT, 0));
+    AXIDEV_IO_LOG_DEBUG("Sender (uinput): releasing %zu held keys",
+                        up.size() - 1);
+    writeEvents(up.data(), up.size());
+  }
 
+  /**
+   * @internal
+   * @brief Take the shared mappings for the detected keyboard layout.
+   *
+   * Detects the XKB rule names (see `detectXkbRuleNames()`) and looks up the
+   * process-wide snapshot for them; xkbcommon only compiles a keymap when no
+   * Sender or Listener has built that layout yet.
+   */
+  void initKeyMap() {
+    const auto detected = detail::detectXkbRuleNames();
     if (detected.empty()) {
       AXIDEV_IO_LOG_DEBUG(
           "Sender (uinput): could not detect layout, using system default");
+    } else {
+      AXIDEV_IO_LOG_INFO("Sender (uinput): xkb names: %s",
+                         detail::xkbLayoutKey(detected).c_str());
     }
-  }
-
-  void initKeyMap() {
-    const auto linuxMap = detail::initLinuxKeyMap(xkbKeymap, xkbState);
-    keyMap = std::move(linuxMap.keyToEvdev);
-    charToKeycode = std::move(linuxMap.charToKeycode);
+    layoutMap = detail::acquireLinuxKeyMap(detected);
 
     AXIDEV_IO_LOG_DEBUG(
         "Sender (uinput): initKeyMap populated %zu key entries, %zu char "
         "entries",
-        keyMap.size(), charToKeycode.size());
+        layoutMap->keyToEvdev.size(), layoutMap->charToKeycode.size());
+  }
+
+  /**
+   * @internal
+   * @brief Reload the layout mappings if `KeyMap::reinitialize()` ran since
+   * they were built, and adopt a layout the tracker published since the last
+   * call.
+   *
+   * Costs two atomic loads when nothing changed, so it runs before every
+   * operation that looks up the mappings.
+   */
+  void syncLayout() {
+    const uint64_t generation = KeyMap::generation();
+    if (generation != layoutGeneration) {
+      AXIDEV_IO_LOG_INFO("Sender (uinput): layout changed, reloading mappings");
+      initKeyMap();
+      layoutGeneration = generation;
+    }
+    if (!hasDevice())
+      return;
+    std::shared_ptr<const detail::LinuxLayout> published;
+    if (!layoutUpdates.refresh(detail::linuxLayoutTracker(), published) ||
+        published->keyMap == layoutMap)
+      return;
+    layoutMap = published->keyMap;
+    AXIDEV_IO_LOG_INFO("Sender (uinput): switched to the new layout");
   }
 
   /**
    * @internal
-   * @brief Emit a raw input_event to the uinput device.
+   * @brief Queue a raw input_event for the uinput device.
    *
-   * This helper constructs an `input_event` and writes it directly to the
-   * uinput device file descriptor. It is a low-level primitive used by
-   * higher-level helpers to synthesize key and synchronization events.
+   * This helper constructs an `input_event` and appends it to the pending
+   * buffer. It is a low-level primitive used by higher-level helpers to
+   * synthesize key and synchronization events. The buffer is written out by
+   * `writePending()` when it fills, when the enclosing Batch ends, or before
+   * a key delay.
    *
    * @param type Event type (e.g., EV_KEY, EV_SYN).
    * @param code Event code (e.g., key code).
    * @param val Event value (press/release/value).
    */
   void emit(int type, int code, int val) {
+    pending.push_back(makeEvent(type, code, val));
+    if (pending.size() >= kMaxPendingEvents)
+      writePending();
+  }
+
+  static struct input_event makeEvent(int type, int code, int val) {
     struct input_event ev{};
     ev.type = static_cast<unsigned short>(type);
     ev.code = static_cast<unsigned short>(code);
     ev.value = val;
-    if (write(fd, &ev, sizeof(ev)) < 0) {
-      AXIDEV_IO_LOG_ERROR("Sender (uinput): write() failed: %s",
-                          strerror(errno));
-    }
+    return ev;
+  }
+
+  /**
+   * @internal
+   * @brief Write all queued events to the device with as few syscalls as
+   * possible.
+   *
+   * uinput accepts any whole number of `input_event` records per write(), so
+   * the buffer normally goes out in one call. Short writes are resumed and
+   * EINTR is retried; any other failure is logged and the remaining events
+   * are dropped so a broken device cannot grow the buffer unbounded.
+   */
+  void writePending() {
+    if (pending.empty())
+      return;
+    if (!writeEvents(pending.data(), pending.size()))
+      writeFailed = true;
+    pending.clear();
+  }
+
+  /// Write @p count events straight to the device; false on failure.
+  bool writeEvents(const struct input_event *events, size_t count) {
+    return hasDevice() && device->write(events, count, heldKeys);
   }
 
   /**
@@ -270,18 +311,21 @@ struct Sender::Impl {
    * @brief Send a key event for the given evdev keycode.
    *
    * Wraps `emit(EV_KEY, ...)` and follows with a `sync()` to ensure timely
-   * delivery. The function is resilient to a missing device or invalid key
-   * code and returns false in those cases.
+   * delivery. Outside of a Batch the events are written immediately. The
+   * function is resilient to a missing device or invalid key code and returns
+   * false in those cases.
    *
    * @param evdevCode evdev keycode to send (e.g., KEY_A).
    * @param down true for key press, false for key release.
    * @return true on success, false on failure (e.g. no device or invalid code).
    */
   bool sendKey(int evdevCode, bool down) {
-    if (fd < 0 || evdevCode < 0)
+    if (!hasDevice() || evdevCode < 0)
       return false;
     emit(EV_KEY, evdevCode, down ? 1 : 0);
     sync();
+    if (batchDepth == 0)
+      writePending();
     return true;
   }
 
@@ -289,7 +333,7 @@ struct Sender::Impl {
    * @internal
    * @brief Send a key event for a logical `Key` by looking up its evdev code.
    *
-   * Performs a lookup in the layout-aware `keyMap` and forwards to `sendKey`.
+   * Performs a lookup in the shared `layoutMap` and forwards to `sendKey`.
    * If no mapping is present, a debug log entry is emitted and the function
    * returns false.
    *
@@ -298,100 +342,317 @@ struct Sender::Impl {
    * @return true on success, false when mapping is missing or send fails.
    */
   bool sendKeyByKey(Key key, bool down) {
-    auto it = keyMap.find(key);
-    if (it == keyMap.end()) {
+    syncLayout();
+    const int32_t *code = layoutMap->keyToEvdev.find(key);
+    if (!code) {
       AXIDEV_IO_LOG_DEBUG("Sender (uinput): no mapping for key=%s",
-                          keyToString(key).c_str());
+                          keyToStringView(key).data());
       return false;
     }
-    return sendKey(it->second, down);
+    return sendKey(*code, down);
   }
 
+  using EventBuffer = detail::CompiledBuffer<struct input_event>;
+
+  // Scratch buffer for sendSequence(), reused across calls.
+  EventBuffer sequenceBuffer;
+
   /**
    * @internal
-   * @brief Type a single Unicode codepoint using layout-derived keycodes.
+   * @brief Resolve a raw key sequence into @p out.
    *
-   * Looks up the provided codepoint in `charToKeycode`, applies the required
-   * modifiers (Shift, Ctrl, Alt), emits press/release for the resolved
-   * evdev keycode, and synchronizes the event stream.
+   * Every key is looked up before anything is sent; each event becomes an
+   * EV_KEY record followed by a SYN_REPORT, and a per-event delay closes the
+   * current run.
    *
-   * @param cp Unicode codepoint (UTF-32).
-   * @return true on success, false when no mapping exists.
+   * @return false when a key has no mapping.
    */
-  bool typeCodepoint(char32_t cp) {
-    auto it = charToKeycode.find(cp);
-    if (it == charToKeycode.end()) {
-      AXIDEV_IO_LOG_DEBUG("Sender (uinput): no mapping for codepoint U+%04X",
-                          static_cast<unsigned>(cp));
-      return false;
+  bool compileEvents(EventBuffer &out, std::span<const KeyEvent> events) const {
+    for (const KeyEvent &ev : events) {
+      const int32_t *code = layoutMap->keyToEvdev.find(ev.key);
+      if (!code) {
+        AXIDEV_IO_LOG_DEBUG("Sender (uinput): sequence - no mapping for key=%s",
+                            keyToStringView(ev.key).data());
+        return false;
+      }
+      out.events.push_back(makeEvent(EV_KEY, *code, ev.down ? 1 : 0));
+      out.events.push_back(makeEvent(EV_SYN, SYN_REPORT, 0));
+      out.trackModifier(ev.key, ev.down);
+      if (ev.delayUs > 0)
+        out.endSegment(ev.delayUs);
     }
+    out.endSegment(0);
+    return true;
+  }
 
-    const KeyMapping &mapping = it->second;
-    int evdevCode = mapping.keycode;
-    Modifier requiredMods = mapping.requiredMods;
+  /**
+   * @internal
+   * @brief Write a resolved buffer to the device, one write() per run.
+   *
+   * Events already queued by a surrounding Batch are written first so the
+   * order on the device is preserved.
+   *
+   * @return false when the device is missing or a write failed.
+   */
+  bool submit(const EventBuffer &buffer) {
+    if (!hasDevice())
+      return false;
+    writePending();
+    const bool ok = buffer.replay(
+        [this](const struct input_event *first, size_t count) {
+          return writeEvents(first, count);
+        },
+        [this](uint32_t pauseUs) { pacer.pause(pauseUs); });
+    currentMods = buffer.applyTo(currentMods);
+    return ok;
+  }
+
+  bool sendSequence(std::span<const KeyEvent> events) {
+    if (!hasDevice())
+      return false;
+    syncLayout();
+    sequenceBuffer.clear();
+    return compileEvents(sequenceBuffer, events) && submit(sequenceBuffer);
+  }
 
-    // Press required modifiers
-    if (hasModifier(requiredMods, Modifier::Shift)) {
-      sendKey(KEY_LEFTSHIFT, true);
-      delay();
+  /**
+   * @internal
+   * @brief A resolved keystroke of a text plan.
+   */
+  struct PlannedKey {
+    int evdevCode;
+    Modifier mods; ///< Shift/Ctrl/Alt subset that must be held
+  };
+
+  // Reused across typeText() calls so planning does not allocate once the
+  // buffer has grown to the longest text typed so far.
+  std::vector<PlannedKey> plan;
+  // UTF-8 text decoded to codepoints, reused the same way.
+  std::u32string decoded;
+
+  /**
+   * @internal
+   * @brief Decode @p utf8Text into `decoded`.
+   * @return false (with a warning) if the text is not well-formed UTF-8.
+   */
+  bool decodeText(std::string_view utf8Text) {
+    lastTyped = 0;
+    decoded.clear();
+    if (!detail::appendUtf8AsUtf32(utf8Text, decoded)) {
+      AXIDEV_IO_LOG_WARN("Sender (uinput): rejecting ill-formed UTF-8 text");
+      return false;
     }
-    if (hasModifier(requiredMods, Modifier::Ctrl)) {
-      sendKey(KEY_LEFTCTRL, true);
-      delay();
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Resolve @p count codepoints into `plan`.
+   *
+   * Every codepoint is looked up in `charToKeycode`; codepoints without a
+   * mapping are logged and left out of the plan, which keeps modifier runs
+   * on either side of them intact.
+   *
+   * @return true when every codepoint resolved.
+   */
+  bool planText(const char32_t *text, size_t count) {
+    plan.clear();
+    plan.reserve(count);
+    bool allResolved = true;
+    for (size_t i = 0; i < count; ++i) {
+      const KeyMapping *mapping = layoutMap->charToKeycode.find(text[i]);
+      if (!mapping) {
+        AXIDEV_IO_LOG_DEBUG("Sender (uinput): no mapping for codepoint U+%04X",
+                            static_cast<unsigned>(text[i]));
+        allResolved = false;
+        continue;
+      }
+      plan.push_back({mapping->keycode,
+                      mapping->requiredMods &
+                          (Modifier::Shift | Modifier::Ctrl | Modifier::Alt)});
     }
-    if (hasModifier(requiredMods, Modifier::Alt)) {
-      sendKey(KEY_LEFTALT, true);
-      delay();
+    return allResolved;
+  }
+
+  /**
+   * @internal
+   * @brief Call @p fn with the evdev code of each modifier in @p mods.
+   *
+   * Presses go Shift, Ctrl, Alt; releases go in reverse order, mirroring a
+   * manual chord.
+   */
+  template <typename Fn>
+  static void forEachTextModifier(Modifier mods, bool down, Fn &&fn) {
+    static constexpr std::pair<Modifier, int> kModKeys[] = {
+        {Modifier::Shift, KEY_LEFTSHIFT},
+        {Modifier::Ctrl, KEY_LEFTCTRL},
+        {Modifier::Alt, KEY_LEFTALT},
+    };
+    if (down) {
+      for (const auto &[mod, code] : kModKeys) {
+        if (hasModifier(mods, mod))
+          fn(code);
+      }
+    } else {
+      for (auto it = std::rbegin(kModKeys); it != std::rend(kModKeys); ++it) {
+        if (hasModifier(mods, it->first))
+          fn(it->second);
+      }
     }
+  }
 
-    sendKey(evdevCode, true);
-    delay();
-    sendKey(evdevCode, false);
+  /**
+   * @internal
+   * @brief Press or release the modifiers in @p mods.
+   *
+   * Each press is followed by a delay and each release preceded by one.
+   */
+  void setTextModifiers(Modifier mods, bool down) {
+    forEachTextModifier(mods, down, [this, down](int code) {
+      if (!down)
+        delay();
+      sendKey(code, down);
+      if (down)
+        delay();
+    });
+  }
 
-    // Release modifiers in reverse order
-    if (hasModifier(requiredMods, Modifier::Alt)) {
-      delay();
-      sendKey(KEY_LEFTALT, false);
-    }
-    if (hasModifier(requiredMods, Modifier::Ctrl)) {
-      delay();
-      sendKey(KEY_LEFTCTRL, false);
-    }
-    if (hasModifier(requiredMods, Modifier::Shift)) {
-      delay();
-      sendKey(KEY_LEFTSHIFT, false);
+  /**
+   * @internal
+   * @brief Type Unicode text using layout-derived keycodes.
+   *
+   * Runs a planning pass (see `planText()`) and then emits the plan with the
+   * modifiers coalesced: consecutive characters needing the same Shift /
+   * Ctrl / Alt state share one press and one release, and a change between
+   * runs only toggles the modifiers that differ. "HELLO WORLD" therefore
+   * costs one Shift press and release instead of one per letter.
+   *
+   * Typing stops at the first failed device write. `lastTyped` counts the
+   * characters whose events are known to have reached the device.
+   *
+   * @param text UTF-32 codepoints to type.
+   * @param count Number of codepoints.
+   * @return true when every codepoint had a mapping and was written.
+   */
+  bool typeCodepoints(const char32_t *text, size_t count) {
+    lastTyped = 0;
+    syncLayout();
+    bool allOk = planText(text, count);
+    if (plan.empty())
+      return allOk;
+
+    writeFailed = false;
+    size_t keysSent = 0;
+    {
+      Batch batch(this);
+      Modifier held = Modifier::None;
+      for (const PlannedKey &key : plan) {
+        if (writeFailed)
+          break;
+        if (key.mods != held) {
+          const auto heldBits = static_cast<uint8_t>(held);
+          const auto wantBits = static_cast<uint8_t>(key.mods);
+          setTextModifiers(static_cast<Modifier>(heldBits & ~wantBits),
+                           false);
+          setTextModifiers(static_cast<Modifier>(wantBits & ~heldBits), true);
+          held = key.mods;
+        }
+        sendKey(key.evdevCode, true);
+        delay();
+        sendKey(key.evdevCode, false);
+        delay();
+        ++keysSent;
+        // Nothing buffered means every key so far reached the device.
+        if (pending.empty() && !writeFailed)
+          lastTyped = keysSent;
+      }
+      setTextModifiers(held, false);
+      sync();
     }
+    if (writeFailed)
+      return false;
+    lastTyped = keysSent;
+    return allOk;
+  }
 
-    sync();
+  /**
+   * @internal
+   * @brief Resolve Unicode text into @p out as a single run.
+   *
+   * Produces the same keystrokes and modifier coalescing as
+   * `typeCodepoints()`, without key delays.
+   *
+   * @return false when a codepoint has no mapping.
+   */
+  bool compileText(EventBuffer &out, const char32_t *text, size_t count) {
+    if (!planText(text, count))
+      return false;
+
+    auto key = [&out](int code, bool down) {
+      out.events.push_back(makeEvent(EV_KEY, code, down ? 1 : 0));
+      out.events.push_back(makeEvent(EV_SYN, SYN_REPORT, 0));
+    };
+    Modifier held = Modifier::None;
+    for (const PlannedKey &planned : plan) {
+      if (planned.mods != held) {
+        const auto heldBits = static_cast<uint8_t>(held);
+        const auto wantBits = static_cast<uint8_t>(planned.mods);
+        forEachTextModifier(static_cast<Modifier>(heldBits & ~wantBits), false,
+                            [&key](int code) { key(code, false); });
+        forEachTextModifier(static_cast<Modifier>(wantBits & ~heldBits), true,
+                            [&key](int code) { key(code, true); });
+        held = planned.mods;
+      }
+      key(planned.evdevCode, true);
+      key(planned.evdevCode, false);
+    }
+    forEachTextModifier(held, false, [&key](int code) { key(code, false); });
+    out.endSegment(0);
     return true;
   }
 
   /**
    * @internal
-   * @brief Sleep for the configured key delay interval.
+   * @brief Wait for the next key delay deadline.
    *
-   * Sleeps for `keyDelayUs` microseconds when a non-zero delay is configured.
-   * This small helper centralizes the delay logic used by tap/combo and
-   * character injection helpers.
+   * Waits on `pacer` when a non-zero delay is configured. Queued events are
+   * written before waiting so the delay separates them on the device as
+   * intended. This small helper centralizes the delay logic used by
+   * tap/combo and character injection helpers.
    */
   void delay() {
-    if (keyDelayUs > 0)
-      std::this_thread::sleep_for(std::chrono::microseconds(keyDelayUs));
+    if (pacer.interval() > 0) {
+      writePending();
+      pacer.wait();
+    }
   }
 };
 
 // Public interface implementation
 Sender::Sender() : m_impl(std::make_unique<Impl>()) {}
 Sender::~Sender() = default;
-Sender::Sender(Sender &&) noexcept = default;
-Sender &Sender::operator=(Sender &&) noexcept = default;
+// The injection thread holds a reference to the Sender it was started on, so
+// async mode is stopped before the backend changes hands. Queued commands
+// are discarded rather than run, as a noexcept move must not block on them.
+Sender::Sender(Sender &&other) noexcept {
+  other.discardAsync();
+  m_impl = std::move(other.m_impl);
+}
+Sender &Sender::operator=(Sender &&other) noexcept {
+  if (this != &other) {
+    discardAsync();
+    other.discardAsync();
+    m_impl = std::move(other.m_impl);
+  }
+  return *this;
+}
 
 BackendType Sender::type() const { return BackendType::LinuxUInput; }
 
 Capabilities Sender::capabilities() const {
   return {
-      .canInjectKeys = (m_impl && m_impl->fd >= 0),
-      .canInjectText = (m_impl && !m_impl->charToKeycode.empty()),
+      .canInjectKeys = (m_impl && m_impl->hasDevice()),
+      .canInjectText = (m_impl && !m_impl->layoutMap->charToKeycode.empty()),
       .canSimulateHID = true,
       .supportsKeyRepeat = true,
       .needsAccessibilityPerm = false,
@@ -400,7 +661,15 @@ Capabilities Sender::capabilities() const {
   };
 }
 
-bool Sender::isReady() const { return m_impl && m_impl->fd >= 0; }
+bool Sender::isReady() const { return m_impl && m_impl->hasDevice(); }
+
+bool Sender::waitUntilReady(uint32_t timeoutMs) {
+  if (!m_impl)
+    return false;
+  return m_impl->hasDevice() &&
+         m_impl->device->awaitReady(std::chrono::steady_clock::now() +
+                                    std::chrono::milliseconds(timeoutMs));
+}
 
 bool Sender::requestPermissions() { return isReady(); }
 
@@ -463,9 +732,56 @@ bool Sender::sendRawKey(Key key, bool down) {
   return m_impl->sendKeyByKey(key, down);
 }
 
+bool Sender::sendSequence(std::span<const KeyEvent> events) {
+  return m_impl && m_impl->sendSequence(events);
+}
+
+CompiledSequence Sender::compile(std::span<const KeyEvent> events) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileEvents(*data, events))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+CompiledSequence Sender::compile(std::u32string_view text) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileText(*data, text.data(), text.size()))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+CompiledSequence Sender::compile(std::string_view utf8Text) {
+  if (!m_impl || !m_impl->decodeText(utf8Text))
+    return {};
+  return compile(std::u32string_view(m_impl->decoded));
+}
+
+bool Sender::replay(const CompiledSequence &sequence) {
+  if (!m_impl)
+    return false;
+  // Adopt a pending layout switch first, so that a sequence compiled for
+  // the previous layout is refused rather than typed with the wrong keys.
+  m_impl->syncLayout();
+  if (!sequence.valid() ||
+      sequence.m_layoutEpoch != m_impl->layoutUpdates.epoch()) {
+    AXIDEV_IO_LOG_DEBUG("Sender (uinput): replay of an invalid sequence");
+    return false;
+  }
+  return m_impl->submit(*sequence.m_data);
+}
+
 bool Sender::keyDown(KeyWithModifier keyMod) {
   if (!m_impl)
     return false;
+  Impl::Batch batch(m_impl.get());
   // Press required modifiers first
   if (!holdModifier(keyMod.requiredMods)) {
     return false;
@@ -476,6 +792,7 @@ bool Sender::keyDown(KeyWithModifier keyMod) {
 bool Sender::keyUp(KeyWithModifier keyMod) {
   if (!m_impl)
     return false;
+  Impl::Batch batch(m_impl.get());
   bool result = sendRawKey(keyMod.key, false);
   // Release modifiers that were specified
   releaseModifier(keyMod.requiredMods);
@@ -485,6 +802,7 @@ bool Sender::keyUp(KeyWithModifier keyMod) {
 bool Sender::tap(KeyWithModifier keyMod) {
   if (!m_impl)
     return false;
+  Impl::Batch batch(m_impl.get());
   // Hold modifiers, tap key, release modifiers
   if (!holdModifier(keyMod.requiredMods)) {
     return false;
@@ -506,6 +824,7 @@ Modifier Sender::activeModifiers() const {
 }
 
 bool Sender::holdModifier(Modifier mod) {
+  Impl::Batch batch(m_impl.get());
   bool ok = true;
   if (hasModifier(mod, Modifier::Shift))
     ok &= sendRawKey(Key::ShiftLeft, true);
@@ -519,6 +838,7 @@ bool Sender::holdModifier(Modifier mod) {
 }
 
 bool Sender::releaseModifier(Modifier mod) {
+  Impl::Batch batch(m_impl.get());
   bool ok = true;
   if (hasModifier(mod, Modifier::Shift))
     ok &= sendRawKey(Key::ShiftLeft, false);
@@ -536,74 +856,49 @@ bool Sender::releaseAllModifiers() {
                          Modifier::Super);
 }
 
-bool Sender::typeText(const std::u32string &text) {
+bool Sender::typeText(std::u32string_view text) {
   if (!m_impl)
     return false;
 
-  bool allOk = true;
-  for (char32_t cp : text) {
-    if (!m_impl->typeCodepoint(cp)) {
-      allOk = false;
-    }
-    m_impl->delay();
-  }
-  return allOk;
+  return m_impl->typeCodepoints(text.data(), text.size());
 }
 
-bool Sender::typeText(const std::string &utf8Text) {
-  // Convert UTF-8 to UTF-32
-  std::u32string utf32;
-  size_t i = 0;
-  while (i < utf8Text.size()) {
-    char32_t cp = 0;
-    auto c = static_cast<unsigned char>(utf8Text[i]);
-    if ((c & 0x80) == 0) {
-      cp = c;
-      i += 1;
-    } else if ((c & 0xE0) == 0xC0) {
-      cp = (c & 0x1F) << 6;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F);
-      i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-      cp = (c & 0x0F) << 12;
-      if (i + 1 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 1]) & 0x3F) << 6;
-      if (i + 2 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 2]) & 0x3F);
-      i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-      cp = (c & 0x07) << 18;
-      if (i + 1 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 1]) & 0x3F) << 12;
-      if (i + 2 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 2]) & 0x3F) << 6;
-      if (i + 3 < utf8Text.size())
-        cp |= (static_cast<unsigned char>(utf8Text[i + 3]) & 0x3F);
-      i += 4;
-    } else {
-      i += 1;
-      continue;
-    }
-    utf32.push_back(cp);
-  }
-  return typeText(utf32);
+bool Sender::typeText(std::string_view utf8Text) {
+  if (!m_impl || !m_impl->decodeText(utf8Text))
+    return false;
+  return m_impl->typeCodepoints(m_impl->decoded.data(),
+                                m_impl->decoded.size());
 }
 
 bool Sender::typeCharacter(char32_t codepoint) {
   if (!m_impl)
     return false;
-  return m_impl->typeCodepoint(codepoint);
+  return m_impl->typeCodepoints(&codepoint, 1);
 }
 
 void Sender::flush() {
-  if (m_impl)
+  if (m_impl) {
     m_impl->sync();
+    m_impl->writePending();
+  }
 }
 
 void Sender::setKeyDelay(uint32_t delayUs) {
   if (m_impl)
-    m_impl->keyDelayUs = delayUs;
+    m_impl->pacer.setInterval(delayUs);
+}
+
+void Sender::setKeyDelaySpin(uint32_t spinUs) {
+  if (m_impl)
+    m_impl->pacer.setSpinUs(spinUs);
+}
+
+// Pending events are already written in chunks of kMaxPendingEvents, so the
+// text batch size has nothing to bound here.
+void Sender::setTextBatchSize(size_t) {}
+
+size_t Sender::lastTypedCount() const {
+  return m_impl ? m_impl->lastTyped : 0;
 }
 
 } // namespace axidev::io::keyboard
@@ -11,31 +11,50 @@
 #include <Windows.h>
 #include <axidev-io/keyboard/sender.hpp>
 #include <axidev-io/log.hpp>
+#include <memory>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <unordered_map>
 
+#include "keyboard/common/keymap.hpp"
+#include "keyboard/common/utf8.hpp"
 #include "keyboard/common/windows_keymap.hpp"
+#include "keyboard/sender/sender_async.hpp"
+#include "keyboard/sender/sender_pacer.hpp"
+#include "keyboard/sender/sender_sequence.hpp"
 
 namespace axidev::io::keyboard {
 
+/**
+ * @internal
+ * @brief Windows payload of a CompiledSequence: ready-to-submit `INPUT`
+ * records.
+ */
+struct CompiledSequence::Data : detail::CompiledBuffer<INPUT> {};
+
 /**
  * @internal
  * @brief PIMPL implementation for the Windows Sender backend.
  *
  * Contains platform-specific state used for input injection on Windows,
- * including discovered mappings (Key -> VK), the active keyboard layout
- * handle (HKL), and the tracked modifier state. These details are internal
- * implementation concerns and are not part of the public API.
+ * including discovered mappings (Key -> VK) together with the keyboard
+ * layout handle (HKL) they were built for, and the tracked modifier state.
+ * These details are internal implementation concerns and are not part of the
+ * public API.
  */
 struct Sender::Impl {
   Modifier currentMods{Modifier::None};
-  uint32_t keyDelayUs{1000}; // 1ms default
+  detail::Pacer pacer{1000}; // 1ms default
   bool ready{true};
-  HKL layout{nullptr};
-  std::unordered_map<Key, WORD> keyMap;
-  std::unordered_map<char32_t, KeyMapping> charToKeycode;
-
-  Impl() : layout(GetKeyboardLayout(0)) {
+  // Layout mappings and their HKL, shared with every other Sender and
+  // Listener on the same layout.
+  std::shared_ptr<const detail::WindowsKeyMap> layoutMap;
+  // KeyMap::generation() the mappings above were built for.
+  uint64_t layoutGeneration{KeyMap::generation()};
+  // Last layout published by `windowsLayoutTracker()` that was adopted.
+  detail::LayoutSubscription layoutUpdates;
+
+  Impl() {
     initKeyMap();
     AXIDEV_IO_LOG_INFO("Sender (Windows): Impl created; ready=%u",
                      static_cast<unsigned>(ready));
@@ -46,27 +65,48 @@ struct Sender::Impl {
    * @brief Build layout-aware mappings for printable characters and logical
    * keys.
    *
-   * Scans physical scan codes against the active keyboard layout to discover
-   * which virtual-key codes produce which Unicode characters and which logical
-   * `Key` values. Populates `keyMap` (Key -> VK) and `charToKeycode` (codepoint
-   * -> (VK, requiresShift)). Falls back to sensible defaults when detailed
-   * layout information is not available.
+   * Takes the shared snapshot for the active keyboard layout (see
+   * `acquireWindowsKeyMap()`). The first Sender or Listener on a layout
+   * scans physical scan codes to discover which virtual-key codes produce
+   * which Unicode characters and which logical `Key` values, falling back to
+   * sensible defaults when detailed layout information is not available.
    */
   void initKeyMap() {
-    auto km = ::axidev::io::keyboard::detail::initWindowsKeyMap(layout);
-    keyMap = std::move(km.keyToVk);
-    charToKeycode = std::move(km.charToKeycode);
+    layoutMap = ::axidev::io::keyboard::detail::acquireWindowsKeyMap(
+        GetKeyboardLayout(0));
     AXIDEV_IO_LOG_DEBUG("Sender (Windows): initKeyMap populated %zu entries",
-                      keyMap.size());
+                        layoutMap->keyToVk.size());
     AXIDEV_IO_LOG_DEBUG("Sender (Windows): charToKeycode populated %zu entries",
-                      charToKeycode.size());
+                        layoutMap->charToKeycode.size());
+  }
+
+  /**
+   * @internal
+   * @brief Reload the layout mappings if `KeyMap::reinitialize()` ran since
+   * they were built, and follow the layout of the foreground window.
+   *
+   * The foreground layout is polled at a bounded rate (see
+   * `pollForegroundLayout()`); a switch is reported to the tracker, which
+   * builds the new mappings off this thread. They are adopted, with their
+   * HKL, by the first operation after they were published.
+   */
+  void syncLayout() {
+    const uint64_t generation = KeyMap::generation();
+    if (generation != layoutGeneration) {
+      AXIDEV_IO_LOG_INFO("Sender (Windows): layout changed, reloading mappings");
+      initKeyMap();
+      layoutGeneration = generation;
+    }
+    detail::pollForegroundLayout();
+    if (layoutUpdates.refresh(detail::windowsLayoutTracker(), layoutMap))
+      AXIDEV_IO_LOG_INFO("Sender (Windows): switched to the new layout");
   }
 
   /**
    * @internal
    * @brief Return the Win32 virtual-key code (VK) for a logical `Key`.
    *
-   * Looks up the provided `Key` in the internal `keyMap` and returns the
+   * Looks up the provided `Key` in the shared `layoutMap` and returns the
    * associated Win32 `WORD` virtual-key code. If no mapping exists, returns 0.
    *
    * This helper is internal to the Windows sender implementation and is used
@@ -77,8 +117,30 @@ struct Sender::Impl {
    * @return WORD Virtual-key code, or 0 if no mapping is present.
    */
   WORD winVkFor(Key key) const {
-    auto it = keyMap.find(key);
-    return (it != keyMap.end()) ? it->second : 0;
+    const int32_t *vk = layoutMap->keyToVk.find(key);
+    return vk ? static_cast<WORD>(*vk) : 0;
+  }
+
+  /**
+   * @internal
+   * @brief Build the scancode-based `INPUT` record for a virtual-key event.
+   *
+   * Sets the extended-key flag for keys that require it.
+   */
+  static INPUT keyInput(WORD vk, bool down) {
+    INPUT input{};
+    input.type = INPUT_KEYBOARD;
+    input.ki.wVk = vk;
+    input.ki.wScan = MapVirtualKeyW(vk, MAPVK_VK_TO_VSC);
+    input.ki.dwFlags = KEYEVENTF_SCANCODE;
+
+    if (::axidev::io::keyboard::detail::isWindowsExtendedKey(vk)) {
+      input.ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
+    }
+    if (!down) {
+      input.ki.dwFlags |= KEYEVENTF_KEYUP;
+    }
+    return input;
   }
 
   /**
@@ -96,104 +158,282 @@ struct Sender::Impl {
    *         failure or when the key has no known mapping.
    */
   bool sendKey(Key key, bool down) {
+    syncLayout();
     WORD vk = winVkFor(key);
     if (vk == 0) {
       AXIDEV_IO_LOG_DEBUG("Sender (Windows): no mapping for key=%s",
-                        keyToString(key).c_str());
+                        keyToStringView(key).data());
       return false;
     }
 
-    INPUT input{};
-    input.type = INPUT_KEYBOARD;
-    input.ki.wVk = vk;
-    input.ki.wScan = MapVirtualKeyW(vk, MAPVK_VK_TO_VSC);
-    input.ki.dwFlags = KEYEVENTF_SCANCODE;
-
-    if (::axidev::io::keyboard::detail::isWindowsExtendedKey(vk)) {
-      input.ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
-    }
-    if (!down) {
-      input.ki.dwFlags |= KEYEVENTF_KEYUP;
-    }
-
+    INPUT input = keyInput(vk, down);
     BOOL ok = SendInput(1, &input, sizeof(INPUT)) > 0;
     if (!ok) {
       AXIDEV_IO_LOG_ERROR("Sender (Windows): SendInput failed for vk=%u key=%s",
-                        static_cast<unsigned>(vk), keyToString(key).c_str());
+                        static_cast<unsigned>(vk), keyToStringView(key).data());
     } else {
       AXIDEV_IO_LOG_DEBUG("Sender (Windows): sendKey vk=%u key=%s down=%u",
-                        static_cast<unsigned>(vk), keyToString(key).c_str(),
+                        static_cast<unsigned>(vk), keyToStringView(key).data(),
                         static_cast<unsigned>(down));
     }
     return ok;
   }
 
+  using InputBuffer = detail::CompiledBuffer<INPUT>;
+
+  // Scratch buffer for sendSequence(), reused across calls.
+  InputBuffer sequenceBuffer;
+
   /**
    * @internal
-   * @brief Type a sequence of Unicode codepoints using Win32 synthetic events.
+   * @brief Resolve a raw key sequence into @p out.
    *
-   * This helper converts each UTF-32 codepoint to UTF-16 (handling surrogate
-   * pairs when necessary) and synthesizes the corresponding keyboard input
-   * events via `SendInput`. It assembles `INPUT` structures for each codepoint
-   * including the key-down / key-up pairs required to generate Unicode
-   * characters through the system's input pipeline.
+   * Every key is translated before anything is sent; a per-event delay
+   * closes the current run.
    *
-   * @param text UTF-32 string containing codepoints to type.
-   * @return true on success; false if an error occurred while sending input.
+   * @return false when a key has no mapping.
    */
-  bool typeUnicode(const std::u32string &text) {
-    AXIDEV_IO_LOG_DEBUG("Sender::typeUnicode called with %zu codepoints",
+  bool compileEvents(InputBuffer &out, std::span<const KeyEvent> events) const {
+    for (const KeyEvent &ev : events) {
+      WORD vk = winVkFor(ev.key);
+      if (vk == 0) {
+        AXIDEV_IO_LOG_DEBUG("Sender (Windows): sequence - no mapping for "
+                            "key=%s",
+                            keyToStringView(ev.key).data());
+        return false;
+      }
+      out.events.push_back(keyInput(vk, ev.down));
+      out.trackModifier(ev.key, ev.down);
+      if (ev.delayUs > 0)
+        out.endSegment(ev.delayUs);
+    }
+    out.endSegment(0);
+    return true;
+  }
+
+  /**
+   * @internal
+   * @brief Submit a resolved buffer, one `SendInput` call per run.
+   * @return true when every record was inserted.
+   */
+  bool submit(const InputBuffer &buffer) {
+    const bool ok = buffer.replay(
+        [](const INPUT *first, size_t count) {
+          return sendInputs(first, count) == count;
+        },
+        [this](uint32_t pauseUs) { pacer.pause(pauseUs); });
+    currentMods = buffer.applyTo(currentMods);
+    return ok;
+  }
+
+  bool sendSequence(std::span<const KeyEvent> events) {
+    syncLayout();
+    sequenceBuffer.clear();
+    return compileEvents(sequenceBuffer, events) && submit(sequenceBuffer);
+  }
+
+  // Characters typeText() hands to each SendInput call. Large enough to
+  // amortise the call, small enough that a multi-megabyte paste never becomes
+  // one giant array for UIPI or the raw input queue to truncate.
+  static constexpr size_t kDefaultTextBatchSize = 256;
+  // Consecutive zero returns from SendInput tolerated before giving up.
+  static constexpr int kMaxSendInputStalls = 3;
+
+  size_t textBatchSize{kDefaultTextBatchSize};
+  // Characters injected by the last typeText() call.
+  size_t lastTyped{0};
+  // KEYEVENTF_UNICODE records of the current batch, reused across calls so
+  // typing does not allocate once the buffer has grown to one batch.
+  std::vector<INPUT> textInputs;
+
+  /**
+   * @internal
+   * @brief Insert @p count records, retrying whatever SendInput left out.
+   *
+   * SendInput may insert only a prefix of the array; the remainder is sent
+   * again until everything went through or SendInput stops making progress
+   * (for example when UIPI blocks the foreground window).
+   *
+   * @return Number of records actually inserted.
+   */
+  static size_t sendInputs(const INPUT *inputs, size_t count) {
+    size_t sent = 0;
+    int stalls = 0;
+    while (sent < count) {
+      const auto n = static_cast<UINT>(count - sent);
+      const UINT inserted =
+          SendInput(n, const_cast<INPUT *>(inputs + sent), sizeof(INPUT));
+      if (inserted == 0) {
+        if (++stalls >= kMaxSendInputStalls) {
+          AXIDEV_IO_LOG_ERROR(
+              "Sender (Windows): SendInput inserted %zu of %zu events "
+              "(error %lu)",
+              sent, count, static_cast<unsigned long>(GetLastError()));
+          break;
+        }
+        SwitchToThread();
+        continue;
+      }
+      stalls = 0;
+      sent += inserted;
+    }
+    return sent;
+  }
+
+  /**
+   * @internal
+   * @brief Number of characters completed by the first @p sent records.
+   *
+   * A character is complete once the key-up of its last UTF-16 unit (a BMP
+   * unit or a low surrogate) went through.
+   */
+  static size_t completedCharacters(const INPUT *inputs, size_t sent) {
+    size_t chars = 0;
+    for (size_t i = 0; i < sent; ++i) {
+      const WORD unit = inputs[i].ki.wScan;
+      if ((inputs[i].ki.dwFlags & KEYEVENTF_KEYUP) != 0 &&
+          (unit < 0xD800 || unit > 0xDBFF))
+        ++chars;
+    }
+    return chars;
+  }
+
+  /**
+   * @internal
+   * @brief Submit the `textInputs` batch holding @p chars characters.
+   * @return false if SendInput did not take the whole batch.
+   */
+  bool flushText(size_t chars) {
+    const size_t sent = sendInputs(textInputs.data(), textInputs.size());
+    const bool ok = sent == textInputs.size();
+    lastTyped += ok ? chars : completedCharacters(textInputs.data(), sent);
+    textInputs.clear();
+    return ok;
+  }
+
+  /**
+   * @internal
+   * @brief Type Unicode text using Win32 synthetic events.
+   *
+   * The text is validated first, so invalid text types nothing. It is then
+   * encoded straight into `KEYEVENTF_UNICODE` down/up records (surrogate
+   * pairs for codepoints outside the BMP) and submitted `textBatchSize`
+   * characters per SendInput call. Typing stops at the first batch that
+   * does not go through completely; `lastTyped` reports how far it got.
+   *
+   * @tparam Text `std::string_view` (UTF-8) or `std::u32string_view`.
+   * @param text Text to type.
+   * @return true on success; false on invalid text or if sending failed.
+   */
+  template <typename Text> bool typeUnicode(Text text) {
+    AXIDEV_IO_LOG_DEBUG("Sender::typeUnicode called with %zu code units",
                       text.size());
+    lastTyped = 0;
     if (text.empty())
       return true;
+    if (!isValidText(text)) {
+      AXIDEV_IO_LOG_WARN("Sender (Windows): rejecting invalid Unicode text");
+      return false;
+    }
 
-    std::vector<INPUT> inputs;
-    inputs.reserve(text.size() * 4); // Worst case: surrogate pairs + up/down
-
-    for (char32_t cp : text) {
-      // Convert to UTF-16
-      wchar_t utf16[2];
-      int len = 0;
-
-      if (cp <= 0xFFFF) {
-        utf16[0] = static_cast<wchar_t>(cp);
-        len = 1;
-      } else if (cp <= 0x10FFFF) {
-        cp -= 0x10000;
-        utf16[0] = static_cast<wchar_t>(0xD800 | (cp >> 10));
-        utf16[1] = static_cast<wchar_t>(0xDC00 | (cp & 0x3FF));
-        len = 2;
-      } else {
-        continue; // Invalid codepoint
+    textInputs.clear();
+    textInputs.reserve(textBatchSize * 4);
+    size_t batched = 0;
+    bool ok = true;
+    detail::forEachCodepoint(text, [&](char32_t cp) {
+      if (!ok)
+        return;
+      detail::encodeUtf16(
+          cp, [this](char16_t u) { appendUnicodeUnit(textInputs, u); });
+      if (++batched == textBatchSize) {
+        ok = flushText(batched);
+        batched = 0;
       }
+    });
+    if (ok && batched > 0)
+      ok = flushText(batched);
+    return ok;
+  }
 
-      for (int i = 0; i < len; ++i) {
-        INPUT down{}, up{};
-        down.type = INPUT_KEYBOARD;
-        down.ki.wScan = utf16[i];
-        down.ki.dwFlags = KEYEVENTF_UNICODE;
+  static bool isValidText(std::string_view text) {
+    return detail::isValidUtf8(text);
+  }
+  static bool isValidText(std::u32string_view text) {
+    return detail::isValidUtf32(text);
+  }
 
-        up = down;
-        up.ki.dwFlags |= KEYEVENTF_KEYUP;
+  /**
+   * @internal
+   * @brief Append the `KEYEVENTF_UNICODE` down/up records of one UTF-16 unit.
+   */
+  static void appendUnicodeUnit(std::vector<INPUT> &inputs, char16_t unit) {
+    INPUT down{};
+    down.type = INPUT_KEYBOARD;
+    down.ki.wScan = static_cast<WORD>(unit);
+    down.ki.dwFlags = KEYEVENTF_UNICODE;
 
-        inputs.push_back(down);
-        inputs.push_back(up);
-      }
-    }
+    INPUT up = down;
+    up.ki.dwFlags |= KEYEVENTF_KEYUP;
+
+    inputs.push_back(down);
+    inputs.push_back(up);
+  }
 
-    return SendInput(static_cast<UINT>(inputs.size()), inputs.data(),
-                     sizeof(INPUT)) > 0;
+  /**
+   * @internal
+   * @brief Append the `KEYEVENTF_UNICODE` records typing UTF-8 @p text.
+   * @return false (leaving @p inputs unchanged) on ill-formed UTF-8.
+   */
+  static bool appendUnicodeInputs(std::vector<INPUT> &inputs,
+                                  std::string_view text) {
+    const size_t base = inputs.size();
+    // Worst case: every byte is an ASCII character needing a down/up pair.
+    inputs.reserve(base + text.size() * 2);
+    const bool ok = detail::decodeUtf8(
+        text,
+        [&inputs](const unsigned char *ascii, size_t n) {
+          for (size_t i = 0; i < n; ++i)
+            appendUnicodeUnit(inputs, ascii[i]);
+        },
+        [&inputs](char32_t cp) {
+          detail::encodeUtf16(
+              cp, [&inputs](char16_t u) { appendUnicodeUnit(inputs, u); });
+        });
+    if (!ok) {
+      inputs.resize(base);
+      AXIDEV_IO_LOG_WARN("Sender (Windows): rejecting ill-formed UTF-8 text");
+    }
+    return ok;
   }
 
-  void delay() {
-    if (keyDelayUs > 0) {
-      // Use Windows Sleep API to avoid nanosleepe64 dependency issues
-      // with MinGW on older Windows versions. Convert microseconds to
-      // milliseconds.
-      unsigned long ms = (keyDelayUs + 999) / 1000; // Round up
-      Sleep(ms);
+  /**
+   * @internal
+   * @brief Append the `KEYEVENTF_UNICODE` records typing UTF-32 @p text.
+   * @return false (leaving @p inputs unchanged) if @p text holds a surrogate
+   * or a value above U+10FFFF.
+   */
+  static bool appendUnicodeInputs(std::vector<INPUT> &inputs,
+                                  std::u32string_view text) {
+    const size_t base = inputs.size();
+    // Worst case: surrogate pairs + up/down
+    inputs.reserve(base + text.size() * 4);
+    for (char32_t cp : text) {
+      if (!detail::isUnicodeScalar(cp)) {
+        inputs.resize(base);
+        AXIDEV_IO_LOG_WARN("Sender (Windows): rejecting invalid codepoint %u",
+                           static_cast<unsigned>(cp));
+        return false;
+      }
+      detail::encodeUtf16(
+          cp, [&inputs](char16_t u) { appendUnicodeUnit(inputs, u); });
     }
+    return true;
   }
+
+  // Waits on a high-resolution waitable timer rather than Sleep(), which
+  // rounded every delay up to whole milliseconds (and often to the 15.6 ms
+  // scheduler tick).
+  void delay() { pacer.wait(); }
 };
 
 AXIDEV_IO_API Sender::Sender() : m_impl(std::make_unique<Impl>()) {
@@ -201,8 +441,21 @@ AXIDEV_IO_API Sender::Sender() : m_impl(std::make_unique<Impl>()) {
                    static_cast<unsigned>(isReady()));
 }
 AXIDEV_IO_API Sender::~Sender() = default;
-AXIDEV_IO_API Sender::Sender(Sender &&) noexcept = default;
-AXIDEV_IO_API Sender &Sender::operator=(Sender &&) noexcept = default;
+// The injection thread holds a reference to the Sender it was started on, so
+// async mode is stopped before the backend changes hands. Queued commands
+// are discarded rather than run, as a noexcept move must not block on them.
+AXIDEV_IO_API Sender::Sender(Sender &&other) noexcept {
+  other.discardAsync();
+  m_impl = std::move(other.m_impl);
+}
+AXIDEV_IO_API Sender &Sender::operator=(Sender &&other) noexcept {
+  if (this != &other) {
+    discardAsync();
+    other.discardAsync();
+    m_impl = std::move(other.m_impl);
+  }
+  return *this;
+}
 
 AXIDEV_IO_API BackendType Sender::type() const {
   AXIDEV_IO_LOG_DEBUG("Sender::type() -> Windows");
@@ -224,6 +477,11 @@ AXIDEV_IO_API Capabilities Sender::capabilities() const {
 }
 
 AXIDEV_IO_API bool Sender::isReady() const { return m_impl->ready; }
+
+// SendInput needs no device setup.
+AXIDEV_IO_API bool Sender::waitUntilReady(uint32_t /*timeoutMs*/) {
+  return isReady();
+}
 AXIDEV_IO_API bool Sender::requestPermissions() { return true; }
 
 // Internal helper to send a raw key event (used by public API)
@@ -284,6 +542,60 @@ AXIDEV_IO_API bool Sender::sendRawKey(Key key, bool down) {
   return m_impl->sendKey(key, down);
 }
 
+AXIDEV_IO_API bool Sender::sendSequence(std::span<const KeyEvent> events) {
+  return m_impl && m_impl->sendSequence(events);
+}
+
+AXIDEV_IO_API CompiledSequence
+Sender::compile(std::span<const KeyEvent> events) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!m_impl->compileEvents(*data, events))
+    return {};
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+AXIDEV_IO_API CompiledSequence Sender::compile(std::u32string_view text) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!Impl::appendUnicodeInputs(data->events, text))
+    return {};
+  data->endSegment(0);
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+AXIDEV_IO_API CompiledSequence Sender::compile(std::string_view utf8Text) {
+  if (!m_impl)
+    return {};
+  m_impl->syncLayout();
+  auto data = std::make_shared<CompiledSequence::Data>();
+  if (!Impl::appendUnicodeInputs(data->events, utf8Text))
+    return {};
+  data->endSegment(0);
+  return CompiledSequence(std::move(data), m_impl->layoutGeneration,
+                          m_impl->layoutUpdates.epoch());
+}
+
+AXIDEV_IO_API bool Sender::replay(const CompiledSequence &sequence) {
+  if (!m_impl)
+    return false;
+  // Adopt a pending layout switch first, so that a sequence compiled for
+  // the previous layout is refused rather than typed with the wrong keys.
+  m_impl->syncLayout();
+  if (!sequence.valid() ||
+      sequence.m_layoutEpoch != m_impl->layoutUpdates.epoch()) {
+    AXIDEV_IO_LOG_DEBUG("Sender (Windows): replay of an invalid sequence");
+    return false;
+  }
+  return m_impl->submit(*sequence.m_data);
+}
+
 AXIDEV_IO_API bool Sender::keyDown(KeyWithModifier keyMod) {
   AXIDEV_IO_LOG_DEBUG(
       "Sender::keyDown %s",
@@ -368,56 +680,20 @@ AXIDEV_IO_API bool Sender::releaseAllModifiers() {
                          Modifier::Super);
 }
 
-AXIDEV_IO_API bool Sender::typeText(const std::u32string &text) {
+AXIDEV_IO_API bool Sender::typeText(std::u32string_view text) {
   AXIDEV_IO_LOG_DEBUG("Sender::typeText (utf32) called with %zu codepoints",
                     text.size());
   return m_impl->typeUnicode(text);
 }
 
-AXIDEV_IO_API bool Sender::typeText(const std::string &utf8Text) {
-  // Convert UTF-8 to UTF-32
-  std::u32string utf32;
-  size_t i = 0;
-  while (i < utf8Text.size()) {
-    char32_t cp = 0;
-    unsigned char c = utf8Text[i];
-
-    if ((c & 0x80) == 0) {
-      cp = c;
-      i += 1;
-    } else if ((c & 0xE0) == 0xC0) {
-      cp = (c & 0x1F) << 6;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F);
-      i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-      cp = (c & 0x0F) << 12;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F) << 6;
-      if (i + 2 < utf8Text.size())
-        cp |= (utf8Text[i + 2] & 0x3F);
-      i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-      cp = (c & 0x07) << 18;
-      if (i + 1 < utf8Text.size())
-        cp |= (utf8Text[i + 1] & 0x3F) << 12;
-      if (i + 2 < utf8Text.size())
-        cp |= (utf8Text[i + 2] & 0x3F) << 6;
-      if (i + 3 < utf8Text.size())
-        cp |= (utf8Text[i + 3] & 0x3F);
-      i += 4;
-    } else {
-      i += 1;
-      continue;
-    }
-
-    utf32.push_back(cp);
-  }
-  return typeText(utf32);
+AXIDEV_IO_API bool Sender::typeText(std::string_view utf8Text) {
+  AXIDEV_IO_LOG_DEBUG("Sender::typeText (utf8) called with %zu bytes",
+                    utf8Text.size());
+  return m_impl->typeUnicode(utf8Text);
 }
 
 AXIDEV_IO_API bool Sender::typeCharacter(char32_t codepoint) {
-  return typeText(std::u32string(1, codepoint));
+  return typeText(std::u32string_view(&codepoint, 1));
 }
 
 AXIDEV_IO_API void Sender::flush() {
@@ -425,7 +701,20 @@ AXIDEV_IO_API void Sender::flush() {
 }
 
 AXIDEV_IO_API void Sender::setKeyDelay(uint32_t delayUs) {
-  m_impl->keyDelayUs = delayUs;
+  m_impl->pacer.setInterval(delayUs);
+}
+
+AXIDEV_IO_API void Sender::setKeyDelaySpin(uint32_t spinUs) {
+  m_impl->pacer.setSpinUs(spinUs);
+}
+
+AXIDEV_IO_API void Sender::setTextBatchSize(size_t characters) {
+  m_impl->textBatchSize =
+      characters > 0 ? characters : Impl::kDefaultTextBatchSize;
+}
+
+AXIDEV_IO_API size_t Sender::lastTypedCount() const {
+  return m_impl->lastTyped;
 }
 
 } // namespace axidev::io::keyboard
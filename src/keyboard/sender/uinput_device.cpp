@@ -0,0 +1,251 @@
+/**
+ * @file keyboard/sender/uinput_device.cpp
+ * @brief Creation, readiness and writes of the shared uinput device.
+ */
+
+#if defined(__linux__) && !defined(BACKEND_USE_X11)
+
+#include "keyboard/sender/uinput_device.hpp"
+
+#include <algorithm>
+#include <axidev-io/log.hpp>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <libudev.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+namespace axidev::io::keyboard::detail {
+
+static_assert(UinputDevice::kKeyCount == KEY_CNT,
+              "UinputDevice::kKeyCount must cover every evdev key code");
+
+std::shared_ptr<UinputDevice> UinputDevice::acquire() {
+  static std::mutex mutex;
+  // Strong reference: the device outlives every Sender, so creating and
+  // destroying Senders in a loop never recreates it.
+  static std::shared_ptr<UinputDevice> shared;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!shared || !shared->valid())
+    shared = std::shared_ptr<UinputDevice>(new UinputDevice());
+  return shared;
+}
+
+UinputDevice::UinputDevice() {
+  fd_ = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+  if (fd_ < 0) {
+    AXIDEV_IO_LOG_ERROR("Sender (uinput): failed to open /dev/uinput: %s",
+                        strerror(errno));
+    return;
+  }
+
+  ioctl(fd_, UI_SET_EVBIT, EV_KEY);
+
+  // uinput has no bulk form of UI_SET_KEYBIT; this loop now runs once per
+  // process rather than once per Sender.
+#ifdef KEY_MAX
+  for (int i = 0; i < KEY_MAX; ++i) {
+    ioctl(fd_, UI_SET_KEYBIT, i);
+  }
+#endif
+
+  struct uinput_setup usetup{};
+  std::memset(&usetup, 0, sizeof(usetup));
+  usetup.id.bustype = BUS_USB;
+  usetup.id.vendor = 0x1234;
+  usetup.id.product = 0x5678;
+  std::strncpy(usetup.name, "Virtual Keyboard", UINPUT_MAX_NAME_SIZE - 1);
+
+  armMonitor();
+  ioctl(fd_, UI_DEV_SETUP, &usetup);
+  ioctl(fd_, UI_DEV_CREATE);
+  settleDeadline_ = std::chrono::steady_clock::now() + kSettleTimeout;
+  node_ = findNode();
+
+  AXIDEV_IO_LOG_INFO("Sender (uinput): device created fd=%d node=%s", fd_,
+                     node_.empty() ? "?" : node_.c_str());
+}
+
+UinputDevice::~UinputDevice() {
+  releaseMonitor();
+  if (fd_ >= 0) {
+    ioctl(fd_, UI_DEV_DESTROY);
+    close(fd_);
+    AXIDEV_IO_LOG_INFO("Sender (uinput): device destroyed (fd=%d)", fd_);
+  }
+}
+
+/**
+ * @internal
+ * @brief Subscribe to udev "input" events before the device is created, so
+ * that its announcement cannot be missed. Failure is not an error; the
+ * device then settles on the timeout alone.
+ */
+void UinputDevice::armMonitor() {
+  udev_ = udev_new();
+  if (udev_)
+    monitor_ = udev_monitor_new_from_netlink(udev_, "udev");
+  if (monitor_ &&
+      (udev_monitor_filter_add_match_subsystem_devtype(monitor_, "input",
+                                                       nullptr) < 0 ||
+       udev_monitor_enable_receiving(monitor_) < 0)) {
+    udev_monitor_unref(monitor_);
+    monitor_ = nullptr;
+  }
+  if (!monitor_) {
+    AXIDEV_IO_LOG_DEBUG("Sender (uinput): no udev monitor, device readiness "
+                        "falls back to a %lld ms settle time",
+                        static_cast<long long>(kSettleTimeout.count()));
+    releaseMonitor();
+  }
+}
+
+void UinputDevice::releaseMonitor() {
+  if (monitor_)
+    udev_monitor_unref(monitor_);
+  if (udev_)
+    udev_unref(udev_);
+  monitor_ = nullptr;
+  udev_ = nullptr;
+}
+
+/**
+ * @internal
+ * @brief Resolve the event node of the freshly created device through
+ * `UI_GET_SYSNAME` and sysfs.
+ * @return "/dev/input/eventN", or an empty string if it is unknown (older
+ * kernels), in which case any new event node satisfies `awaitReady()`.
+ */
+std::string UinputDevice::findNode() const {
+  char sysname[64] = {};
+  if (ioctl(fd_, UI_GET_SYSNAME(sizeof(sysname) - 1), sysname) < 0 ||
+      sysname[0] == '\0')
+    return {};
+  const std::string dir = std::string("/sys/devices/virtual/input/") + sysname;
+  // The input device has exactly one "eventN" child once it is registered.
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("event", 0) == 0)
+      return "/dev/input/" + name;
+  }
+  return {};
+}
+
+/// Consume queued udev events; true once our node has been announced.
+bool UinputDevice::nodeAnnounced() {
+  bool seen = false;
+  while (struct udev_device *dev = udev_monitor_receive_device(monitor_)) {
+    const char *action = udev_device_get_action(dev);
+    const char *node = udev_device_get_devnode(dev);
+    if (action && node && std::strcmp(action, "add") == 0) {
+      seen = seen || (node_.empty()
+                          ? std::strncmp(node, "/dev/input/event", 16) == 0
+                          : node_ == node);
+    }
+    udev_device_unref(dev);
+  }
+  return seen;
+}
+
+bool UinputDevice::awaitReady(std::chrono::steady_clock::time_point deadline) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return awaitReadyLocked(deadline);
+}
+
+bool UinputDevice::awaitReadyLocked(
+    std::chrono::steady_clock::time_point deadline) {
+  if (settled_)
+    return true;
+  if (fd_ < 0)
+    return false;
+  while (true) {
+    if (monitor_ && nodeAnnounced()) {
+      AXIDEV_IO_LOG_DEBUG("Sender (uinput): %s announced by udev",
+                          node_.empty() ? "device" : node_.c_str());
+      break;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= settleDeadline_) {
+      AXIDEV_IO_LOG_DEBUG(
+          "Sender (uinput): no udev announcement, assuming device ready");
+      break;
+    }
+    if (now >= deadline)
+      return false;
+    const auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+        std::min(deadline, settleDeadline_) - now);
+    if (monitor_) {
+      struct pollfd pfd = {udev_monitor_get_fd(monitor_), POLLIN, 0};
+      poll(&pfd, 1, static_cast<int>(wait.count()));
+    } else {
+      std::this_thread::sleep_for(wait);
+    }
+  }
+  settled_ = true;
+  releaseMonitor();
+  return true;
+}
+
+bool UinputDevice::write(const struct input_event *events, size_t count,
+                         HeldKeys &held) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0)
+    return false;
+  awaitReadyLocked(std::chrono::steady_clock::time_point::max());
+  // Written in runs, skipping releases of keys other writers still hold.
+  size_t runStart = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const struct input_event &ev = events[i];
+    if (ev.type != EV_KEY || ev.code >= kKeyCount)
+      continue;
+    uint16_t &holders = holders_[ev.code];
+    if (ev.value != 0) {
+      if (!held.test(ev.code)) {
+        held.set(ev.code);
+        ++holders;
+      }
+      continue;
+    }
+    if (held.test(ev.code)) {
+      held.reset(ev.code);
+      --holders;
+    }
+    if (holders == 0)
+      continue;
+    if (!writeLocked(events + runStart, i - runStart))
+      return false;
+    runStart = i + 1;
+  }
+  return writeLocked(events + runStart, count - runStart);
+}
+
+bool UinputDevice::writeLocked(const struct input_event *events,
+                               size_t count) {
+  const auto *data = reinterpret_cast<const char *>(events);
+  size_t remaining = count * sizeof(struct input_event);
+  while (remaining > 0) {
+    ssize_t n = ::write(fd_, data, remaining);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      AXIDEV_IO_LOG_ERROR("Sender (uinput): write() failed: %s",
+                          strerror(errno));
+      return false;
+    }
+    data += n;
+    remaining -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+} // namespace axidev::io::keyboard::detail
+
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+/**
+ * @file keyboard/sender/uinput_device.hpp
+ * @brief Internal process-wide virtual keyboard for the uinput Sender.
+ *
+ * Creating a uinput device is expensive well beyond this process: udev,
+ * libinput and the compositor all run their device-added handling for it,
+ * and tear it down again when it goes away. Every uinput Sender therefore
+ * writes to one shared device, created by the first Sender and kept until
+ * the process exits.
+ */
+
+#if defined(__linux__) && !defined(BACKEND_USE_X11)
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+struct input_event;
+struct udev;
+struct udev_monitor;
+
+namespace axidev::io::keyboard::detail {
+
+/**
+ * @internal
+ * @brief Reference-counted handle on the shared uinput keyboard device.
+ *
+ * Writes from different Senders are serialized, so each `write()` call
+ * reaches the device as one uninterrupted run of events.
+ *
+ * Held keys are reference-counted across Senders: a key goes down with its
+ * first holder and only goes up when its last holder releases it, so one
+ * Sender releasing (or being destroyed with) a key never lifts it from
+ * under another that still holds it.
+ */
+class UinputDevice {
+public:
+  /// Number of evdev key codes (`KEY_CNT`).
+  static constexpr size_t kKeyCount = 0x300;
+  /// Keys one writer holds down through the device.
+  using HeldKeys = std::bitset<kKeyCount>;
+
+  /// Longest time `awaitReady()` waits for udev after the device is created.
+  static constexpr std::chrono::milliseconds kSettleTimeout{100};
+
+  /**
+   * @brief The shared device, created on first use.
+   *
+   * A device whose creation failed (no access to `/dev/uinput`) is not kept,
+   * so a later call tries again.
+   *
+   * @return std::shared_ptr<UinputDevice> Never null; check `valid()`.
+   */
+  static std::shared_ptr<UinputDevice> acquire();
+
+  ~UinputDevice();
+  UinputDevice(const UinputDevice &) = delete;
+  UinputDevice &operator=(const UinputDevice &) = delete;
+
+  /// True when the device was created.
+  bool valid() const noexcept { return fd_ >= 0; }
+  int fd() const noexcept { return fd_; }
+
+  /**
+   * @brief Wait until the device is read by the rest of the system, or
+   * @p deadline.
+   *
+   * Readers such as libinput only open the new event node once udev has
+   * announced it, so events written before that are lost. A udev monitor
+   * armed before `UI_DEV_CREATE` observes that announcement; without one the
+   * device counts as ready `kSettleTimeout` after creation.
+   *
+   * @return true when the device is ready; false if @p deadline came first
+   * or there is no device.
+   */
+  bool awaitReady(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Write @p count events on behalf of the writer holding @p held,
+   * waiting for readiness first.
+   *
+   * Key events update @p held and the per-key holder counts; a release of a
+   * key that another writer still holds is not written.
+   *
+   * @return false on failure (logged); the remaining events are dropped.
+   */
+  bool write(const struct input_event *events, size_t count,
+             HeldKeys &held);
+
+private:
+  UinputDevice();
+
+  void armMonitor();
+  void releaseMonitor();
+  std::string findNode() const;
+  bool nodeAnnounced();
+  bool awaitReadyLocked(std::chrono::steady_clock::time_point deadline);
+  bool writeLocked(const struct input_event *events, size_t count);
+
+  int fd_{-1};
+  std::mutex mutex_;
+  struct udev *udev_{nullptr};
+  struct udev_monitor *monitor_{nullptr};
+  // "/dev/input/eventN" of the device, or empty if it could not be resolved.
+  std::string node_;
+  bool settled_{false};
+  std::chrono::steady_clock::time_point settleDeadline_{};
+  // Number of writers holding each key down.
+  std::array<uint16_t, kKeyCount> holders_{};
+};
+
+} // namespace axidev::io::keyboard::detail
+
+#endif
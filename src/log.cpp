@@ -0,0 +1,380 @@
+/**
+ * @file log.cpp
+ * @brief Record dispatch, the default stderr sink and the async writer for
+ * `<axidev-io/log.hpp>`.
+ *
+ * Synchronous mode formats the record on the calling thread and calls the
+ * sink under a mutex. Async mode formats into a slot of a bounded
+ * multi-producer/single-consumer queue; a writer thread drains the queue into
+ * the sink, so logging threads never wait on the sink or on stderr.
+ */
+
+#include <axidev-io/log.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace axidev {
+namespace io {
+namespace log {
+
+namespace {
+
+/// Longest trimmed source path kept by the async queue.
+constexpr size_t kAsyncFileCapacity = 96;
+
+/**
+ * @brief Record storage inside the async queue (fixed size, no allocation).
+ */
+struct QueuedRecord {
+  Level level{Level::Info};
+  int line{0};
+  int64_t timestampUs{0};
+  char file[kAsyncFileCapacity];
+  char message[kAsyncMessageCapacity];
+};
+
+/**
+ * @brief Bounded lock-free MPSC queue of log records.
+ *
+ * Vyukov-style ring where every cell carries a sequence number: producers
+ * claim a position with a CAS on the enqueue counter and publish the filled
+ * cell by bumping its sequence; the single consumer reads cells in order.
+ * Records are written in place so a push copies only the formatted bytes.
+ */
+class RecordQueue {
+public:
+  explicit RecordQueue(size_t minCapacity) {
+    size_t cap = 2;
+    while (cap < minCapacity)
+      cap <<= 1;
+    mask_ = cap - 1;
+    cells_ = std::make_unique<Cell[]>(cap);
+    for (size_t i = 0; i < cap; ++i)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Claim a cell and fill it with @p fill (any producer thread).
+   * @return false when the queue is full.
+   */
+  template <typename Fill> bool tryPush(Fill &&fill) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          fill(cell.record);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Hand the oldest published record to @p fn (consumer thread only).
+   * @return false when no published record is available.
+   */
+  template <typename Fn> bool tryConsume(Fn &&fn) {
+    Cell &cell = cells_[dequeuePos_ & mask_];
+    const size_t seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != dequeuePos_ + 1)
+      return false;
+    fn(cell.record);
+    cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    QueuedRecord record;
+  };
+
+  static constexpr size_t kCacheLine = 64;
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_{0};
+  alignas(kCacheLine) std::atomic<size_t> enqueuePos_{0};
+  alignas(kCacheLine) size_t dequeuePos_{0};
+};
+
+/**
+ * @brief Process-wide logging state.
+ *
+ * A single function-local static so the sink outlives the writer thread
+ * during static destruction (members are destroyed after the destructor
+ * body has stopped async mode).
+ */
+struct LogState {
+  // Sink, guarded by sinkMutex. Held while the sink runs, which is what
+  // serializes sink calls.
+  std::mutex sinkMutex;
+  Sink sink{stderrSink};
+  void *sinkUserData{nullptr};
+
+  // Async mode. `queue` is the only thing producers look at; `inflight`
+  // lets stopAsync() wait out producers that already loaded it.
+  std::mutex lifecycleMutex;
+  std::atomic<RecordQueue *> queue{nullptr};
+  std::atomic<int> inflight{0};
+  std::atomic<bool> signaled{false};
+  std::atomic<uint64_t> dropped{0};
+  std::unique_ptr<RecordQueue> ownedQueue;
+  std::thread writer;
+  std::mutex wakeMutex;
+  std::condition_variable wake;
+  bool stopping{false}; // guarded by wakeMutex
+
+  ~LogState();
+};
+
+LogState &state() {
+  static LogState s;
+  return s;
+}
+
+int64_t nowUs() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(system_clock::now().time_since_epoch())
+      .count();
+}
+
+void copyTruncated(char *dst, size_t dstSize, const char *src) {
+  size_t n = std::strlen(src);
+  if (n >= dstSize)
+    n = dstSize - 1;
+  std::memcpy(dst, src, n);
+  dst[n] = '\0';
+}
+
+/**
+ * @brief Writer thread body: sleep until signaled, then drain the queue.
+ *
+ * `stopping` is only set after every producer has left the queue, so the
+ * final drain after observing it flushes everything that was accepted.
+ */
+void writerLoop(LogState &st, RecordQueue &queue) {
+  std::unique_lock<std::mutex> lk(st.wakeMutex);
+  for (;;) {
+    st.wake.wait(lk, [&st] {
+      return st.stopping || st.signaled.load(std::memory_order_acquire);
+    });
+    const bool stopping = st.stopping;
+    lk.unlock();
+
+    // Reset before draining: records published after this point raise the
+    // signal again.
+    st.signaled.store(false, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> sinkLock(st.sinkMutex);
+      while (queue.tryConsume([&st](const QueuedRecord &queued) {
+        Record rec;
+        rec.level = queued.level;
+        rec.file = queued.file;
+        rec.line = queued.line;
+        rec.timestampUs = queued.timestampUs;
+        rec.message = queued.message;
+        st.sink(rec, st.sinkUserData);
+      })) {
+      }
+    }
+
+    lk.lock();
+    if (stopping)
+      return;
+  }
+}
+
+/**
+ * @brief Tear down async mode; caller holds `st.lifecycleMutex`.
+ */
+void stopAsyncLocked(LogState &st) {
+  if (!st.ownedQueue)
+    return;
+
+  // New records go to the synchronous path from here on; wait for producers
+  // that already picked up the queue pointer to finish their push.
+  st.queue.store(nullptr, std::memory_order_seq_cst);
+  while (st.inflight.load(std::memory_order_seq_cst) != 0)
+    std::this_thread::yield();
+
+  {
+    std::lock_guard<std::mutex> wakeLock(st.wakeMutex);
+    st.stopping = true;
+  }
+  st.wake.notify_one();
+  if (st.writer.joinable())
+    st.writer.join();
+  st.ownedQueue.reset();
+}
+
+LogState::~LogState() {
+  // A still-running writer would call std::terminate when destroyed.
+  std::lock_guard<std::mutex> lk(lifecycleMutex);
+  stopAsyncLocked(*this);
+}
+
+} // namespace
+
+AXIDEV_IO_API void stderrSink(const Record &record, void * /*userData*/) {
+  const std::time_t t = static_cast<std::time_t>(record.timestampUs / 1000000);
+  const int ms = static_cast<int>((record.timestampUs / 1000) % 1000);
+
+  // Convert to local time in a portable way
+  std::tm tmbuf;
+#if defined(_MSC_VER) || defined(_WIN32)
+  localtime_s(&tmbuf, &t);
+#else
+  localtime_r(&t, &tmbuf);
+#endif
+
+  char timebuf[64];
+  if (std::strftime(timebuf, sizeof(timebuf), "%Y-%m-%d %H:%M:%S", &tmbuf) ==
+      0) {
+    // Fallback if strftime fails
+    std::snprintf(timebuf, sizeof(timebuf), "%lld", static_cast<long long>(t));
+  }
+
+  const bool use_colors = colorsEnabled();
+  const char *reset = use_colors ? "\x1b[0m" : "";
+  const char *file_color = use_colors ? "\x1b[90m" : "";
+  const char *lvl_color = use_colors ? levelColor(record.level) : "";
+
+  // timestamp.millis [LEVEL] file:line: message (with coloring), written in
+  // one call so concurrent writers from other processes don't interleave.
+  std::fprintf(stderr, "[axidev-io] %s.%03d [%s%s%s] %s%s:%d:%s %s\n", timebuf,
+               ms, lvl_color, levelToString(record.level), reset, file_color,
+               record.file, record.line, reset, record.message);
+  // Flush for immediacy (useful when used from tests / CI)
+  std::fflush(stderr);
+}
+
+AXIDEV_IO_API void setSink(Sink sink, void *userData) {
+  LogState &st = state();
+  std::lock_guard<std::mutex> lk(st.sinkMutex);
+  st.sink = sink ? sink : stderrSink;
+  st.sinkUserData = sink ? userData : nullptr;
+}
+
+AXIDEV_IO_API bool startAsync(size_t capacity) {
+  LogState &st = state();
+  std::lock_guard<std::mutex> lk(st.lifecycleMutex);
+  if (st.ownedQueue)
+    return true;
+
+  auto queue = std::make_unique<RecordQueue>(capacity);
+  {
+    std::lock_guard<std::mutex> wakeLock(st.wakeMutex);
+    st.stopping = false;
+  }
+  st.signaled.store(false, std::memory_order_relaxed);
+  try {
+    st.writer = std::thread(writerLoop, std::ref(st), std::ref(*queue));
+  } catch (const std::system_error &e) {
+    AXIDEV_IO_LOG_ERROR("log: failed to start async writer thread: %s",
+                        e.what());
+    return false;
+  }
+  st.ownedQueue = std::move(queue);
+  st.queue.store(st.ownedQueue.get(), std::memory_order_seq_cst);
+  return true;
+}
+
+AXIDEV_IO_API void stopAsync() {
+  LogState &st = state();
+  std::lock_guard<std::mutex> lk(st.lifecycleMutex);
+  stopAsyncLocked(st);
+}
+
+AXIDEV_IO_API bool asyncEnabled() {
+  return state().queue.load(std::memory_order_acquire) != nullptr;
+}
+
+AXIDEV_IO_API uint64_t droppedMessages() {
+  return state().dropped.load(std::memory_order_relaxed);
+}
+
+AXIDEV_IO_API void vlog(Level level, const char *file, int line,
+                        const char *fmt, va_list ap) {
+  if (!isEnabled(level))
+    return;
+
+  const int64_t timestampUs = nowUs();
+  const char *trimmed = trimPathToAxidevIo(file ? file : "");
+  LogState &st = state();
+
+  // Async path. The seq_cst increment/load pair with stopAsync()'s store/load
+  // guarantees the queue cannot be freed while we are pushing into it.
+  st.inflight.fetch_add(1, std::memory_order_seq_cst);
+  if (RecordQueue *queue = st.queue.load(std::memory_order_seq_cst)) {
+    const bool pushed = queue->tryPush([&](QueuedRecord &rec) {
+      rec.level = level;
+      rec.line = line;
+      rec.timestampUs = timestampUs;
+      copyTruncated(rec.file, sizeof(rec.file), trimmed);
+      if (std::vsnprintf(rec.message, sizeof(rec.message), fmt, ap) < 0)
+        rec.message[0] = '\0';
+    });
+    if (!pushed) {
+      st.dropped.fetch_add(1, std::memory_order_relaxed);
+    } else if (!st.signaled.exchange(true, std::memory_order_acq_rel)) {
+      // Only the idle-to-pending edge wakes the writer. Notifying under the
+      // mutex means the writer is either before its predicate check (and
+      // sees the flag) or already waiting, so the wake-up cannot be lost.
+      std::lock_guard<std::mutex> wakeLock(st.wakeMutex);
+      st.wake.notify_one();
+    }
+    st.inflight.fetch_sub(1, std::memory_order_seq_cst);
+    return;
+  }
+  st.inflight.fetch_sub(1, std::memory_order_seq_cst);
+
+  // Synchronous path: format on the stack, falling back to the heap for long
+  // messages so nothing is truncated.
+  char stackBuf[1024];
+  std::string heapBuf;
+  const char *message = stackBuf;
+  va_list apCopy;
+  va_copy(apCopy, ap);
+  int n = std::vsnprintf(stackBuf, sizeof(stackBuf), fmt, apCopy);
+  va_end(apCopy);
+  if (n < 0) {
+    stackBuf[0] = '\0';
+  } else if (static_cast<size_t>(n) >= sizeof(stackBuf)) {
+    heapBuf.resize(static_cast<size_t>(n) + 1);
+    std::vsnprintf(heapBuf.data(), heapBuf.size(), fmt, ap);
+    message = heapBuf.c_str();
+  }
+
+  Record rec;
+  rec.level = level;
+  rec.file = trimmed;
+  rec.line = line;
+  rec.timestampUs = timestampUs;
+  rec.message = message;
+
+  std::lock_guard<std::mutex> lk(st.sinkMutex);
+  st.sink(rec, st.sinkUserData);
+}
+
+} // namespace log
+} // namespace io
+} // namespace axidev
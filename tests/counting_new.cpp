@@ -0,0 +1,50 @@
+/**
+ * @file counting_new.cpp
+ * @brief Counting replacements of the global allocation functions for
+ * `axidev-io-hot-path-tests`.
+ *
+ * Every non-aligned form is replaced, so any new/delete pair in the binary,
+ * including the library's `new (std::nothrow)`, goes through malloc() and
+ * free(); the aligned forms keep the runtime's own pair. They live in their
+ * own translation unit so the tests never see them inlined into a
+ * new-expression.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+uint64_t countedAllocations() {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return ::operator new(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+  return ::operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  std::free(p);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <filesystem>
 #include <string>
 
 #include <axidev-io/c_api.h>
@@ -14,6 +15,12 @@ static void noop_listener_cb(uint32_t codepoint,
   (void)user_data;
 }
 
+static void noop_listener_event_cb(const axidev_io_keyboard_event_t *event,
+                                   void *user_data) {
+  (void)event;
+  (void)user_data;
+}
+
 TEST(CApiTest, KeyStringConversion) {
   axidev_io_clear_last_error();
 
@@ -86,6 +93,39 @@ TEST(CApiTest, KeyStringWithModifierConversion) {
   EXPECT_FALSE(axidev_io_keyboard_string_to_key_with_modifier("Shift+A", NULL));
 }
 
+TEST(CApiTest, KeyStringBufferConversion) {
+  axidev_io_clear_last_error();
+
+  char buf[32];
+  axidev_io_keyboard_key_t enter = axidev_io_keyboard_string_to_key("Enter");
+  EXPECT_EQ(axidev_io_keyboard_key_to_string_buf(enter, buf, sizeof(buf)), 5u);
+  EXPECT_STREQ(buf, "Enter");
+
+  /* Truncation follows snprintf: full length returned, output terminated */
+  char small[3];
+  EXPECT_EQ(axidev_io_keyboard_key_to_string_buf(enter, small, sizeof(small)),
+            5u);
+  EXPECT_STREQ(small, "En");
+  EXPECT_EQ(axidev_io_keyboard_key_to_string_buf(enter, NULL, 0), 5u);
+
+  axidev_io_keyboard_key_with_modifier_t kwm;
+  kwm.key = axidev_io_keyboard_string_to_key("C");
+  kwm.mods = AXIDEV_IO_MOD_CTRL | AXIDEV_IO_MOD_SHIFT;
+  size_t n =
+      axidev_io_keyboard_key_to_string_with_modifier_buf(kwm, buf, sizeof(buf));
+  char *heap = axidev_io_keyboard_key_to_string_with_modifier(kwm);
+  ASSERT_NE(heap, nullptr);
+  EXPECT_EQ(n, std::strlen(heap));
+  EXPECT_STREQ(buf, heap);
+  axidev_io_free_string(heap);
+
+  /* NULL buffer with a non-zero size is an error */
+  EXPECT_EQ(axidev_io_keyboard_key_to_string_buf(enter, NULL, 8), 0u);
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+}
+
 TEST(CApiTest, SenderCreationAndErrorHandling) {
   axidev_io_clear_last_error();
 
@@ -117,8 +157,35 @@ TEST(CApiTest, SenderCreationAndErrorHandling) {
   axidev_io_free_string(err);
   axidev_io_clear_last_error();
 
+  /* A NULL event array is only accepted with count == 0. */
+  ok = axidev_io_keyboard_sender_send_sequence(sender, NULL, 2);
+  EXPECT_FALSE(ok);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("events"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  axidev_io_keyboard_key_event_t seq[2] = {{1, true, 0}, {1, false, 0}};
+  EXPECT_FALSE(axidev_io_keyboard_sender_send_sequence(NULL, seq, 2));
+  axidev_io_clear_last_error();
+
   /* Misc calls should be safe / no-ops in tests */
   axidev_io_keyboard_sender_set_key_delay(sender, 1000);
+  axidev_io_keyboard_sender_set_key_delay_spin(sender, 200);
+  axidev_io_keyboard_sender_set_key_delay_spin(NULL, 200);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  axidev_io_keyboard_sender_set_text_batch_size(sender, 64);
+  axidev_io_keyboard_sender_set_text_batch_size(sender, 0);
+  EXPECT_EQ(axidev_io_keyboard_sender_last_typed_count(NULL), 0u);
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(axidev_io_keyboard_sender_wait_until_ready(NULL, 10));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
   axidev_io_keyboard_sender_flush(sender);
 
   /* Freeing NULL should be safe */
@@ -127,6 +194,113 @@ TEST(CApiTest, SenderCreationAndErrorHandling) {
   axidev_io_keyboard_sender_destroy(sender);
 }
 
+TEST(CApiTest, SenderAsyncMode) {
+  axidev_io_clear_last_error();
+
+  /* NULL handles are rejected with a last error. */
+  EXPECT_FALSE(axidev_io_keyboard_sender_start_async(NULL, 0));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("sender"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_sender_t sender = axidev_io_keyboard_sender_create();
+  ASSERT_NE(sender, nullptr);
+
+  /* Before async mode nothing can be queued or waited on. */
+  axidev_io_keyboard_key_with_modifier_t unknown_key = {0, 0};
+  EXPECT_EQ(axidev_io_keyboard_sender_tap_async(sender, unknown_key), 0u);
+  EXPECT_FALSE(axidev_io_keyboard_sender_wait_idle(sender, 0));
+  EXPECT_EQ(axidev_io_keyboard_sender_async_failures(sender), 0u);
+  EXPECT_EQ(axidev_io_keyboard_sender_type_text_utf8_async(sender, NULL), 0u);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("utf8_text"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* Tapping Key::Unknown injects nothing, so the queued command completes
+     as a failure on every backend. */
+  if (axidev_io_keyboard_sender_start_async(sender, 4)) {
+    EXPECT_FALSE(axidev_io_keyboard_sender_start_async(sender, 4));
+    uint64_t ticket = axidev_io_keyboard_sender_tap_async(sender, unknown_key);
+    ASSERT_NE(ticket, 0u);
+    EXPECT_FALSE(axidev_io_keyboard_sender_wait(sender, ticket + 1, 0));
+    EXPECT_TRUE(axidev_io_keyboard_sender_wait(sender, ticket,
+                                               AXIDEV_IO_WAIT_INFINITE));
+    EXPECT_TRUE(axidev_io_keyboard_sender_wait_idle(sender, 1000));
+    EXPECT_EQ(axidev_io_keyboard_sender_async_failures(sender), 1u);
+    axidev_io_keyboard_sender_cancel_pending(sender);
+    axidev_io_keyboard_sender_stop_async(sender);
+  } else {
+    char *e = axidev_io_get_last_error();
+    if (e) {
+      axidev_io_free_string(e);
+      axidev_io_clear_last_error();
+    }
+  }
+
+  axidev_io_keyboard_sender_destroy(sender);
+}
+
+TEST(CApiTest, SenderCompiledSequences) {
+  axidev_io_clear_last_error();
+
+  /* NULL compiled handles are rejected or ignored. */
+  EXPECT_FALSE(axidev_io_keyboard_compiled_is_valid(NULL));
+  axidev_io_keyboard_compiled_destroy(NULL);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_sender_t sender = axidev_io_keyboard_sender_create();
+  ASSERT_NE(sender, nullptr);
+
+  EXPECT_FALSE(axidev_io_keyboard_sender_replay(sender, NULL));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("compiled"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_sequence(sender, NULL, 2),
+            nullptr);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("events"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_text_utf32(sender, NULL, 1),
+            nullptr);
+  axidev_io_clear_last_error();
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_text_utf8(sender, NULL), nullptr);
+  axidev_io_clear_last_error();
+
+  /* Ill-formed UTF-8 (an overlong NUL, an encoded surrogate) is rejected
+     before anything is compiled or typed. */
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_text_utf8(sender, "a\xC0\x80"),
+            nullptr);
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(
+      axidev_io_keyboard_sender_type_text_utf8(sender, "\xED\xA0\x80"));
+  EXPECT_EQ(axidev_io_keyboard_sender_last_typed_count(sender), 0u);
+  axidev_io_clear_last_error();
+
+  /* Key::Unknown never resolves, so compiling it fails on every backend
+     and no handle is returned. */
+  axidev_io_keyboard_key_event_t seq[2] = {{0, true, 0}, {0, false, 0}};
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_sequence(NULL, seq, 2), nullptr);
+  axidev_io_clear_last_error();
+  EXPECT_EQ(axidev_io_keyboard_sender_compile_sequence(sender, seq, 2),
+            nullptr);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_sender_destroy(sender);
+}
+
 TEST(CApiTest, ListenerCreateStartStop) {
   axidev_io_clear_last_error();
 
@@ -161,3 +335,413 @@ TEST(CApiTest, ListenerCreateStartStop) {
 
   axidev_io_keyboard_listener_destroy(listener);
 }
+
+TEST(CApiTest, ListenerQueuedMode) {
+  axidev_io_clear_last_error();
+
+  /* NULL handles are rejected with a last error. */
+  axidev_io_keyboard_event_t events[8];
+  EXPECT_EQ(axidev_io_keyboard_listener_poll(NULL, events, 8), 0u);
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("listener"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(axidev_io_keyboard_listener_start_queued(NULL, 0));
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+
+  /* Before queued mode there is nothing to drain or wait on. */
+  EXPECT_EQ(axidev_io_keyboard_listener_poll(listener, events, 8), 0u);
+  EXPECT_EQ(axidev_io_keyboard_listener_wait_handle(listener), -1);
+  EXPECT_FALSE(axidev_io_keyboard_listener_wait(listener, 0));
+  EXPECT_EQ(axidev_io_keyboard_listener_dropped_events(listener), 0u);
+
+  /* A NULL output buffer is only accepted with max_events == 0. */
+  EXPECT_EQ(axidev_io_keyboard_listener_poll(listener, NULL, 0), 0u);
+  EXPECT_EQ(axidev_io_keyboard_listener_poll(listener, NULL, 4), 0u);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("out_events"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* Starting may fail without permissions; when it succeeds the queue must be
+     drainable and waitable without blocking the test. */
+  bool ok = axidev_io_keyboard_listener_start_queued(listener, 16);
+  if (ok) {
+    EXPECT_TRUE(axidev_io_keyboard_listener_is_listening(listener));
+    EXPECT_NE(axidev_io_keyboard_listener_wait_handle(listener), -1);
+    (void)axidev_io_keyboard_listener_wait(listener, 10);
+    (void)axidev_io_keyboard_listener_poll(listener, events, 8);
+    axidev_io_keyboard_listener_stop(listener);
+    EXPECT_FALSE(axidev_io_keyboard_listener_is_listening(listener));
+  } else {
+    char *e = axidev_io_get_last_error();
+    if (e) {
+      axidev_io_free_string(e);
+      axidev_io_clear_last_error();
+    }
+  }
+
+  axidev_io_keyboard_listener_destroy(listener);
+}
+
+TEST(CApiTest, ListenerStatsAndTimedEvents) {
+  axidev_io_clear_last_error();
+
+  /* NULL handles and NULL outputs are rejected with a last error. */
+  axidev_io_keyboard_listener_stats_t stats;
+  EXPECT_FALSE(axidev_io_keyboard_listener_get_stats(NULL, &stats));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("listener"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(axidev_io_keyboard_listener_start_with_events(
+      NULL, noop_listener_event_cb, NULL));
+  axidev_io_clear_last_error();
+  axidev_io_keyboard_listener_reset_stats(NULL);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+
+  EXPECT_FALSE(axidev_io_keyboard_listener_get_stats(listener, NULL));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("out_stats"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  EXPECT_FALSE(
+      axidev_io_keyboard_listener_start_with_events(listener, NULL, NULL));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* A listener that never ran reports all-zero counters. */
+  std::memset(&stats, 0xff, sizeof(stats));
+  ASSERT_TRUE(axidev_io_keyboard_listener_get_stats(listener, &stats));
+  EXPECT_EQ(stats.events_seen, 0u);
+  EXPECT_EQ(stats.events_dropped, 0u);
+  EXPECT_EQ(stats.callback_time_max_ns, 0u);
+  for (int i = 0; i < AXIDEV_IO_LISTENER_HISTOGRAM_BUCKETS; ++i)
+    EXPECT_EQ(stats.callback_time_histogram[i], 0u);
+  axidev_io_keyboard_listener_reset_stats(listener);
+
+  /* Starting may fail without permissions; either way it must be safe. */
+  if (axidev_io_keyboard_listener_start_with_events(
+          listener, noop_listener_event_cb, NULL)) {
+    EXPECT_TRUE(axidev_io_keyboard_listener_is_listening(listener));
+    EXPECT_TRUE(axidev_io_keyboard_listener_get_stats(listener, &stats));
+    axidev_io_keyboard_listener_stop(listener);
+    EXPECT_FALSE(axidev_io_keyboard_listener_is_listening(listener));
+  } else {
+    char *e = axidev_io_get_last_error();
+    if (e) {
+      axidev_io_free_string(e);
+      axidev_io_clear_last_error();
+    }
+  }
+
+  axidev_io_keyboard_listener_destroy(listener);
+}
+
+TEST(CApiTest, ListenerFilter) {
+  axidev_io_clear_last_error();
+
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_filter(NULL, NULL));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("listener"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+
+  /* A non-zero count with a NULL array is rejected. */
+  axidev_io_keyboard_listener_filter_t filter;
+  std::memset(&filter, 0, sizeof(filter));
+  filter.key_count = 1;
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_filter(listener, &filter));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_key_t keys[2] = {axidev_io_keyboard_string_to_key("A"),
+                                      axidev_io_keyboard_string_to_key("Z")};
+  axidev_io_keyboard_key_with_modifier_t chord;
+  chord.key = axidev_io_keyboard_string_to_key("S");
+  chord.mods = AXIDEV_IO_MOD_CTRL;
+  filter.keys = keys;
+  filter.key_count = 2;
+  filter.chords = &chord;
+  filter.chord_count = 1;
+  filter.press_only = true;
+  filter.need_codepoint = false;
+  EXPECT_TRUE(axidev_io_keyboard_listener_set_filter(listener, &filter));
+
+  /* NULL clears the filter again. */
+  EXPECT_TRUE(axidev_io_keyboard_listener_set_filter(listener, NULL));
+
+  axidev_io_keyboard_listener_stats_t stats;
+  ASSERT_TRUE(axidev_io_keyboard_listener_get_stats(listener, &stats));
+  EXPECT_EQ(stats.events_filtered, 0u);
+
+  axidev_io_keyboard_listener_destroy(listener);
+}
+
+TEST(CApiTest, ListenerSources) {
+  axidev_io_clear_last_error();
+
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_sources(NULL, NULL));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("listener"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+
+  /* A non-zero count with a NULL array is rejected. */
+  axidev_io_keyboard_listener_sources_t sources;
+  std::memset(&sources, 0, sizeof(sources));
+  sources.device_path_count = 1;
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_sources(listener, &sources));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* So is a NULL entry. */
+  const char *seats[2] = {"seat0", NULL};
+  sources.device_path_count = 0;
+  sources.seats = seats;
+  sources.seat_count = 2;
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_sources(listener, &sources));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("seat"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* Explicit seats are only read on Linux. */
+  sources.seat_count = 1;
+#if defined(__linux__)
+  EXPECT_TRUE(axidev_io_keyboard_listener_set_sources(listener, &sources));
+#else
+  EXPECT_FALSE(axidev_io_keyboard_listener_set_sources(listener, &sources));
+  axidev_io_clear_last_error();
+#endif
+
+  /* NULL restores the default sources everywhere. */
+  EXPECT_TRUE(axidev_io_keyboard_listener_set_sources(listener, NULL));
+
+  axidev_io_keyboard_listener_destroy(listener);
+}
+
+TEST(CApiTest, MeasureRoundTripArguments) {
+  axidev_io_clear_last_error();
+  axidev_io_keyboard_round_trip_t result;
+
+  EXPECT_FALSE(
+      axidev_io_keyboard_measure_round_trip(NULL, NULL, 1, 10, &result));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("sender"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_sender_t sender = axidev_io_keyboard_sender_create();
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+  if (sender) {
+    EXPECT_FALSE(
+        axidev_io_keyboard_measure_round_trip(sender, NULL, 1, 10, &result));
+    axidev_io_clear_last_error();
+    EXPECT_FALSE(
+        axidev_io_keyboard_measure_round_trip(sender, listener, 1, 10, NULL));
+    err = axidev_io_get_last_error();
+    ASSERT_NE(err, nullptr);
+    EXPECT_NE(std::string(err).find("out_result"), std::string::npos);
+    axidev_io_free_string(err);
+    axidev_io_clear_last_error();
+    axidev_io_keyboard_sender_destroy(sender);
+  }
+  axidev_io_keyboard_listener_destroy(listener);
+}
+
+TEST(CApiTest, TraceRecordAndOpen) {
+  axidev_io_clear_last_error();
+  EXPECT_EQ(axidev_io_keyboard_trace_recorder_create(NULL), nullptr);
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("path"), std::string::npos);
+  axidev_io_free_string(err);
+  EXPECT_EQ(axidev_io_keyboard_trace_player_open(NULL), nullptr);
+  axidev_io_clear_last_error();
+
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "axidev-io-c-api.axkt")
+          .string();
+  axidev_io_keyboard_trace_recorder_t recorder =
+      axidev_io_keyboard_trace_recorder_create(path.c_str());
+  ASSERT_NE(recorder, nullptr);
+  EXPECT_FALSE(axidev_io_keyboard_trace_recorder_record(recorder, NULL));
+  axidev_io_keyboard_event_t ev;
+  std::memset(&ev, 0, sizeof(ev));
+  ev.key_mod.key = axidev_io_keyboard_string_to_key("A");
+  ev.pressed = true;
+  EXPECT_TRUE(axidev_io_keyboard_trace_recorder_record(recorder, &ev));
+  EXPECT_TRUE(axidev_io_keyboard_trace_recorder_flush(recorder));
+  EXPECT_EQ(axidev_io_keyboard_trace_recorder_recorded_count(recorder), 1u);
+  axidev_io_keyboard_trace_recorder_destroy(recorder);
+  axidev_io_keyboard_trace_recorder_destroy(NULL);
+
+  axidev_io_keyboard_trace_player_t player =
+      axidev_io_keyboard_trace_player_open(path.c_str());
+  ASSERT_NE(player, nullptr);
+  EXPECT_FALSE(axidev_io_keyboard_trace_player_play(player, NULL, 1.0, 0));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("sender"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  EXPECT_EQ(axidev_io_keyboard_trace_player_played_count(player), 0u);
+  EXPECT_EQ(axidev_io_keyboard_trace_player_skipped_count(player), 0u);
+  axidev_io_keyboard_trace_player_destroy(player);
+  axidev_io_keyboard_trace_player_destroy(NULL);
+
+  std::filesystem::remove(path);
+  EXPECT_EQ(axidev_io_keyboard_trace_player_open(path.c_str()), nullptr);
+  axidev_io_clear_last_error();
+}
+
+static void noop_listener_batch_cb(const axidev_io_keyboard_event_t *events,
+                                   size_t count, void *user_data) {
+  (void)events;
+  (void)count;
+  (void)user_data;
+}
+
+TEST(CApiTest, KeysToStringBuffer) {
+  axidev_io_clear_last_error();
+  const axidev_io_keyboard_key_t keys[] = {
+      axidev_io_keyboard_string_to_key("A"),
+      axidev_io_keyboard_string_to_key("Enter"),
+      axidev_io_keyboard_string_to_key("B")};
+
+  char buf[32];
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(keys, 3, ' ', buf,
+                                                  sizeof(buf)),
+            9u);
+  EXPECT_STREQ(buf, "A Enter B");
+
+  /* NUL separators keep each name terminated. */
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(keys, 3, '\0', buf,
+                                                  sizeof(buf)),
+            9u);
+  EXPECT_STREQ(buf, "A");
+  EXPECT_STREQ(buf + 2, "Enter");
+  EXPECT_STREQ(buf + 8, "B");
+
+  /* snprintf semantics: truncated but terminated, full length returned. */
+  char small[4];
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(keys, 3, ' ', small,
+                                                  sizeof(small)),
+            9u);
+  EXPECT_STREQ(small, "A E");
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(keys, 3, ' ', NULL, 0), 9u);
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(keys, 0, ' ', buf,
+                                                  sizeof(buf)),
+            0u);
+  EXPECT_STREQ(buf, "");
+
+  EXPECT_EQ(axidev_io_keyboard_keys_to_string_buf(NULL, 2, ' ', buf,
+                                                  sizeof(buf)),
+            0u);
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("keys"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+}
+
+TEST(CApiTest, SenderBatchedEntryPointsArguments) {
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(axidev_io_keyboard_sender_type_text_utf8_n(NULL, "a", 1));
+  EXPECT_EQ(axidev_io_keyboard_sender_type_text_utf8_n_async(NULL, "a", 1),
+            0u);
+  EXPECT_EQ(axidev_io_keyboard_sender_tap_keys(NULL, NULL, 0), 0u);
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("sender"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_sender_t sender = axidev_io_keyboard_sender_create();
+  if (!sender) {
+    axidev_io_clear_last_error();
+    return;
+  }
+  EXPECT_FALSE(axidev_io_keyboard_sender_type_text_utf8_n(sender, NULL, 3));
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("utf8_text"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  EXPECT_EQ(axidev_io_keyboard_sender_tap_keys(sender, NULL, 2), 0u);
+  err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("keys"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+  /* Nothing to tap is a complete success. */
+  EXPECT_EQ(axidev_io_keyboard_sender_tap_keys(sender, NULL, 0), 0u);
+  axidev_io_keyboard_sender_destroy(sender);
+}
+
+TEST(CApiTest, ListenerBatchedMode) {
+  axidev_io_clear_last_error();
+  EXPECT_FALSE(axidev_io_keyboard_listener_start_batched(
+      NULL, noop_listener_batch_cb, NULL, 0, 0));
+  axidev_io_clear_last_error();
+
+  axidev_io_keyboard_listener_t listener = axidev_io_keyboard_listener_create();
+  ASSERT_NE(listener, nullptr);
+  EXPECT_FALSE(
+      axidev_io_keyboard_listener_start_batched(listener, NULL, NULL, 0, 0));
+  char *err = axidev_io_get_last_error();
+  ASSERT_NE(err, nullptr);
+  EXPECT_NE(std::string(err).find("callback"), std::string::npos);
+  axidev_io_free_string(err);
+  axidev_io_clear_last_error();
+
+  /* Starting may fail without permissions; when it succeeds, stopping must
+     join the dispatcher and a second session must start cleanly. */
+  if (axidev_io_keyboard_listener_start_batched(
+          listener, noop_listener_batch_cb, NULL, 16, 4)) {
+    EXPECT_TRUE(axidev_io_keyboard_listener_is_listening(listener));
+    EXPECT_FALSE(axidev_io_keyboard_listener_start_batched(
+        listener, noop_listener_batch_cb, NULL, 16, 4));
+    axidev_io_clear_last_error();
+    axidev_io_keyboard_listener_stop(listener);
+    EXPECT_FALSE(axidev_io_keyboard_listener_is_listening(listener));
+    EXPECT_TRUE(axidev_io_keyboard_listener_start_batched(
+        listener, noop_listener_batch_cb, NULL, 16, 4));
+  } else {
+    axidev_io_clear_last_error();
+  }
+  /* Destroying a running batched listener joins the dispatcher. */
+  axidev_io_keyboard_listener_destroy(listener);
+}
@@ -0,0 +1,163 @@
+// test_hotkey.cpp
+// Unit tests for HotkeyMatcher: chords, multi-stroke sequences, modifier
+// handling, conflict rejection and sequence recovery. The matcher is pure
+// logic, so events are fed directly without a Listener.
+
+#include <gtest/gtest.h>
+
+#include <axidev-io/keyboard/hotkey.hpp>
+
+#include <vector>
+
+using namespace axidev::io::keyboard;
+
+namespace {
+
+KeyWithModifier ctrl(Key key) { return {key, Modifier::Ctrl}; }
+
+// Press and release @p keyMod, returning the binding matched by the press.
+HotkeyMatcher::BindingId tap(HotkeyMatcher &m, KeyWithModifier keyMod) {
+  HotkeyMatcher::BindingId id = m.feed(keyMod, true);
+  EXPECT_EQ(m.feed(keyMod, false), HotkeyMatcher::kInvalidBinding);
+  return id;
+}
+
+} // namespace
+
+TEST(HotkeyMatcherTest, ChordFiresAction) {
+  HotkeyMatcher m;
+  std::vector<HotkeyMatcher::BindingId> fired;
+  auto record = [&fired](HotkeyMatcher::BindingId id) { fired.push_back(id); };
+
+  HotkeyMatcher::BindingId save =
+      m.add(KeyWithModifier(Key::S, Modifier::Ctrl | Modifier::Shift), record);
+  ASSERT_NE(save, HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.size(), 1u);
+  m.compile();
+
+  EXPECT_EQ(tap(m, ctrl(Key::S)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(tap(m, {Key::S, Modifier::Ctrl | Modifier::Shift}), save);
+  // Lock states do not affect matching.
+  EXPECT_EQ(tap(m, {Key::S, Modifier::Ctrl | Modifier::Shift |
+                                Modifier::CapsLock}),
+            save);
+  EXPECT_EQ(fired, (std::vector<HotkeyMatcher::BindingId>{save, save}));
+}
+
+TEST(HotkeyMatcherTest, SequenceWithHeldModifier) {
+  HotkeyMatcher m;
+  int comments = 0;
+  HotkeyMatcher::BindingId id =
+      m.add("Ctrl+K Ctrl+C", [&comments](auto) { ++comments; });
+  ASSERT_NE(id, HotkeyMatcher::kInvalidBinding);
+
+  // Ctrl is held across both strokes; its own press must not break the
+  // sequence.
+  EXPECT_EQ(m.feed({Key::CtrlLeft, Modifier::Ctrl}, true),
+            HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_TRUE(m.pending());
+  EXPECT_EQ(tap(m, ctrl(Key::C)), id);
+  EXPECT_FALSE(m.pending());
+  EXPECT_EQ(comments, 1);
+
+  // The second stroke alone does nothing.
+  EXPECT_EQ(tap(m, ctrl(Key::C)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(comments, 1);
+}
+
+TEST(HotkeyMatcherTest, WrongStrokeRestartsSequence) {
+  HotkeyMatcher m;
+  HotkeyMatcher::BindingId kc = m.add("Ctrl+K Ctrl+C", {});
+  HotkeyMatcher::BindingId ku = m.add("Ctrl+K Ctrl+U", {});
+  HotkeyMatcher::BindingId p = m.add("Ctrl+P", {});
+  ASSERT_NE(kc, HotkeyMatcher::kInvalidBinding);
+  ASSERT_NE(ku, HotkeyMatcher::kInvalidBinding);
+  ASSERT_NE(p, HotkeyMatcher::kInvalidBinding);
+
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(tap(m, ctrl(Key::U)), ku);
+
+  // A stroke that breaks the sequence is retried from the start.
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(tap(m, ctrl(Key::P)), p);
+  EXPECT_FALSE(m.pending());
+
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(tap(m, {Key::X, Modifier::None}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_FALSE(m.pending());
+
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  m.reset();
+  EXPECT_EQ(tap(m, ctrl(Key::C)), HotkeyMatcher::kInvalidBinding);
+}
+
+TEST(HotkeyMatcherTest, RejectsInvalidAndConflictingBindings) {
+  HotkeyMatcher m;
+  EXPECT_EQ(m.add("", {}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.add("Ctrl+NotAKey", {}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.add(KeyWithModifier(Key::ShiftLeft), {}),
+            HotkeyMatcher::kInvalidBinding);
+
+  ASSERT_NE(m.add("Ctrl+K Ctrl+C", {}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.add("Ctrl+K Ctrl+C", {}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.add("Ctrl+K", {}), HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.add("Ctrl+K Ctrl+C Ctrl+D", {}),
+            HotkeyMatcher::kInvalidBinding);
+  EXPECT_EQ(m.size(), 1u);
+
+  // A rejected binding leaves the matcher unchanged.
+  EXPECT_EQ(tap(m, ctrl(Key::K)), HotkeyMatcher::kInvalidBinding);
+  EXPECT_NE(tap(m, ctrl(Key::C)), HotkeyMatcher::kInvalidBinding);
+
+  m.clear();
+  EXPECT_EQ(m.size(), 0u);
+  EXPECT_NE(m.add("Ctrl+K", {}), HotkeyMatcher::kInvalidBinding);
+}
+
+TEST(HotkeyMatcherTest, ManyBindings) {
+  HotkeyMatcher m;
+  std::vector<KeyWithModifier> seq(3);
+  std::vector<HotkeyMatcher::BindingId> ids;
+  // Every three-stroke sequence over F1..F12 with Alt: 1728 bindings.
+  for (int a = 0; a < 12; ++a) {
+    for (int b = 0; b < 12; ++b) {
+      for (int c = 0; c < 12; ++c) {
+        seq[0] = {static_cast<Key>(static_cast<int>(Key::F1) + a),
+                  Modifier::Alt};
+        seq[1] = {static_cast<Key>(static_cast<int>(Key::F1) + b),
+                  Modifier::Alt};
+        seq[2] = {static_cast<Key>(static_cast<int>(Key::F1) + c),
+                  Modifier::Alt};
+        ids.push_back(m.add(seq, {}));
+        ASSERT_NE(ids.back(), HotkeyMatcher::kInvalidBinding);
+      }
+    }
+  }
+  m.compile();
+
+  for (size_t i = 0; i < ids.size(); i += 97) {
+    const int a = static_cast<int>(i / 144), b = static_cast<int>(i / 12 % 12),
+              c = static_cast<int>(i % 12);
+    EXPECT_EQ(tap(m, {static_cast<Key>(static_cast<int>(Key::F1) + a),
+                      Modifier::Alt}),
+              HotkeyMatcher::kInvalidBinding);
+    EXPECT_EQ(tap(m, {static_cast<Key>(static_cast<int>(Key::F1) + b),
+                      Modifier::Alt}),
+              HotkeyMatcher::kInvalidBinding);
+    EXPECT_EQ(tap(m, {static_cast<Key>(static_cast<int>(Key::F1) + c),
+                      Modifier::Alt}),
+              ids[i]);
+  }
+}
+
+TEST(HotkeyMatcherTest, FeedsListenerEvents) {
+  HotkeyMatcher m;
+  HotkeyMatcher::BindingId id = m.add(ctrl(Key::Q), {});
+  Listener::Event ev;
+  ev.keyMod = ctrl(Key::Q);
+  ev.pressed = false;
+  EXPECT_EQ(m.feed(ev), HotkeyMatcher::kInvalidBinding);
+  ev.pressed = true;
+  EXPECT_EQ(m.feed(ev), id);
+}
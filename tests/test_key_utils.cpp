@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -292,6 +293,29 @@ TEST(KeyUtilsTest, CanonicalValues) {
   EXPECT_EQ(keyToString(Key::Minus), "-");
 }
 
+TEST(KeyUtilsTest, StringViewApi) {
+  // keyToStringView agrees with keyToString and is null-terminated.
+  for (unsigned i = 0; i <= 300u; ++i) {
+    Key k = static_cast<Key>(i);
+    std::string_view view = keyToStringView(k);
+    EXPECT_EQ(std::string(view), keyToString(k));
+    EXPECT_EQ(view.data()[view.size()], '\0');
+  }
+  EXPECT_EQ(keyToStringView(static_cast<Key>(0xFFFF)), "Unknown");
+
+  // Parsing honours the view bounds rather than a null terminator.
+  std::string_view combo = "EnterXYZ";
+  EXPECT_EQ(stringToKey(combo.substr(0, 5)), Key::Enter);
+  EXPECT_EQ(stringToKey(std::string_view("\0", 1)), Key::AsciiNUL);
+  EXPECT_EQ(stringToKeyWithModifier(std::string_view("Ctrl+Cx", 6)).key,
+            Key::C);
+
+  // Case-only aliases keep their exact-case preference.
+  EXPECT_EQ(stringToKey("OE"), Key::OE);
+  EXPECT_EQ(stringToKey("oe"), Key::oe);
+  EXPECT_EQ(stringToKey("Oe"), Key::oe);
+}
+
 TEST(ModifierTest, BitOpsAndHelpers) {
   AXIDEV_IO_LOG_INFO("test_key_utils: modifier bit-ops start");
   Modifier m = Modifier::None;
@@ -0,0 +1,292 @@
+/**
+ * @file test_keymap_cache.cpp
+ * @brief Tests for the shared keymap cache: the on-disk table format, the
+ * checks that reject foreign or damaged files, and snapshot reuse.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "keyboard/common/keymap_cache.hpp"
+
+using namespace axidev::io::keyboard;
+using detail::KeyMapBuild;
+using detail::SharedKeyMapCache;
+
+namespace {
+
+struct TestMap {
+  detail::KeyCodeTable keyToCode;
+  detail::CodeKeyTable codeToKey;
+  detail::CharMappingTable charToKeycode;
+  detail::CodeModsKeyTable codeAndModsToKey;
+  int stamped{0};
+};
+
+auto keyMapTables(TestMap &map) {
+  return std::tie(map.keyToCode, map.codeToKey, map.charToKeycode,
+                  map.codeAndModsToKey);
+}
+auto keyMapTables(const TestMap &map) {
+  return std::tie(map.keyToCode, map.codeToKey, map.charToKeycode,
+                  map.codeAndModsToKey);
+}
+
+TestMap sampleMap() {
+  TestMap map;
+  map.keyToCode.insert(Key::A, 30);
+  map.keyToCode.insert(Key::Enter, 28);
+  map.codeToKey.insert(30, Key::A);
+  map.codeToKey.insert(28, Key::Enter);
+  map.charToKeycode.insert(U'a', {30, Modifier::None, Key::A});
+  map.charToKeycode.insert(U'\u00E9', {18, Modifier::Alt, Key::Unknown});
+  map.codeAndModsToKey.insert(2, Modifier::Shift, Key::Exclamation);
+  return map;
+}
+
+void setCacheDir(const std::string &dir) {
+#ifdef _WIN32
+  _putenv_s("AXIDEV_IO_KEYMAP_CACHE_DIR", dir.c_str());
+#else
+  if (dir.empty())
+    unsetenv("AXIDEV_IO_KEYMAP_CACHE_DIR");
+  else
+    setenv("AXIDEV_IO_KEYMAP_CACHE_DIR", dir.c_str(), 1);
+#endif
+}
+
+// Points the on-disk cache at a fresh directory for the lifetime of a test.
+class KeymapCacheDir : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("axidev-io-keymap-cache-" +
+            std::string(::testing::UnitTest::GetInstance()
+                            ->current_test_info()
+                            ->name()));
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    setCacheDir(dir_.string());
+  }
+
+  void TearDown() override {
+    setCacheDir("");
+    std::error_code ec;
+    std::filesystem::remove_all(dir_, ec);
+  }
+
+  std::filesystem::path dir_;
+};
+
+std::string g_dataStamp = "data-1";
+std::string testDataStamp() { return g_dataStamp; }
+
+bool saveSample(const std::string &path, const std::string &layout) {
+  const TestMap map = sampleMap();
+  return detail::saveKeyMapFile(path, layout, [&map](std::ostream &out) {
+    std::apply(
+        [&out](const auto &...tables) {
+          (detail::writeKeyMapTable(out, tables), ...);
+        },
+        keyMapTables(map));
+  });
+}
+
+bool loadSample(const std::string &path, const std::string &layout) {
+  TestMap map;
+  return detail::loadKeyMapFile(path, layout, [&map](std::istream &in) {
+    return std::apply(
+        [&in](auto &...tables) {
+          return (detail::readKeyMapTable(in, tables) && ...);
+        },
+        keyMapTables(map));
+  });
+}
+
+} // namespace
+
+TEST(KeymapCacheFormat, TablesRoundTrip) {
+  const TestMap map = sampleMap();
+  std::stringstream stream;
+  std::apply(
+      [&stream](const auto &...tables) {
+        (detail::writeKeyMapTable(stream, tables), ...);
+      },
+      keyMapTables(map));
+
+  TestMap read;
+  ASSERT_TRUE(detail::readKeyMapTable(stream, read.keyToCode));
+  ASSERT_TRUE(detail::readKeyMapTable(stream, read.codeToKey));
+  ASSERT_TRUE(detail::readKeyMapTable(stream, read.charToKeycode));
+  ASSERT_TRUE(detail::readKeyMapTable(stream, read.codeAndModsToKey));
+
+  EXPECT_EQ(read.keyToCode.size(), 2u);
+  ASSERT_NE(read.keyToCode.find(Key::Enter), nullptr);
+  EXPECT_EQ(*read.keyToCode.find(Key::Enter), 28);
+  ASSERT_NE(read.codeToKey.find(30), nullptr);
+  EXPECT_EQ(*read.codeToKey.find(30), Key::A);
+  const KeyMapping *accent = read.charToKeycode.find(U'\u00E9');
+  ASSERT_NE(accent, nullptr);
+  EXPECT_EQ(accent->keycode, 18);
+  EXPECT_EQ(accent->requiredMods, Modifier::Alt);
+  EXPECT_EQ(accent->producedKey, Key::Unknown);
+  ASSERT_NE(read.codeAndModsToKey.find(2, Modifier::Shift), nullptr);
+  EXPECT_EQ(*read.codeAndModsToKey.find(2, Modifier::Shift),
+            Key::Exclamation);
+}
+
+TEST(KeymapCacheFormat, RejectsBadCounts) {
+  // A count larger than any real table, and one promising more entries than
+  // the stream holds.
+  std::stringstream huge;
+  const uint32_t tooMany = 0xFFFFFFFFu;
+  huge.write(reinterpret_cast<const char *>(&tooMany), sizeof(tooMany));
+  detail::CodeKeyTable table;
+  EXPECT_FALSE(detail::readKeyMapTable(huge, table));
+
+  std::stringstream truncated;
+  const uint32_t two = 2;
+  truncated.write(reinterpret_cast<const char *>(&two), sizeof(two));
+  truncated.write("\x1e\0\0\0\x04\0", 6);
+  detail::CodeKeyTable other;
+  EXPECT_FALSE(detail::readKeyMapTable(truncated, other));
+}
+
+TEST_F(KeymapCacheDir, FileRoundTripAndIdentityCheck) {
+  const std::string path = detail::keyMapCachePath("test", "us");
+  ASSERT_FALSE(path.empty());
+  EXPECT_NE(path, detail::keyMapCachePath("test", "de"));
+
+  ASSERT_TRUE(saveSample(path, "us"));
+  EXPECT_TRUE(loadSample(path, "us"));
+  EXPECT_FALSE(loadSample(path, "de"));
+  EXPECT_FALSE(loadSample((dir_ / "missing.keymap").string(), "us"));
+
+  // Nothing but the cache file is left in the directory.
+  size_t files = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(dir_)) {
+    EXPECT_EQ(entry.path().string(), path);
+    ++files;
+  }
+  EXPECT_EQ(files, 1u);
+}
+
+TEST_F(KeymapCacheDir, RejectsBadMagicVersionAndTruncation) {
+  const std::string path = detail::keyMapCachePath("test", "us");
+  ASSERT_TRUE(saveSample(path, "us"));
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  auto rewrite = [&path](const std::string &content) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  };
+
+  std::string badMagic = bytes;
+  badMagic[0] = 'Z';
+  rewrite(badMagic);
+  EXPECT_FALSE(loadSample(path, "us"));
+
+  // The format version follows the 4-byte magic.
+  std::string badVersion = bytes;
+  badVersion[4] = static_cast<char>(badVersion[4] + 1);
+  rewrite(badVersion);
+  EXPECT_FALSE(loadSample(path, "us"));
+
+  rewrite(bytes.substr(0, bytes.size() - 1));
+  EXPECT_FALSE(loadSample(path, "us"));
+
+  rewrite(bytes);
+  EXPECT_TRUE(loadSample(path, "us"));
+}
+
+TEST(KeymapCacheAcquire, ReusesSnapshotForSameLayout) {
+  setCacheDir("");
+  SharedKeyMapCache<TestMap> cache("test");
+  int builds = 0;
+  auto build = [&builds] {
+    ++builds;
+    return sampleMap();
+  };
+  auto stamp = [](TestMap &map) { ++map.stamped; };
+
+  const auto first = cache.acquire("us", build, stamp);
+  const auto second = cache.acquire("us", build, stamp);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(builds, 1);
+  EXPECT_EQ(first->stamped, 1);
+
+  const auto other = cache.acquire("de", build, stamp);
+  EXPECT_NE(other, first);
+  EXPECT_EQ(builds, 2);
+}
+
+TEST(KeymapCacheAcquire, IncompleteBuildIsNotCached) {
+  setCacheDir("");
+  SharedKeyMapCache<TestMap> cache("test");
+  int builds = 0;
+  bool complete = false;
+  auto build = [&builds, &complete] {
+    ++builds;
+    return KeyMapBuild<TestMap>{sampleMap(), complete};
+  };
+
+  // Every request retries the build and gets a map of its own.
+  const auto degraded = cache.acquire("us", build);
+  ASSERT_NE(degraded, nullptr);
+  EXPECT_NE(cache.acquire("us", build), degraded);
+  EXPECT_EQ(builds, 2);
+
+  complete = true;
+  const auto full = cache.acquire("us", build);
+  EXPECT_EQ(cache.acquire("us", build), full);
+  EXPECT_EQ(builds, 3);
+}
+
+TEST_F(KeymapCacheDir, FreshCacheLoadsSavedFile) {
+  int builds = 0;
+  auto build = [&builds] {
+    ++builds;
+    return sampleMap();
+  };
+  g_dataStamp = "data-1";
+  {
+    SharedKeyMapCache<TestMap> cache("test", testDataStamp);
+    cache.acquire("us", build);
+  }
+  EXPECT_EQ(builds, 1);
+
+  // A new process (here, a new cache) skips the build.
+  {
+    SharedKeyMapCache<TestMap> cache("test", testDataStamp);
+    const auto loaded = cache.acquire("us", build);
+    EXPECT_EQ(builds, 1);
+    ASSERT_NE(loaded->codeToKey.find(28), nullptr);
+    EXPECT_EQ(*loaded->codeToKey.find(28), Key::Enter);
+  }
+
+  // Changed layout data makes the file stale.
+  g_dataStamp = "data-2";
+  {
+    SharedKeyMapCache<TestMap> cache("test", testDataStamp);
+    cache.acquire("us", build);
+  }
+  EXPECT_EQ(builds, 2);
+}
+
+TEST_F(KeymapCacheDir, IncompleteBuildIsNotSaved) {
+  SharedKeyMapCache<TestMap> cache("test");
+  cache.acquire("us",
+                [] { return KeyMapBuild<TestMap>{sampleMap(), false}; });
+  EXPECT_FALSE(
+      std::filesystem::exists(detail::keyMapCachePath("test", "us")));
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_layout_tracker.cpp
+ * @brief Tests for the background layout rebuild and publication shared by
+ * the keyboard backends.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "keyboard/common/layout_tracker.hpp"
+
+using axidev::io::keyboard::detail::LayoutSubscription;
+using axidev::io::keyboard::detail::LayoutTracker;
+
+namespace {
+
+struct FakeMap {
+  int layout{0};
+};
+
+using Tracker = LayoutTracker<FakeMap>;
+
+constexpr std::chrono::milliseconds kWait{2000};
+
+} // namespace
+
+TEST(LayoutTracker, PublishesRebuiltSnapshot) {
+  auto snapshot = std::make_shared<const FakeMap>(FakeMap{1});
+  Tracker tracker("test", [&snapshot] { return snapshot; });
+  uint64_t epoch = 99;
+  EXPECT_EQ(tracker.current(epoch), nullptr);
+  EXPECT_EQ(epoch, 0u);
+
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  EXPECT_EQ(tracker.epoch(), 1u);
+  EXPECT_EQ(tracker.current(epoch), snapshot);
+  EXPECT_EQ(epoch, 1u);
+}
+
+TEST(LayoutTracker, SameSnapshotIsNotPublishedAgain) {
+  auto snapshot = std::make_shared<const FakeMap>(FakeMap{1});
+  Tracker tracker("test", [&snapshot] { return snapshot; });
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  EXPECT_EQ(tracker.epoch(), 1u);
+}
+
+TEST(LayoutTracker, BuildsOffTheCallingThread) {
+  std::atomic<std::thread::id> builder{};
+  Tracker tracker("test", [&builder] {
+    builder = std::this_thread::get_id();
+    return std::make_shared<const FakeMap>();
+  });
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  EXPECT_NE(builder.load(), std::thread::id{});
+  EXPECT_NE(builder.load(), std::this_thread::get_id());
+}
+
+TEST(LayoutTracker, FailedBuildKeepsPreviousSnapshot) {
+  auto snapshot = std::make_shared<const FakeMap>(FakeMap{1});
+  bool fail = false;
+  Tracker tracker("test", [&] {
+    if (fail)
+      throw std::runtime_error("no layout");
+    return snapshot;
+  });
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  fail = true;
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  uint64_t epoch = 0;
+  EXPECT_EQ(tracker.current(epoch), snapshot);
+  EXPECT_EQ(epoch, 1u);
+}
+
+TEST(LayoutTracker, SubscriptionSwapsOncePerPublication) {
+  auto next = std::make_shared<const FakeMap>(FakeMap{2});
+  Tracker tracker("test", [&next] { return next; });
+  std::shared_ptr<const FakeMap> map =
+      std::make_shared<const FakeMap>(FakeMap{1});
+  LayoutSubscription updates;
+
+  EXPECT_FALSE(updates.refresh(tracker, map)); // nothing published yet
+  tracker.notifyChanged();
+  ASSERT_TRUE(tracker.waitIdle(kWait));
+  EXPECT_TRUE(updates.refresh(tracker, map));
+  EXPECT_EQ(map->layout, 2);
+  EXPECT_FALSE(updates.refresh(tracker, map));
+
+  // A reader already on the published snapshot does not swap.
+  std::shared_ptr<const FakeMap> current = next;
+  LayoutSubscription late;
+  EXPECT_FALSE(late.refresh(tracker, current));
+  EXPECT_EQ(current, next);
+}
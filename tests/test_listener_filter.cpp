@@ -0,0 +1,170 @@
+// test_listener_filter.cpp
+// Unit tests for KeyFilter, the compiled form of Listener::Filter: the
+// keycode pre-check against a layout's tables (including codes the layout
+// does not know) and the exact key and chord rules applied after
+// translation. Tables are built by hand, so no backend is involved.
+
+#include <gtest/gtest.h>
+
+#include <axidev-io/keyboard/listener.hpp>
+
+#include "keyboard/common/flat_keymap.hpp"
+#include "keyboard/listener/listener_filter.hpp"
+
+using namespace axidev::io::keyboard;
+using detail::CodeKeyTable;
+using detail::CodeModsKeyTable;
+using detail::KeyFilter;
+
+namespace {
+
+// A small layout: code 10 types A, 11 types B, 12 types 1 (and ! with
+// Shift), 13 types Escape. Every other code is unknown to it.
+struct Layout {
+  CodeKeyTable base;
+  CodeModsKeyTable withMods;
+
+  Layout() {
+    base.insert(10, Key::A);
+    base.insert(11, Key::B);
+    base.insert(12, Key::Num1);
+    base.insert(13, Key::Escape);
+    withMods.insert(12, Modifier::Shift, Key::Exclamation);
+  }
+
+  KeyFilter compile(const Listener::Filter &spec) const {
+    return KeyFilter(spec, base, withMods);
+  }
+};
+
+} // namespace
+
+TEST(KeyFilterTest, DefaultAdmitsEverything) {
+  const KeyFilter filter;
+  EXPECT_TRUE(filter.admitsCode(10, true));
+  EXPECT_TRUE(filter.admitsCode(10, false));
+  EXPECT_TRUE(filter.admitsCode(KeyFilter::kMaxCodes + 5, true));
+  EXPECT_TRUE(filter.admits({Key::Unknown, Modifier::None}));
+  EXPECT_TRUE(filter.wantsCodepoint());
+
+  const Layout layout;
+  const KeyFilter empty = layout.compile(Listener::Filter{});
+  EXPECT_TRUE(empty.admitsCode(11, false));
+  EXPECT_TRUE(empty.admits({Key::B, Modifier::Ctrl}));
+}
+
+TEST(KeyFilterTest, KeysRestrictCodesTheLayoutKnows) {
+  const Layout layout;
+  const KeyFilter filter = layout.compile(Listener::Filter{}.addKey(Key::A));
+
+  EXPECT_TRUE(filter.admitsCode(10, true));
+  EXPECT_TRUE(filter.admitsCode(10, false));
+  EXPECT_FALSE(filter.admitsCode(11, true));
+  EXPECT_FALSE(filter.admitsCode(13, true));
+
+  EXPECT_TRUE(filter.admits({Key::A, Modifier::None}));
+  EXPECT_TRUE(filter.admits({Key::A, Modifier::Ctrl | Modifier::Alt}));
+  EXPECT_FALSE(filter.admits({Key::B, Modifier::None}));
+  EXPECT_FALSE(filter.admits({Key::Unknown, Modifier::None}));
+}
+
+TEST(KeyFilterTest, UnknownCodesPassThePreCheck) {
+  // Codes neither table maps may still be resolved by a backend fallback,
+  // so the pre-check lets them through and admits() decides.
+  const Layout layout;
+  const KeyFilter filter = layout.compile(Listener::Filter{}.addKey(Key::A));
+
+  EXPECT_TRUE(filter.admitsCode(0, true));
+  EXPECT_TRUE(filter.admitsCode(99, true));
+  EXPECT_TRUE(filter.admitsCode(KeyFilter::kMaxCodes - 1, true));
+  EXPECT_TRUE(filter.admitsCode(KeyFilter::kMaxCodes, true));
+  EXPECT_FALSE(filter.admits({Key::Enter, Modifier::None}));
+}
+
+TEST(KeyFilterTest, ModifiedTableLetsSharedCodesThrough) {
+  // Code 12 is Num1 unshifted but Exclamation with Shift: asking for
+  // Exclamation must keep the code, and admits() picks the right key.
+  const Layout layout;
+  const KeyFilter filter =
+      layout.compile(Listener::Filter{}.addKey(Key::Exclamation));
+
+  EXPECT_TRUE(filter.admitsCode(12, true));
+  EXPECT_FALSE(filter.admitsCode(10, true));
+  EXPECT_TRUE(filter.admits({Key::Exclamation, Modifier::Shift}));
+  EXPECT_FALSE(filter.admits({Key::Num1, Modifier::None}));
+}
+
+TEST(KeyFilterTest, ChordOnlyFilterMatchesExactModifiers) {
+  const Layout layout;
+  const KeyFilter filter = layout.compile(
+      Listener::Filter{}.addChord({Key::B, Modifier::Ctrl | Modifier::Shift}));
+
+  EXPECT_TRUE(filter.admitsCode(11, true));
+  EXPECT_FALSE(filter.admitsCode(10, true));
+
+  EXPECT_TRUE(filter.admits({Key::B, Modifier::Ctrl | Modifier::Shift}));
+  // Lock states are ignored on both sides.
+  EXPECT_TRUE(filter.admits(
+      {Key::B, Modifier::Ctrl | Modifier::Shift | Modifier::CapsLock}));
+  EXPECT_TRUE(filter.admits(
+      {Key::B, Modifier::Ctrl | Modifier::Shift | Modifier::NumLock}));
+  // Missing or extra modifiers do not match.
+  EXPECT_FALSE(filter.admits({Key::B, Modifier::Ctrl}));
+  EXPECT_FALSE(filter.admits({Key::B, Modifier::None}));
+  EXPECT_FALSE(filter.admits(
+      {Key::B, Modifier::Ctrl | Modifier::Shift | Modifier::Alt}));
+  EXPECT_FALSE(filter.admits({Key::A, Modifier::Ctrl | Modifier::Shift}));
+}
+
+TEST(KeyFilterTest, KeysAndChordsCombine) {
+  const Layout layout;
+  Listener::Filter spec;
+  spec.addKey(Key::A)
+      .addChord({Key::Escape, Modifier::Alt})
+      .addChord({Key::Escape, Modifier::Ctrl});
+  const KeyFilter filter = layout.compile(spec);
+
+  EXPECT_TRUE(filter.admitsCode(10, true));
+  EXPECT_TRUE(filter.admitsCode(13, true));
+  EXPECT_FALSE(filter.admitsCode(11, true));
+
+  EXPECT_TRUE(filter.admits({Key::A, Modifier::Super}));
+  EXPECT_TRUE(filter.admits({Key::Escape, Modifier::Alt}));
+  EXPECT_TRUE(filter.admits({Key::Escape, Modifier::Ctrl}));
+  EXPECT_FALSE(filter.admits({Key::Escape, Modifier::None}));
+  EXPECT_FALSE(filter.admits({Key::Escape, Modifier::Ctrl | Modifier::Alt}));
+}
+
+TEST(KeyFilterTest, PressOnlyAndCodepointFlags) {
+  const Layout layout;
+  Listener::Filter spec;
+  spec.pressOnly = true;
+  spec.needCodepoint = false;
+
+  // The flags apply even to a filter without keys or chords.
+  const KeyFilter filter = layout.compile(spec);
+  EXPECT_TRUE(filter.admitsCode(11, true));
+  EXPECT_FALSE(filter.admitsCode(11, false));
+  EXPECT_FALSE(filter.admitsCode(99, false));
+  EXPECT_FALSE(filter.wantsCodepoint());
+
+  const KeyFilter keyed = layout.compile(spec.addKey(Key::A));
+  EXPECT_TRUE(keyed.admitsCode(10, true));
+  EXPECT_FALSE(keyed.admitsCode(10, false));
+}
+
+TEST(KeyFilterTest, KeyRangeAddsEveryKeyInEnumOrder) {
+  Listener::Filter spec;
+  spec.addKeyRange(Key::A, Key::C);
+  ASSERT_EQ(spec.keys.size(), 3u);
+  EXPECT_EQ(spec.keys[0], Key::A);
+  EXPECT_EQ(spec.keys[1], Key::B);
+  EXPECT_EQ(spec.keys[2], Key::C);
+
+  const Layout layout;
+  const KeyFilter filter = layout.compile(spec);
+  EXPECT_TRUE(filter.admitsCode(10, true));
+  EXPECT_TRUE(filter.admitsCode(11, true));
+  EXPECT_FALSE(filter.admitsCode(12, true));
+  EXPECT_TRUE(filter.admits({Key::C, Modifier::None}));
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_listener_hot_path.cpp
+ * @brief Locks in that the per-event listener path never allocates.
+ *
+ * Built as its own executable (`axidev-io-hot-path-tests`) together with
+ * counting_new.cpp, which replaces the global allocation functions with
+ * counting ones. Each test drives the pieces every backend runs per OS event (release
+ * bookkeeping, dispatch through the published callback, hotkey matching)
+ * and checks that no allocation happened while doing so.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <axidev-io/keyboard/hotkey.hpp>
+#include <axidev-io/keyboard/listener.hpp>
+
+#include "keyboard/common/published_callback.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+#include "keyboard/listener/release_tracker.hpp"
+
+// Defined with the replaced allocation functions in counting_new.cpp.
+uint64_t countedAllocations();
+
+using namespace axidev::io::keyboard;
+
+namespace {
+
+constexpr int kEvents = 100000;
+
+uint64_t allocations() { return countedAllocations(); }
+
+// Keeps the sanity-check allocation observable.
+std::unique_ptr<int> g_sink;
+
+} // namespace
+
+TEST(ListenerHotPath, CountingHookSeesAllocations) {
+  const uint64_t before = allocations();
+  g_sink = std::make_unique<int>(1);
+  EXPECT_GT(allocations(), before);
+  g_sink.reset();
+}
+
+TEST(ListenerHotPath, DispatchDoesNotAllocate) {
+  detail::PublishedCallback<Listener::EventCallback> callback;
+  uint64_t delivered = 0;
+  callback.publish(detail::adaptCallback(
+      [&delivered](char32_t, KeyWithModifier, bool) { ++delivered; }));
+  detail::ListenerStats stats;
+
+  const uint64_t before = allocations();
+  for (int i = 0; i < kEvents; ++i) {
+    Listener::Event ev;
+    ev.codepoint = U'a';
+    ev.keyMod = KeyWithModifier(Key::A, Modifier::Shift);
+    ev.pressed = (i & 1) == 0;
+    ev.osTimestampNs = static_cast<uint64_t>(i);
+    stats.dispatch(callback, ev);
+  }
+  EXPECT_EQ(allocations(), before);
+  EXPECT_EQ(delivered, static_cast<uint64_t>(kEvents));
+  EXPECT_EQ(stats.snapshot(0).eventsSeen, static_cast<uint64_t>(kEvents));
+}
+
+TEST(ListenerHotPath, ReleaseTrackerDoesNotAllocate) {
+  detail::ReleaseTracker<256> releases;
+  auto now = std::chrono::steady_clock::now();
+
+  const uint64_t before = allocations();
+  uint64_t duplicates = 0;
+  for (int i = 0; i < kEvents; ++i) {
+    const auto code = static_cast<uint32_t>(i % 300); // some out of range
+    releases.press(code, U'a' + static_cast<char32_t>(i % 26));
+    const char32_t cp = releases.pressCodepoint(code);
+    now += std::chrono::milliseconds(100);
+    duplicates += releases.release(code, cp, Modifier::None, now) ? 1 : 0;
+    releases.press(code, 0);
+  }
+  EXPECT_EQ(allocations(), before);
+  EXPECT_EQ(duplicates, 0u);
+}
+
+TEST(ListenerHotPath, ReleaseTrackerDebouncesRepeats) {
+  detail::ReleaseTracker<256> releases;
+  const auto t0 = std::chrono::steady_clock::now();
+
+  releases.press(65, U'a');
+  EXPECT_EQ(releases.pressCodepoint(65), U'a');
+  EXPECT_FALSE(releases.release(65, U'a', Modifier::None, t0));
+  // Same release again within the debounce window.
+  EXPECT_TRUE(releases.release(65, U'a', Modifier::None,
+                               t0 + std::chrono::milliseconds(10)));
+  // Different modifiers, or outside the window, are new releases.
+  EXPECT_FALSE(releases.release(65, U'a', Modifier::Shift,
+                                t0 + std::chrono::milliseconds(20)));
+  EXPECT_FALSE(releases.release(65, U'a', Modifier::Shift,
+                                t0 + std::chrono::milliseconds(200)));
+
+  // Keycodes past the table are not tracked.
+  releases.press(1000, U'x');
+  EXPECT_EQ(releases.pressCodepoint(1000), 0u);
+  EXPECT_FALSE(releases.release(1000, U'x', Modifier::None, t0));
+  EXPECT_FALSE(releases.release(1000, U'x', Modifier::None, t0));
+}
+
+TEST(ListenerHotPath, HotkeyFeedDoesNotAllocate) {
+  HotkeyMatcher hotkeys;
+  uint64_t fired = 0;
+  ASSERT_NE(hotkeys.add("Ctrl+K Ctrl+C",
+                        [&fired](HotkeyMatcher::BindingId) { ++fired; }),
+            HotkeyMatcher::kInvalidBinding);
+  hotkeys.compile();
+
+  const KeyWithModifier k(Key::K, Modifier::Ctrl);
+  const KeyWithModifier c(Key::C, Modifier::Ctrl);
+  const uint64_t before = allocations();
+  for (int i = 0; i < kEvents; ++i) {
+    hotkeys.feed(k, true);
+    hotkeys.feed(k, false);
+    hotkeys.feed(c, true);
+    hotkeys.feed(c, false);
+  }
+  EXPECT_EQ(allocations(), before);
+  EXPECT_EQ(fired, static_cast<uint64_t>(kEvents));
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_listener_queue.cpp
+ * @brief Tests for the SPSC ring and the event queue behind
+ * `Listener::startQueued()`.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include <axidev-io/keyboard/listener.hpp>
+
+#include "keyboard/common/spsc_ring.hpp"
+#include "keyboard/listener/listener_queue.hpp"
+
+using axidev::io::keyboard::Listener;
+using axidev::io::keyboard::detail::SpscRing;
+
+namespace {
+
+Listener::Event event(uint64_t sequence) {
+  Listener::Event ev;
+  ev.timestampNs = sequence;
+  return ev;
+}
+
+} // namespace
+
+TEST(SpscRing, RoundsCapacityUpToPowerOfTwo) {
+  EXPECT_EQ(SpscRing<int>(0).capacity(), 2u);
+  EXPECT_EQ(SpscRing<int>(2).capacity(), 2u);
+  EXPECT_EQ(SpscRing<int>(5).capacity(), 8u);
+  EXPECT_EQ(SpscRing<int>(64).capacity(), 64u);
+}
+
+TEST(SpscRing, KeepsOrderAcrossWraparound) {
+  SpscRing<int> ring(4);
+  int next = 0;
+  int expected = 0;
+  // Three in, three out shifts the indices by one slot per round, so every
+  // slot boundary is crossed, both element by element and in one popBulk().
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 3; ++i)
+      ASSERT_TRUE(ring.tryPush(next++));
+    if (round % 2 == 0) {
+      for (int i = 0; i < 3; ++i) {
+        int value = -1;
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, expected++);
+      }
+    } else {
+      std::array<int, 4> out{};
+      ASSERT_EQ(ring.popBulk(out.data(), out.size()), 3u);
+      for (size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(out[i], expected++);
+    }
+    EXPECT_TRUE(ring.empty());
+  }
+}
+
+TEST(SpscRing, FullRingRejectsUntilPopped) {
+  SpscRing<int> ring(4);
+  for (int i = 0; i < 4; ++i)
+    ASSERT_TRUE(ring.tryPush(i));
+  EXPECT_FALSE(ring.tryPush(4));
+
+  int value = -1;
+  ASSERT_TRUE(ring.tryPop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(ring.tryPush(4));
+  EXPECT_FALSE(ring.tryPush(5));
+
+  std::array<int, 8> out{};
+  ASSERT_EQ(ring.popBulk(out.data(), out.size()), 4u);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(out[static_cast<size_t>(i)], i + 1);
+  EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(SpscRing, ConcurrentProducerAndConsumerKeepOrder) {
+  constexpr uint64_t kCount = 200'000;
+  SpscRing<uint64_t> ring(64);
+  std::thread producer([&ring] {
+    for (uint64_t i = 0; i < kCount; ++i) {
+      while (!ring.tryPush(i))
+        std::this_thread::yield();
+    }
+  });
+
+  uint64_t expected = 0;
+  std::array<uint64_t, 16> out{};
+  while (expected < kCount) {
+    const size_t n = ring.popBulk(out.data(), out.size());
+    for (size_t i = 0; i < n; ++i)
+      ASSERT_EQ(out[i], expected++);
+    if (n == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(ListenerQueue, CountsDropsWhenFull) {
+  Listener::Queue queue(4);
+  for (uint64_t i = 0; i < 6; ++i)
+    queue.push(event(i));
+  EXPECT_EQ(queue.dropped.load(), 2u);
+
+  std::array<Listener::Event, 8> out{};
+  ASSERT_EQ(queue.drain(out.data(), out.size()), 4u);
+  for (size_t i = 0; i < 4; ++i)
+    EXPECT_EQ(out[i].timestampNs, i);
+
+  // Draining makes room again.
+  queue.push(event(6));
+  EXPECT_EQ(queue.dropped.load(), 2u);
+  ASSERT_EQ(queue.drain(out.data(), out.size()), 1u);
+  EXPECT_EQ(out[0].timestampNs, 6u);
+}
+
+TEST(ListenerQueue, WaitReportsPendingEvents) {
+  Listener::Queue queue(8);
+  ASSERT_GE(queue.handle(), 0);
+  EXPECT_FALSE(queue.wait(0));
+
+  queue.push(event(1));
+  queue.push(event(2));
+  EXPECT_TRUE(queue.wait(0));
+
+  // A short drain leaves events behind and keeps the waiter awake.
+  std::array<Listener::Event, 1> one{};
+  ASSERT_EQ(queue.drain(one.data(), one.size()), 1u);
+  EXPECT_TRUE(queue.wait(0));
+  ASSERT_EQ(queue.drain(one.data(), one.size()), 1u);
+  EXPECT_EQ(one[0].timestampNs, 2u);
+  EXPECT_FALSE(queue.wait(10));
+}
+
+TEST(ListenerQueue, WaitNeverReportsAnEmptyQueue) {
+  constexpr uint64_t kCount = 50'000;
+  Listener::Queue queue(64);
+  std::atomic<bool> done{false};
+  std::thread producer([&queue, &done] {
+    for (uint64_t i = 0; i < kCount; ++i) {
+      queue.push(event(i));
+      if (i % 64 == 0)
+        std::this_thread::yield();
+    }
+    done.store(true);
+  });
+
+  // Events pushed while drain() runs can leave the signal raised over an
+  // empty ring; wait() must wait through it rather than report it.
+  uint64_t received = 0;
+  uint64_t last = 0;
+  std::array<Listener::Event, 8> out{};
+  while (!done.load() || received + queue.dropped.load() < kCount) {
+    if (!queue.wait(20))
+      continue;
+    const size_t n = queue.drain(out.data(), out.size());
+    // EXPECT rather than ASSERT: returning early would leave the producer
+    // thread joinable.
+    EXPECT_GT(n, 0u);
+    for (size_t i = 0; i < n; ++i) {
+      if (received > 0) {
+        EXPECT_GT(out[i].timestampNs, last);
+      }
+      last = out[i].timestampNs;
+      ++received;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(received + queue.dropped.load(), kCount);
+  EXPECT_FALSE(queue.wait(0));
+}
+
+TEST(ListenerQueue, WakeEndsAnInfiniteWait) {
+  Listener::Queue queue(8);
+  std::atomic<bool> returned{false};
+  bool result = true;
+  std::thread waiter([&] {
+    result = queue.wait(Listener::kWaitInfinite);
+    returned.store(true);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(returned.load());
+  queue.wake();
+  waiter.join();
+  EXPECT_FALSE(result);
+
+  // A wake with no waiter ends the next wait on an empty queue, once, even
+  // if a drain reset the signal in between.
+  queue.wake();
+  std::array<Listener::Event, 1> out{};
+  EXPECT_EQ(queue.drain(out.data(), out.size()), 0u);
+  EXPECT_FALSE(queue.wait(Listener::kWaitInfinite));
+  EXPECT_FALSE(queue.wait(0));
+
+  // Pending events still win.
+  queue.push(event(1));
+  queue.wake();
+  EXPECT_TRUE(queue.wait(0));
+}
@@ -0,0 +1,117 @@
+// test_round_trip.cpp
+// Unit tests for RoundTripHistogram, and for the argument checks of
+// measureRoundTrip() that do not need a working input pipeline.
+
+#include <gtest/gtest.h>
+
+#include <axidev-io/keyboard/round_trip.hpp>
+
+#include <algorithm>
+
+using namespace axidev::io::keyboard;
+
+TEST(RoundTripHistogramTest, EmptyHistogram) {
+  RoundTripHistogram h;
+  EXPECT_EQ(h.sent(), 0u);
+  EXPECT_EQ(h.received(), 0u);
+  EXPECT_EQ(h.minNs(), 0u);
+  EXPECT_EQ(h.maxNs(), 0u);
+  EXPECT_EQ(h.meanNs(), 0u);
+  EXPECT_EQ(h.percentileNs(0.5), 0u);
+  EXPECT_TRUE(h.samplesNs().empty());
+}
+
+TEST(RoundTripHistogramTest, PercentilesAndBuckets) {
+  RoundTripHistogram h;
+  // 100 samples, 1..100 us, added out of order.
+  for (uint64_t i = 100; i >= 1; --i)
+    h.add(i * 1000);
+  h.addLost();
+  h.addLost();
+
+  EXPECT_EQ(h.received(), 100u);
+  EXPECT_EQ(h.lost(), 2u);
+  EXPECT_EQ(h.sent(), 102u);
+  EXPECT_EQ(h.minNs(), 1000u);
+  EXPECT_EQ(h.maxNs(), 100000u);
+  EXPECT_EQ(h.meanNs(), 50500u);
+  EXPECT_EQ(h.percentileNs(0.0), 1000u);
+  EXPECT_EQ(h.percentileNs(0.5), 50000u);
+  EXPECT_EQ(h.percentileNs(0.99), 99000u);
+  EXPECT_EQ(h.percentileNs(1.0), 100000u);
+  EXPECT_EQ(h.percentileNs(2.0), 100000u);
+
+  const auto samples = h.samplesNs();
+  ASSERT_EQ(samples.size(), 100u);
+  EXPECT_TRUE(std::is_sorted(samples.begin(), samples.end()));
+
+  // Bucket i holds [2^(i-1), 2^i) us: 1 us -> 1, 2-3 us -> 2, 64-100 -> 7.
+  uint64_t total = 0;
+  for (uint64_t n : h.buckets())
+    total += n;
+  EXPECT_EQ(total, 100u);
+  EXPECT_EQ(h.buckets()[0], 0u);
+  EXPECT_EQ(h.buckets()[1], 1u);
+  EXPECT_EQ(h.buckets()[2], 2u);
+  EXPECT_EQ(h.buckets()[7], 37u);
+}
+
+TEST(RoundTripHistogramTest, MergeAndClear) {
+  RoundTripHistogram a;
+  RoundTripHistogram b;
+  a.add(5000);
+  b.add(1000);
+  b.addLost();
+  a.merge(b);
+  EXPECT_EQ(a.received(), 2u);
+  EXPECT_EQ(a.lost(), 1u);
+  EXPECT_EQ(a.minNs(), 1000u);
+  a.merge(a);
+  EXPECT_EQ(a.received(), 2u);
+  a.clear();
+  EXPECT_EQ(a.sent(), 0u);
+  EXPECT_EQ(a.buckets()[3], 0u);
+}
+
+TEST(RoundTripHistogramTest, KeptSamplesStayBounded) {
+  const size_t kMax = RoundTripHistogram::kMaxSamples;
+  RoundTripHistogram h;
+  // A uniform spread of 1..10 * kMax ns, so percentiles are known.
+  const uint64_t total = 10 * kMax;
+  for (uint64_t i = 1; i <= total; ++i)
+    h.add(i);
+  EXPECT_EQ(h.received(), total);
+  EXPECT_EQ(h.samplesNs().size(), kMax);
+  EXPECT_TRUE(std::is_sorted(h.samplesNs().begin(), h.samplesNs().end()));
+  // Exact regardless of sampling.
+  EXPECT_EQ(h.minNs(), 1u);
+  EXPECT_EQ(h.maxNs(), total);
+  EXPECT_EQ(h.meanNs(), (total + 1) / 2);
+  // Estimated from the sample: well within 5% of the true rank.
+  const double p50 = static_cast<double>(h.percentileNs(0.5));
+  EXPECT_NEAR(p50 / static_cast<double>(total), 0.5, 0.05);
+  const double p90 = static_cast<double>(h.percentileNs(0.9));
+  EXPECT_NEAR(p90 / static_cast<double>(total), 0.9, 0.05);
+
+  // Merging keeps the bound and weights each side by its probes.
+  RoundTripHistogram slow;
+  for (uint64_t i = 0; i < total; ++i)
+    slow.add(10 * total);
+  h.merge(slow);
+  EXPECT_EQ(h.received(), 2 * total);
+  EXPECT_EQ(h.samplesNs().size(), kMax);
+  EXPECT_EQ(h.maxNs(), 10 * total);
+  EXPECT_EQ(h.percentileNs(0.9), 10 * total);
+  EXPECT_LT(h.percentileNs(0.4), total);
+}
+
+TEST(RoundTripTest, RejectsEmptyMarkers) {
+  Sender sender;
+  Listener listener;
+  RoundTripHistogram h;
+  RoundTripOptions options;
+  options.markers.clear();
+  EXPECT_FALSE(measureRoundTrip(sender, listener, 1, h, options));
+  EXPECT_EQ(h.sent(), 0u);
+  EXPECT_FALSE(listener.isListening());
+}
@@ -0,0 +1,369 @@
+/**
+ * @file test_trace.cpp
+ * @brief Tests for the keystroke trace format, TraceRecorder, the file side
+ * of TracePlayer and the batching that feeds its Sender.
+ *
+ * Playback itself injects keys into the session and is not exercised here;
+ * the batches it would send are checked through `batchTraceRecords()`.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <axidev-io/keyboard/trace.hpp>
+
+#include "keyboard/common/trace_batcher.hpp"
+#include "keyboard/common/trace_format.hpp"
+#include "keyboard/listener/listener_stats.hpp"
+
+using namespace axidev::io::keyboard;
+
+namespace {
+
+std::string tracePath(const char *name) {
+  return (std::filesystem::temp_directory_path() /
+          (std::string("axidev-io-") + name + ".axkt"))
+      .string();
+}
+
+std::vector<uint8_t> readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in),
+          std::istreambuf_iterator<char>()};
+}
+
+Listener::Event event(Key key, Modifier mods, bool pressed, uint64_t ns) {
+  Listener::Event ev;
+  ev.keyMod = KeyWithModifier(key, mods);
+  ev.pressed = pressed;
+  ev.timestampNs = ns;
+  return ev;
+}
+
+// Encoded records of a trace body, built one record at a time.
+struct RecordBytes {
+  std::vector<uint8_t> bytes;
+
+  RecordBytes &add(uint64_t deltaUs, Key key, bool pressed = true) {
+    detail::TraceRecord rec;
+    rec.deltaUs = deltaUs;
+    rec.key = key;
+    rec.pressed = pressed;
+    std::array<uint8_t, detail::kMaxTraceRecordSize> buf{};
+    const size_t n = detail::encodeTraceRecord(buf.data(), rec);
+    bytes.insert(bytes.end(), buf.begin(), buf.begin() + n);
+    return *this;
+  }
+};
+
+// The batches batchTraceRecords() hands out, copied as they are sent.
+struct Batches {
+  std::vector<std::vector<Sender::KeyEvent>> sent;
+  detail::TraceBatchResult result;
+};
+
+Batches batches(const std::vector<uint8_t> &bytes,
+                const TracePlayOptions &options = {},
+                size_t batchSize = detail::kTracePlayBatchSize) {
+  Batches out;
+  std::vector<Sender::KeyEvent> batch(batchSize);
+  out.result = detail::batchTraceRecords(
+      bytes.data(), bytes.size(), options, batch, [&](size_t count) {
+        out.sent.emplace_back(batch.begin(), batch.begin() + count);
+        return true;
+      });
+  return out;
+}
+
+} // namespace
+
+TEST(TraceFormat, RecordRoundTrip) {
+  const std::array<uint64_t, 5> deltas = {
+      0, 127, 128, 1'000'000, std::numeric_limits<uint64_t>::max()};
+  for (uint64_t delta : deltas) {
+    detail::TraceRecord in;
+    in.deltaUs = delta;
+    in.key = Key::Z;
+    in.mods = Modifier::Shift | Modifier::Ctrl | Modifier::NumLock;
+    in.pressed = true;
+    std::array<uint8_t, detail::kMaxTraceRecordSize> buf{};
+    const size_t n = detail::encodeTraceRecord(buf.data(), in);
+    ASSERT_LE(n, buf.size());
+
+    detail::TraceRecord out;
+    EXPECT_EQ(detail::decodeTraceRecord(buf.data(), n, out), n);
+    EXPECT_EQ(out.deltaUs, delta);
+    EXPECT_EQ(out.key, Key::Z);
+    EXPECT_EQ(out.mods, in.mods);
+    EXPECT_TRUE(out.pressed);
+  }
+}
+
+TEST(TraceFormat, TypicalKeystrokeIsCompact) {
+  detail::TraceRecord rec;
+  rec.deltaUs = 80'000; // 80 ms between keystrokes
+  rec.key = Key::A;
+  std::array<uint8_t, detail::kMaxTraceRecordSize> buf{};
+  EXPECT_EQ(detail::encodeTraceRecord(buf.data(), rec), 6u);
+}
+
+TEST(TraceFormat, TruncatedRecordIsRejected) {
+  detail::TraceRecord rec;
+  rec.deltaUs = 300;
+  rec.key = Key::Enter;
+  std::array<uint8_t, detail::kMaxTraceRecordSize> buf{};
+  const size_t n = detail::encodeTraceRecord(buf.data(), rec);
+  detail::TraceRecord out;
+  for (size_t size = 0; size < n; ++size)
+    EXPECT_EQ(detail::decodeTraceRecord(buf.data(), size, out), 0u) << size;
+
+  // A varint that never terminates within 64 bits.
+  std::array<uint8_t, 16> overlong{};
+  overlong.fill(0xFF);
+  EXPECT_EQ(detail::decodeTraceRecord(overlong.data(), overlong.size(), out),
+            0u);
+}
+
+TEST(TraceFormat, HeaderValidation) {
+  std::array<uint8_t, detail::kTraceHeaderSize> header{};
+  detail::encodeTraceHeader(header.data(), 0x0123456789ABCDEFull);
+  uint64_t startNs = 0;
+  ASSERT_TRUE(
+      detail::decodeTraceHeader(header.data(), header.size(), startNs));
+  EXPECT_EQ(startNs, 0x0123456789ABCDEFull);
+
+  EXPECT_FALSE(
+      detail::decodeTraceHeader(header.data(), header.size() - 1, startNs));
+  auto badVersion = header;
+  badVersion[4] = 2;
+  EXPECT_FALSE(detail::decodeTraceHeader(badVersion.data(), badVersion.size(),
+                                         startNs));
+  auto badMagic = header;
+  badMagic[0] = 'x';
+  EXPECT_FALSE(
+      detail::decodeTraceHeader(badMagic.data(), badMagic.size(), startNs));
+}
+
+TEST(TraceRecorder, WritesDeltaEncodedRecords) {
+  const std::string path = tracePath("recorder");
+  TraceRecorder recorder;
+  ASSERT_TRUE(recorder.open(path));
+  EXPECT_TRUE(recorder.isOpen());
+
+  // Stamp the events after the start of the recording, on a microsecond.
+  const uint64_t t0 = (detail::steadyNowNs() / 1000 + 1'000'000) * 1000;
+  ASSERT_TRUE(recorder.record(event(Key::A, Modifier::Shift, true, t0)));
+  ASSERT_TRUE(
+      recorder.record(event(Key::A, Modifier::Shift, false, t0 + 50'000'999)));
+  // Out of order: no negative pause.
+  ASSERT_TRUE(recorder.record(event(Key::B, Modifier::None, true, t0)));
+  EXPECT_EQ(recorder.recordedCount(), 3u);
+  recorder.close();
+  EXPECT_FALSE(recorder.isOpen());
+  EXPECT_FALSE(recorder.record(event(Key::C, Modifier::None, true, t0)));
+
+  const std::vector<uint8_t> bytes = readFile(path);
+  uint64_t startNs = 0;
+  ASSERT_TRUE(detail::decodeTraceHeader(bytes.data(), bytes.size(), startNs));
+  EXPECT_LT(startNs, t0);
+
+  std::vector<detail::TraceRecord> records;
+  size_t offset = detail::kTraceHeaderSize;
+  while (offset < bytes.size()) {
+    detail::TraceRecord rec;
+    const size_t n = detail::decodeTraceRecord(bytes.data() + offset,
+                                               bytes.size() - offset, rec);
+    ASSERT_NE(n, 0u);
+    offset += n;
+    records.push_back(rec);
+  }
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_EQ(records[0].deltaUs, t0 / 1000 - startNs / 1000);
+  EXPECT_EQ(records[0].key, Key::A);
+  EXPECT_EQ(records[0].mods, Modifier::Shift);
+  EXPECT_TRUE(records[0].pressed);
+  EXPECT_EQ(records[1].deltaUs, 50'000u);
+  EXPECT_FALSE(records[1].pressed);
+  EXPECT_EQ(records[2].deltaUs, 0u);
+  EXPECT_EQ(records[2].key, Key::B);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TraceRecorder, OpenFailsForMissingDirectory) {
+  TraceRecorder recorder;
+  EXPECT_FALSE(recorder.open(
+      (std::filesystem::temp_directory_path() / "axidev-io-no-such-dir" /
+       "trace.axkt")
+          .string()));
+  EXPECT_FALSE(recorder.isOpen());
+  EXPECT_FALSE(recorder.record(event(Key::A, Modifier::None, true, 1)));
+}
+
+TEST(TracePlayer, OpensOnlyTraces) {
+  const std::string path = tracePath("player");
+  {
+    TraceRecorder recorder;
+    ASSERT_TRUE(recorder.open(path));
+    ASSERT_TRUE(recorder.record(event(Key::A, Modifier::None, true, 0)));
+  }
+  TracePlayer player;
+  EXPECT_TRUE(player.open(path));
+  EXPECT_TRUE(player.isOpen());
+  player.close();
+  EXPECT_FALSE(player.isOpen());
+
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a trace at all";
+  }
+  EXPECT_FALSE(player.open(path));
+  EXPECT_FALSE(player.isOpen());
+
+  std::filesystem::remove(path);
+  EXPECT_FALSE(player.open(path));
+}
+
+TEST(TraceBatcher, PausesCarryOverSkippedRecords) {
+  RecordBytes trace;
+  trace.add(5'000, Key::Unknown) // before the first event: dropped
+      .add(1'000, Key::A)
+      .add(100, Key::Unknown)
+      .add(200, Key::Unknown)
+      .add(300, Key::A, false)
+      .add(400, Key::Unknown); // after the last event: dropped
+  const Batches out = batches(trace.bytes);
+  EXPECT_EQ(out.result.skipped, 4u);
+  EXPECT_TRUE(out.result.complete);
+  EXPECT_EQ(out.result.consumed, trace.bytes.size());
+  ASSERT_EQ(out.sent.size(), 1u);
+  ASSERT_EQ(out.sent[0].size(), 2u);
+  EXPECT_EQ(out.sent[0][0].key, Key::A);
+  EXPECT_TRUE(out.sent[0][0].down);
+  EXPECT_EQ(out.sent[0][0].delayUs, 600u);
+  EXPECT_FALSE(out.sent[0][1].down);
+  EXPECT_EQ(out.sent[0][1].delayUs, 0u);
+}
+
+TEST(TraceBatcher, LastEventOfBatchHoldsPauseToNextBatch) {
+  RecordBytes trace;
+  trace.add(0, Key::A).add(10, Key::B).add(20, Key::Unknown).add(30, Key::C);
+  const Batches out = batches(trace.bytes, {}, 2);
+  ASSERT_EQ(out.sent.size(), 2u);
+  ASSERT_EQ(out.sent[0].size(), 2u);
+  EXPECT_EQ(out.sent[0][0].delayUs, 10u);
+  EXPECT_EQ(out.sent[0][1].key, Key::B);
+  EXPECT_EQ(out.sent[0][1].delayUs, 50u);
+  ASSERT_EQ(out.sent[1].size(), 1u);
+  EXPECT_EQ(out.sent[1][0].key, Key::C);
+  EXPECT_EQ(out.sent[1][0].delayUs, 0u);
+}
+
+TEST(TraceBatcher, SplitsAtTheBatchSize) {
+  const size_t kBatch = detail::kTracePlayBatchSize;
+  EXPECT_EQ(kBatch, 256u);
+  RecordBytes full;
+  for (size_t i = 0; i < kBatch; ++i)
+    full.add(i, Key::A, i % 2 == 0);
+  Batches out = batches(full.bytes);
+  ASSERT_EQ(out.sent.size(), 1u);
+  EXPECT_EQ(out.sent[0].size(), kBatch);
+  EXPECT_EQ(out.sent[0].back().delayUs, 0u);
+
+  RecordBytes over = full;
+  over.add(7'777, Key::B);
+  out = batches(over.bytes);
+  ASSERT_EQ(out.sent.size(), 2u);
+  ASSERT_EQ(out.sent[0].size(), kBatch);
+  EXPECT_EQ(out.sent[0][kBatch - 2].delayUs, kBatch - 1);
+  EXPECT_EQ(out.sent[0].back().delayUs, 7'777u);
+  ASSERT_EQ(out.sent[1].size(), 1u);
+  EXPECT_EQ(out.sent[1][0].key, Key::B);
+}
+
+TEST(TraceBatcher, ScalesPauses) {
+  TracePlayOptions options;
+  EXPECT_EQ(detail::scaleTracePause(1'000, options), 1'000u);
+  options.speed = 4.0;
+  EXPECT_EQ(detail::scaleTracePause(1'000, options), 250u);
+  options.maxPauseUs = 100;
+  EXPECT_EQ(detail::scaleTracePause(1'000, options), 100u);
+  EXPECT_EQ(detail::scaleTracePause(200, options), 50u);
+  options = {};
+  options.speed = 0.0;
+  EXPECT_EQ(detail::scaleTracePause(1'000, options), 0u);
+  options.speed = 0.5;
+  EXPECT_EQ(detail::scaleTracePause(std::numeric_limits<uint64_t>::max(),
+                                    options),
+            std::numeric_limits<uint32_t>::max());
+
+  RecordBytes trace;
+  trace.add(0, Key::A).add(2'000, Key::Unknown).add(6'000, Key::B);
+  options = {};
+  options.speed = 2.0;
+  options.maxPauseUs = 3'000;
+  // The cap applies to the whole carried-over pause, after scaling.
+  const Batches out = batches(trace.bytes, options);
+  ASSERT_EQ(out.sent.size(), 1u);
+  EXPECT_EQ(out.sent[0][0].delayUs, 3'000u);
+  options.maxPauseUs = 0;
+  EXPECT_EQ(batches(trace.bytes, options).sent[0][0].delayUs, 4'000u);
+}
+
+TEST(TraceBatcher, IncompleteRecordEndsDecoding) {
+  RecordBytes trace;
+  trace.add(0, Key::A).add(10, Key::B);
+  const size_t complete = trace.bytes.size();
+  trace.add(20, Key::C);
+  trace.bytes.pop_back();
+  const Batches out = batches(trace.bytes);
+  EXPECT_FALSE(out.result.complete);
+  EXPECT_EQ(out.result.consumed, complete);
+  ASSERT_EQ(out.sent.size(), 1u);
+  ASSERT_EQ(out.sent[0].size(), 2u);
+  EXPECT_EQ(out.sent[0][1].delayUs, 0u);
+}
+
+TEST(TraceBatcher, UnplayableKeysAreLeftOutBeforeBatching) {
+  RecordBytes trace;
+  trace.add(0, Key::A).add(10, Key::F13).add(20, Key::B).add(30, Key::F13);
+  std::vector<Sender::KeyEvent> batch(detail::kTracePlayBatchSize);
+  std::vector<Sender::KeyEvent> sent;
+  const detail::TraceBatchResult result = detail::batchTraceRecords(
+      trace.bytes.data(), trace.bytes.size(), {}, batch,
+      [](Key key) { return key != Key::F13; },
+      [&](size_t count) {
+        sent.assign(batch.begin(), batch.begin() + count);
+        return true;
+      });
+  EXPECT_EQ(result.skipped, 2u);
+  EXPECT_FALSE(result.stopped);
+  ASSERT_EQ(sent.size(), 2u);
+  EXPECT_EQ(sent[0].key, Key::A);
+  EXPECT_EQ(sent[0].delayUs, 30u);
+  EXPECT_EQ(sent[1].key, Key::B);
+}
+
+TEST(TraceBatcher, FailedBatchStopsDecoding) {
+  RecordBytes trace;
+  for (int i = 0; i < 5; ++i)
+    trace.add(0, Key::A, i % 2 == 0);
+  std::vector<Sender::KeyEvent> batch(2);
+  int calls = 0;
+  const detail::TraceBatchResult result = detail::batchTraceRecords(
+      trace.bytes.data(), trace.bytes.size(), {}, batch, [&](size_t) {
+        ++calls;
+        return false;
+      });
+  EXPECT_TRUE(result.stopped);
+  EXPECT_EQ(calls, 1);
+  EXPECT_LT(result.consumed, trace.bytes.size());
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_utf8.cpp
+ * @brief Tests for the validating UTF-8 decoder shared by the Sender
+ * backends.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "keyboard/common/utf8.hpp"
+
+using namespace axidev::io::keyboard::detail;
+
+namespace {
+
+// What one decodeUtf8() call reported, in order; ASCII runs are kept apart
+// from code points so the run boundaries can be checked.
+struct Decoded {
+  bool ok{false};
+  std::vector<std::string> asciiRuns;
+  std::u32string all;
+};
+
+Decoded decode(std::string_view in) {
+  Decoded d;
+  d.ok = decodeUtf8(
+      in,
+      [&d](const unsigned char *bytes, size_t n) {
+        d.asciiRuns.emplace_back(reinterpret_cast<const char *>(bytes), n);
+        d.all.append(bytes, bytes + n);
+      },
+      [&d](char32_t cp) { d.all.push_back(cp); });
+  return d;
+}
+
+} // namespace
+
+TEST(Utf8, DecodesEverySequenceLength) {
+  const Decoded d = decode("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z");
+  EXPECT_TRUE(d.ok);
+  EXPECT_EQ(d.all, U"a\u00E9\u20AC\U0001F600z");
+  EXPECT_EQ(d.asciiRuns, (std::vector<std::string>{"a", "z"}));
+
+  // The extremes of each length.
+  EXPECT_EQ(decode("\xC2\x80").all, U"\u0080");
+  EXPECT_EQ(decode("\xDF\xBF").all, U"\u07FF");
+  EXPECT_EQ(decode("\xE0\xA0\x80").all, U"\u0800");
+  EXPECT_EQ(decode("\xEF\xBF\xBF").all, U"\uFFFF");
+  EXPECT_EQ(decode("\xF0\x90\x80\x80").all, U"\U00010000");
+  EXPECT_EQ(decode("\xF4\x8F\xBF\xBF").all, U"\U0010FFFF");
+  EXPECT_TRUE(decode("").ok);
+}
+
+TEST(Utf8, RejectsOverlongForms) {
+  for (std::string_view bad : {
+           std::string_view("\xC0\x80"), std::string_view("\xC1\xBF"),
+           std::string_view("\xE0\x80\x80"), std::string_view("\xE0\x9F\xBF"),
+           std::string_view("\xF0\x80\x80\x80"),
+           std::string_view("\xF0\x8F\xBF\xBF")}) {
+    EXPECT_FALSE(isValidUtf8(bad)) << testing::PrintToString(bad);
+  }
+}
+
+TEST(Utf8, RejectsEncodedSurrogates) {
+  EXPECT_FALSE(isValidUtf8("\xED\xA0\x80")); // U+D800
+  EXPECT_FALSE(isValidUtf8("\xED\xBF\xBF")); // U+DFFF
+  EXPECT_TRUE(isValidUtf8("\xED\x9F\xBF"));  // U+D7FF
+  EXPECT_TRUE(isValidUtf8("\xEE\x80\x80"));  // U+E000
+  EXPECT_FALSE(isValidUtf32(std::u32string(1, char32_t(0xD800))));
+}
+
+TEST(Utf8, RejectsCodePointsAboveUnicodeRange) {
+  EXPECT_FALSE(isValidUtf8("\xF4\x90\x80\x80")); // U+110000
+  EXPECT_FALSE(isValidUtf8("\xF5\x80\x80\x80"));
+  EXPECT_FALSE(isValidUtf8("\xFF"));
+  EXPECT_FALSE(isValidUtf32(std::u32string(1, char32_t(0x110000))));
+}
+
+TEST(Utf8, RejectsStrayAndMissingContinuationBytes) {
+  EXPECT_FALSE(isValidUtf8("\x80"));
+  EXPECT_FALSE(isValidUtf8("a\xBF"));
+  EXPECT_FALSE(isValidUtf8("\xE2\x28\xA1"));
+  EXPECT_FALSE(isValidUtf8("\xF0\x9F\x98\x28"));
+}
+
+TEST(Utf8, RejectsSequencesTruncatedAtTheEnd) {
+  const std::string full = "ab\xF0\x9F\x98\x80";
+  for (size_t cut = 3; cut < full.size(); ++cut) {
+    const Decoded d = decode(std::string_view(full).substr(0, cut));
+    EXPECT_FALSE(d.ok) << cut;
+    // What came before the truncated sequence was still reported.
+    EXPECT_EQ(d.all, U"ab") << cut;
+  }
+  EXPECT_FALSE(isValidUtf8("\xC3"));
+  EXPECT_FALSE(isValidUtf8("\xE2\x82"));
+}
+
+TEST(Utf8, AsciiRunsCrossingBlockBoundaries) {
+  // Runs of every length around the 8- and 16-byte block sizes, followed by
+  // a multi-byte code point and more ASCII, must come back intact and as a
+  // single run each.
+  for (size_t length = 1; length <= 40; ++length) {
+    std::string in(length, 'x');
+    for (size_t i = 0; i < length; ++i)
+      in[i] = static_cast<char>('a' + i % 26);
+    const std::string head = in;
+    in += "\xC3\xA9";
+    in += head;
+
+    const Decoded d = decode(in);
+    ASSERT_TRUE(d.ok) << length;
+    ASSERT_EQ(d.asciiRuns.size(), 2u) << length;
+    EXPECT_EQ(d.asciiRuns[0], head) << length;
+    EXPECT_EQ(d.asciiRuns[1], head) << length;
+    EXPECT_EQ(asciiPrefixLength(in.data(), in.size()), length);
+  }
+}
+
+TEST(Utf8, InvalidByteAtEveryOffsetOfALongRun) {
+  const std::string run(33, 'q');
+  for (size_t at = 0; at < run.size(); ++at) {
+    std::string in = run;
+    in[at] = '\x80';
+    EXPECT_EQ(asciiPrefixLength(in.data(), in.size()), at);
+    const Decoded d = decode(in);
+    EXPECT_FALSE(d.ok) << at;
+    EXPECT_EQ(d.all.size(), at) << at;
+  }
+  EXPECT_EQ(asciiPrefixLength(run.data(), run.size()), run.size());
+}
+
+TEST(Utf8, FailedAppendLeavesOutputUnchanged) {
+  std::u32string utf32 = U"keep";
+  EXPECT_FALSE(appendUtf8AsUtf32("ok\xC3", utf32));
+  EXPECT_EQ(utf32, U"keep");
+  EXPECT_TRUE(appendUtf8AsUtf32("\xC3\xA9", utf32));
+  EXPECT_EQ(utf32, U"keep\u00E9");
+
+  std::vector<char16_t> utf16 = {u'k'};
+  EXPECT_FALSE(appendUtf8AsUtf16("\xF0\x9F\x98\x80\xED\xA0\x80", utf16));
+  EXPECT_EQ(utf16, std::vector<char16_t>({u'k'}));
+  EXPECT_TRUE(appendUtf8AsUtf16("\xF0\x9F\x98\x80", utf16));
+  EXPECT_EQ(utf16, std::vector<char16_t>({u'k', 0xD83D, 0xDE00}));
+}